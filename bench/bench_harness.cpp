@@ -0,0 +1,408 @@
+/**
+ * bench_harness.cpp
+ *
+ * Implementation of the benchmark runner and JSON reporter.
+ */
+
+#include "bench_harness.h"
+#include "perf_counters.h"
+#include "../src/common/types.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace cmse::bench {
+
+    // =================================================================
+    // BenchState
+    // =================================================================
+
+    void BenchState::StartTimer() {
+        if (!running_) {
+            if (perf_ != nullptr) {
+                // First StartTimer(): drop what the harness counted during setup.
+                if (!timer_used_) {
+                    perf_->Disable();
+                    perf_->Reset();
+                }
+                perf_->Enable();
+            }
+            running_ = true;
+            start_ = std::chrono::steady_clock::now();
+        }
+        timer_used_ = true;
+    }
+
+    void BenchState::StopTimer() {
+        if (running_) {
+            auto end = std::chrono::steady_clock::now();
+            if (perf_ != nullptr) {
+                perf_->Disable();
+            }
+            elapsed_ns_ += std::chrono::duration<double, std::nano>(end - start_).count();
+            running_ = false;
+        }
+    }
+
+    // =================================================================
+    // BenchRegistry
+    // =================================================================
+
+    BenchRegistry& BenchRegistry::Instance() {
+        static BenchRegistry registry;
+        return registry;
+    }
+
+    void BenchRegistry::Register(BenchCase bench_case) {
+        cases_.push_back(std::move(bench_case));
+    }
+
+    // =================================================================
+    // Options
+    // =================================================================
+
+    namespace {
+
+        void PrintUsage(const char* program) {
+            std::cout << "Usage: " << program << " [options]\n"
+                << "  --filter=<substr>    Run only cases whose name contains <substr>\n"
+                << "  --category=<name>    Run only 'micro' or 'macro' cases\n"
+                << "  --warmup=<n>         Unmeasured runs per case (default 1)\n"
+                << "  --reps=<n>           Measured runs per case (default 5)\n"
+                << "  --scale=<f>          Multiply every case's iteration count (default 1.0)\n"
+                << "  --json=<path>        Write a machine-readable JSON report\n"
+                << "  --perf               Report hardware counters per op (Linux perf_event_open)\n"
+                << "  --baseline=<path>    Run the cases in a baseline JSON and fail on regressions\n"
+                << "  --tolerance=<f>      Allowed slowdown vs. baseline; overrides the baseline's\n"
+                << "                       own tolerances (default: those, else 3.0)\n"
+                << "  --list               List registered cases and exit\n";
+        }
+
+        bool StartsWith(const std::string& s, const std::string& prefix) {
+            return s.compare(0, prefix.size(), prefix) == 0;
+        }
+
+        std::string JsonEscape(const std::string& s) {
+            std::string out;
+            out.reserve(s.size() + 2);
+            for (char c : s) {
+                switch (c) {
+                case '"':  out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char buf[8];
+                        std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                        out += buf;
+                    }
+                    else {
+                        out += c;
+                    }
+                }
+            }
+            return out;
+        }
+
+        // JSON has no representation for NaN/Inf; emit 0 instead.
+        std::string JsonNumber(double v) {
+            if (!std::isfinite(v)) {
+                return "0";
+            }
+            std::ostringstream ss;
+            ss << std::setprecision(10) << v;
+            return ss.str();
+        }
+
+        std::string UtcTimestamp() {
+            std::time_t now = std::time(nullptr);
+            std::tm tm_utc{};
+#if defined(_WIN32)
+            gmtime_s(&tm_utc, &now);
+#else
+            gmtime_r(&now, &tm_utc);
+#endif
+            char buf[32];
+            std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", &tm_utc);
+            return buf;
+        }
+
+        std::string CompilerId() {
+#if defined(__clang__)
+            return "clang " __clang_version__;
+#elif defined(__GNUC__)
+            return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+            return "msvc " + std::to_string(_MSC_VER);
+#else
+            return "unknown";
+#endif
+        }
+
+    } // namespace
+
+    bool ParseOptions(int argc, char** argv, BenchOptions* out_options) {
+        BenchOptions& opt = *out_options;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            try {
+                if (StartsWith(arg, "--filter=")) {
+                    opt.filter = arg.substr(9);
+                }
+                else if (StartsWith(arg, "--category=")) {
+                    opt.category = arg.substr(11);
+                }
+                else if (StartsWith(arg, "--json=")) {
+                    opt.json_path = arg.substr(7);
+                }
+                else if (StartsWith(arg, "--warmup=")) {
+                    opt.warmup = std::max(0, std::stoi(arg.substr(9)));
+                }
+                else if (StartsWith(arg, "--reps=")) {
+                    opt.repetitions = std::max(1, std::stoi(arg.substr(7)));
+                }
+                else if (StartsWith(arg, "--scale=")) {
+                    opt.scale = std::max(0.0, std::stod(arg.substr(8)));
+                }
+                else if (StartsWith(arg, "--baseline=")) {
+                    opt.baseline_path = arg.substr(11);
+                }
+                else if (StartsWith(arg, "--tolerance=")) {
+                    opt.tolerance = std::max(1.0, std::stod(arg.substr(12)));
+                }
+                else if (arg == "--perf") {
+                    opt.perf = true;
+                }
+                else if (arg == "--list") {
+                    opt.list_only = true;
+                }
+                else {
+                    std::cerr << "[BENCH] Unknown argument: " << arg << std::endl;
+                    PrintUsage(argv[0]);
+                    return false;
+                }
+            }
+            catch (const std::exception&) {
+                std::cerr << "[BENCH] Invalid value in argument: " << arg << std::endl;
+                PrintUsage(argv[0]);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // =================================================================
+    // Runner
+    // =================================================================
+
+    BenchResult RunCase(const BenchCase& bench_case, const BenchOptions& options, PerfCounters* perf) {
+        if (perf != nullptr && !perf->IsOpen()) {
+            perf = nullptr;
+        }
+
+        uint64_t iterations = static_cast<uint64_t>(static_cast<double>(bench_case.iterations) * options.scale);
+        iterations = std::max<uint64_t>(1, iterations);
+
+        BenchResult result;
+        result.name = bench_case.name;
+        result.category = bench_case.category;
+        result.iterations = iterations;
+        result.repetitions = options.repetitions;
+
+        // Warm-up runs: populate caches, fault in pages, let the CPU clock up.
+        for (int w = 0; w < options.warmup; ++w) {
+            BenchState state(iterations);
+            bench_case.fn(state);
+        }
+
+        std::vector<double> ns_per_op;
+        ns_per_op.reserve(options.repetitions);
+
+        PerfReading perf_total;
+
+        for (int r = 0; r < options.repetitions; ++r) {
+            BenchState state(iterations);
+
+            // Counting starts with the call; the first StartTimer() discards setup counts.
+            if (perf != nullptr) {
+                state.AttachPerfCounters(perf);
+                perf->Reset();
+                perf->Enable();
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            bench_case.fn(state);
+            auto end = std::chrono::steady_clock::now();
+
+            if (perf != nullptr) {
+                perf->Disable();
+                PerfReading reading = perf->Read();
+                for (size_t e = 0; e < NUM_PERF_EVENTS; ++e) {
+                    perf_total.values[e] += reading.values[e];
+                    perf_total.valid[e] = reading.valid[e];
+                }
+            }
+
+            double elapsed_ns = state.TimerUsed()
+                ? state.ElapsedNs()
+                : std::chrono::duration<double, std::nano>(end - start).count();
+
+            ns_per_op.push_back(elapsed_ns / static_cast<double>(iterations));
+            result.counters = state.Counters();
+        }
+
+        if (perf != nullptr) {
+            double total_ops = static_cast<double>(iterations) * options.repetitions;
+            for (size_t e = 0; e < NUM_PERF_EVENTS; ++e) {
+                if (perf_total.valid[e]) {
+                    std::string key = std::string("perf_") + PerfEventName(static_cast<PerfEvent>(e)) + "_per_op";
+                    result.counters[key] = perf_total.values[e] / total_ops;
+                }
+            }
+            if (perf_total.Has(PerfEvent::Cycles) && perf_total.Has(PerfEvent::Instructions)
+                && perf_total.Get(PerfEvent::Cycles) > 0.0) {
+                result.counters["perf_ipc"] = perf_total.Get(PerfEvent::Instructions) / perf_total.Get(PerfEvent::Cycles);
+            }
+        }
+
+        std::vector<double> sorted = ns_per_op;
+        std::sort(sorted.begin(), sorted.end());
+
+        double sum = 0.0;
+        for (double v : sorted) sum += v;
+        double mean = sum / sorted.size();
+
+        double var = 0.0;
+        for (double v : sorted) var += (v - mean) * (v - mean);
+
+        size_t mid = sorted.size() / 2;
+        result.median_ns_per_op = (sorted.size() % 2 == 1) ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2.0;
+        result.mean_ns_per_op = mean;
+        result.min_ns_per_op = sorted.front();
+        result.max_ns_per_op = sorted.back();
+        result.stddev_ns_per_op = sorted.size() > 1 ? std::sqrt(var / (sorted.size() - 1)) : 0.0;
+        result.ops_per_sec = result.median_ns_per_op > 0.0 ? 1e9 / result.median_ns_per_op : 0.0;
+
+        return result;
+    }
+
+    std::vector<BenchResult> RunAll(const BenchOptions& options) {
+        std::vector<BenchResult> results;
+
+        PerfCounters perf;
+        if (options.perf) {
+            std::string error;
+            if (!perf.Open(&error)) {
+                std::cerr << "[BENCH] Warning: hardware counters unavailable (" << error
+                    << "); continuing without --perf." << std::endl;
+            }
+        }
+
+        std::cout << std::left << std::setw(40) << "Benchmark"
+            << std::right << std::setw(12) << "Iters"
+            << std::setw(14) << "Median ns/op"
+            << std::setw(12) << "Stddev"
+            << std::setw(16) << "Ops/sec" << "\n";
+        std::cout << std::string(94, '-') << "\n";
+
+        for (const auto& bench_case : BenchRegistry::Instance().Cases()) {
+            if (!options.filter.empty() && bench_case.name.find(options.filter) == std::string::npos) {
+                continue;
+            }
+            if (!options.category.empty() && bench_case.category != options.category) {
+                continue;
+            }
+            if (!options.names.empty()
+                && std::find(options.names.begin(), options.names.end(), bench_case.name) == options.names.end()) {
+                continue;
+            }
+
+            BenchResult r = RunCase(bench_case, options, &perf);
+
+            std::cout << std::left << std::setw(40) << r.name
+                << std::right << std::setw(12) << r.iterations
+                << std::setw(14) << std::fixed << std::setprecision(1) << r.median_ns_per_op
+                << std::setw(12) << r.stddev_ns_per_op
+                << std::setw(16) << std::setprecision(0) << r.ops_per_sec << "\n";
+            std::cout.unsetf(std::ios::fixed);
+            std::cout << std::setprecision(6);
+
+            for (const auto& [key, value] : r.counters) {
+                std::cout << "    " << key << " = " << value << "\n";
+            }
+
+            results.push_back(std::move(r));
+        }
+
+        return results;
+    }
+
+    // =================================================================
+    // JSON Reporter
+    // =================================================================
+
+    std::string ToJson(const std::vector<BenchResult>& results) {
+        std::ostringstream out;
+        out << "{\n";
+        out << "  \"context\": {\n";
+        out << "    \"date\": \"" << UtcTimestamp() << "\",\n";
+        out << "    \"compiler\": \"" << JsonEscape(CompilerId()) << "\",\n";
+#ifdef NDEBUG
+        out << "    \"build_type\": \"release\",\n";
+#else
+        out << "    \"build_type\": \"debug\",\n";
+#endif
+        out << "    \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+        out << "    \"page_size\": " << cmse::PAGE_SIZE << "\n";
+        out << "  },\n";
+        out << "  \"benchmarks\": [";
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            const BenchResult& r = results[i];
+            out << (i == 0 ? "\n" : ",\n");
+            out << "    {\n";
+            out << "      \"name\": \"" << JsonEscape(r.name) << "\",\n";
+            out << "      \"category\": \"" << JsonEscape(r.category) << "\",\n";
+            out << "      \"iterations\": " << r.iterations << ",\n";
+            out << "      \"repetitions\": " << r.repetitions << ",\n";
+            out << "      \"ns_per_op\": {"
+                << "\"mean\": " << JsonNumber(r.mean_ns_per_op)
+                << ", \"median\": " << JsonNumber(r.median_ns_per_op)
+                << ", \"min\": " << JsonNumber(r.min_ns_per_op)
+                << ", \"max\": " << JsonNumber(r.max_ns_per_op)
+                << ", \"stddev\": " << JsonNumber(r.stddev_ns_per_op) << "},\n";
+            out << "      \"ops_per_sec\": " << JsonNumber(r.ops_per_sec) << ",\n";
+            out << "      \"counters\": {";
+            bool first = true;
+            for (const auto& [key, value] : r.counters) {
+                out << (first ? "" : ", ") << "\"" << JsonEscape(key) << "\": " << JsonNumber(value);
+                first = false;
+            }
+            out << "}\n";
+            out << "    }";
+        }
+
+        out << (results.empty() ? "]\n" : "\n  ]\n");
+        out << "}\n";
+        return out.str();
+    }
+
+    bool WriteJson(const std::vector<BenchResult>& results, const std::string& path) {
+        std::ofstream outfile(path);
+        if (!outfile.is_open()) {
+            std::cerr << "[BENCH] Error: Could not open " << path << " for writing." << std::endl;
+            return false;
+        }
+        outfile << ToJson(results);
+        return true;
+    }
+
+} // namespace cmse::bench
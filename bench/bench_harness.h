@@ -0,0 +1,174 @@
+/**
+ * bench_harness.h
+ *
+ * Minimal benchmark harness for the cmse_bench target.
+ * Each benchmark case is a function that performs state.Iterations() operations.
+ * The harness handles warm-up, repetitions, summary statistics and JSON output
+ * so results can be tracked across commits.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace cmse::bench {
+
+    class PerfCounters;
+
+    /**
+     * BenchState
+     * Passed to every benchmark body. The body must perform Iterations() operations.
+     * Setup that should not be measured goes before StartTimer() / after StopTimer().
+     * If the body never calls StartTimer(), the whole call is measured.
+     */
+    class BenchState {
+    public:
+        explicit BenchState(uint64_t iterations) : iterations_(iterations) {}
+
+        uint64_t Iterations() const { return iterations_; }
+
+        void StartTimer();
+        void StopTimer();
+
+        // Attaches a named value to the result (e.g. hit ratio, bytes written).
+        // The value of the last repetition is reported.
+        void SetCounter(const std::string& name, double value) { counters_[name] = value; }
+
+        // --- Harness side ---
+        // Hardware counters (--perf) follow StartTimer()/StopTimer() so setup is excluded.
+        void AttachPerfCounters(PerfCounters* perf) { perf_ = perf; }
+        bool TimerUsed() const { return timer_used_; }
+        double ElapsedNs() const { return elapsed_ns_; }
+        const std::map<std::string, double>& Counters() const { return counters_; }
+
+    private:
+        uint64_t iterations_;
+        bool timer_used_ = false;
+        bool running_ = false;
+        double elapsed_ns_ = 0.0;
+        std::chrono::steady_clock::time_point start_;
+        std::map<std::string, double> counters_;
+        PerfCounters* perf_ = nullptr;
+    };
+
+    using BenchFn = std::function<void(BenchState&)>;
+
+    /**
+     * BenchCase
+     * A registered benchmark. 'category' is "micro" or "macro".
+     * 'iterations' is the number of operations performed per repetition.
+     */
+    struct BenchCase {
+        std::string name;
+        std::string category;
+        uint64_t iterations;
+        BenchFn fn;
+    };
+
+    /**
+     * BenchResult
+     * Summary of all measured repetitions of a single case (warm-up runs excluded).
+     */
+    struct BenchResult {
+        std::string name;
+        std::string category;
+        uint64_t iterations = 0;
+        int repetitions = 0;
+
+        double mean_ns_per_op = 0.0;
+        double median_ns_per_op = 0.0;
+        double min_ns_per_op = 0.0;
+        double max_ns_per_op = 0.0;
+        double stddev_ns_per_op = 0.0;
+        double ops_per_sec = 0.0;
+
+        std::map<std::string, double> counters;
+    };
+
+    // Allowed slowdown factor vs. a baseline when neither --tolerance nor the baseline sets one.
+    constexpr double DEFAULT_TOLERANCE = 3.0;
+
+    /**
+     * BenchOptions
+     * Parsed from the command line (see ParseOptions).
+     */
+    struct BenchOptions {
+        std::string filter;        // Substring match on case name; empty = all
+        std::vector<std::string> names; // Exact case names to run (set from --baseline); empty = all
+        std::string category;      // "micro", "macro" or empty = all
+        std::string json_path;     // Write JSON report here if non-empty
+        int warmup = 1;            // Unmeasured runs per case
+        int repetitions = 5;       // Measured runs per case
+        double scale = 1.0;        // Multiplier applied to every case's iteration count
+        bool perf = false;         // Collect hardware counters (Linux perf_event_open)
+        std::string baseline_path; // Compare against this baseline and fail on regressions
+        double tolerance = 0.0;    // --tolerance; 0 = not given (see perf_baseline.h)
+        bool list_only = false;
+    };
+
+    /**
+     * BenchRegistry
+     * Global list of benchmark cases. Cases register themselves at static-init time
+     * through the CMSE_BENCHMARK macro.
+     */
+    class BenchRegistry {
+    public:
+        static BenchRegistry& Instance();
+
+        void Register(BenchCase bench_case);
+        const std::vector<BenchCase>& Cases() const { return cases_; }
+
+    private:
+        std::vector<BenchCase> cases_;
+    };
+
+    struct BenchRegistrar {
+        BenchRegistrar(const char* name, const char* category, uint64_t iterations, BenchFn fn) {
+            BenchRegistry::Instance().Register({ name, category, iterations, std::move(fn) });
+        }
+    };
+
+    // Parses "--filter=", "--category=", "--json=", "--warmup=", "--reps=", "--scale=", "--perf",
+    // "--baseline=", "--tolerance=", "--list".
+    // Returns false (after printing usage) on an unknown argument.
+    bool ParseOptions(int argc, char** argv, BenchOptions* out_options);
+
+    // Runs one case with warm-up and repetitions and returns its summary.
+    // If 'perf' is open, per-op hardware counters ("perf_*_per_op") are added to the result.
+    BenchResult RunCase(const BenchCase& bench_case, const BenchOptions& options, PerfCounters* perf = nullptr);
+
+    // Runs every registered case that matches the options. Prints a table to stdout.
+    // With options.perf, hardware counters are opened once; if unavailable a warning is printed
+    // and the run continues without them.
+    std::vector<BenchResult> RunAll(const BenchOptions& options);
+
+    // Serializes results to a JSON document (schema: {"context": {...}, "benchmarks": [...]}).
+    std::string ToJson(const std::vector<BenchResult>& results);
+
+    // Writes ToJson(results) to 'path'. Returns false if the file could not be opened.
+    bool WriteJson(const std::vector<BenchResult>& results, const std::string& path);
+
+    // Prevents the compiler from optimizing away a computed value.
+    template <typename T>
+    inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        volatile char sink = *reinterpret_cast<const volatile char*>(&value);
+        (void)sink;
+#endif
+    }
+
+} // namespace cmse::bench
+
+#define CMSE_BENCH_CONCAT_INNER(a, b) a##b
+#define CMSE_BENCH_CONCAT(a, b) CMSE_BENCH_CONCAT_INNER(a, b)
+
+// Registers 'fn' (void(BenchState&)) as a benchmark case.
+#define CMSE_BENCHMARK(fn, category, iterations) \
+    static ::cmse::bench::BenchRegistrar CMSE_BENCH_CONCAT(bench_registrar_, __LINE__)(#fn, category, iterations, fn)
@@ -0,0 +1,66 @@
+/**
+ * bench_main.cpp
+ *
+ * Entry point of the cmse_bench target.
+ * Example: cmse_bench --category=micro --reps=10 --json=bench.json
+ *
+ * Perf-smoke mode (ctest label "perf-smoke"): runs only the cases listed in a baseline
+ * and exits with 1 if any is slower than baseline * tolerance.
+ *   cmse_bench --baseline=bench/baselines/perf_smoke.json --scale=0.25 --reps=3
+ */
+
+#include <iostream>
+#include <string>
+
+#include "bench_harness.h"
+#include "perf_baseline.h"
+
+// ctest SKIP_RETURN_CODE for the perf-smoke test.
+constexpr int EXIT_SKIPPED = 77;
+
+int main(int argc, char** argv) {
+    cmse::bench::BenchOptions options;
+    if (!cmse::bench::ParseOptions(argc, argv, &options)) {
+        return 2;
+    }
+
+    if (options.list_only) {
+        for (const auto& bench_case : cmse::bench::BenchRegistry::Instance().Cases()) {
+            std::cout << bench_case.category << "  " << bench_case.name << "\n";
+        }
+        return 0;
+    }
+
+    cmse::bench::Baseline baseline;
+    if (!options.baseline_path.empty()) {
+#if !defined(NDEBUG) || defined(CMSE_LATENCY_HISTOGRAMS) || defined(CMSE_LATCH_PROFILING)
+        // Baselines are recorded from optimized, uninstrumented builds; other timings are not comparable.
+        std::cout << "[BENCH] Skipping baseline check: not an optimized build without instrumentation." << std::endl;
+        return EXIT_SKIPPED;
+#endif
+        std::string error;
+        if (!cmse::bench::LoadBaseline(options.baseline_path, &baseline, &error)) {
+            std::cerr << "[BENCH] Cannot load baseline " << options.baseline_path << ": " << error << std::endl;
+            return 1;
+        }
+        for (const auto& [name, entry] : baseline.entries) {
+            options.names.push_back(name);
+        }
+    }
+
+    auto results = cmse::bench::RunAll(options);
+
+    if (!options.json_path.empty()) {
+        if (!cmse::bench::WriteJson(results, options.json_path)) {
+            return 1;
+        }
+        std::cout << "[BENCH] Wrote " << results.size() << " results to " << options.json_path << std::endl;
+    }
+
+    if (!options.baseline_path.empty()
+        && cmse::bench::CompareToBaseline(results, baseline, options.tolerance, std::cout) > 0) {
+        return 1;
+    }
+
+    return 0;
+}
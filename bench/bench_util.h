@@ -0,0 +1,124 @@
+/**
+ * bench_util.h
+ *
+ * Shared helpers for benchmark cases: scratch DB files and key distributions.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_harness.h"
+#include "../src/utils/latch.h"
+#include "../src/utils/latency_histogram.h"
+
+namespace cmse::bench {
+
+    /**
+     * ScratchDbFile
+     * RAII guard for a benchmark DB file. Removes any leftover file on construction
+     * (DiskManager reopens existing files instead of truncating) and on destruction.
+     */
+    class ScratchDbFile {
+    public:
+        explicit ScratchDbFile(std::string path) : path_(std::move(path)) { Remove(); }
+        ~ScratchDbFile() { Remove(); }
+
+        ScratchDbFile(const ScratchDbFile&) = delete;
+        ScratchDbFile& operator=(const ScratchDbFile&) = delete;
+
+        const std::string& Path() const { return path_; }
+
+    private:
+        void Remove() {
+            std::error_code ec;
+            std::filesystem::remove(path_, ec);
+        }
+
+        std::string path_;
+    };
+
+    /**
+     * ZipfianGenerator
+     * Draws integers in [0, n) with P(i) proportional to 1 / (i + 1)^theta,
+     * using the constant-time method of Gray et al. ("Quickly Generating
+     * Billion-Record Synthetic Databases"), as in YCSB.
+     * theta = 0.99 is the YCSB default skew.
+     */
+    class ZipfianGenerator {
+    public:
+        ZipfianGenerator(uint64_t n, double theta, uint64_t seed)
+            : n_(n), theta_(theta), rng_(seed), uniform_(0.0, 1.0) {
+            zetan_ = Zeta(n_, theta_);
+            double zeta2 = Zeta(2, theta_);
+            alpha_ = 1.0 / (1.0 - theta_);
+            eta_ = (1.0 - std::pow(2.0 / static_cast<double>(n_), 1.0 - theta_)) / (1.0 - zeta2 / zetan_);
+        }
+
+        uint64_t Next() {
+            double u = uniform_(rng_);
+            double uz = u * zetan_;
+            if (uz < 1.0) return 0;
+            if (uz < 1.0 + std::pow(0.5, theta_)) return 1;
+            uint64_t v = static_cast<uint64_t>(static_cast<double>(n_) * std::pow(eta_ * u - eta_ + 1.0, alpha_));
+            return v >= n_ ? n_ - 1 : v;
+        }
+
+    private:
+        static double Zeta(uint64_t n, double theta) {
+            double sum = 0.0;
+            for (uint64_t i = 1; i <= n; ++i) {
+                sum += 1.0 / std::pow(static_cast<double>(i), theta);
+            }
+            return sum;
+        }
+
+        uint64_t n_;
+        double theta_;
+        double zetan_ = 0.0;
+        double alpha_ = 0.0;
+        double eta_ = 0.0;
+        std::mt19937_64 rng_;
+        std::uniform_real_distribution<double> uniform_;
+    };
+
+    /**
+     * Copies p50/p99/p999 of each operation into the case's counters
+     * (e.g. "fetch_page_p99_ns"). No-op when histograms are compiled out.
+     */
+    inline void AddLatencyCounters(BenchState& state, const std::vector<utils::LatencySummary>& summaries) {
+        for (const auto& s : summaries) {
+            if (s.count == 0) {
+                continue;
+            }
+            state.SetCounter(s.op + "_p50_ns", static_cast<double>(s.p50_ns));
+            state.SetCounter(s.op + "_p99_ns", static_cast<double>(s.p99_ns));
+            state.SetCounter(s.op + "_p999_ns", static_cast<double>(s.p999_ns));
+        }
+    }
+
+    /**
+     * Reports the 'top_n' most contended latches since the last LatchRegistry reset:
+     * contended acquisitions in percent, wait time per benchmark op and mean hold time.
+     * Adds nothing unless built with CMSE_ENABLE_LATCH_PROFILING (no latch registers otherwise).
+     */
+    inline void AddLatchCounters(BenchState& state, uint64_t total_ops, size_t top_n = 3) {
+        auto latches = utils::LatchRegistry::instance().snapshot();
+        for (size_t i = 0; i < latches.size() && i < top_n; ++i) {
+            const auto& l = latches[i];
+            if (l.acquisitions == 0) {
+                continue;
+            }
+            const std::string prefix = "latch_" + l.name;
+            state.SetCounter(prefix + "_contended_pct", 100.0 * l.ContentionRatio());
+            state.SetCounter(prefix + "_wait_ns_per_op", total_ops == 0 ? 0.0 : static_cast<double>(l.wait_ns) / static_cast<double>(total_ops));
+            state.SetCounter(prefix + "_avg_hold_ns", static_cast<double>(l.hold_ns) / static_cast<double>(l.acquisitions));
+        }
+    }
+
+} // namespace cmse::bench
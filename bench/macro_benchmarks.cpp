@@ -0,0 +1,1206 @@
+/**
+ * macro_benchmarks.cpp
+ *
+ * Macro workloads that exercise several components together:
+ * log ingestion into pages, skewed point reads, a concurrent mixed workload,
+ * event-type queries (bitmap index vs. full scan), vectorized query pipelines,
+ * rollup counts (materialized buckets vs. raw records), approximate distinct/top-k
+ * questions (merged sketches vs. raw records), group-by on names (parallel interned-id
+ * aggregation vs. the string-keyed pipeline), miss-heavy timeline lookups
+ * (with vs. without per-leaf Bloom filters), "latest N events of a resource"
+ * (reverse scan with the limit pushed down vs. reading the whole timeline),
+ * name-prefix joins into the timeline tree (one batched walk vs. one scan per resource),
+ * warm restarts (resident-set snapshot vs. refilling the pool through misses) and
+ * scans / point lookups across page sizes (4KB, 16KB, 64KB files).
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "bench_harness.h"
+#include "bench_util.h"
+#include "../src/adapter/btree_adapter.h"
+#include "../src/bufferpool/buffer_pool_adapter.h"
+#include "../src/bufferpool/buffer_pool_manager.h"
+#include "../src/bufferpool/resident_set.h"
+#include "../src/disk/disk_manager.h"
+#include "../src/index/bitmap_index.h"
+#include "../src/index/leaf_bloom_filters.h"
+#include "../src/query/parallel_aggregate.h"
+#include "../src/query/pipeline.h"
+#include "../src/rollup/rollup_store.h"
+#include "../src/rollup/sketch_store.h"
+#include "../src/storage/log_store.h"
+#include "../src/utils/log_manager.h"
+#include "../src/versioning/version_manager.h"
+
+using cmse::page_id_t;
+using cmse::bufferpool::BufferPoolManager;
+using cmse::disk::DiskManager;
+
+namespace cmse::bench {
+
+    namespace {
+        constexpr size_t RECORDS_PER_PAGE = (PAGE_SIZE - sizeof(PageHeader)) / sizeof(LogRecord);
+
+        // Event-query workload: 100k records (4k+ pages) with a skewed event mix,
+        // queried through a pool that holds ~1/8 of them.
+        constexpr int QUERY_RECORDS = 100000;
+        constexpr size_t QUERY_POOL_SIZE = 256;
+        const std::vector<std::string> QUERY_TYPES = { "ERROR", "RESTART" };
+
+        struct EventQueryFixture {
+            ScratchDbFile db;
+            DiskManager disk_manager;
+            BufferPoolManager bpm;
+            bufferpool::BufferPoolManagerAdapter bpm_adapter;
+            storage::LogStore store;
+            index::BitmapIndex bitmap_index;
+            int64_t first_ms = 0;
+            int64_t last_ms = 0;
+
+            explicit EventQueryFixture(const std::string& path)
+                : db(path), disk_manager(db.Path()), bpm(QUERY_POOL_SIZE, &disk_manager), bpm_adapter(&bpm),
+                store(&bpm_adapter), bitmap_index(&bpm_adapter) {
+                store.addListener(&bitmap_index);
+                const char* events[] = { "START", "STOP", "RESTART", "ERROR", "WARNING", "DEPLOY" };
+                std::discrete_distribution<int> pick({ 40, 25, 4, 1, 20, 10 });
+                std::mt19937 rng(21);
+                for (auto& record : utils::LogManager::generateSyntheticLogs(QUERY_RECORDS)) {
+                    std::memset(record.event_type, 0, sizeof(record.event_type));
+                    std::strcpy(record.event_type, events[pick(rng)]);
+                    store.append(record);
+                }
+                LogRecord record;
+                store.get(0, &record);
+                first_ms = storage::LogStore::timestampMillis(record);
+                store.get(QUERY_RECORDS - 1, &record);
+                last_ms = storage::LogStore::timestampMillis(record);
+                bpm.FlushAllPages();
+            }
+
+            // Random windows covering 10% of the time span.
+            std::vector<std::pair<int64_t, int64_t>> Windows(uint64_t count) const {
+                std::mt19937_64 rng(22);
+                int64_t width = (last_ms - first_ms) / 10;
+                std::vector<std::pair<int64_t, int64_t>> windows(count);
+                for (auto& w : windows) {
+                    w.first = first_ms + static_cast<int64_t>(rng() % static_cast<uint64_t>(last_ms - first_ms - width));
+                    w.second = w.first + width;
+                }
+                return windows;
+            }
+        };
+    }
+
+    // Ingest: parse CSV lines and pack the records into freshly allocated pages.
+    // One op = one ingested record.
+    void Macro_IngestLogs(BenchState& state) {
+        const size_t pool_size = 64;
+        auto logs = utils::LogManager::generateSyntheticLogs(static_cast<int>(state.Iterations()));
+        std::vector<std::string> lines;
+        lines.reserve(logs.size());
+        for (const auto& log : logs) {
+            lines.push_back(log.toString());
+        }
+
+        ScratchDbFile db("bench_macro_ingest.db");
+        DiskManager disk_manager(db.Path());
+        BufferPoolManager bpm(pool_size, &disk_manager);
+
+        state.StartTimer();
+        page_id_t pid = INVALID_PAGE_ID;
+        Page* page = nullptr;
+        size_t slot = 0;
+        for (const auto& line : lines) {
+            if (page == nullptr || slot == RECORDS_PER_PAGE) {
+                if (page != nullptr) {
+                    bpm.UnpinPage(pid, true);
+                }
+                page = bpm.NewPage(pid);
+                slot = 0;
+            }
+            LogRecord record = utils::LogManager::parseLine(line);
+            std::memcpy(page->GetData() + slot * sizeof(LogRecord), &record, sizeof(LogRecord));
+            page->GetHeader()->key_count = static_cast<uint32_t>(++slot);
+        }
+        if (page != nullptr) {
+            bpm.UnpinPage(pid, true);
+        }
+        bpm.FlushAllPages();
+        state.StopTimer();
+
+        state.SetCounter("pages_written", static_cast<double>(disk_manager.GetNumFlushes()));
+    }
+    CMSE_BENCHMARK(Macro_IngestLogs, "macro", 20000);
+
+    // Zipfian point reads (theta 0.99) over a data set 8x larger than the pool.
+    // One op = FetchPage + UnpinPage.
+    void Macro_ZipfianReads(BenchState& state) {
+        const size_t pool_size = 128;
+        const page_id_t num_pages = 1024;
+
+        ScratchDbFile db("bench_macro_zipf.db");
+        DiskManager disk_manager(db.Path());
+        BufferPoolManager bpm(pool_size, &disk_manager);
+        for (page_id_t i = 0; i < num_pages; ++i) {
+            page_id_t pid;
+            bpm.NewPage(pid);
+            bpm.UnpinPage(pid, true);
+        }
+        bpm.FlushAllPages();
+        bpm.ResetStats();
+
+        ZipfianGenerator zipf(num_pages, 0.99, 11);
+        std::vector<page_id_t> ids(state.Iterations());
+        for (auto& id : ids) {
+            id = static_cast<page_id_t>(zipf.Next());
+        }
+
+        state.StartTimer();
+        for (page_id_t id : ids) {
+            Page* page = bpm.FetchPage(id);
+            DoNotOptimize(page);
+            bpm.UnpinPage(id, false);
+        }
+        state.StopTimer();
+
+        state.SetCounter("hit_ratio", bpm.GetStats().HitRatio());
+        AddLatencyCounters(state, bpm.GetLatencySummaries());
+        AddLatencyCounters(state, disk_manager.GetLatencySummaries());
+    }
+    CMSE_BENCHMARK(Macro_ZipfianReads, "macro", 50000);
+
+    // Same workload as Macro_ZipfianReads with SHARDS miss-ratio estimation enabled
+    // (rate 0.1). Compare ns/op against Macro_ZipfianReads for the sampling overhead;
+    // 'estimated_hit_ratio' is the curve evaluated at the actual pool size.
+    void Macro_ZipfianReadsShards(BenchState& state) {
+        const size_t pool_size = 128;
+        const page_id_t num_pages = 1024;
+
+        ScratchDbFile db("bench_macro_zipf_shards.db");
+        DiskManager disk_manager(db.Path());
+        BufferPoolManager bpm(pool_size, &disk_manager);
+        for (page_id_t i = 0; i < num_pages; ++i) {
+            page_id_t pid;
+            bpm.NewPage(pid);
+            bpm.UnpinPage(pid, true);
+        }
+        bpm.FlushAllPages();
+        bpm.ResetStats();
+        bpm.EnableMissRatioEstimation(0.1, 8192);
+
+        ZipfianGenerator zipf(num_pages, 0.99, 11);
+        std::vector<page_id_t> ids(state.Iterations());
+        for (auto& id : ids) {
+            id = static_cast<page_id_t>(zipf.Next());
+        }
+
+        state.StartTimer();
+        for (page_id_t id : ids) {
+            Page* page = bpm.FetchPage(id);
+            DoNotOptimize(page);
+            bpm.UnpinPage(id, false);
+        }
+        state.StopTimer();
+
+        auto curve = bpm.GetEstimatedMissRatioCurve({ pool_size });
+        state.SetCounter("hit_ratio", bpm.GetStats().HitRatio());
+        state.SetCounter("estimated_hit_ratio", 1.0 - curve[0].miss_ratio);
+    }
+    CMSE_BENCHMARK(Macro_ZipfianReadsShards, "macro", 50000);
+
+    // Concurrent mixed workload: 4 threads, 90% reads / 10% dirty updates,
+    // uniform over a data set 4x larger than the pool.
+    // One op = one FetchPage + UnpinPage by any thread.
+    void Macro_ConcurrentMixed(BenchState& state) {
+        const size_t pool_size = 64;
+        const page_id_t num_pages = 256;
+        const int num_threads = 4;
+
+        ScratchDbFile db("bench_macro_mixed.db");
+        DiskManager disk_manager(db.Path());
+        BufferPoolManager bpm(pool_size, &disk_manager);
+        for (page_id_t i = 0; i < num_pages; ++i) {
+            page_id_t pid;
+            bpm.NewPage(pid);
+            bpm.UnpinPage(pid, true);
+        }
+        bpm.FlushAllPages();
+        bpm.ResetStats();
+
+        const uint64_t per_thread = state.Iterations() / num_threads;
+        std::atomic<uint64_t> failed{ 0 };
+
+        utils::LatchRegistry::instance().reset();
+        state.StartTimer();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&bpm, &failed, per_thread, num_pages, t]() {
+                std::mt19937 rng(100 + t);
+                for (uint64_t i = 0; i < per_thread; ++i) {
+                    page_id_t id = static_cast<page_id_t>(rng() % num_pages);
+                    bool is_write = (rng() % 10) == 0;
+                    Page* page = bpm.FetchPage(id);
+                    if (page == nullptr) {
+                        failed++;
+                        continue;
+                    }
+                    if (is_write) {
+                        page->GetData()[t] = static_cast<char>(i);
+                    }
+                    bpm.UnpinPage(id, is_write);
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+        state.StopTimer();
+
+        auto stats = bpm.GetStats();
+        state.SetCounter("failed_fetches", static_cast<double>(failed.load()));
+        state.SetCounter("hit_ratio", stats.HitRatio());
+        state.SetCounter("dirty_evictions", static_cast<double>(stats.evictions_dirty));
+        AddLatencyCounters(state, bpm.GetLatencySummaries());
+        AddLatchCounters(state, per_thread * num_threads);
+    }
+    CMSE_BENCHMARK(Macro_ConcurrentMixed, "macro", 40000);
+
+    // Concurrent hot reads: 8 threads over a working set that fits in the pool, so every
+    // fetch is a hit and the run is bound by latch_ / the replacer mutex, not disk I/O.
+    // One op = one FetchPage + UnpinPage by any thread.
+    void Macro_ConcurrentHotReads(BenchState& state) {
+        const size_t pool_size = 64;
+        const page_id_t num_pages = 32;
+        const int num_threads = 8;
+
+        ScratchDbFile db("bench_macro_hot.db");
+        DiskManager disk_manager(db.Path());
+        BufferPoolManager bpm(pool_size, &disk_manager);
+        for (page_id_t i = 0; i < num_pages; ++i) {
+            page_id_t pid;
+            bpm.NewPage(pid);
+            bpm.UnpinPage(pid, true);
+        }
+        bpm.ResetStats();
+
+        const uint64_t per_thread = state.Iterations() / num_threads;
+
+        utils::LatchRegistry::instance().reset();
+        state.StartTimer();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&bpm, per_thread, num_pages, t]() {
+                std::mt19937 rng(200 + t);
+                for (uint64_t i = 0; i < per_thread; ++i) {
+                    page_id_t id = static_cast<page_id_t>(rng() % num_pages);
+                    Page* page = bpm.FetchPage(id);
+                    DoNotOptimize(page);
+                    bpm.UnpinPage(id, false);
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+        state.StopTimer();
+
+        state.SetCounter("hit_ratio", bpm.GetStats().HitRatio());
+        AddLatencyCounters(state, bpm.GetLatencySummaries());
+        AddLatchCounters(state, per_thread * num_threads);
+    }
+    CMSE_BENCHMARK(Macro_ConcurrentHotReads, "macro", 80000);
+
+    // "ERROR or RESTART within a 10% time window", answered by intersecting the event_type
+    // bitmaps with the zone-map time range and fetching only the matching records.
+    // One op = one query (rows materialized). Compare with Macro_EventQueryScan.
+    void Macro_EventQueryBitmap(BenchState& state) {
+        EventQueryFixture fixture("bench_macro_event_bitmap.db");
+        auto windows = fixture.Windows(state.Iterations());
+        fixture.bpm.ResetStats();
+
+        uint64_t rows = 0;
+        state.StartTimer();
+        for (const auto& [t1, t2] : windows) {
+            index::RoaringBitmap window;
+            fixture.store.timeRange(t1, t2, &window);
+            index::RoaringBitmap hits = fixture.bitmap_index.anyOf(QUERY_TYPES, window);
+            fixture.store.forEach(hits, [&rows](record_id_t, const LogRecord& record) {
+                DoNotOptimize(record);
+                rows++;
+            });
+        }
+        state.StopTimer();
+
+        auto stats = fixture.bpm.GetStats();
+        double queries = static_cast<double>(windows.size());
+        state.SetCounter("rows_per_query", rows / queries);
+        state.SetCounter("pages_per_query", (stats.hits + stats.misses) / queries);
+        state.SetCounter("bitmap_bytes", static_cast<double>(fixture.bitmap_index.sizeInBytes()));
+    }
+    CMSE_BENCHMARK(Macro_EventQueryBitmap, "macro", 200);
+
+    // Same queries as Macro_EventQueryBitmap answered by scanning every page.
+    void Macro_EventQueryScan(BenchState& state) {
+        EventQueryFixture fixture("bench_macro_event_scan.db");
+        auto windows = fixture.Windows(state.Iterations());
+        size_t num_pages = fixture.store.pageCount();
+        fixture.bpm.ResetStats();
+
+        uint64_t rows = 0;
+        std::vector<LogRecord> records;
+        state.StartTimer();
+        for (const auto& [t1, t2] : windows) {
+            for (size_t p = 0; p < num_pages; ++p) {
+                fixture.store.readPage(p, &records);
+                for (const auto& record : records) {
+                    int64_t ts = storage::LogStore::timestampMillis(record);
+                    if (ts < t1 || ts > t2) {
+                        continue;
+                    }
+                    if (std::strcmp(record.event_type, "ERROR") == 0 || std::strcmp(record.event_type, "RESTART") == 0) {
+                        DoNotOptimize(record);
+                        rows++;
+                    }
+                }
+            }
+        }
+        state.StopTimer();
+
+        auto stats = fixture.bpm.GetStats();
+        double queries = static_cast<double>(windows.size());
+        state.SetCounter("rows_per_query", rows / queries);
+        state.SetCounter("pages_per_query", (stats.hits + stats.misses) / queries);
+    }
+    CMSE_BENCHMARK(Macro_EventQueryScan, "macro", 50);
+
+    // "Top 10 resources by ERROR/RESTART count in a 10% window" through the vectorized engine:
+    // scan (3 columns) -> filter -> hash aggregate -> top-N. One op = one query over 100k rows.
+    void Macro_QueryScanAggregate(BenchState& state) {
+        EventQueryFixture fixture("bench_macro_query_agg.db");
+        auto windows = fixture.Windows(state.Iterations());
+        fixture.bpm.ResetStats();
+
+        uint64_t rows = 0;
+        state.StartTimer();
+        for (const auto& [t1, t2] : windows) {
+            query::Pipeline pipeline(std::make_unique<query::LogScanSource>(&fixture.store,
+                std::vector<query::LogColumn>{ query::LogColumn::Timestamp, query::LogColumn::ResourceId, query::LogColumn::EventType }));
+            pipeline.filter({ query::Predicate::between("timestamp", t1, t2), query::Predicate::in("event_type", QUERY_TYPES) })
+                .aggregate({ "resource_id" }, { query::AggregateSpec::count("events") })
+                .topN("events", 10);
+            query::ResultSet result;
+            pipeline.execute(&result);
+            rows += pipeline.source()->rowsProduced();
+            DoNotOptimize(result);
+        }
+        state.StopTimer();
+
+        state.SetCounter("rows_per_query", rows / static_cast<double>(windows.size()));
+        state.SetCounter(std::string("isa_") + query::filterKernelIsa(), 1);
+    }
+    CMSE_BENCHMARK(Macro_QueryScanAggregate, "macro", 20);
+
+    namespace {
+        // Rollup workload: 100k records one second apart (~28 hours, 50 resources) with minute
+        // and hour buckets maintained on ingest.
+        constexpr int ROLLUP_RECORDS = 100000;
+        constexpr int ROLLUP_STEP_MS = 1000;
+
+        struct RollupFixture {
+            ScratchDbFile db;
+            DiskManager disk_manager;
+            BufferPoolManager bpm;
+            bufferpool::BufferPoolManagerAdapter bpm_adapter;
+            storage::LogStore store;
+            rollup::RollupStore rollups;
+            int64_t first_ms = 0;
+            int64_t last_ms = 0;
+
+            explicit RollupFixture(const std::string& path)
+                : db(path), disk_manager(db.Path()), bpm(QUERY_POOL_SIZE, &disk_manager), bpm_adapter(&bpm),
+                store(&bpm_adapter), rollups(&bpm_adapter) {
+                store.addListener(&rollups);
+                const char* events[] = { "START", "STOP", "RESTART", "ERROR", "WARNING", "DEPLOY" };
+                std::discrete_distribution<int> pick({ 40, 25, 4, 1, 20, 10 });
+                std::mt19937 rng(31);
+                for (auto& record : utils::LogManager::generateSyntheticLogs(ROLLUP_RECORDS, 1000, ROLLUP_STEP_MS)) {
+                    std::memset(record.event_type, 0, sizeof(record.event_type));
+                    std::strcpy(record.event_type, events[pick(rng)]);
+                    store.append(record);
+                }
+                rollups.flush();
+                LogRecord record;
+                store.get(0, &record);
+                first_ms = storage::LogStore::timestampMillis(record);
+                store.get(ROLLUP_RECORDS - 1, &record);
+                last_ms = storage::LogStore::timestampMillis(record);
+                bpm.FlushAllPages();
+            }
+
+            // "ERROR events of one resource in a random 6-hour window" (unaligned edges).
+            std::vector<rollup::CountQuery> Queries(uint64_t count) const {
+                std::mt19937_64 rng(32);
+                int64_t width = 6 * rollup::RollupStore::HOUR_MS;
+                std::vector<rollup::CountQuery> queries(count);
+                for (auto& q : queries) {
+                    q.begin_ms = first_ms + static_cast<int64_t>(rng() % static_cast<uint64_t>(last_ms - first_ms - width));
+                    q.end_ms = q.begin_ms + width;
+                    q.resource_id = 1000 + static_cast<int64_t>(rng() % 50);
+                    q.event_type = "ERROR";
+                }
+                return queries;
+            }
+        };
+    } // namespace
+
+    // One op = one count answered from hour/minute buckets plus raw records at the edges.
+    // Compare with Macro_RollupRawCount.
+    void Macro_RollupCount(BenchState& state) {
+        RollupFixture fixture("bench_macro_rollup.db");
+        auto queries = fixture.Queries(state.Iterations());
+        fixture.bpm.ResetStats();
+
+        uint64_t total = 0;
+        uint64_t bucket_rows = 0;
+        uint64_t raw_records = 0;
+        state.StartTimer();
+        for (const auto& q : queries) {
+            rollup::CountResult result;
+            fixture.rollups.count(q, &fixture.store, &result);
+            total += result.count;
+            bucket_rows += result.rollup_rows_read;
+            raw_records += result.raw_records_read;
+        }
+        state.StopTimer();
+        DoNotOptimize(total);
+
+        auto stats = fixture.bpm.GetStats();
+        double n = static_cast<double>(queries.size());
+        state.SetCounter("bucket_rows_per_query", bucket_rows / n);
+        state.SetCounter("raw_records_per_query", raw_records / n);
+        state.SetCounter("pages_per_query", (stats.hits + stats.misses) / n);
+    }
+    CMSE_BENCHMARK(Macro_RollupCount, "macro", 200);
+
+    // Same counts answered from the raw records in the window (zone-map time range).
+    void Macro_RollupRawCount(BenchState& state) {
+        RollupFixture fixture("bench_macro_rollup_raw.db");
+        auto queries = fixture.Queries(state.Iterations());
+        fixture.bpm.ResetStats();
+
+        uint64_t total = 0;
+        uint64_t raw_records = 0;
+        state.StartTimer();
+        for (const auto& q : queries) {
+            index::RoaringBitmap window;
+            fixture.store.timeRange(q.begin_ms, q.end_ms - 1, &window);
+            fixture.store.forEach(window, [&](record_id_t, const LogRecord& record) {
+                raw_records++;
+                if (record.resource_id == *q.resource_id && std::strcmp(record.event_type, "ERROR") == 0) {
+                    total++;
+                }
+            });
+        }
+        state.StopTimer();
+        DoNotOptimize(total);
+
+        auto stats = fixture.bpm.GetStats();
+        double n = static_cast<double>(queries.size());
+        state.SetCounter("raw_records_per_query", raw_records / n);
+        state.SetCounter("pages_per_query", (stats.hits + stats.misses) / n);
+    }
+    CMSE_BENCHMARK(Macro_RollupRawCount, "macro", 50);
+
+    namespace {
+        // Sketch workload: 100k records one second apart (~28 hours), Zipfian over 5000
+        // resources, 10% ERROR, with hourly sketches maintained on ingest.
+        struct SketchFixture {
+            ScratchDbFile db;
+            DiskManager disk_manager;
+            BufferPoolManager bpm;
+            bufferpool::BufferPoolManagerAdapter bpm_adapter;
+            storage::LogStore store;
+            rollup::SketchStore sketches;
+            int64_t first_ms = 0;
+            int64_t last_ms = 0;
+
+            explicit SketchFixture(const std::string& path)
+                : db(path), disk_manager(db.Path()), bpm(QUERY_POOL_SIZE, &disk_manager), bpm_adapter(&bpm), store(&bpm_adapter) {
+                store.addListener(&sketches);
+                ZipfianGenerator resources(5000, 0.99, 51);
+                std::mt19937 rng(52);
+                for (auto& record : utils::LogManager::generateSyntheticLogs(ROLLUP_RECORDS, 1000, ROLLUP_STEP_MS)) {
+                    record.resource_id = 1000 + static_cast<int64_t>(resources.Next());
+                    std::memset(record.event_type, 0, sizeof(record.event_type));
+                    std::strcpy(record.event_type, rng() % 10 == 0 ? "ERROR" : "INFO");
+                    store.append(record);
+                }
+                LogRecord record;
+                store.get(0, &record);
+                first_ms = storage::LogStore::timestampMillis(record);
+                store.get(ROLLUP_RECORDS - 1, &record);
+                last_ms = storage::LogStore::timestampMillis(record);
+                bpm.FlushAllPages();
+            }
+
+            // Hour-aligned 6-hour windows.
+            std::vector<std::pair<int64_t, int64_t>> Windows(uint64_t count) const {
+                std::mt19937_64 rng(53);
+                int64_t width = 6 * rollup::RollupStore::HOUR_MS;
+                std::vector<std::pair<int64_t, int64_t>> windows(count);
+                for (auto& w : windows) {
+                    int64_t start = first_ms + static_cast<int64_t>(rng() % static_cast<uint64_t>(last_ms - first_ms - width));
+                    w.first = rollup::RollupStore::bucketStart(start, rollup::RollupStore::HOUR_MS);
+                    w.second = w.first + width;
+                }
+                return windows;
+            }
+        };
+    } // namespace
+
+    // "Distinct resources with ERROR and the 10 noisiest ones in a 6-hour window", answered by
+    // merging six hourly sketches. One op = both answers. Compare with Macro_SketchExactScan.
+    void Macro_SketchDistinctTop(BenchState& state) {
+        SketchFixture fixture("bench_macro_sketch.db");
+        auto windows = fixture.Windows(state.Iterations());
+
+        double distinct = 0;
+        state.StartTimer();
+        for (const auto& [t1, t2] : windows) {
+            rollup::WindowSketch window;
+            fixture.sketches.summarize(t1, t2, std::string("ERROR"), &window);
+            distinct += window.distinct.estimate();
+            auto top = window.top.top(10);
+            DoNotOptimize(top);
+        }
+        state.StopTimer();
+
+        state.SetCounter("distinct_per_query", distinct / static_cast<double>(windows.size()));
+        state.SetCounter("sketch_bytes", static_cast<double>(fixture.sketches.sizeInBytes()));
+    }
+    CMSE_BENCHMARK(Macro_SketchDistinctTop, "macro", 2000);
+
+    // Same questions answered exactly from the records in the window (zone-map time range).
+    void Macro_SketchExactScan(BenchState& state) {
+        SketchFixture fixture("bench_macro_sketch_exact.db");
+        auto windows = fixture.Windows(state.Iterations());
+        fixture.bpm.ResetStats();
+
+        double distinct = 0;
+        state.StartTimer();
+        for (const auto& [t1, t2] : windows) {
+            index::RoaringBitmap window;
+            fixture.store.timeRange(t1, t2 - 1, &window);
+            std::unordered_map<int64_t, uint64_t> counts;
+            fixture.store.forEach(window, [&counts](record_id_t, const LogRecord& record) {
+                if (std::strcmp(record.event_type, "ERROR") == 0) {
+                    counts[record.resource_id]++;
+                }
+            });
+            std::vector<std::pair<uint64_t, int64_t>> ranked;
+            for (const auto& [id, count] : counts) {
+                ranked.emplace_back(count, id);
+            }
+            size_t k = std::min<size_t>(10, ranked.size());
+            std::partial_sort(ranked.begin(), ranked.begin() + k, ranked.end(), std::greater<>());
+            distinct += static_cast<double>(counts.size());
+            DoNotOptimize(ranked);
+        }
+        state.StopTimer();
+
+        auto stats = fixture.bpm.GetStats();
+        double n = static_cast<double>(windows.size());
+        state.SetCounter("distinct_per_query", distinct / n);
+        state.SetCounter("pages_per_query", (stats.hits + stats.misses) / n);
+    }
+    CMSE_BENCHMARK(Macro_SketchExactScan, "macro", 50);
+
+    namespace {
+        // Group-by workload: 500k records over 20k Zipfian resource names. Built once and shared
+        // by the aggregation cases (ingest dominates otherwise).
+        constexpr int GROUP_RECORDS = 500000;
+
+        struct GroupByFixture {
+            ScratchDbFile db;
+            DiskManager disk_manager;
+            BufferPoolManager bpm;
+            bufferpool::BufferPoolManagerAdapter bpm_adapter;
+            storage::LogStore store;
+            query::NameDictionary names;
+
+            GroupByFixture()
+                : db("bench_macro_group_by.db"), disk_manager(db.Path()), bpm(QUERY_POOL_SIZE, &disk_manager), bpm_adapter(&bpm),
+                store(&bpm_adapter) {
+                store.addListener(&names);
+                const char* events[] = { "START", "STOP", "RESTART", "ERROR", "WARNING", "DEPLOY" };
+                ZipfianGenerator zipf(20000, 0.99, 61);
+                std::mt19937 rng(62);
+                for (auto& record : utils::LogManager::generateSyntheticLogs(GROUP_RECORDS)) {
+                    std::string name = "vm-" + std::to_string(zipf.Next());
+                    std::memset(record.resource_name, 0, sizeof(record.resource_name));
+                    std::memcpy(record.resource_name, name.data(), name.size());
+                    std::memset(record.event_type, 0, sizeof(record.event_type));
+                    std::strcpy(record.event_type, events[rng() % 6]);
+                    store.append(record);
+                }
+                bpm.FlushAllPages();
+            }
+
+            static GroupByFixture& Get() {
+                static GroupByFixture fixture;
+                return fixture;
+            }
+        };
+
+        // One op = COUNT(*) GROUP BY resource_name, event_type over all 500k records.
+        void RunParallelCountBy(BenchState& state, size_t threads) {
+            GroupByFixture& fixture = GroupByFixture::Get();
+            query::ParallelAggregateOptions options;
+            options.threads = threads;
+            query::ParallelHashAggregator aggregator(&fixture.names, options);
+
+            uint64_t groups = 0;
+            state.StartTimer();
+            for (uint64_t i = 0; i < state.Iterations(); ++i) {
+                query::ResultSet result;
+                aggregator.countBy({ query::GroupColumn::ResourceName, query::GroupColumn::EventType }, nullptr, &result);
+                groups += result.rows.size();
+                DoNotOptimize(result);
+            }
+            state.StopTimer();
+
+            const auto& stats = aggregator.lastStats();
+            state.SetCounter("groups", static_cast<double>(groups) / static_cast<double>(state.Iterations()));
+            state.SetCounter("rows", static_cast<double>(stats.rows));
+            state.SetCounter("spilled_per_row", static_cast<double>(stats.spilled) / static_cast<double>(stats.rows));
+            state.SetCounter("threads", static_cast<double>(stats.threads));
+        }
+    } // namespace
+
+    // Compare the ns/op of the 1/2/4/8-thread cases for scaling, and Macro_PipelineCountByName
+    // for the string-keyed single-threaded operator.
+    void Macro_ParallelCountBy_1T(BenchState& state) { RunParallelCountBy(state, 1); }
+    CMSE_BENCHMARK(Macro_ParallelCountBy_1T, "macro", 10);
+    void Macro_ParallelCountBy_2T(BenchState& state) { RunParallelCountBy(state, 2); }
+    CMSE_BENCHMARK(Macro_ParallelCountBy_2T, "macro", 10);
+    void Macro_ParallelCountBy_4T(BenchState& state) { RunParallelCountBy(state, 4); }
+    CMSE_BENCHMARK(Macro_ParallelCountBy_4T, "macro", 10);
+    void Macro_ParallelCountBy_8T(BenchState& state) { RunParallelCountBy(state, 8); }
+    CMSE_BENCHMARK(Macro_ParallelCountBy_8T, "macro", 10);
+
+    // Same query through the vectorized pipeline (scan -> hash aggregate on the strings).
+    void Macro_PipelineCountByName(BenchState& state) {
+        GroupByFixture& fixture = GroupByFixture::Get();
+        uint64_t groups = 0;
+        state.StartTimer();
+        for (uint64_t i = 0; i < state.Iterations(); ++i) {
+            query::Pipeline pipeline(std::make_unique<query::LogScanSource>(&fixture.store,
+                std::vector<query::LogColumn>{ query::LogColumn::ResourceName, query::LogColumn::EventType }));
+            pipeline.aggregate({ "resource_name", "event_type" }, { query::AggregateSpec::count("count") });
+            query::ResultSet result;
+            pipeline.execute(&result);
+            groups += result.rows.size();
+            DoNotOptimize(result);
+        }
+        state.StopTimer();
+        state.SetCounter("groups", static_cast<double>(groups) / static_cast<double>(state.Iterations()));
+    }
+    CMSE_BENCHMARK(Macro_PipelineCountByName, "macro", 3);
+
+    namespace {
+        // Timeline workload: 2000 of 20000 resource ids have 50 events each (100k keys, ~2k
+        // leaves) in a (resource_id, timestamp) tree read through a 128-frame pool. Lookups pick
+        // resource ids uniformly, so 90% of them ask for a resource without events.
+        constexpr int64_t TIMELINE_RESOURCE_IDS = 20000;
+        constexpr int64_t TIMELINE_ACTIVE_EVERY = 10;
+        constexpr int TIMELINE_EVENTS = 50;
+        constexpr size_t TIMELINE_POOL_SIZE = 128;
+
+        struct TimelineFixture {
+            ScratchDbFile db;
+            DiskManager disk_manager;
+            BufferPoolManager bpm;
+            bufferpool::BufferPoolManagerAdapter bpm_adapter;
+            adapter::BasicBTreeAdapter<ResourceTimeKey> tree_adapter;
+            versioning::CompositeVersionManager vm;
+            index::LeafBloomFilters filters;
+            version_t version = INVALID_VERSION;
+
+            TimelineFixture(const std::string& path, bool with_filters)
+                : db(path), disk_manager(db.Path()), bpm(TIMELINE_POOL_SIZE, &disk_manager), bpm_adapter(&bpm),
+                vm(&bpm_adapter, &tree_adapter), filters(&bpm_adapter) {
+                if (with_filters) {
+                    vm.setLeafFilter(&filters);
+                }
+                std::mt19937_64 rng(41);
+                version = vm.createVersion();
+                for (int64_t rid = 0; rid < TIMELINE_RESOURCE_IDS; rid += TIMELINE_ACTIVE_EVERY) {
+                    for (int e = 0; e < TIMELINE_EVENTS; ++e) {
+                        vm.applyUpdate(version, INVALID_VERSION, { rid, static_cast<int64_t>(rng() % 100000000) }, e);
+                    }
+                }
+                vm.commitVersion(version);
+                bpm.FlushAllPages();
+            }
+
+            std::vector<int64_t> Queries(uint64_t count) const {
+                std::mt19937_64 rng(42);
+                std::vector<int64_t> ids(count);
+                for (auto& id : ids) {
+                    id = static_cast<int64_t>(rng() % TIMELINE_RESOURCE_IDS);
+                }
+                return ids;
+            }
+        };
+
+        struct TimelineCost {
+            uint64_t rows = 0;
+            uint64_t fetches = 0;   // Buffer pool fetches (hits + misses)
+            uint64_t misses = 0;
+        };
+
+        TimelineCost ScanTimelines(TimelineFixture& fixture, const std::vector<int64_t>& ids) {
+            fixture.bpm.ResetStats();
+            TimelineCost cost;
+            std::vector<std::pair<ResourceTimeKey, ValueType>> timeline;
+            for (int64_t rid : ids) {
+                timeline.clear();
+                fixture.vm.scanRange(fixture.version, ResourceTimeKey::prefixBegin(rid), ResourceTimeKey::prefixEnd(rid), TIMELINE_EVENTS * 2, &timeline);
+                cost.rows += timeline.size();
+            }
+            auto stats = fixture.bpm.GetStats();
+            cost.fetches = stats.hits + stats.misses;
+            cost.misses = stats.misses;
+            return cost;
+        }
+
+        // One op = the whole timeline of one resource (a single-prefix range scan).
+        // 'plain' (optional) is the cost of the same queries without filters, for the
+        // *_saved_per_query counters.
+        void RunTimelineLookups(BenchState& state, TimelineFixture& fixture, const TimelineCost* plain = nullptr) {
+            auto ids = fixture.Queries(state.Iterations());
+            fixture.filters.resetStats();
+
+            state.StartTimer();
+            TimelineCost cost = ScanTimelines(fixture, ids);
+            state.StopTimer();
+            DoNotOptimize(cost.rows);
+
+            auto filter_stats = fixture.filters.stats();
+            double n = static_cast<double>(ids.size());
+            state.SetCounter("rows_per_query", cost.rows / n);
+            state.SetCounter("pages_per_query", cost.fetches / n);
+            state.SetCounter("misses_per_query", cost.misses / n);
+            state.SetCounter("leaves_skipped_per_query", filter_stats.negatives / n);
+            state.SetCounter("filter_pages", static_cast<double>(fixture.filters.pageCount()));
+            if (plain != nullptr) {
+                state.SetCounter("fetches_saved_per_query", (static_cast<double>(plain->fetches) - cost.fetches) / n);
+                state.SetCounter("misses_saved_per_query", (static_cast<double>(plain->misses) - cost.misses) / n);
+            }
+        }
+    } // namespace
+
+    // Leaves of absent resources are ruled out by their Bloom filter. Filters are kept in
+    // memory, so a probe is not a fetch: fetches_saved_per_query and misses_saved_per_query compare
+    // against the same queries on an unfiltered tree (untimed), see Macro_TimelineMissesPlain.
+    void Macro_TimelineMissesBloom(BenchState& state) {
+        TimelineCost plain;
+        {
+            TimelineFixture baseline("bench_macro_timeline_plain.db", false);
+            plain = ScanTimelines(baseline, baseline.Queries(state.Iterations()));
+        }
+        TimelineFixture fixture("bench_macro_timeline_bloom.db", true);
+        RunTimelineLookups(state, fixture, &plain);
+    }
+    CMSE_BENCHMARK(Macro_TimelineMissesBloom, "macro", 20000);
+
+    // Same lookups without filters: every lookup fetches a leaf.
+    void Macro_TimelineMissesPlain(BenchState& state) {
+        TimelineFixture fixture("bench_macro_timeline_plain.db", false);
+        RunTimelineLookups(state, fixture);
+    }
+    CMSE_BENCHMARK(Macro_TimelineMissesPlain, "macro", 20000);
+
+    namespace {
+        // Resource ids a name prefix resolves to in the trie: names are "vm-<id>", so "vm-1"
+        // yields every active id whose decimal form starts with '1', in byte order of the names.
+        std::vector<int64_t> IdsUnderPrefix(char first_digit) {
+            std::vector<std::string> names;
+            for (int64_t rid = 0; rid < TIMELINE_RESOURCE_IDS; rid += TIMELINE_ACTIVE_EVERY) {
+                std::string name = std::to_string(rid);
+                if (name[0] == first_digit) {
+                    names.push_back(name);
+                }
+            }
+            std::sort(names.begin(), names.end());
+            std::vector<int64_t> ids;
+            for (const auto& name : names) {
+                ids.push_back(std::stoll(name));
+            }
+            return ids;
+        }
+
+        // One op = the timelines of every resource under one name prefix ("vm-1" .. "vm-9").
+        void RunNamePrefixJoin(BenchState& state, bool batched) {
+            TimelineFixture fixture(batched ? "bench_macro_prefix_batched.db" : "bench_macro_prefix_single.db", false);
+            std::vector<std::vector<int64_t>> prefixes;
+            for (char digit = '1'; digit <= '9'; ++digit) {
+                prefixes.push_back(IdsUnderPrefix(digit));
+            }
+            fixture.bpm.ResetStats();
+
+            uint64_t rows = 0;
+            uint64_t resources = 0;
+            std::vector<std::pair<ResourceTimeKey, ValueType>> entries;
+            std::vector<std::pair<ResourceTimeKey, ResourceTimeKey>> ranges;
+            state.StartTimer();
+            for (uint64_t i = 0; i < state.Iterations(); ++i) {
+                const auto& ids = prefixes[i % prefixes.size()];
+                entries.clear();
+                if (batched) {
+                    ranges.clear();
+                    for (int64_t rid : ids) {
+                        ranges.push_back({ ResourceTimeKey::prefixBegin(rid), ResourceTimeKey::prefixEnd(rid) });
+                    }
+                    fixture.vm.scanRanges(fixture.version, ranges, &entries);
+                } else {
+                    for (int64_t rid : ids) {
+                        fixture.vm.scanRange(fixture.version, ResourceTimeKey::prefixBegin(rid), ResourceTimeKey::prefixEnd(rid), UINT32_MAX, &entries);
+                    }
+                }
+                rows += entries.size();
+                resources += ids.size();
+            }
+            state.StopTimer();
+            DoNotOptimize(rows);
+
+            auto stats = fixture.bpm.GetStats();
+            double n = static_cast<double>(state.Iterations());
+            state.SetCounter("resources_per_query", resources / n);
+            state.SetCounter("rows_per_query", rows / n);
+            state.SetCounter("pages_per_query", (stats.hits + stats.misses) / n);
+            state.SetCounter("misses_per_query", stats.misses / n);
+        }
+    } // namespace
+
+    // Trie terminals -> key ranges -> one key-sorted walk of the timeline tree.
+    void Macro_NamePrefixBatchedJoin(BenchState& state) {
+        RunNamePrefixJoin(state, true);
+    }
+    CMSE_BENCHMARK(Macro_NamePrefixBatchedJoin, "macro", 200);
+
+    // Same resources, one root-to-leaf range scan each, in trie (name) order.
+    void Macro_NamePrefixPerResource(BenchState& state) {
+        RunNamePrefixJoin(state, false);
+    }
+    CMSE_BENCHMARK(Macro_NamePrefixPerResource, "macro", 200);
+
+    namespace {
+        // Long timelines: 20 resources with 5000 events each (100k keys); queries ask for the
+        // latest LATEST_EVENTS events of a random resource. The pool holds the whole tree.
+        constexpr int64_t LATEST_RESOURCES = 20;
+        constexpr int LATEST_TIMELINE_EVENTS = 5000;
+        constexpr size_t LATEST_EVENTS = 100;
+
+        struct LatestFixture {
+            ScratchDbFile db;
+            DiskManager disk_manager;
+            BufferPoolManager bpm;
+            bufferpool::BufferPoolManagerAdapter bpm_adapter;
+            adapter::BasicBTreeAdapter<ResourceTimeKey> tree_adapter;
+            versioning::CompositeVersionManager vm;
+            version_t version = INVALID_VERSION;
+
+            explicit LatestFixture(const std::string& path)
+                : db(path), disk_manager(db.Path()), bpm(4096, &disk_manager), bpm_adapter(&bpm), vm(&bpm_adapter, &tree_adapter) {
+                std::mt19937_64 rng(43);
+                version = vm.createVersion();
+                for (int e = 0; e < LATEST_TIMELINE_EVENTS; ++e) {
+                    for (int64_t rid = 0; rid < LATEST_RESOURCES; ++rid) {
+                        vm.applyUpdate(version, INVALID_VERSION, { rid, static_cast<int64_t>(rng() % 1000000000) }, e);
+                    }
+                }
+                vm.commitVersion(version);
+            }
+        };
+
+        // One op = the latest LATEST_EVENTS events of one resource, newest first.
+        void RunLatestEvents(BenchState& state, bool pushdown) {
+            LatestFixture fixture(pushdown ? "bench_macro_latest_topk.db" : "bench_macro_latest_full.db");
+            std::mt19937_64 rng(44);
+            fixture.bpm.ResetStats();
+
+            uint64_t rows = 0;
+            std::vector<std::pair<ResourceTimeKey, ValueType>> timeline;
+            state.StartTimer();
+            for (uint64_t i = 0; i < state.Iterations(); ++i) {
+                int64_t rid = static_cast<int64_t>(rng() % LATEST_RESOURCES);
+                timeline.clear();
+                if (pushdown) {
+                    fixture.vm.scanRangeReverse(fixture.version, ResourceTimeKey::prefixBegin(rid), ResourceTimeKey::prefixEnd(rid), LATEST_EVENTS, &timeline);
+                } else {
+                    fixture.vm.scanRange(fixture.version, ResourceTimeKey::prefixBegin(rid), ResourceTimeKey::prefixEnd(rid), SIZE_MAX, &timeline);
+                    size_t keep = std::min(LATEST_EVENTS, timeline.size());
+                    timeline.erase(timeline.begin(), timeline.end() - keep);
+                    std::reverse(timeline.begin(), timeline.end());
+                }
+                rows += timeline.size();
+            }
+            state.StopTimer();
+            DoNotOptimize(rows);
+
+            auto stats = fixture.bpm.GetStats();
+            double n = static_cast<double>(state.Iterations());
+            state.SetCounter("rows_per_query", rows / n);
+            state.SetCounter("pages_per_query", (stats.hits + stats.misses) / n);
+        }
+    } // namespace
+
+    // ORDER BY timestamp DESC LIMIT 100 pushed into the tree walk: only the last leaves.
+    void Macro_TimelineLatestTopK(BenchState& state) {
+        RunLatestEvents(state, true);
+    }
+    CMSE_BENCHMARK(Macro_TimelineLatestTopK, "macro", 20000);
+
+    // Same answer from the whole timeline (forward scan, keep the tail).
+    void Macro_TimelineLatestFullScan(BenchState& state) {
+        RunLatestEvents(state, false);
+    }
+    CMSE_BENCHMARK(Macro_TimelineLatestFullScan, "macro", 2000);
+
+    namespace {
+        // Warm restart workload: Zipfian reads (theta 0.9) over 16384 pages through a 2048-frame
+        // pool. Before the timed part, 200k reads reach steady state (hit ratio measured over
+        // the last 100k) and the resident set is persisted; then the pool is torn down and
+        // rebuilt on the same file. One op = FetchPage + UnpinPage after the restart; with a
+        // snapshot, the synchronous warm-up load is inside the timed region.
+        // misses_to_90pct is the device-independent cost: each is one random read on a cold
+        // device, while the warm-up reads the same pages as an ascending sweep.
+        void RunWarmRestart(BenchState& state, bool use_snapshot, const char* db_path, const char* snapshot_path) {
+            const size_t pool_size = 2048;
+            const page_id_t num_pages = 16384;
+            const size_t window = 500;
+
+            ScratchDbFile db(db_path);
+            ScratchDbFile snapshot(snapshot_path);
+            DiskManager disk_manager(db.Path());
+            ZipfianGenerator zipf(num_pages, 0.9, 17);
+            double steady_hit_ratio = 0;
+            {
+                BufferPoolManager bpm(pool_size, &disk_manager);
+                for (page_id_t i = 0; i < num_pages; ++i) {
+                    page_id_t pid;
+                    bpm.NewPage(pid);
+                    bpm.UnpinPage(pid, true);
+                }
+                bpm.FlushAllPages();
+                for (int phase = 0; phase < 2; ++phase) {
+                    bpm.ResetStats();
+                    for (int i = 0; i < 100000; ++i) {
+                        page_id_t id = static_cast<page_id_t>(zipf.Next());
+                        bpm.FetchPage(id);
+                        bpm.UnpinPage(id, false);
+                    }
+                }
+                steady_hit_ratio = bpm.GetStats().HitRatio();
+                bufferpool::ResidentSetPersister(&bpm, snapshot.Path(), std::chrono::milliseconds(1000)).persistNow();
+            }
+
+            std::vector<page_id_t> ids(state.Iterations());
+            for (auto& id : ids) {
+                id = static_cast<page_id_t>(zipf.Next());
+            }
+
+            // Restart.
+            BufferPoolManager bpm(pool_size, &disk_manager);
+            uint64_t ops_to_target = 0;
+            uint64_t misses_to_target = 0;
+            double ms_to_target = 0;
+            double warmup_ms = 0;
+            uint64_t hits_before = 0;
+
+            state.StartTimer();
+            auto start = std::chrono::steady_clock::now();
+            if (use_snapshot) {
+                warmup_ms = bufferpool::WarmupLoader(&bpm, snapshot.Path()).run().elapsed_ms;
+            }
+            for (size_t i = 0; i < ids.size(); ++i) {
+                Page* page = bpm.FetchPage(ids[i]);
+                DoNotOptimize(page);
+                bpm.UnpinPage(ids[i], false);
+
+                // Windowed hit ratio; the first window at 90% of steady state ends the warm-up.
+                if (ops_to_target == 0 && (i + 1) % window == 0) {
+                    uint64_t hits = bpm.GetStats().hits;
+                    if (static_cast<double>(hits - hits_before) >= 0.9 * steady_hit_ratio * window) {
+                        ops_to_target = i + 1;
+                        misses_to_target = bpm.GetStats().misses;
+                        ms_to_target = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                    }
+                    hits_before = hits;
+                }
+            }
+            state.StopTimer();
+
+            state.SetCounter("steady_hit_ratio", steady_hit_ratio);
+            state.SetCounter("hit_ratio", bpm.GetStats().HitRatio());
+            state.SetCounter("ops_to_90pct", static_cast<double>(ops_to_target));
+            state.SetCounter("misses_to_90pct", static_cast<double>(misses_to_target));
+            state.SetCounter("ms_to_90pct", ms_to_target);
+            state.SetCounter("warmup_ms", warmup_ms);
+        }
+    } // namespace
+
+    // Restart with the persisted resident set loaded first (sorted, batched prefetch).
+    void Macro_WarmRestartSnapshot(BenchState& state) {
+        RunWarmRestart(state, true, "bench_macro_warm_snapshot.db", "bench_macro_warm_snapshot.snap");
+    }
+    CMSE_BENCHMARK(Macro_WarmRestartSnapshot, "macro", 50000);
+
+    // Same restart without a snapshot: the pool refills through misses.
+    void Macro_WarmRestartCold(BenchState& state) {
+        RunWarmRestart(state, false, "bench_macro_warm_cold.db", "bench_macro_warm_cold.snap");
+    }
+    CMSE_BENCHMARK(Macro_WarmRestartCold, "macro", 50000);
+
+
+    namespace {
+        // Page-size workloads: a B+Tree of 1M int64 keys (inserted in key order, one committed
+        // version) on pages of PageSize, cached by a pool with a fixed 4MB frame budget
+        // (1024 x 4KB ... 64 x 64KB), well under the size of the tree. Node capacity follows
+        // the page size (adapter::BTREE_MAX_KEYS), so bigger pages mean shallower trees and
+        // fewer leaves.
+        constexpr uint64_t PAGE_SIZE_KEYS = uint64_t{ 1 } << 20;
+        constexpr size_t PAGE_SIZE_POOL_BYTES = size_t{ 4 } << 20;
+        constexpr size_t PAGE_SIZE_SCAN_WINDOW = 4096;
+
+        template <size_t PageSize>
+        struct PageSizeTreeFixture {
+            ScratchDbFile db;
+            disk::BasicDiskManager<PageSize> disk_manager;
+            bufferpool::BasicBufferPoolManager<PageSize> bpm;
+            bufferpool::BasicBufferPoolManagerAdapter<PageSize> bpm_adapter;
+            adapter::BasicBTreeAdapter<KeyType, PageSize> tree_adapter;
+            versioning::BasicVersionManager<KeyType, PageSize> vm;
+            version_t version = INVALID_VERSION;
+
+            explicit PageSizeTreeFixture(const std::string& path)
+                : db(path), disk_manager(db.Path()), bpm(PAGE_SIZE_POOL_BYTES / PageSize, &disk_manager), bpm_adapter(&bpm),
+                vm(&bpm_adapter, &tree_adapter) {
+                version = vm.createVersion();
+                for (uint64_t k = 0; k < PAGE_SIZE_KEYS; ++k) {
+                    KeyType key = static_cast<KeyType>(k);
+                    vm.applyUpdate(version, INVALID_VERSION, key, key * 3);
+                }
+                vm.commitVersion(version);
+                bpm.FlushAllPages();
+                bpm.ResetStats();
+            }
+        };
+
+        // One op = one entry returned by range scans over consecutive windows of
+        // PAGE_SIZE_SCAN_WINDOW keys (iterations = whole passes over the key space).
+        template <size_t PageSize>
+        void RunPageSizeScan(BenchState& state, const char* path) {
+            PageSizeTreeFixture<PageSize> fixture(path);
+
+            std::vector<std::pair<KeyType, ValueType>> entries;
+            int64_t sum = 0;
+            uint64_t visited = 0;
+            state.StartTimer();
+            while (visited < state.Iterations()) {
+                for (uint64_t start = 0; start < PAGE_SIZE_KEYS && visited < state.Iterations(); start += PAGE_SIZE_SCAN_WINDOW) {
+                    size_t n = static_cast<size_t>(std::min<uint64_t>(PAGE_SIZE_SCAN_WINDOW, state.Iterations() - visited));
+                    entries.clear();
+                    fixture.vm.scanRange(fixture.version, static_cast<KeyType>(start), static_cast<KeyType>(start + n - 1), n, &entries);
+                    for (const auto& entry : entries) {
+                        sum += entry.second;
+                    }
+                    visited += n;
+                }
+            }
+            state.StopTimer();
+            DoNotOptimize(sum);
+
+            auto stats = fixture.bpm.GetStats();
+            state.SetCounter("fetches_per_1k_records", 1000.0 * static_cast<double>(stats.hits + stats.misses) / static_cast<double>(visited));
+            state.SetCounter("node_capacity", adapter::BasicBTreeAdapter<KeyType, PageSize>::MAX_KEYS);
+        }
+
+        // One op = point lookup of one key (scrambled Zipfian 0.99 over the keys, so hot keys
+        // are spread over the leaves instead of packed into the first ones).
+        template <size_t PageSize>
+        void RunPageSizeLookup(BenchState& state, const char* path) {
+            PageSizeTreeFixture<PageSize> fixture(path);
+
+            ZipfianGenerator zipf(PAGE_SIZE_KEYS, 0.99, 23);
+            std::vector<KeyType> keys(state.Iterations());
+            for (auto& key : keys) {
+                key = static_cast<KeyType>((zipf.Next() * 0x9E3779B1ull) & (PAGE_SIZE_KEYS - 1));
+            }
+
+            int64_t sum = 0;
+            uint64_t found = 0;
+            state.StartTimer();
+            for (KeyType key : keys) {
+                ValueType value;
+                if (fixture.vm.lookup(fixture.version, key, &value)) {
+                    sum += value;
+                    found++;
+                }
+            }
+            state.StopTimer();
+            DoNotOptimize(sum);
+
+            auto stats = fixture.bpm.GetStats();
+            double n = static_cast<double>(keys.size());
+            state.SetCounter("found_ratio", static_cast<double>(found) / n);
+            state.SetCounter("fetches_per_op", static_cast<double>(stats.hits + stats.misses) / n);
+            state.SetCounter("hit_ratio", stats.HitRatio());
+            state.SetCounter("read_bytes_per_op", static_cast<double>(stats.bytes_read) / n);
+        }
+    } // namespace
+
+    // B+Tree range scans: bigger nodes mean fewer leaf fetches (and latch/page-table round trips).
+    void Macro_PageSizeScan4K(BenchState& state) {
+        RunPageSizeScan<4096>(state, "bench_macro_page_scan_4k.db");
+    }
+    CMSE_BENCHMARK(Macro_PageSizeScan4K, "macro", 2097152);
+
+    void Macro_PageSizeScan16K(BenchState& state) {
+        RunPageSizeScan<16384>(state, "bench_macro_page_scan_16k.db");
+    }
+    CMSE_BENCHMARK(Macro_PageSizeScan16K, "macro", 2097152);
+
+    void Macro_PageSizeScan64K(BenchState& state) {
+        RunPageSizeScan<65536>(state, "bench_macro_page_scan_64k.db");
+    }
+    CMSE_BENCHMARK(Macro_PageSizeScan64K, "macro", 2097152);
+
+    // Skewed B+Tree point lookups with the same memory: bigger nodes mean shorter paths but
+    // fewer cached hot leaves.
+    void Macro_PageSizeLookup4K(BenchState& state) {
+        RunPageSizeLookup<4096>(state, "bench_macro_page_lookup_4k.db");
+    }
+    CMSE_BENCHMARK(Macro_PageSizeLookup4K, "macro", 200000);
+
+    void Macro_PageSizeLookup16K(BenchState& state) {
+        RunPageSizeLookup<16384>(state, "bench_macro_page_lookup_16k.db");
+    }
+    CMSE_BENCHMARK(Macro_PageSizeLookup16K, "macro", 200000);
+
+    void Macro_PageSizeLookup64K(BenchState& state) {
+        RunPageSizeLookup<65536>(state, "bench_macro_page_lookup_64k.db");
+    }
+    CMSE_BENCHMARK(Macro_PageSizeLookup64K, "macro", 200000);
+
+} // namespace cmse::bench
@@ -0,0 +1,484 @@
+/**
+ * micro_benchmarks.cpp
+ *
+ * Micro-benchmarks for the individual storage components:
+ * LRUReplacer, BufferPoolManager hit/miss paths, frame sweeps and random hits with/without huge pages, DiskManager I/O, LogManager parsing,
+ * the versioned B+Tree (insert / point lookup) and the query filter kernels.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_harness.h"
+#include "bench_util.h"
+#include "../src/adapter/btree_adapter.h"
+#include "../src/bufferpool/buffer_pool_adapter.h"
+#include "../src/bufferpool/buffer_pool_manager.h"
+#include "../src/bufferpool/lru_replacer.h"
+#include "../src/disk/disk_manager.h"
+#include "../src/query/filter_kernels.h"
+#include "../src/utils/log_manager.h"
+#include "../src/versioning/version_manager.h"
+
+using cmse::frame_id_t;
+using cmse::page_id_t;
+using cmse::bufferpool::ArenaBacking;
+using cmse::bufferpool::BufferPoolManager;
+using cmse::bufferpool::BufferPoolManagerAdapter;
+using cmse::bufferpool::HugePagePolicy;
+using cmse::bufferpool::LRUReplacer;
+using cmse::disk::DiskManager;
+using cmse::versioning::VersionManager;
+
+namespace cmse::bench {
+
+    // =================================================================
+    // LRUReplacer
+    // =================================================================
+
+    // One op = Unpin of a fresh frame followed (in a second pass) by its eviction.
+    void BM_LRU_UnpinVictim(BenchState& state) {
+        const frame_id_t n = static_cast<frame_id_t>(state.Iterations());
+        LRUReplacer lru(n);
+
+        state.StartTimer();
+        for (frame_id_t f = 0; f < n; ++f) {
+            lru.Unpin(f);
+        }
+        frame_id_t victim;
+        while (lru.Victim(&victim)) {
+            DoNotOptimize(victim);
+        }
+        state.StopTimer();
+    }
+    CMSE_BENCHMARK(BM_LRU_UnpinVictim, "micro", 200000);
+
+    // One op = Pin + Unpin of a random frame in a full replacer (the BPM hit path).
+    void BM_LRU_PinUnpinRandom(BenchState& state) {
+        const frame_id_t pool = 1024;
+        LRUReplacer lru(pool);
+        for (frame_id_t f = 0; f < pool; ++f) {
+            lru.Unpin(f);
+        }
+
+        std::mt19937 rng(42);
+        std::vector<frame_id_t> frames(state.Iterations());
+        for (auto& f : frames) {
+            f = static_cast<frame_id_t>(rng() % pool);
+        }
+
+        state.StartTimer();
+        for (frame_id_t f : frames) {
+            lru.Pin(f);
+            lru.Unpin(f);
+        }
+        state.StopTimer();
+    }
+    CMSE_BENCHMARK(BM_LRU_PinUnpinRandom, "micro", 200000);
+
+    // =================================================================
+    // BufferPoolManager
+    // =================================================================
+
+    // One op = FetchPage + UnpinPage on a resident page (hit path, no I/O).
+    void BM_BPM_FetchHit(BenchState& state) {
+        const size_t pool_size = 64;
+        ScratchDbFile db("bench_bpm_hit.db");
+        DiskManager disk_manager(db.Path());
+        BufferPoolManager bpm(pool_size, &disk_manager);
+
+        for (size_t i = 0; i < pool_size; ++i) {
+            page_id_t pid;
+            bpm.NewPage(pid);
+            bpm.UnpinPage(pid, false);
+        }
+
+        std::mt19937 rng(7);
+        std::vector<page_id_t> ids(state.Iterations());
+        for (auto& id : ids) {
+            id = static_cast<page_id_t>(rng() % pool_size);
+        }
+
+        state.StartTimer();
+        for (page_id_t id : ids) {
+            Page* page = bpm.FetchPage(id);
+            DoNotOptimize(page);
+            bpm.UnpinPage(id, false);
+        }
+        state.StopTimer();
+    }
+    CMSE_BENCHMARK(BM_BPM_FetchHit, "micro", 200000);
+
+    // One op = FetchPage + UnpinPage that misses and evicts a clean page.
+    // A cyclic scan over 4x the pool size defeats LRU, so every access is a miss.
+    void BM_BPM_FetchMissClean(BenchState& state) {
+        const size_t pool_size = 16;
+        const page_id_t num_pages = 64;
+        ScratchDbFile db("bench_bpm_miss.db");
+        DiskManager disk_manager(db.Path());
+        BufferPoolManager bpm(pool_size, &disk_manager);
+
+        for (page_id_t i = 0; i < num_pages; ++i) {
+            page_id_t pid;
+            bpm.NewPage(pid);
+            bpm.UnpinPage(pid, true);
+        }
+        bpm.FlushAllPages();
+
+        state.StartTimer();
+        for (uint64_t i = 0; i < state.Iterations(); ++i) {
+            page_id_t id = static_cast<page_id_t>(i % num_pages);
+            Page* page = bpm.FetchPage(id);
+            DoNotOptimize(page);
+            bpm.UnpinPage(id, false);
+        }
+        state.StopTimer();
+    }
+    CMSE_BENCHMARK(BM_BPM_FetchMissClean, "micro", 20000);
+
+    // One op = NewPage + dirty UnpinPage once the pool is full (each op evicts a dirty page).
+    void BM_BPM_NewPageDirtyEvict(BenchState& state) {
+        const size_t pool_size = 16;
+        ScratchDbFile db("bench_bpm_new.db");
+        DiskManager disk_manager(db.Path());
+        BufferPoolManager bpm(pool_size, &disk_manager);
+
+        for (size_t i = 0; i < pool_size; ++i) {
+            page_id_t pid;
+            bpm.NewPage(pid);
+            bpm.UnpinPage(pid, true);
+        }
+
+        state.StartTimer();
+        for (uint64_t i = 0; i < state.Iterations(); ++i) {
+            page_id_t pid;
+            Page* page = bpm.NewPage(pid);
+            std::memcpy(page->GetData(), &i, sizeof(i));
+            bpm.UnpinPage(pid, true);
+        }
+        state.StopTimer();
+    }
+    CMSE_BENCHMARK(BM_BPM_NewPageDirtyEvict, "micro", 5000);
+
+    // One op = dirty one page, then FlushAllPages over a full 4096-frame pool: the sweep checks
+    // every frame's dirty bit but writes back a single page.
+    void BM_BPM_FlushSweep(BenchState& state) {
+        const size_t pool_size = 4096;
+        ScratchDbFile db("bench_bpm_sweep.db");
+        DiskManager disk_manager(db.Path());
+        BufferPoolManager bpm(pool_size, &disk_manager);
+
+        for (size_t i = 0; i < pool_size; ++i) {
+            page_id_t pid;
+            bpm.NewPage(pid);
+            bpm.UnpinPage(pid, false);
+        }
+        bpm.FlushAllPages();
+
+        state.StartTimer();
+        for (uint64_t i = 0; i < state.Iterations(); ++i) {
+            page_id_t id = static_cast<page_id_t>((i * 64) % pool_size);
+            Page* page = bpm.FetchPage(id);
+            DoNotOptimize(page);
+            bpm.UnpinPage(id, true);
+            bpm.FlushAllPages();
+        }
+        state.StopTimer();
+    }
+    CMSE_BENCHMARK(BM_BPM_FlushSweep, "micro", 2000);
+
+    namespace {
+        // One op = FetchPage + read one word of the page + UnpinPage, at a random resident page of
+        // a 32768-frame (128MB) pool: far more pages than the dTLB covers with 4KB entries.
+        void RunRandomHits(BenchState& state, HugePagePolicy policy, const char* path) {
+            const size_t pool_size = 32768;
+            ScratchDbFile db(path);
+            DiskManager disk_manager(db.Path());
+            BufferPoolManager bpm(pool_size, &disk_manager, policy);
+
+            for (size_t i = 0; i < pool_size; ++i) {
+                page_id_t pid;
+                Page* page = bpm.NewPage(pid);
+                std::memcpy(page->GetData(), &i, sizeof(i));
+                bpm.UnpinPage(pid, false);
+            }
+            bpm.FlushAllPages();
+
+            std::mt19937 rng(9);
+            std::vector<page_id_t> ids(state.Iterations());
+            for (auto& id : ids) {
+                id = static_cast<page_id_t>(rng() % pool_size);
+            }
+
+            uint64_t sum = 0;
+            state.StartTimer();
+            for (page_id_t id : ids) {
+                Page* page = bpm.FetchPage(id);
+                uint64_t word;
+                std::memcpy(&word, page->GetData(), sizeof(word));
+                sum += word;
+                bpm.UnpinPage(id, false);
+            }
+            state.StopTimer();
+            DoNotOptimize(sum);
+
+            ArenaBacking backing = bpm.GetArenaBacking();
+            state.SetCounter("huge_pages", backing == ArenaBacking::TransparentHuge || backing == ArenaBacking::ExplicitHuge ? 1 : 0);
+        }
+    } // namespace
+
+    // Frame arena on huge pages where available (compare perf_dtlb_misses_per_op under --perf).
+    void BM_BPM_RandomHitHugePages(BenchState& state) {
+        RunRandomHits(state, HugePagePolicy::Auto, "bench_bpm_random_huge.db");
+    }
+    CMSE_BENCHMARK(BM_BPM_RandomHitHugePages, "micro", 500000);
+
+    // Same accesses with the arena on 4KB pages.
+    void BM_BPM_RandomHitRegularPages(BenchState& state) {
+        RunRandomHits(state, HugePagePolicy::Off, "bench_bpm_random_regular.db");
+    }
+    CMSE_BENCHMARK(BM_BPM_RandomHitRegularPages, "micro", 500000);
+
+    // One op = shrink a full 4096-frame pool to 1024 frames and grow it back, with 64 pages
+    // dirtied per op: evicts the 3072 retired pages (64 written back), unmaps the grown segment
+    // and maps a new one. No flush of the surviving frames, no cold restart.
+    void BM_BPM_ResizeCycle(BenchState& state) {
+        const size_t pool_size = 4096;
+        const size_t small_size = 1024;
+        ScratchDbFile db("bench_bpm_resize.db");
+        DiskManager disk_manager(db.Path());
+        BufferPoolManager bpm(small_size, &disk_manager);
+        bpm.ResizePool(pool_size);
+
+        for (size_t i = 0; i < pool_size; ++i) {
+            page_id_t pid;
+            bpm.NewPage(pid);
+            bpm.UnpinPage(pid, false);
+        }
+        bpm.FlushAllPages();
+
+        state.StartTimer();
+        for (uint64_t i = 0; i < state.Iterations(); ++i) {
+            for (size_t j = 0; j < 64; ++j) {
+                page_id_t id = static_cast<page_id_t>((i * 64 + j) % pool_size);
+                Page* page = bpm.FetchPage(id);
+                DoNotOptimize(page);
+                bpm.UnpinPage(id, true);
+            }
+            bpm.ResizePool(small_size);
+            bpm.ResizePool(pool_size);
+        }
+        state.StopTimer();
+
+        state.SetCounter("mapped_frames", static_cast<double>(bpm.GetStats().mapped_frames));
+    }
+    CMSE_BENCHMARK(BM_BPM_ResizeCycle, "micro", 200);
+
+    // =================================================================
+    // DiskManager
+    // =================================================================
+
+    // One op = WritePage at a sequential offset (includes the per-write fflush).
+    void BM_Disk_WriteSequential(BenchState& state) {
+        ScratchDbFile db("bench_disk_write.db");
+        DiskManager disk_manager(db.Path());
+        std::vector<char> buffer(PAGE_SIZE, 'x');
+
+        state.StartTimer();
+        for (uint64_t i = 0; i < state.Iterations(); ++i) {
+            disk_manager.WritePage(static_cast<page_id_t>(i), buffer.data());
+        }
+        state.StopTimer();
+
+        state.SetCounter("bytes_per_op", PAGE_SIZE);
+    }
+    CMSE_BENCHMARK(BM_Disk_WriteSequential, "micro", 5000);
+
+    // One op = ReadPage at a random offset within a pre-written file.
+    void BM_Disk_ReadRandom(BenchState& state) {
+        const page_id_t num_pages = 1024;
+        ScratchDbFile db("bench_disk_read.db");
+        DiskManager disk_manager(db.Path());
+        std::vector<char> buffer(PAGE_SIZE, 'y');
+        for (page_id_t i = 0; i < num_pages; ++i) {
+            disk_manager.WritePage(i, buffer.data());
+        }
+
+        std::mt19937 rng(3);
+        std::vector<page_id_t> ids(state.Iterations());
+        for (auto& id : ids) {
+            id = static_cast<page_id_t>(rng() % num_pages);
+        }
+
+        state.StartTimer();
+        for (page_id_t id : ids) {
+            disk_manager.ReadPage(id, buffer.data());
+        }
+        state.StopTimer();
+        DoNotOptimize(buffer[0]);
+    }
+    CMSE_BENCHMARK(BM_Disk_ReadRandom, "micro", 20000);
+
+    // =================================================================
+    // LogManager
+    // =================================================================
+
+    // One op = LogRecord::toString (CSV serialization).
+    void BM_Log_Serialize(BenchState& state) {
+        auto logs = utils::LogManager::generateSyntheticLogs(1000);
+
+        state.StartTimer();
+        size_t total = 0;
+        for (uint64_t i = 0; i < state.Iterations(); ++i) {
+            std::string line = logs[i % logs.size()].toString();
+            total += line.size();
+        }
+        state.StopTimer();
+        DoNotOptimize(total);
+    }
+    CMSE_BENCHMARK(BM_Log_Serialize, "micro", 200000);
+
+    // One op = LogManager::parseLine on a pre-serialized CSV line.
+    void BM_Log_Parse(BenchState& state) {
+        auto logs = utils::LogManager::generateSyntheticLogs(1000);
+        std::vector<std::string> lines;
+        lines.reserve(logs.size());
+        for (const auto& log : logs) {
+            lines.push_back(log.toString());
+        }
+
+        state.StartTimer();
+        for (uint64_t i = 0; i < state.Iterations(); ++i) {
+            LogRecord record = utils::LogManager::parseLine(lines[i % lines.size()]);
+            DoNotOptimize(record.resource_id);
+        }
+        state.StopTimer();
+    }
+    CMSE_BENCHMARK(BM_Log_Parse, "micro", 200000);
+
+    // =================================================================
+    // Versioned B+Tree
+    // =================================================================
+
+    // One op = applyUpdate of a random key into one open version (CoW path after the first touch).
+    // The pool holds the whole tree, so this measures traversal, leaf insert and splits, not I/O.
+    void BM_BTree_Insert(BenchState& state) {
+        ScratchDbFile db("bench_btree_insert.db");
+        DiskManager disk_manager(db.Path());
+        BufferPoolManager bpm(4096, &disk_manager);
+        BufferPoolManagerAdapter bpm_adapter(&bpm);
+        adapter::BTreeAdapter tree_adapter;
+        VersionManager vm(&bpm_adapter, &tree_adapter);
+
+        std::mt19937_64 rng(11);
+        std::vector<KeyType> keys(state.Iterations());
+        for (auto& key : keys) {
+            key = static_cast<KeyType>(rng() >> 1);
+        }
+
+        version_t v = vm.createVersion();
+        state.StartTimer();
+        for (size_t i = 0; i < keys.size(); ++i) {
+            vm.applyUpdate(v, INVALID_VERSION, keys[i], static_cast<ValueType>(i));
+        }
+        state.StopTimer();
+        vm.abortVersion(v);
+    }
+    CMSE_BENCHMARK(BM_BTree_Insert, "micro", 50000);
+
+    // One op = lookup of a random present key in a committed 50k-key tree.
+    void BM_BTree_Lookup(BenchState& state) {
+        const size_t num_keys = 50000;
+        ScratchDbFile db("bench_btree_lookup.db");
+        DiskManager disk_manager(db.Path());
+        BufferPoolManager bpm(4096, &disk_manager);
+        BufferPoolManagerAdapter bpm_adapter(&bpm);
+        adapter::BTreeAdapter tree_adapter;
+        VersionManager vm(&bpm_adapter, &tree_adapter);
+
+        std::mt19937_64 rng(13);
+        std::vector<KeyType> keys(num_keys);
+        version_t v = vm.createVersion();
+        for (size_t i = 0; i < num_keys; ++i) {
+            keys[i] = static_cast<KeyType>(rng() >> 1);
+            vm.applyUpdate(v, INVALID_VERSION, keys[i], static_cast<ValueType>(i));
+        }
+        vm.commitVersion(v);
+
+        std::vector<KeyType> probes(state.Iterations());
+        for (auto& probe : probes) {
+            probe = keys[rng() % num_keys];
+        }
+
+        state.StartTimer();
+        for (const KeyType& key : probes) {
+            ValueType value;
+            bool found = vm.lookup(v, key, &value);
+            DoNotOptimize(found);
+        }
+        state.StopTimer();
+    }
+    CMSE_BENCHMARK(BM_BTree_Lookup, "micro", 200000);
+
+    // =================================================================
+    // Query Filter Kernels
+    // =================================================================
+
+    // One op = one row: BETWEEN over a batch of random timestamps, then selection compaction.
+    // 'isa' reports the kernel path compiled in (see CMSE_ENABLE_AVX2).
+    void BM_Query_FilterBetween(BenchState& state) {
+        const size_t rows = query::BATCH_SIZE;
+        std::mt19937_64 rng(17);
+        std::vector<int64_t> values(rows);
+        for (auto& v : values) {
+            v = static_cast<int64_t>(rng() % 1000000);
+        }
+        std::vector<uint8_t> mask(rows);
+        std::vector<uint16_t> selection(rows);
+        const uint64_t batches = std::max<uint64_t>(1, state.Iterations() / rows);
+
+        size_t kept = 0;
+        state.StartTimer();
+        for (uint64_t b = 0; b < batches; ++b) {
+            for (size_t i = 0; i < rows; ++i) {
+                selection[i] = static_cast<uint16_t>(i);
+            }
+            query::compareInt64(values.data(), rows, query::CompareOp::Between, 250000, 750000, mask.data());
+            kept += query::compactSelection(mask.data(), selection.data(), rows, selection.data());
+        }
+        state.StopTimer();
+        DoNotOptimize(kept);
+        state.SetCounter("selectivity", static_cast<double>(kept) / static_cast<double>(batches * rows));
+        state.SetCounter(std::string("isa_") + query::filterKernelIsa(), 1);
+    }
+    CMSE_BENCHMARK(BM_Query_FilterBetween, "micro", 2000000);
+
+    // One op = one row: event_type IN (ERROR, RESTART) over a batch of 16-byte symbols.
+    void BM_Query_MatchSymbol(BenchState& state) {
+        const size_t rows = query::BATCH_SIZE;
+        const char* events[] = { "START", "STOP", "RESTART", "ERROR", "WARNING", "DEPLOY" };
+        std::mt19937 rng(18);
+        std::vector<query::Symbol> values(rows);
+        for (auto& v : values) {
+            v = query::Symbol::from(events[rng() % 6]);
+        }
+        const query::Symbol error = query::Symbol::from("ERROR");
+        const query::Symbol restart = query::Symbol::from("RESTART");
+        std::vector<uint8_t> mask(rows);
+        const uint64_t batches = std::max<uint64_t>(1, state.Iterations() / rows);
+
+        state.StartTimer();
+        for (uint64_t b = 0; b < batches; ++b) {
+            std::fill(mask.begin(), mask.end(), uint8_t{ 0 });
+            query::matchSymbol(values.data(), rows, error, mask.data());
+            query::matchSymbol(values.data(), rows, restart, mask.data());
+            DoNotOptimize(mask);
+        }
+        state.StopTimer();
+    }
+    CMSE_BENCHMARK(BM_Query_MatchSymbol, "micro", 2000000);
+
+} // namespace cmse::bench
@@ -0,0 +1,115 @@
+/**
+ * perf_baseline.cpp
+ *
+ * Baseline loading (via utils::parseJsonFile) and tolerance-band comparison.
+ */
+
+#include "perf_baseline.h"
+#include "../src/utils/json_reader.h"
+
+#include <iomanip>
+
+namespace cmse::bench {
+
+    bool LoadBaseline(const std::string& path, Baseline* out, std::string* error) {
+        utils::JsonValue root;
+        if (!utils::parseJsonFile(path, &root, error)) {
+            return false;
+        }
+
+        const utils::JsonValue* benchmarks = root.get("benchmarks");
+        if (benchmarks == nullptr || !benchmarks->isArray()) {
+            *error = "baseline has no \"benchmarks\" array";
+            return false;
+        }
+
+        Baseline baseline;
+        baseline.tolerance = root.numberOr("tolerance", 0.0);
+        for (const auto& item : benchmarks->items()) {
+            const utils::JsonValue* name = item.get("name");
+            const utils::JsonValue* ns_per_op = item.get("ns_per_op");
+            if (name == nullptr || !name->isString() || ns_per_op == nullptr) {
+                *error = "baseline entry without \"name\" / \"ns_per_op\"";
+                return false;
+            }
+
+            BaselineEntry entry;
+            entry.name = name->asString();
+            entry.median_ns_per_op = ns_per_op->numberOr("median", 0.0);
+            entry.tolerance = item.numberOr("tolerance", 0.0);
+            if (entry.median_ns_per_op <= 0.0) {
+                *error = "baseline entry " + entry.name + " has no positive median";
+                return false;
+            }
+            baseline.entries[entry.name] = entry;
+        }
+
+        *out = std::move(baseline);
+        return true;
+    }
+
+    int CompareToBaseline(const std::vector<BenchResult>& results, const Baseline& baseline,
+        double cli_tolerance, std::ostream& out) {
+        int regressions = 0;
+
+        out << "\n" << std::left << std::setw(40) << "Baseline check"
+            << std::right << std::setw(14) << "Baseline" << std::setw(14) << "Current"
+            << std::setw(10) << "Ratio" << std::setw(10) << "Limit" << "  Status\n";
+        out << std::string(104, '-') << "\n";
+
+        for (const auto& r : results) {
+            auto it = baseline.entries.find(r.name);
+            if (it == baseline.entries.end()) {
+                out << std::left << std::setw(40) << r.name << std::right << std::setw(14) << "-"
+                    << std::setw(14) << std::fixed << std::setprecision(1) << r.median_ns_per_op
+                    << std::setw(10) << "-" << std::setw(10) << "-" << "  no baseline\n";
+                out.unsetf(std::ios::fixed);
+                continue;
+            }
+
+            const BaselineEntry& entry = it->second;
+            double tolerance = DEFAULT_TOLERANCE;
+            if (cli_tolerance > 0.0) {
+                tolerance = cli_tolerance;
+            }
+            else if (entry.tolerance > 0.0) {
+                tolerance = entry.tolerance;
+            }
+            else if (baseline.tolerance > 0.0) {
+                tolerance = baseline.tolerance;
+            }
+            double ratio = r.median_ns_per_op / entry.median_ns_per_op;
+
+            const char* status = "ok";
+            if (ratio > tolerance) {
+                status = "REGRESSION";
+                ++regressions;
+            }
+            else if (ratio < 1.0 / tolerance) {
+                status = "faster (refresh baseline?)";
+            }
+
+            out << std::left << std::setw(40) << r.name << std::right << std::fixed
+                << std::setprecision(1) << std::setw(14) << entry.median_ns_per_op
+                << std::setw(14) << r.median_ns_per_op
+                << std::setprecision(2) << std::setw(10) << ratio
+                << std::setw(10) << tolerance << "  " << status << "\n";
+            out.unsetf(std::ios::fixed);
+        }
+
+        for (const auto& [name, entry] : baseline.entries) {
+            bool ran = false;
+            for (const auto& r : results) {
+                ran = ran || r.name == name;
+            }
+            if (!ran) {
+                out << std::left << std::setw(40) << name << std::right << "  not run (unknown or filtered out)\n";
+            }
+        }
+
+        out << std::setprecision(6);
+        out << "[BENCH] " << regressions << " regression(s) against baseline." << std::endl;
+        return regressions;
+    }
+
+} // namespace cmse::bench
@@ -0,0 +1,47 @@
+/**
+ * perf_baseline.h
+ *
+ * Regression check of cmse_bench results against a checked-in baseline (--baseline=).
+ * The baseline uses the same schema as the --json report, so it can be refreshed with
+ *   cmse_bench --filter=... --json=bench/baselines/perf_smoke.json
+ * and then trimmed. Optional "tolerance" fields (top level or per benchmark) set the band; an
+ * explicit --tolerance overrides them for the whole run.
+ */
+
+#pragma once
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "bench_harness.h"
+
+namespace cmse::bench {
+
+    struct BaselineEntry {
+        std::string name;
+        double median_ns_per_op = 0.0;
+        double tolerance = 0.0;    // 0 = use the file-wide tolerance
+    };
+
+    struct Baseline {
+        double tolerance = 0.0;    // File-wide default; 0 = DEFAULT_TOLERANCE
+        std::map<std::string, BaselineEntry> entries;
+    };
+
+    // Loads a baseline file. Returns false with a reason in 'error' if it is missing or malformed.
+    bool LoadBaseline(const std::string& path, Baseline* out, std::string* error);
+
+    /**
+     * Compares each result with its baseline entry and prints one line per case.
+     * A case regresses if median ns/op > baseline * tolerance, where tolerance is
+     * 'cli_tolerance' if non-zero (an explicit --tolerance), else the per-entry value, else the
+     * file-wide value, else DEFAULT_TOLERANCE. Cases faster than baseline / tolerance are
+     * reported as improvements (baseline may need refreshing) but do not fail.
+     * @return Number of regressions.
+     */
+    int CompareToBaseline(const std::vector<BenchResult>& results, const Baseline& baseline,
+        double cli_tolerance, std::ostream& out);
+
+} // namespace cmse::bench
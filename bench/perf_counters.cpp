@@ -0,0 +1,165 @@
+/**
+ * perf_counters.cpp
+ *
+ * perf_event_open backend (Linux) and no-op fallback (other platforms).
+ */
+
+#include "perf_counters.h"
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace cmse::bench {
+
+    const char* PerfEventName(PerfEvent event) {
+        switch (event) {
+        case PerfEvent::Cycles: return "cycles";
+        case PerfEvent::Instructions: return "instructions";
+        case PerfEvent::LlcMisses: return "llc_misses";
+        case PerfEvent::BranchMisses: return "branch_misses";
+        case PerfEvent::DtlbMisses: return "dtlb_misses";
+        default: return "unknown";
+        }
+    }
+
+#ifdef __linux__
+
+    namespace {
+
+        uint64_t EventConfig(PerfEvent event) {
+            switch (event) {
+            case PerfEvent::Cycles: return PERF_COUNT_HW_CPU_CYCLES;
+            case PerfEvent::Instructions: return PERF_COUNT_HW_INSTRUCTIONS;
+            case PerfEvent::LlcMisses: return PERF_COUNT_HW_CACHE_MISSES; // Last-level cache misses on x86/ARM PMUs
+            case PerfEvent::BranchMisses: return PERF_COUNT_HW_BRANCH_MISSES;
+            case PerfEvent::DtlbMisses: // Data-TLB read misses (a generalized cache event)
+                return PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            default: return 0;
+            }
+        }
+
+        int OpenEvent(PerfEvent event) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = event == PerfEvent::DtlbMisses ? PERF_TYPE_HW_CACHE : PERF_TYPE_HARDWARE;
+            attr.config = EventConfig(event);
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1; // Allowed with perf_event_paranoid <= 2
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0 /* this process */, -1 /* any cpu */, -1, 0));
+        }
+
+    } // namespace
+
+    PerfCounters::~PerfCounters() {
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    bool PerfCounters::Open(std::string* error) {
+        int first_errno = 0;
+        for (size_t i = 0; i < NUM_PERF_EVENTS; ++i) {
+            if (fds_[i] >= 0) {
+                continue;
+            }
+            fds_[i] = OpenEvent(static_cast<PerfEvent>(i));
+            if (fds_[i] < 0 && first_errno == 0) {
+                first_errno = errno;
+            }
+        }
+        if (!IsOpen()) {
+            if (error != nullptr) {
+                *error = std::string("perf_event_open failed: ") + std::strerror(first_errno);
+            }
+            return false;
+        }
+        return true;
+    }
+
+    bool PerfCounters::IsOpen() const {
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void PerfCounters::Reset() {
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            }
+        }
+    }
+
+    void PerfCounters::Enable() {
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    void PerfCounters::Disable() {
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+    }
+
+    PerfReading PerfCounters::Read() const {
+        PerfReading reading;
+        for (size_t i = 0; i < NUM_PERF_EVENTS; ++i) {
+            if (fds_[i] < 0) {
+                continue;
+            }
+            uint64_t data[3] = { 0, 0, 0 }; // value, time_enabled, time_running
+            if (read(fds_[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+                continue;
+            }
+            double value = static_cast<double>(data[0]);
+            // Scale if the PMU was multiplexed between more events than it has registers.
+            if (data[2] > 0 && data[2] < data[1]) {
+                value *= static_cast<double>(data[1]) / static_cast<double>(data[2]);
+            }
+            reading.values[i] = value;
+            reading.valid[i] = true;
+        }
+        return reading;
+    }
+
+#else // !__linux__
+
+    PerfCounters::~PerfCounters() {}
+
+    bool PerfCounters::Open(std::string* error) {
+        if (error != nullptr) {
+            *error = "hardware counters require Linux perf_event_open";
+        }
+        return false;
+    }
+
+    bool PerfCounters::IsOpen() const { return false; }
+    void PerfCounters::Reset() {}
+    void PerfCounters::Enable() {}
+    void PerfCounters::Disable() {}
+    PerfReading PerfCounters::Read() const { return {}; }
+
+#endif
+
+} // namespace cmse::bench
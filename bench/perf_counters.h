@@ -0,0 +1,66 @@
+/**
+ * perf_counters.h
+ *
+ * Optional hardware performance counters for cmse_bench (--perf).
+ * Uses Linux perf_event_open; on other platforms (or when the kernel refuses,
+ * e.g. perf_event_paranoid or a VM without a PMU) Open() fails and the harness
+ * runs without counters.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace cmse::bench {
+
+    enum class PerfEvent { Cycles, Instructions, LlcMisses, BranchMisses, DtlbMisses, Count };
+
+    constexpr size_t NUM_PERF_EVENTS = static_cast<size_t>(PerfEvent::Count);
+
+    // Short name used in counter keys, e.g. "llc_misses".
+    const char* PerfEventName(PerfEvent event);
+
+    /**
+     * PerfReading
+     * Counter totals since the last Reset(), scaled up if the kernel multiplexed the PMU.
+     * valid[i] is false for events the CPU/kernel does not provide.
+     */
+    struct PerfReading {
+        std::array<double, NUM_PERF_EVENTS> values{};
+        std::array<bool, NUM_PERF_EVENTS> valid{};
+
+        double Get(PerfEvent event) const { return values[static_cast<size_t>(event)]; }
+        bool Has(PerfEvent event) const { return valid[static_cast<size_t>(event)]; }
+    };
+
+    /**
+     * PerfCounters
+     * One counter per event for the calling process, user space only, inherited by threads
+     * created while the counters exist (so multi-threaded cases are covered).
+     * Counters start disabled; Enable()/Disable() bracket the measured region.
+     */
+    class PerfCounters {
+    public:
+        PerfCounters() { fds_.fill(-1); }
+        ~PerfCounters();
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        // Opens every event that is available. Returns false (with a reason) if none is.
+        bool Open(std::string* error);
+        bool IsOpen() const;
+
+        void Reset();
+        void Enable();
+        void Disable();
+
+        PerfReading Read() const;
+
+    private:
+        std::array<int, NUM_PERF_EVENTS> fds_;
+    };
+
+} // namespace cmse::bench
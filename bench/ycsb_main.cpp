@@ -0,0 +1,180 @@
+/**
+ * ycsb_main.cpp
+ *
+ * cmse_ycsb: runs a YCSB-style workload (A-F) against the versioned B+Tree.
+ *
+ * Usage:
+ *   cmse_ycsb [--workload=A..F] [--records=N] [--threads=N] [--batch=N]
+ *             [--duration=SEC | --ops=N] [--distribution=uniform|zipfian|latest]
+ *             [--theta=0.99] [--pool=FRAMES] [--scan-length=N] [--seed=N] [--json=PATH]
+ *             [--sweep-pool=F1,F2,... [--sweep-threads=T1,T2,...] [--format=markdown|csv] [--out=PATH]]
+ *
+ * Example: cmse_ycsb --workload=B --threads=8 --batch=128 --duration=10
+ *
+ * Sweep mode runs the workload once per pool size x thread count and prints a table of
+ * throughput, hit ratio and p99 latency (capacity planning for a given --records):
+ *   cmse_ycsb --workload=C --records=100000 --duration=3 --sweep-pool=64,256,1024 --sweep-threads=1,4
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ycsb_sweep.h"
+#include "ycsb_workload.h"
+
+using namespace cmse::bench;
+
+namespace {
+
+    void PrintUsage(const char* program) {
+        std::cerr << "Usage: " << program << " [--workload=A..F] [--records=N] [--threads=N] [--batch=N]\n"
+            << "       [--duration=SEC | --ops=N] [--distribution=uniform|zipfian|latest] [--theta=0.99]\n"
+            << "       [--pool=FRAMES] [--scan-length=N] [--seed=N] [--json=PATH]\n"
+            << "       [--sweep-pool=F1,F2,... [--sweep-threads=T1,T2,...] [--format=markdown|csv] [--out=PATH]]" << std::endl;
+    }
+
+    bool StartsWith(const std::string& s, const std::string& prefix) {
+        return s.compare(0, prefix.size(), prefix) == 0;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    YcsbConfig config;
+    std::string json_path;
+    std::vector<size_t> sweep_pools;
+    std::vector<size_t> sweep_threads;
+    SweepFormat sweep_format = SweepFormat::Markdown;
+    std::string sweep_out;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string value = arg.substr(arg.find('=') + 1);
+        try {
+            if (StartsWith(arg, "--workload=") && value.size() == 1) {
+                config.workload = static_cast<char>(std::toupper(static_cast<unsigned char>(value[0])));
+            }
+            else if (StartsWith(arg, "--records=")) {
+                config.record_count = std::stoull(value);
+            }
+            else if (StartsWith(arg, "--threads=")) {
+                config.threads = std::max(1, std::stoi(value));
+            }
+            else if (StartsWith(arg, "--batch=")) {
+                config.commit_batch = std::max<size_t>(1, std::stoull(value));
+            }
+            else if (StartsWith(arg, "--duration=")) {
+                config.duration_sec = std::stod(value);
+            }
+            else if (StartsWith(arg, "--ops=")) {
+                config.operation_count = std::stoull(value);
+            }
+            else if (StartsWith(arg, "--distribution=")) {
+                if (!ParseDistribution(value, &config.distribution)) {
+                    throw std::invalid_argument(value);
+                }
+                config.distribution_set = true;
+            }
+            else if (StartsWith(arg, "--theta=")) {
+                config.zipf_theta = std::stod(value);
+            }
+            else if (StartsWith(arg, "--pool=")) {
+                config.pool_size = std::max<size_t>(8, std::stoull(value));
+            }
+            else if (StartsWith(arg, "--scan-length=")) {
+                config.max_scan_length = std::max<size_t>(1, std::stoull(value));
+            }
+            else if (StartsWith(arg, "--seed=")) {
+                config.seed = std::stoull(value);
+            }
+            else if (StartsWith(arg, "--json=")) {
+                json_path = value;
+            }
+            else if (StartsWith(arg, "--sweep-pool=")) {
+                if (!ParseSizeList(value, &sweep_pools)) {
+                    throw std::invalid_argument(value);
+                }
+            }
+            else if (StartsWith(arg, "--sweep-threads=")) {
+                if (!ParseSizeList(value, &sweep_threads)) {
+                    throw std::invalid_argument(value);
+                }
+            }
+            else if (StartsWith(arg, "--format=")) {
+                if (value == "csv") {
+                    sweep_format = SweepFormat::Csv;
+                }
+                else if (value == "markdown" || value == "md") {
+                    sweep_format = SweepFormat::Markdown;
+                }
+                else {
+                    throw std::invalid_argument(value);
+                }
+            }
+            else if (StartsWith(arg, "--out=")) {
+                sweep_out = value;
+            }
+            else {
+                std::cerr << "[YCSB] Unknown argument: " << arg << std::endl;
+                PrintUsage(argv[0]);
+                return 2;
+            }
+        }
+        catch (const std::exception&) {
+            std::cerr << "[YCSB] Invalid value in argument: " << arg << std::endl;
+            PrintUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    YcsbMix mix;
+    if (!GetYcsbMix(config.workload, &mix)) {
+        std::cerr << "[YCSB] Unknown workload: " << config.workload << std::endl;
+        return 2;
+    }
+
+    if (!sweep_pools.empty() || !sweep_threads.empty()) {
+        if (sweep_pools.empty()) {
+            sweep_pools.push_back(config.pool_size);
+        }
+        std::vector<int> thread_counts;
+        for (size_t t : sweep_threads) {
+            thread_counts.push_back(static_cast<int>(t));
+        }
+        if (thread_counts.empty()) {
+            thread_counts.push_back(config.threads);
+        }
+
+        std::vector<SweepPoint> points = RunYcsbSweep(config, sweep_pools, thread_counts, &std::cerr);
+        if (sweep_out.empty()) {
+            WriteSweepTable(config, points, sweep_format, std::cout);
+            return 0;
+        }
+        std::ofstream out(sweep_out, std::ios::trunc);
+        if (!out) {
+            std::cerr << "[YCSB] Cannot open " << sweep_out << std::endl;
+            return 1;
+        }
+        WriteSweepTable(config, points, sweep_format, out);
+        std::cout << "[YCSB] Wrote sweep table to " << sweep_out << std::endl;
+        return 0;
+    }
+
+    YcsbReport report = RunYcsb(config);
+    PrintYcsbReport(report, std::cout);
+
+    if (!json_path.empty()) {
+        std::ofstream out(json_path, std::ios::trunc);
+        if (!out) {
+            std::cerr << "[YCSB] Cannot open " << json_path << std::endl;
+            return 1;
+        }
+        out << YcsbReportToJson(report);
+        std::cout << "[YCSB] Wrote results to " << json_path << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * ycsb_sweep.cpp
+ *
+ * Pool size x thread count sweep over RunYcsb() and CSV / markdown rendering.
+ */
+
+#include "ycsb_sweep.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace cmse::bench {
+
+    std::vector<SweepPoint> RunYcsbSweep(const YcsbConfig& base, const std::vector<size_t>& pool_sizes,
+        const std::vector<int>& thread_counts, std::ostream* progress) {
+        std::vector<SweepPoint> points;
+        points.reserve(pool_sizes.size() * thread_counts.size());
+
+        for (size_t pool_size : pool_sizes) {
+            for (int threads : thread_counts) {
+                YcsbConfig config = base;
+                config.pool_size = std::max<size_t>(8, pool_size); // Same floor as --pool
+                config.threads = threads;
+
+                YcsbReport report = RunYcsb(config);
+
+                SweepPoint point;
+                point.pool_size = config.pool_size;
+                point.threads = threads;
+                point.total_ops = report.total_ops;
+                point.ops_per_sec = report.ops_per_sec;
+                point.hit_ratio = report.hit_ratio;
+                point.p50_ns = report.latency.p50_ns;
+                point.p99_ns = report.latency.p99_ns;
+                for (const auto& op : report.ops) {
+                    point.failed += op.failed;
+                }
+                points.push_back(point);
+
+                if (progress != nullptr) {
+                    *progress << "[YCSB] pool=" << pool_size << " threads=" << threads
+                        << std::fixed << std::setprecision(1) << " -> " << point.ops_per_sec << " ops/s, hit ratio "
+                        << std::setprecision(4) << point.hit_ratio << ", p99 "
+                        << std::setprecision(2) << point.p99_ns / 1000.0 << " us" << std::endl;
+                    progress->unsetf(std::ios::fixed);
+                }
+            }
+        }
+        return points;
+    }
+
+    void WriteSweepTable(const YcsbConfig& base, const std::vector<SweepPoint>& points, SweepFormat format, std::ostream& out) {
+        out << std::fixed;
+        if (format == SweepFormat::Csv) {
+            out << "pool_size,threads,ops,ops_per_sec,hit_ratio,p50_us,p99_us,failed\n";
+            for (const auto& p : points) {
+                out << p.pool_size << "," << p.threads << "," << p.total_ops << ","
+                    << std::setprecision(1) << p.ops_per_sec << ","
+                    << std::setprecision(4) << p.hit_ratio << ","
+                    << std::setprecision(2) << p.p50_ns / 1000.0 << "," << p.p99_ns / 1000.0 << ","
+                    << p.failed << "\n";
+            }
+        }
+        else {
+            YcsbMix mix;
+            KeyDistribution distribution = base.distribution;
+            if (!base.distribution_set && GetYcsbMix(base.workload, &mix)) {
+                distribution = mix.distribution;
+            }
+            out << "### YCSB-" << base.workload << " sweep (" << base.record_count << " records, "
+                << DistributionName(distribution) << ", batch " << base.commit_batch << ")\n\n";
+            out << "| pool_size | threads | ops/sec | hit ratio | p50 (us) | p99 (us) | failed |\n";
+            out << "|---:|---:|---:|---:|---:|---:|---:|\n";
+            for (const auto& p : points) {
+                out << "| " << p.pool_size << " | " << p.threads
+                    << " | " << std::setprecision(1) << p.ops_per_sec
+                    << " | " << std::setprecision(4) << p.hit_ratio
+                    << " | " << std::setprecision(2) << p.p50_ns / 1000.0
+                    << " | " << p.p99_ns / 1000.0
+                    << " | " << p.failed << " |\n";
+            }
+        }
+        out.unsetf(std::ios::fixed);
+    }
+
+    bool ParseSizeList(const std::string& text, std::vector<size_t>* out) {
+        std::vector<size_t> values;
+        std::stringstream ss(text);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            if (item.empty() || item.find_first_not_of("0123456789") != std::string::npos) {
+                return false;
+            }
+            size_t value = std::stoull(item);
+            if (value == 0) {
+                return false;
+            }
+            values.push_back(value);
+        }
+        if (values.empty()) {
+            return false;
+        }
+        *out = std::move(values);
+        return true;
+    }
+
+} // namespace cmse::bench
@@ -0,0 +1,46 @@
+/**
+ * ycsb_sweep.h
+ *
+ * Capacity-planning sweep: runs one YCSB workload for every (pool size, thread count)
+ * pair and tabulates throughput, buffer pool hit ratio and p99 latency.
+ * Used by cmse_ycsb --sweep-pool=... / --sweep-threads=...
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ycsb_workload.h"
+
+namespace cmse::bench {
+
+    struct SweepPoint {
+        size_t pool_size = 0;
+        int threads = 0;
+        uint64_t total_ops = 0;
+        double ops_per_sec = 0.0;
+        double hit_ratio = 0.0;
+        uint64_t p50_ns = 0;
+        uint64_t p99_ns = 0;
+        uint64_t failed = 0;
+    };
+
+    enum class SweepFormat { Markdown, Csv };
+
+    /**
+     * Runs 'base' once per pool size x thread count (pool-major order). Every run loads a
+     * fresh database, so points are independent. Progress lines go to 'progress' if non-null.
+     */
+    std::vector<SweepPoint> RunYcsbSweep(const YcsbConfig& base, const std::vector<size_t>& pool_sizes,
+        const std::vector<int>& thread_counts, std::ostream* progress);
+
+    // One row per point. Markdown adds a header describing the workload.
+    void WriteSweepTable(const YcsbConfig& base, const std::vector<SweepPoint>& points, SweepFormat format, std::ostream& out);
+
+    // Parses "64,128,256" into positive integers. Returns false on any malformed entry.
+    bool ParseSizeList(const std::string& text, std::vector<size_t>* out);
+
+} // namespace cmse::bench
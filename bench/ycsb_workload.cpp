@@ -0,0 +1,424 @@
+/**
+ * ycsb_workload.cpp
+ *
+ * Load phase, worker threads and reporting for the YCSB-style driver.
+ */
+
+#include "ycsb_workload.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "bench_util.h"
+#include "../src/adapter/btree_adapter.h"
+#include "../src/bufferpool/buffer_pool_adapter.h"
+#include "../src/bufferpool/buffer_pool_manager.h"
+#include "../src/disk/disk_manager.h"
+#include "../src/versioning/version_manager.h"
+
+namespace cmse::bench {
+
+    namespace {
+
+        constexpr size_t NUM_OPS = static_cast<size_t>(YcsbOp::Count);
+
+        // YCSB hashes record numbers so that consecutive inserts land in different leaves.
+        KeyType KeyFor(uint64_t keynum) {
+            uint64_t hash = 0xCBF29CE484222325ULL; // FNV-1a 64
+            for (int i = 0; i < 8; ++i) {
+                hash ^= (keynum >> (i * 8)) & 0xFF;
+                hash *= 0x100000001B3ULL;
+            }
+            return static_cast<KeyType>(hash & 0x7FFFFFFFFFFFFFFFULL);
+        }
+
+        /**
+         * Group commit: all threads write into one open version, committed every 'batch' writes.
+         * Record numbers for inserts are assigned here, and only become readable (VisibleKeys)
+         * once their version commits, like YCSB's acknowledged-insert counter.
+         */
+        class GroupCommitter {
+        public:
+            GroupCommitter(versioning::VersionManager* vm, size_t batch)
+                : vm_(vm), batch_(std::max<size_t>(1, batch)) {}
+
+            bool Update(KeyType key, ValueType val) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return WriteLocked(key, val);
+            }
+
+            bool Insert(ValueType val) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return WriteLocked(KeyFor(next_keynum_++), val);
+            }
+
+            // Record numbers [0, VisibleKeys()) exist in the latest committed version.
+            uint64_t VisibleKeys() const {
+                return visible_keys_.load(std::memory_order_acquire);
+            }
+
+            void Flush() {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (pending_ > 0) {
+                    CommitLocked();
+                }
+            }
+
+            uint64_t Commits() {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return commits_;
+            }
+
+        private:
+            bool WriteLocked(KeyType key, ValueType val) {
+                if (open_ == INVALID_VERSION) {
+                    open_ = vm_->createVersion();
+                }
+                if (!vm_->applyUpdate(open_, base_, key, val)) {
+                    // The open version may be incomplete: drop the whole batch.
+                    vm_->abortVersion(open_);
+                    open_ = INVALID_VERSION;
+                    pending_ = 0;
+                    next_keynum_ = visible_keys_.load(std::memory_order_relaxed);
+                    return false;
+                }
+                if (++pending_ >= batch_) {
+                    CommitLocked();
+                }
+                return true;
+            }
+
+            void CommitLocked() {
+                if (vm_->commitVersion(open_)) {
+                    base_ = open_;
+                    commits_++;
+                    visible_keys_.store(next_keynum_, std::memory_order_release);
+                }
+                else {
+                    next_keynum_ = visible_keys_.load(std::memory_order_relaxed);
+                }
+                open_ = INVALID_VERSION;
+                pending_ = 0;
+            }
+
+            versioning::VersionManager* vm_;
+            size_t batch_;
+            std::mutex mutex_;
+            version_t open_ = INVALID_VERSION;
+            version_t base_ = INVALID_VERSION;
+            size_t pending_ = 0;
+            uint64_t commits_ = 0;
+            uint64_t next_keynum_ = 0;
+            std::atomic<uint64_t> visible_keys_{ 0 };
+        };
+
+        struct SharedState {
+            versioning::VersionManager* vm;
+            GroupCommitter* committer;
+            std::atomic<bool> stop{ false };
+            std::array<std::unique_ptr<utils::LatencyRecorder>, NUM_OPS> latency;
+            utils::LatencyRecorder all_latency{ "all" };
+            std::array<std::atomic<uint64_t>, NUM_OPS> failed{};
+        };
+
+        class KeyChooser {
+        public:
+            KeyChooser(KeyDistribution distribution, uint64_t record_count, double theta, uint64_t seed)
+                : distribution_(distribution), rng_(seed),
+                zipf_(distribution == KeyDistribution::Uniform ? nullptr
+                    : std::make_unique<ZipfianGenerator>(std::max<uint64_t>(2, record_count), theta, seed ^ 0x5DEECE66DULL)) {}
+
+            uint64_t Next(uint64_t key_count) {
+                if (key_count == 0) {
+                    return 0;
+                }
+                switch (distribution_) {
+                case KeyDistribution::Uniform:
+                    return rng_() % key_count;
+                case KeyDistribution::Zipfian:
+                    return zipf_->Next() % key_count;
+                case KeyDistribution::Latest:
+                default: {
+                    uint64_t offset = zipf_->Next();
+                    return offset >= key_count ? 0 : key_count - 1 - offset;
+                }
+                }
+            }
+
+            std::mt19937_64& Rng() { return rng_; }
+
+        private:
+            KeyDistribution distribution_;
+            std::mt19937_64 rng_;
+            std::unique_ptr<ZipfianGenerator> zipf_;
+        };
+
+        YcsbOp ChooseOp(const YcsbMix& mix, double u) {
+            if ((u -= mix.read) < 0) return YcsbOp::Read;
+            if ((u -= mix.update) < 0) return YcsbOp::Update;
+            if ((u -= mix.insert) < 0) return YcsbOp::Insert;
+            if ((u -= mix.scan) < 0) return YcsbOp::Scan;
+            return YcsbOp::ReadModifyWrite;
+        }
+
+        // Executes one operation; returns false if it failed.
+        bool Execute(YcsbOp op, SharedState& shared, KeyChooser& chooser, const YcsbConfig& config,
+            std::vector<std::pair<KeyType, ValueType>>& scan_buffer) {
+            auto& rng = chooser.Rng();
+            ValueType value = static_cast<ValueType>(rng() >> 1);
+
+            switch (op) {
+            case YcsbOp::Read: {
+                KeyType key = KeyFor(chooser.Next(shared.committer->VisibleKeys()));
+                ValueType out;
+                return shared.vm->lookup(shared.vm->latestVersion(), key, &out);
+            }
+            case YcsbOp::Update: {
+                KeyType key = KeyFor(chooser.Next(shared.committer->VisibleKeys()));
+                return shared.committer->Update(key, value);
+            }
+            case YcsbOp::Insert:
+                return shared.committer->Insert(value);
+            case YcsbOp::Scan: {
+                KeyType start = KeyFor(chooser.Next(shared.committer->VisibleKeys()));
+                size_t length = 1 + static_cast<size_t>(rng() % std::max<size_t>(1, config.max_scan_length));
+                scan_buffer.clear();
+                return shared.vm->scan(shared.vm->latestVersion(), start, length, &scan_buffer);
+            }
+            case YcsbOp::ReadModifyWrite:
+            default: {
+                KeyType key = KeyFor(chooser.Next(shared.committer->VisibleKeys()));
+                ValueType current = 0;
+                if (!shared.vm->lookup(shared.vm->latestVersion(), key, &current)) {
+                    return false;
+                }
+                return shared.committer->Update(key, current + 1);
+            }
+            }
+        }
+
+        double SecondsSince(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+
+    } // namespace
+
+    const char* YcsbOpName(YcsbOp op) {
+        switch (op) {
+        case YcsbOp::Read: return "read";
+        case YcsbOp::Update: return "update";
+        case YcsbOp::Insert: return "insert";
+        case YcsbOp::Scan: return "scan";
+        case YcsbOp::ReadModifyWrite: return "read_modify_write";
+        default: return "unknown";
+        }
+    }
+
+    const char* DistributionName(KeyDistribution distribution) {
+        switch (distribution) {
+        case KeyDistribution::Uniform: return "uniform";
+        case KeyDistribution::Zipfian: return "zipfian";
+        case KeyDistribution::Latest: return "latest";
+        default: return "unknown";
+        }
+    }
+
+    bool ParseDistribution(const std::string& name, KeyDistribution* out) {
+        if (name == "uniform") { *out = KeyDistribution::Uniform; return true; }
+        if (name == "zipfian") { *out = KeyDistribution::Zipfian; return true; }
+        if (name == "latest") { *out = KeyDistribution::Latest; return true; }
+        return false;
+    }
+
+    bool GetYcsbMix(char workload, YcsbMix* out_mix) {
+        YcsbMix mix;
+        switch (workload) {
+        case 'A': case 'a': mix.read = 0.50; mix.update = 0.50; break;
+        case 'B': case 'b': mix.read = 0.95; mix.update = 0.05; break;
+        case 'C': case 'c': mix.read = 1.00; break;
+        case 'D': case 'd': mix.read = 0.95; mix.insert = 0.05; mix.distribution = KeyDistribution::Latest; break;
+        case 'E': case 'e': mix.scan = 0.95; mix.insert = 0.05; break;
+        case 'F': case 'f': mix.read = 0.50; mix.read_modify_write = 0.50; break;
+        default: return false;
+        }
+        *out_mix = mix;
+        return true;
+    }
+
+    YcsbReport RunYcsb(const YcsbConfig& config) {
+        YcsbMix mix;
+        if (!GetYcsbMix(config.workload, &mix)) {
+            throw std::invalid_argument(std::string("Unknown YCSB workload: ") + config.workload);
+        }
+        KeyDistribution distribution = config.distribution_set ? config.distribution : mix.distribution;
+
+        ScratchDbFile db(config.db_path);
+        disk::DiskManager disk_manager(db.Path());
+        bufferpool::BufferPoolManager bpm(config.pool_size, &disk_manager);
+        bufferpool::BufferPoolManagerAdapter bpm_adapter(&bpm);
+        adapter::BTreeAdapter tree_adapter;
+        versioning::VersionManager vm(&bpm_adapter, &tree_adapter);
+        GroupCommitter committer(&vm, config.commit_batch);
+
+        SharedState shared;
+        shared.vm = &vm;
+        shared.committer = &committer;
+        for (size_t i = 0; i < NUM_OPS; ++i) {
+            shared.latency[i] = std::make_unique<utils::LatencyRecorder>(YcsbOpName(static_cast<YcsbOp>(i)));
+        }
+
+        YcsbReport report;
+        report.config = config;
+        report.config.distribution = distribution;
+
+        // --- Load phase (single thread, not measured) ---
+        auto load_start = std::chrono::steady_clock::now();
+        std::mt19937_64 load_rng(config.seed);
+        for (uint64_t keynum = 0; keynum < config.record_count; ++keynum) {
+            committer.Insert(static_cast<ValueType>(load_rng() >> 1));
+        }
+        committer.Flush();
+        report.load_sec = SecondsSince(load_start);
+        uint64_t load_commits = committer.Commits();
+        bpm.ResetStats();
+
+        // --- Run phase ---
+        const int threads = std::max(1, config.threads);
+        const uint64_t per_thread = config.operation_count == 0 ? 0 : std::max<uint64_t>(1, config.operation_count / threads);
+        std::vector<std::array<uint64_t, NUM_OPS>> counts(threads);
+
+        auto run_start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                KeyChooser chooser(distribution, config.record_count, config.zipf_theta, config.seed * 7919 + t);
+                std::uniform_real_distribution<double> uniform(0.0, 1.0);
+                std::vector<std::pair<KeyType, ValueType>> scan_buffer;
+                auto& local = counts[t];
+                local.fill(0);
+
+                for (uint64_t i = 0; per_thread == 0 || i < per_thread; ++i) {
+                    if (shared.stop.load(std::memory_order_relaxed)) {
+                        break;
+                    }
+                    YcsbOp op = ChooseOp(mix, uniform(chooser.Rng()));
+                    auto start = std::chrono::steady_clock::now();
+                    bool ok = Execute(op, shared, chooser, config, scan_buffer);
+                    auto elapsed = std::chrono::steady_clock::now() - start;
+
+                    size_t idx = static_cast<size_t>(op);
+                    uint64_t elapsed_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+                    shared.latency[idx]->record(elapsed_ns);
+                    shared.all_latency.record(elapsed_ns);
+                    local[idx]++;
+                    if (!ok) {
+                        shared.failed[idx].fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+
+        if (per_thread == 0) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(config.duration_sec));
+            shared.stop = true;
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        committer.Flush();
+        report.elapsed_sec = SecondsSince(run_start);
+
+        // --- Report ---
+        report.commits = committer.Commits() - load_commits;
+        report.hit_ratio = bpm.GetStats().HitRatio();
+        for (size_t i = 0; i < NUM_OPS; ++i) {
+            uint64_t count = 0;
+            for (const auto& local : counts) {
+                count += local[i];
+            }
+            if (count == 0) {
+                continue;
+            }
+            YcsbOpReport op;
+            op.op = YcsbOpName(static_cast<YcsbOp>(i));
+            op.count = count;
+            op.failed = shared.failed[i].load();
+            op.ops_per_sec = report.elapsed_sec > 0 ? static_cast<double>(count) / report.elapsed_sec : 0.0;
+            op.latency = shared.latency[i]->summarize();
+            report.total_ops += count;
+            report.ops.push_back(op);
+        }
+        report.ops_per_sec = report.elapsed_sec > 0 ? static_cast<double>(report.total_ops) / report.elapsed_sec : 0.0;
+        report.latency = shared.all_latency.summarize();
+        return report;
+    }
+
+    void PrintYcsbReport(const YcsbReport& report, std::ostream& out) {
+        const auto& c = report.config;
+        out << "[YCSB] workload=" << c.workload << " records=" << c.record_count
+            << " threads=" << c.threads << " batch=" << c.commit_batch
+            << " distribution=" << DistributionName(c.distribution) << " pool=" << c.pool_size << "\n";
+        out << std::fixed << std::setprecision(2);
+        out << "[YCSB] load " << report.load_sec << " s, run " << report.elapsed_sec << " s, "
+            << report.total_ops << " ops, " << report.ops_per_sec << " ops/s, "
+            << report.commits << " commits, hit ratio " << std::setprecision(4) << report.hit_ratio << "\n\n";
+
+        out << std::left << std::setw(20) << "operation" << std::right
+            << std::setw(12) << "count" << std::setw(10) << "failed" << std::setw(14) << "ops/sec"
+            << std::setw(12) << "mean_us" << std::setw(12) << "p50_us" << std::setw(12) << "p99_us"
+            << std::setw(12) << "p999_us" << std::setw(12) << "max_us" << "\n";
+        out << std::string(116, '-') << "\n";
+        for (const auto& op : report.ops) {
+            out << std::left << std::setw(20) << op.op << std::right
+                << std::setw(12) << op.count << std::setw(10) << op.failed
+                << std::setw(14) << std::setprecision(1) << op.ops_per_sec
+                << std::setprecision(2)
+                << std::setw(12) << op.latency.mean_ns / 1000.0
+                << std::setw(12) << op.latency.p50_ns / 1000.0
+                << std::setw(12) << op.latency.p99_ns / 1000.0
+                << std::setw(12) << op.latency.p999_ns / 1000.0
+                << std::setw(12) << op.latency.max_ns / 1000.0 << "\n";
+        }
+    }
+
+    std::string YcsbReportToJson(const YcsbReport& report) {
+        const auto& c = report.config;
+        std::ostringstream out;
+        out << "{\n";
+        out << "  \"config\": {\"workload\": \"" << c.workload << "\", \"record_count\": " << c.record_count
+            << ", \"threads\": " << c.threads << ", \"commit_batch\": " << c.commit_batch
+            << ", \"distribution\": \"" << DistributionName(c.distribution) << "\", \"zipf_theta\": " << c.zipf_theta
+            << ", \"pool_size\": " << c.pool_size << ", \"duration_sec\": " << c.duration_sec
+            << ", \"operation_count\": " << c.operation_count << "},\n";
+        out << "  \"load_sec\": " << report.load_sec << ",\n";
+        out << "  \"elapsed_sec\": " << report.elapsed_sec << ",\n";
+        out << "  \"total_ops\": " << report.total_ops << ",\n";
+        out << "  \"ops_per_sec\": " << report.ops_per_sec << ",\n";
+        out << "  \"commits\": " << report.commits << ",\n";
+        out << "  \"hit_ratio\": " << report.hit_ratio << ",\n";
+        out << "  \"latency_ns\": {\"mean\": " << report.latency.mean_ns << ", \"p50\": " << report.latency.p50_ns
+            << ", \"p99\": " << report.latency.p99_ns << ", \"p999\": " << report.latency.p999_ns
+            << ", \"max\": " << report.latency.max_ns << "},\n";
+        out << "  \"operations\": [\n";
+        for (size_t i = 0; i < report.ops.size(); ++i) {
+            const auto& op = report.ops[i];
+            out << "    {\"op\": \"" << op.op << "\", \"count\": " << op.count << ", \"failed\": " << op.failed
+                << ", \"ops_per_sec\": " << op.ops_per_sec
+                << ", \"latency_ns\": {\"mean\": " << op.latency.mean_ns << ", \"p50\": " << op.latency.p50_ns
+                << ", \"p99\": " << op.latency.p99_ns << ", \"p999\": " << op.latency.p999_ns
+                << ", \"max\": " << op.latency.max_ns << "}}" << (i + 1 < report.ops.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+        return out.str();
+    }
+
+} // namespace cmse::bench
@@ -0,0 +1,97 @@
+/**
+ * ycsb_workload.h
+ *
+ * YCSB-style (Cooper et al., SoCC '10) key-value workloads A-F over the versioned
+ * B+Tree (VersionManager + BTreeAdapter + BufferPoolManager).
+ *
+ * Writes from all threads go through one group committer: they are applied to a shared
+ * open version, which is committed every 'commit_batch' writes. Reads and scans run
+ * against the latest committed version, so they never block on writers.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../src/utils/latency_histogram.h"
+
+namespace cmse::bench {
+
+    enum class YcsbOp { Read, Update, Insert, Scan, ReadModifyWrite, Count };
+
+    const char* YcsbOpName(YcsbOp op);
+
+    enum class KeyDistribution { Uniform, Zipfian, Latest };
+
+    /**
+     * Operation proportions of one workload (sum to 1.0).
+     */
+    struct YcsbMix {
+        double read = 0.0;
+        double update = 0.0;
+        double insert = 0.0;
+        double scan = 0.0;
+        double read_modify_write = 0.0;
+        KeyDistribution distribution = KeyDistribution::Zipfian;
+    };
+
+    /**
+     * Standard core workloads:
+     *   A 50/50 read/update, B 95/5 read/update, C read only, D 95/5 read/insert (latest),
+     *   E 95/5 scan/insert, F 50/50 read/read-modify-write.
+     * @return false for an unknown workload letter.
+     */
+    bool GetYcsbMix(char workload, YcsbMix* out_mix);
+
+    struct YcsbConfig {
+        char workload = 'A';
+        uint64_t record_count = 10000;     // Keys loaded before the run
+        uint64_t operation_count = 0;      // Total ops; 0 = run for 'duration_sec'
+        double duration_sec = 5.0;
+        int threads = 4;
+        size_t commit_batch = 64;          // Writes per committed version
+        bool distribution_set = false;     // false = the workload's default distribution
+        KeyDistribution distribution = KeyDistribution::Zipfian;
+        double zipf_theta = 0.99;
+        size_t pool_size = 256;            // Buffer pool frames
+        size_t max_scan_length = 100;      // Scan lengths are uniform in [1, max_scan_length]
+        uint64_t seed = 1;
+        std::string db_path = "ycsb.db";
+    };
+
+    struct YcsbOpReport {
+        std::string op;
+        uint64_t count = 0;
+        uint64_t failed = 0;               // Buffer pool exhaustion or key not found
+        double ops_per_sec = 0.0;
+        utils::LatencySummary latency;
+    };
+
+    struct YcsbReport {
+        YcsbConfig config;
+        double load_sec = 0.0;
+        double elapsed_sec = 0.0;
+        uint64_t total_ops = 0;
+        double ops_per_sec = 0.0;
+        uint64_t commits = 0;
+        double hit_ratio = 0.0;
+        utils::LatencySummary latency;     // All operation types combined
+        std::vector<YcsbOpReport> ops;     // Only operation types that ran
+    };
+
+    /**
+     * Loads 'record_count' keys, then runs the configured mix and reports per-op results.
+     * Throws std::invalid_argument for an unknown workload.
+     */
+    YcsbReport RunYcsb(const YcsbConfig& config);
+
+    const char* DistributionName(KeyDistribution distribution);
+    bool ParseDistribution(const std::string& name, KeyDistribution* out);
+
+    void PrintYcsbReport(const YcsbReport& report, std::ostream& out);
+    std::string YcsbReportToJson(const YcsbReport& report);
+
+} // namespace cmse::bench
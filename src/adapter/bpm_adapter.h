@@ -7,10 +7,14 @@ namespace cmse::adapter {
      * BufferPoolAdapter
      * Abstract interface that VersionManager uses to interact with the Buffer Pool.
      * This decouples the versioning logic from the specific BufferPool implementation.
+     * Parameterized on the page size of the pool behind it (BufferPoolAdapter: PAGE_SIZE).
      */
-    class BufferPoolAdapter {
+    template <size_t PageSize>
+    class BasicBufferPoolAdapter {
     public:
-        virtual ~BufferPoolAdapter() = default;
+        using Page = BasicPage<PageSize>;
+
+        virtual ~BasicBufferPoolAdapter() = default;
 
         // Fetches a page from disk/cache and pins it. Returns nullptr on failure.
         virtual Page* FetchPage(page_id_t page_id) = 0;
@@ -29,4 +33,6 @@ namespace cmse::adapter {
         virtual void FlushAll() = 0;
     };
 
+    using BufferPoolAdapter = BasicBufferPoolAdapter<PAGE_SIZE>;
+
 } // namespace cmse::adapter
\ No newline at end of file
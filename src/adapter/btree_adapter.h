@@ -1,24 +1,13 @@
 #pragma once
-#include "../storage/page/page.h"
+#include "../page/page.h"
 #include "../common/types.h"
+#include "tree_adapter.h"
 #include <vector>
 #include <cstring>
 #include <algorithm>
 
 namespace cmse::adapter {
 
-    /**
-     * SplitResult
-     * Output structure for the splitNode operation.
-     * Captures the result of a page split to propagate up to the parent.
-     */
-    struct SplitResult {
-        bool did_split = false;
-        page_id_t left_page_id = INVALID_PAGE_ID;
-        page_id_t right_page_id = INVALID_PAGE_ID; // The new page created during split
-        KeyType promoted_key;                      // The key to be inserted into the parent
-    };
-
     /**
      * BPlusNodeHeader
      * The standard header for every B+Tree page (Internal or Leaf).
@@ -28,29 +17,39 @@ namespace cmse::adapter {
      * 2. Phase 3 Stats: 'min_key', 'max_key', and 'density' are reserved here to avoid
      * changing data layout later in Phase 3.
      */
-    struct BPlusNodeHeader {
+    template <typename KeyT>
+    struct BasicBPlusNodeHeader {
         bool is_leaf;
         int16_t key_count;
 
         // --- Phase 3: Statistical Indexing Metadata ---
-        KeyType min_key;
-        KeyType max_key;
+        KeyT min_key;
+        KeyT max_key;
         float density;    // (key_count / MAX_CAPACITY)
     };
 
-    // Constants for array sizing (Simplified for project)
-    // In a real system, these depend on KeyType size and PAGE_SIZE.
-    constexpr int MAX_KEYS = 100;
+    /**
+     * Keys per node for a key type and page size: the page payload minus the node header and the
+     * leaf's next_leaf_id (padded to a ValueType), divided by the size of one leaf entry. Internal
+     * nodes store page ids instead of values and always fit.
+     */
+    template <typename KeyT, size_t PageSize>
+    constexpr int BTREE_MAX_KEYS = static_cast<int>(
+        (PageSize - sizeof(PageHeader) - sizeof(BasicBPlusNodeHeader<KeyT>) - sizeof(ValueType)) / (sizeof(KeyT) + sizeof(ValueType)));
+
+    // Keys per node of the int64 tree on PAGE_SIZE pages.
+    constexpr int MAX_KEYS = BTREE_MAX_KEYS<KeyType, PAGE_SIZE>;
 
     /**
      * BPlusInternalNode
      * Maps the raw Page data for Internal Nodes.
      * Memory Layout: [Header] [Keys Array] [Children PageIDs Array]
      */
-    struct BPlusInternalNode {
-        BPlusNodeHeader header;
-        KeyType keys[MAX_KEYS];
-        page_id_t children[MAX_KEYS + 1]; // N keys, N+1 children
+    template <typename KeyT, size_t PageSize = PAGE_SIZE>
+    struct BasicBPlusInternalNode {
+        BasicBPlusNodeHeader<KeyT> header;
+        KeyT keys[BTREE_MAX_KEYS<KeyT, PageSize>];
+        page_id_t children[BTREE_MAX_KEYS<KeyT, PageSize> + 1]; // N keys, N+1 children
     };
 
     /**
@@ -58,50 +57,77 @@ namespace cmse::adapter {
      * Maps the raw Page data for Leaf Nodes.
      * Memory Layout: [Header] [Keys Array] [Values Array] [Next Leaf ID]
      */
-    struct BPlusLeafNode {
-        BPlusNodeHeader header;
-        KeyType keys[MAX_KEYS];
-        ValueType values[MAX_KEYS];
+    template <typename KeyT, size_t PageSize = PAGE_SIZE>
+    struct BasicBPlusLeafNode {
+        BasicBPlusNodeHeader<KeyT> header;
+        KeyT keys[BTREE_MAX_KEYS<KeyT, PageSize>];
+        ValueType values[BTREE_MAX_KEYS<KeyT, PageSize>];
         page_id_t next_leaf_id; // For Range Queries
     };
 
+    using BPlusNodeHeader = BasicBPlusNodeHeader<KeyType>;
+    using BPlusInternalNode = BasicBPlusInternalNode<KeyType>;
+    using BPlusLeafNode = BasicBPlusLeafNode<KeyType>;
+
 
     /**
      * BTreeAdapter
      * Concrete implementation of the TreeAdapter interface for B+Tree logic.
      * Handles raw byte manipulation, splitting, and CoW pointer updates.
+     * Nodes fill the page: MAX_KEYS grows with PageSize (larger pages for scan-heavy trees).
+     * Instantiated (in btree_adapter.cpp) for KeyType, ResourceTimeKey and RollupKey on every
+     * CMSE_FOR_EACH_PAGE_SIZE.
      */
-    class BTreeAdapter {
+    template <typename KeyT, size_t PageSize = PAGE_SIZE>
+    class BasicBTreeAdapter : public BasicTreeAdapter<KeyT, PageSize> {
     public:
+        using Page = BasicPage<PageSize>;
+        using SplitResult = BasicSplitResult<KeyT>;
+        using NodeHeader = BasicBPlusNodeHeader<KeyT>;
+        using InternalNode = BasicBPlusInternalNode<KeyT, PageSize>;
+        using LeafNode = BasicBPlusLeafNode<KeyT, PageSize>;
+
+        static constexpr int MAX_KEYS = BTREE_MAX_KEYS<KeyT, PageSize>;
+
         // --- Initialization Helpers ---
-        void initLeaf(Page* page);
-        void initInternal(Page* page);
+        void initLeaf(Page* page) override;
+        void initInternal(Page* page) override;
 
         // --- Inspection (ReadOnly) ---
-        bool isLeaf(Page* page);
-        int getCount(Page* page);
+        bool isLeaf(Page* page) override;
+        int getCount(Page* page) override;
 
         // Returns the child page ID that should contain the key (for Internal Nodes)
-        page_id_t findChild(Page* internal_page, const KeyType& key);
+        page_id_t findChild(Page* internal_page, const KeyT& key) override;
+        int findChildIndex(Page* internal_page, const KeyT& key) override;
+        page_id_t getChildAt(Page* internal_page, int index) override;
+
+        // --- Leaf Access (ReadOnly) ---
+        bool lookupInLeaf(Page* leaf_page, const KeyT& key, ValueType* out_val) override;
+        int lowerBoundInLeaf(Page* leaf_page, const KeyT& key) override;
+        KeyT getKeyAt(Page* leaf_page, int index) override;
+        ValueType getValueAt(Page* leaf_page, int index) override;
 
         // --- Phase 3: Statistics (ReadOnly) ---
         // Checks if a subtree can be skipped during a range query based on min/max stats.
-        bool shouldSkip(Page* page, const KeyType& query_min, const KeyType& query_max);
+        bool shouldSkip(Page* page, const KeyT& query_min, const KeyT& query_max) override;
+        float getDensity(Page* page) override;
+        int getCapacity() override { return MAX_KEYS; }
 
 
         // --- Modification Operations (Performed on CoW Copies) ---
 
         // Applies an insert/update on a LEAF page.
         // Returns true if successful, false if the page is full (needs split).
-        bool applyUpdateToLeaf(Page* leaf_page, const KeyType& key, const ValueType& val);
+        bool applyUpdateToLeaf(Page* leaf_page, const KeyT& key, const ValueType& val) override;
 
         // Updates a child pointer in a PARENT page.
         // Critical for CoW: When a child gets a new PageID, the parent must point to it.
-        void updateChildPointer(Page* parent_page, page_id_t old_child_id, page_id_t new_child_id);
+        void updateChildPointer(Page* parent_page, page_id_t old_child_id, page_id_t new_child_id) override;
 
         // Inserts a promoted key and new child pointer into an INTERNAL node.
         // Returns true if successful, false if full (needs split).
-        bool insertIntoInternal(Page* internal_page, const KeyType& key, page_id_t right_child_id);
+        bool insertIntoInternal(Page* internal_page, const KeyT& key, page_id_t right_child_id) override;
 
 
         // --- Structure Management (Split/Merge) ---
@@ -110,21 +136,40 @@ namespace cmse::adapter {
         // node_to_split: The full page (source).
         // new_right_page: An empty page allocated by VersionManager.
         // out_result: Filled with split details (promoted key, new IDs).
-        void splitNode(Page* node_to_split, Page* new_right_page, SplitResult* out_result);
+        void splitNode(Page* node_to_split, Page* new_right_page, SplitResult* out_result) override;
 
         // Creates a new root when the old root splits (Tree height grows).
         // new_root_page: Empty page allocated for the new root.
-        void createNewRoot(Page* new_root_page, page_id_t left_child, page_id_t right_child, const KeyType& key);
+        void createNewRoot(Page* new_root_page, page_id_t left_child, page_id_t right_child, const KeyT& key) override;
 
         // --- Phase 3: Stats Calculation ---
         // Recalculates min_key, max_key, and density. Called after modification.
-        void updateStatistics(Page* page);
+        void updateStatistics(Page* page) override;
+        void expandStatistics(Page* page, const KeyT& key) override;
+        void mergeStatistics(Page* parent_page, Page* child_page) override;
 
     private:
         // Helper to access raw headers
-        BPlusNodeHeader* getHeader(Page* page) {
-            return reinterpret_cast<BPlusNodeHeader*>(page->GetData());
+        NodeHeader* getHeader(Page* page) {
+            return reinterpret_cast<NodeHeader*>(page->GetData());
+        }
+        InternalNode* asInternal(Page* page) {
+            return reinterpret_cast<InternalNode*>(page->GetData());
+        }
+        LeafNode* asLeaf(Page* page) {
+            return reinterpret_cast<LeafNode*>(page->GetData());
         }
     };
 
+#define CMSE_EXTERN_BTREE_ADAPTERS(size) \
+    extern template class BasicBTreeAdapter<KeyType, size>; \
+    extern template class BasicBTreeAdapter<ResourceTimeKey, size>; \
+    extern template class BasicBTreeAdapter<RollupKey, size>;
+    CMSE_FOR_EACH_PAGE_SIZE(CMSE_EXTERN_BTREE_ADAPTERS)
+#undef CMSE_EXTERN_BTREE_ADAPTERS
+
+    using BTreeAdapter = BasicBTreeAdapter<KeyType>;
+    using CompositeBTreeAdapter = BasicBTreeAdapter<ResourceTimeKey>;
+    using RollupBTreeAdapter = BasicBTreeAdapter<RollupKey>;
+
 } // namespace cmse::adapter
\ No newline at end of file
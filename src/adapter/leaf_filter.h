@@ -0,0 +1,30 @@
+#pragma once
+#include "../common/types.h"
+#include <vector>
+
+namespace cmse::adapter {
+
+    /**
+     * LeafFilter
+     * Optional membership filter that VersionManager consults before fetching a leaf page.
+     * Filters are keyed by the leading component of the index key (KeyTraits::filterKey), so
+     * one filter answers both point lookups and single-prefix range scans.
+     *
+     * Only leaves of committed versions are registered: those pages are immutable and their ids
+     * are never reused, so a filter never goes stale. mayContain() must not return false for a
+     * key that is in the leaf; pages without a filter are always fetched.
+     */
+    class LeafFilter {
+    public:
+        virtual ~LeafFilter() = default;
+
+        // Registers the filter keys of a leaf. Returns false if the filter could not be stored.
+        virtual bool addLeaf(page_id_t leaf_page_id, const std::vector<int64_t>& filter_keys) = 0;
+
+        virtual bool hasLeaf(page_id_t leaf_page_id) = 0;
+
+        // False only if no key of the leaf has this filter key (true for unknown pages).
+        virtual bool mayContain(page_id_t leaf_page_id, int64_t filter_key) = 0;
+    };
+
+} // namespace cmse::adapter
@@ -0,0 +1,93 @@
+#pragma once
+#include "../page/page.h"
+#include "../common/types.h"
+#include "../common/key_traits.h"
+
+namespace cmse::adapter {
+
+    /**
+     * SplitResult
+     * Output structure for the splitNode operation.
+     * Captures the result of a page split to propagate up to the parent.
+     */
+    template <typename KeyT>
+    struct BasicSplitResult {
+        bool did_split = false;
+        page_id_t left_page_id = INVALID_PAGE_ID;
+        page_id_t right_page_id = INVALID_PAGE_ID; // The new page created during split
+        KeyT promoted_key{};                       // The key to be inserted into the parent
+    };
+
+    /**
+     * TreeAdapter
+     * Abstract interface that VersionManager uses to manipulate index pages.
+     * Implementations only interpret raw Page bytes; they never touch the disk, the buffer pool
+     * or version metadata (VersionManager owns allocation, pinning and Copy-on-Write).
+     * KeyT must be totally ordered (operator<, ==) and have a KeyTraits specialization.
+     * PageSize is the page size of the pool the nodes live in (see adapter::BasicBufferPoolAdapter).
+     */
+    template <typename KeyT, size_t PageSize = PAGE_SIZE>
+    class BasicTreeAdapter {
+    public:
+        using Page = BasicPage<PageSize>;
+        using SplitResult = BasicSplitResult<KeyT>;
+
+        virtual ~BasicTreeAdapter() = default;
+
+        // --- Initialization ---
+        virtual void initLeaf(Page* page) = 0;
+        virtual void initInternal(Page* page) = 0;
+
+        // --- Inspection (ReadOnly) ---
+        virtual bool isLeaf(Page* page) = 0;
+        virtual int getCount(Page* page) = 0;
+
+        // Returns the child page ID that should contain the key (for Internal Nodes)
+        virtual page_id_t findChild(Page* internal_page, const KeyT& key) = 0;
+
+        // Index of the child findChild() would return, and the child stored at an index (0..count).
+        virtual int findChildIndex(Page* internal_page, const KeyT& key) = 0;
+        virtual page_id_t getChildAt(Page* internal_page, int index) = 0;
+
+        // Point lookup in a LEAF page. Returns false if the key is not present.
+        virtual bool lookupInLeaf(Page* leaf_page, const KeyT& key, ValueType* out_val) = 0;
+
+        // Index of the first entry >= key in a LEAF page (== count if none), and entry accessors.
+        virtual int lowerBoundInLeaf(Page* leaf_page, const KeyT& key) = 0;
+        virtual KeyT getKeyAt(Page* leaf_page, int index) = 0;
+        virtual ValueType getValueAt(Page* leaf_page, int index) = 0;
+
+        // --- Modification Operations (Performed on CoW Copies) ---
+
+        // Returns true if successful, false if the page is full (needs split).
+        virtual bool applyUpdateToLeaf(Page* leaf_page, const KeyT& key, const ValueType& val) = 0;
+        virtual void updateChildPointer(Page* parent_page, page_id_t old_child_id, page_id_t new_child_id) = 0;
+        virtual bool insertIntoInternal(Page* internal_page, const KeyT& key, page_id_t right_child_id) = 0;
+
+        // --- Structure Management ---
+        virtual void splitNode(Page* node_to_split, Page* new_right_page, SplitResult* out_result) = 0;
+        virtual void createNewRoot(Page* new_root_page, page_id_t left_child, page_id_t right_child, const KeyT& key) = 0;
+
+        // --- Statistics ---
+        // Recalculates the node statistics after a modification.
+        virtual void updateStatistics(Page* page) = 0;
+
+        // Widens the [min_key, max_key] range of a node to include 'key'.
+        // Used on internal nodes, whose subtree range cannot be derived from the page alone.
+        virtual void expandStatistics(Page* page, const KeyT& key) = 0;
+
+        // Widens the range of 'parent_page' to cover the range of 'child_page'.
+        virtual void mergeStatistics(Page* parent_page, Page* child_page) = 0;
+
+        // Fill factor of a node (key_count / getCapacity()); used to estimate subtree sizes.
+        virtual float getDensity(Page* page) = 0;
+        virtual int getCapacity() = 0;
+
+        // True if no key of the node's subtree can lie in [query_min, query_max] (min/max stats).
+        virtual bool shouldSkip(Page* page, const KeyT& query_min, const KeyT& query_max) = 0;
+    };
+
+    using SplitResult = BasicSplitResult<KeyType>;
+    using TreeAdapter = BasicTreeAdapter<KeyType>;
+
+} // namespace cmse::adapter
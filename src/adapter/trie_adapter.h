@@ -1,5 +1,5 @@
 #pragma once
-#include "../storage/page/page.h"
+#include "../page/page.h"
 #include "../common/types.h"
 #include <vector>
 #include <cstring>
@@ -31,6 +31,20 @@ namespace cmse::adapter {
         // --- Statistical Metadata ---
         int32_t subtree_terminals;  // Total number of terminal nodes in the subtree rooted here.
         // Used for quick COUNT(*) queries on prefixes.
+
+        page_id_t postings_page_id; // First page of further values of this key, or INVALID_PAGE_ID
+    };
+
+    /**
+     * TriePostingHeader
+     * Header of a posting page: values of a terminal beyond the one stored in its node, so a
+     * key can map to several values (e.g. one resource name shared by several resource ids).
+     * Posting pages form a singly linked chain; values are kept in insertion order.
+     *   Posting page: [TriePostingHeader] [ValueType values[TRIE_MAX_POSTINGS<PageSize>]]
+     */
+    struct TriePostingHeader {
+        page_id_t next_page_id;     // Next posting page, or INVALID_PAGE_ID
+        int32_t count;              // Values on this page
     };
 
     // Constants
@@ -39,14 +53,26 @@ namespace cmse::adapter {
     // We can safely assume it handles full ASCII (256) without overflow/splitting logic.
     constexpr int MAX_TRIE_CHILDREN = 256;
 
+    // Values per posting page: grows with the page size.
+    template <size_t PageSize>
+    constexpr int TRIE_MAX_POSTINGS = static_cast<int>((PageSize - sizeof(PageHeader) - sizeof(TriePostingHeader)) / sizeof(ValueType));
+    constexpr int MAX_TRIE_POSTINGS = TRIE_MAX_POSTINGS<PAGE_SIZE>;
+
     /**
      * TrieAdapter
      * Manages Page-based Trie operations for Text Indexing (Phase 4).
      * Unlike B+Tree, Trie nodes do not split horizontally; they grow vertically.
-     * * This class handles raw byte manipulation on the Page object.
+     * * This class handles raw byte manipulation on the Page object (see trie/trie_adapter.cpp).
+     * Instantiated for CMSE_FOR_EACH_PAGE_SIZE; a node needs ~2KB at full fan-out, so the
+     * smallest page wastes the least on the many sparse nodes deep in a name trie.
      */
-    class TrieAdapter {
+    template <size_t PageSize = PAGE_SIZE>
+    class BasicTrieAdapter {
     public:
+        using Page = BasicPage<PageSize>;
+
+        static constexpr int MAX_POSTINGS = TRIE_MAX_POSTINGS<PageSize>;
+
         // --- Initialization ---
         void initNode(Page* page);
 
@@ -57,6 +83,11 @@ namespace cmse::adapter {
         // Implements Binary Search on the entries for O(log child_count) access.
         page_id_t findChild(Page* page, char c);
 
+        // Number of children, and the edge at 'index' (0..count-1, ordered by unsigned char value).
+        // Used to enumerate a subtree (prefix scans).
+        int getChildCount(Page* page);
+        TrieNodeEntry getChildAt(Page* page, int index);
+
         // Returns true if the node represents a complete word.
         bool isTerminal(Page* page);
 
@@ -89,6 +120,21 @@ namespace cmse::adapter {
         // This change must propagate up to the root during the recursive update.
         void adjustSubtreeCount(Page* page, int delta);
 
+        // --- Posting Pages (further values of a terminal) ---
+
+        // First posting page of a node (INVALID_PAGE_ID if the node holds a single value).
+        page_id_t getPostingsPage(Page* node);
+        void setPostingsPage(Page* node, page_id_t postings_page_id);
+
+        void initPostings(Page* page);
+        int getPostingCount(Page* page);
+        ValueType getPostingAt(Page* page, int index);
+        page_id_t getNextPostings(Page* page);
+        void setNextPostings(Page* page, page_id_t next_page_id);
+
+        // Appends a value. Returns false if the page already holds MAX_POSTINGS values.
+        bool appendPosting(Page* page, ValueType value);
+
     private:
         // Helper to access header
         TrieNodeHeader* getHeader(Page* page) {
@@ -99,6 +145,20 @@ namespace cmse::adapter {
         TrieNodeEntry* getEntries(Page* page) {
             return reinterpret_cast<TrieNodeEntry*>(page->GetData() + sizeof(TrieNodeHeader));
         }
+
+        TriePostingHeader* getPostingHeader(Page* page) {
+            return reinterpret_cast<TriePostingHeader*>(page->GetData());
+        }
+
+        ValueType* getPostings(Page* page) {
+            return reinterpret_cast<ValueType*>(page->GetData() + sizeof(TriePostingHeader));
+        }
     };
 
+#define CMSE_EXTERN_TRIE_ADAPTER(size) extern template class BasicTrieAdapter<size>;
+    CMSE_FOR_EACH_PAGE_SIZE(CMSE_EXTERN_TRIE_ADAPTER)
+#undef CMSE_EXTERN_TRIE_ADAPTER
+
+    using TrieAdapter = BasicTrieAdapter<PAGE_SIZE>;
+
 } // namespace cmse::adapter
\ No newline at end of file
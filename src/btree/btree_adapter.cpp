@@ -0,0 +1,303 @@
+#include "../adapter/btree_adapter.h"
+
+namespace cmse::adapter {
+
+    namespace {
+        // An empty node has min_key > max_key, so no query range overlaps it.
+        template <typename KeyT>
+        void resetRange(BasicBPlusNodeHeader<KeyT>* header) {
+            header->min_key = KeyTraits<KeyT>::highest();
+            header->max_key = KeyTraits<KeyT>::lowest();
+        }
+    }
+
+    // =================================================================
+    // Initialization
+    // =================================================================
+
+    template <typename KeyT, size_t PageSize>
+    void BasicBTreeAdapter<KeyT, PageSize>::initLeaf(Page* page) {
+        LeafNode* leaf = asLeaf(page);
+        leaf->header.is_leaf = true;
+        leaf->header.key_count = 0;
+        leaf->header.density = 0.0f;
+        resetRange(&leaf->header);
+        leaf->next_leaf_id = INVALID_PAGE_ID;
+
+        page->GetHeader()->is_leaf = 1;
+        page->GetHeader()->key_count = 0;
+    }
+
+    template <typename KeyT, size_t PageSize>
+    void BasicBTreeAdapter<KeyT, PageSize>::initInternal(Page* page) {
+        InternalNode* node = asInternal(page);
+        node->header.is_leaf = false;
+        node->header.key_count = 0;
+        node->header.density = 0.0f;
+        resetRange(&node->header);
+
+        page->GetHeader()->is_leaf = 0;
+        page->GetHeader()->key_count = 0;
+    }
+
+    // =================================================================
+    // Inspection
+    // =================================================================
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicBTreeAdapter<KeyT, PageSize>::isLeaf(Page* page) {
+        return getHeader(page)->is_leaf;
+    }
+
+    template <typename KeyT, size_t PageSize>
+    int BasicBTreeAdapter<KeyT, PageSize>::getCount(Page* page) {
+        return getHeader(page)->key_count;
+    }
+
+    template <typename KeyT, size_t PageSize>
+    int BasicBTreeAdapter<KeyT, PageSize>::findChildIndex(Page* internal_page, const KeyT& key) {
+        InternalNode* node = asInternal(internal_page);
+        // keys[i-1] <= key < keys[i]  ->  children[i]
+        return static_cast<int>(std::upper_bound(node->keys, node->keys + node->header.key_count, key) - node->keys);
+    }
+
+    template <typename KeyT, size_t PageSize>
+    page_id_t BasicBTreeAdapter<KeyT, PageSize>::findChild(Page* internal_page, const KeyT& key) {
+        return asInternal(internal_page)->children[findChildIndex(internal_page, key)];
+    }
+
+    template <typename KeyT, size_t PageSize>
+    page_id_t BasicBTreeAdapter<KeyT, PageSize>::getChildAt(Page* internal_page, int index) {
+        return asInternal(internal_page)->children[index];
+    }
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicBTreeAdapter<KeyT, PageSize>::shouldSkip(Page* page, const KeyT& query_min, const KeyT& query_max) {
+        NodeHeader* header = getHeader(page);
+        return query_max < header->min_key || query_min > header->max_key;
+    }
+
+    template <typename KeyT, size_t PageSize>
+    float BasicBTreeAdapter<KeyT, PageSize>::getDensity(Page* page) {
+        return getHeader(page)->density;
+    }
+
+    // =================================================================
+    // Leaf Access
+    // =================================================================
+
+    template <typename KeyT, size_t PageSize>
+    int BasicBTreeAdapter<KeyT, PageSize>::lowerBoundInLeaf(Page* leaf_page, const KeyT& key) {
+        LeafNode* leaf = asLeaf(leaf_page);
+        return static_cast<int>(std::lower_bound(leaf->keys, leaf->keys + leaf->header.key_count, key) - leaf->keys);
+    }
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicBTreeAdapter<KeyT, PageSize>::lookupInLeaf(Page* leaf_page, const KeyT& key, ValueType* out_val) {
+        LeafNode* leaf = asLeaf(leaf_page);
+        int pos = lowerBoundInLeaf(leaf_page, key);
+        if (pos == leaf->header.key_count || leaf->keys[pos] != key) {
+            return false;
+        }
+        if (out_val != nullptr) {
+            *out_val = leaf->values[pos];
+        }
+        return true;
+    }
+
+    template <typename KeyT, size_t PageSize>
+    KeyT BasicBTreeAdapter<KeyT, PageSize>::getKeyAt(Page* leaf_page, int index) {
+        return asLeaf(leaf_page)->keys[index];
+    }
+
+    template <typename KeyT, size_t PageSize>
+    ValueType BasicBTreeAdapter<KeyT, PageSize>::getValueAt(Page* leaf_page, int index) {
+        return asLeaf(leaf_page)->values[index];
+    }
+
+    // =================================================================
+    // Modification
+    // =================================================================
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicBTreeAdapter<KeyT, PageSize>::applyUpdateToLeaf(Page* leaf_page, const KeyT& key, const ValueType& val) {
+        LeafNode* leaf = asLeaf(leaf_page);
+        int count = leaf->header.key_count;
+        int pos = lowerBoundInLeaf(leaf_page, key);
+
+        // Update in place (never needs a split)
+        if (pos < count && leaf->keys[pos] == key) {
+            leaf->values[pos] = val;
+            return true;
+        }
+
+        if (count >= MAX_KEYS) {
+            return false;
+        }
+
+        std::memmove(&leaf->keys[pos + 1], &leaf->keys[pos], sizeof(KeyT) * (count - pos));
+        std::memmove(&leaf->values[pos + 1], &leaf->values[pos], sizeof(ValueType) * (count - pos));
+        leaf->keys[pos] = key;
+        leaf->values[pos] = val;
+        leaf->header.key_count++;
+        return true;
+    }
+
+    template <typename KeyT, size_t PageSize>
+    void BasicBTreeAdapter<KeyT, PageSize>::updateChildPointer(Page* parent_page, page_id_t old_child_id, page_id_t new_child_id) {
+        InternalNode* node = asInternal(parent_page);
+        for (int i = 0; i <= node->header.key_count; ++i) {
+            if (node->children[i] == old_child_id) {
+                node->children[i] = new_child_id;
+                return;
+            }
+        }
+    }
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicBTreeAdapter<KeyT, PageSize>::insertIntoInternal(Page* internal_page, const KeyT& key, page_id_t right_child_id) {
+        InternalNode* node = asInternal(internal_page);
+        int count = node->header.key_count;
+        if (count >= MAX_KEYS) {
+            return false;
+        }
+
+        int pos = findChildIndex(internal_page, key);
+        std::memmove(&node->keys[pos + 1], &node->keys[pos], sizeof(KeyT) * (count - pos));
+        std::memmove(&node->children[pos + 2], &node->children[pos + 1], sizeof(page_id_t) * (count - pos));
+        node->keys[pos] = key;
+        node->children[pos + 1] = right_child_id;
+        node->header.key_count++;
+        return true;
+    }
+
+    // =================================================================
+    // Structure Management
+    // =================================================================
+
+    template <typename KeyT, size_t PageSize>
+    void BasicBTreeAdapter<KeyT, PageSize>::splitNode(Page* node_to_split, Page* new_right_page, SplitResult* out_result) {
+        out_result->did_split = true;
+        out_result->left_page_id = node_to_split->GetPageId();
+        out_result->right_page_id = new_right_page->GetPageId();
+
+        if (isLeaf(node_to_split)) {
+            LeafNode* left = asLeaf(node_to_split);
+            initLeaf(new_right_page);
+            LeafNode* right = asLeaf(new_right_page);
+
+            int count = left->header.key_count;
+            int mid = count / 2;
+            int moved = count - mid;
+            std::memcpy(right->keys, &left->keys[mid], sizeof(KeyT) * moved);
+            std::memcpy(right->values, &left->values[mid], sizeof(ValueType) * moved);
+            right->header.key_count = static_cast<int16_t>(moved);
+            left->header.key_count = static_cast<int16_t>(mid);
+
+            // Sibling links are only valid within one version (CoW copies do not relink predecessors).
+            right->next_leaf_id = left->next_leaf_id;
+            left->next_leaf_id = out_result->right_page_id;
+
+            // Leaf split copies the separator up: it stays as the first key of the right leaf.
+            out_result->promoted_key = right->keys[0];
+            updateStatistics(node_to_split);
+            updateStatistics(new_right_page);
+            return;
+        }
+
+        InternalNode* left = asInternal(node_to_split);
+        initInternal(new_right_page);
+        InternalNode* right = asInternal(new_right_page);
+
+        int count = left->header.key_count;
+        int mid = count / 2;
+        int moved = count - mid - 1;
+
+        // Internal split moves the middle key up: it is kept in neither half.
+        out_result->promoted_key = left->keys[mid];
+        std::memcpy(right->keys, &left->keys[mid + 1], sizeof(KeyT) * moved);
+        std::memcpy(right->children, &left->children[mid + 1], sizeof(page_id_t) * (moved + 1));
+        right->header.key_count = static_cast<int16_t>(moved);
+        left->header.key_count = static_cast<int16_t>(mid);
+
+        // Subtree ranges stay conservative: each half inherits the old range, clipped at the separator.
+        KeyT old_min = left->header.min_key;
+        KeyT old_max = left->header.max_key;
+        if (!(old_max < old_min)) {
+            left->header.max_key = std::min(old_max, KeyTraits<KeyT>::predecessor(out_result->promoted_key));
+            right->header.min_key = std::max(old_min, out_result->promoted_key);
+            right->header.max_key = old_max;
+        }
+        updateStatistics(node_to_split);
+        updateStatistics(new_right_page);
+    }
+
+    template <typename KeyT, size_t PageSize>
+    void BasicBTreeAdapter<KeyT, PageSize>::createNewRoot(Page* new_root_page, page_id_t left_child, page_id_t right_child, const KeyT& key) {
+        initInternal(new_root_page);
+        InternalNode* root = asInternal(new_root_page);
+        root->keys[0] = key;
+        root->children[0] = left_child;
+        root->children[1] = right_child;
+        root->header.key_count = 1;
+        updateStatistics(new_root_page);
+    }
+
+    // =================================================================
+    // Statistics
+    // =================================================================
+
+    template <typename KeyT, size_t PageSize>
+    void BasicBTreeAdapter<KeyT, PageSize>::updateStatistics(Page* page) {
+        NodeHeader* header = getHeader(page);
+        header->density = static_cast<float>(header->key_count) / static_cast<float>(MAX_KEYS);
+        page->GetHeader()->key_count = static_cast<uint32_t>(header->key_count);
+
+        // Leaves know their exact range; internal ranges are maintained through expandStatistics().
+        if (header->is_leaf) {
+            LeafNode* leaf = asLeaf(page);
+            if (header->key_count == 0) {
+                resetRange(header);
+            }
+            else {
+                header->min_key = leaf->keys[0];
+                header->max_key = leaf->keys[header->key_count - 1];
+            }
+        }
+    }
+
+    template <typename KeyT, size_t PageSize>
+    void BasicBTreeAdapter<KeyT, PageSize>::expandStatistics(Page* page, const KeyT& key) {
+        NodeHeader* header = getHeader(page);
+        header->min_key = std::min(header->min_key, key);
+        header->max_key = std::max(header->max_key, key);
+    }
+
+    template <typename KeyT, size_t PageSize>
+    void BasicBTreeAdapter<KeyT, PageSize>::mergeStatistics(Page* parent_page, Page* child_page) {
+        NodeHeader* child = getHeader(child_page);
+        if (child->max_key < child->min_key) {
+            return; // Empty child
+        }
+        expandStatistics(parent_page, child->min_key);
+        expandStatistics(parent_page, child->max_key);
+    }
+
+    // =================================================================
+    // Instantiations
+    // =================================================================
+
+#define CMSE_INSTANTIATE_BTREE_ADAPTERS(size) \
+    template class BasicBTreeAdapter<KeyType, size>; \
+    template class BasicBTreeAdapter<ResourceTimeKey, size>; \
+    template class BasicBTreeAdapter<RollupKey, size>; \
+    static_assert(sizeof(BasicBPlusLeafNode<KeyType, size>) <= size - sizeof(PageHeader), "B+Tree leaf does not fit in a page"); \
+    static_assert(sizeof(BasicBPlusInternalNode<KeyType, size>) <= size - sizeof(PageHeader), "B+Tree internal node does not fit in a page"); \
+    static_assert(sizeof(BasicBPlusLeafNode<ResourceTimeKey, size>) <= size - sizeof(PageHeader), "Composite B+Tree leaf does not fit in a page"); \
+    static_assert(sizeof(BasicBPlusInternalNode<ResourceTimeKey, size>) <= size - sizeof(PageHeader), "Composite B+Tree internal node does not fit in a page"); \
+    static_assert(sizeof(BasicBPlusLeafNode<RollupKey, size>) <= size - sizeof(PageHeader), "Rollup B+Tree leaf does not fit in a page"); \
+    static_assert(sizeof(BasicBPlusInternalNode<RollupKey, size>) <= size - sizeof(PageHeader), "Rollup B+Tree internal node does not fit in a page");
+    CMSE_FOR_EACH_PAGE_SIZE(CMSE_INSTANTIATE_BTREE_ADAPTERS)
+#undef CMSE_INSTANTIATE_BTREE_ADAPTERS
+
+} // namespace cmse::adapter
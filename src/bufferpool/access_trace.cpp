@@ -0,0 +1,115 @@
+/**
+ * access_trace.cpp
+ *
+ * Ring buffer recorder and binary trace file I/O.
+ */
+
+#include "access_trace.h"
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace cmse {
+    namespace bufferpool {
+
+        namespace {
+            constexpr char TRACE_MAGIC[8] = { 'C', 'M', 'S', 'E', 'T', 'R', 'C', '1' };
+
+            size_t RoundUpToPowerOfTwo(size_t n) {
+                size_t p = 1;
+                while (p < n) {
+                    p <<= 1;
+                }
+                return p;
+            }
+        }
+
+        AccessTraceRecorder::AccessTraceRecorder(size_t capacity)
+            : ring_(RoundUpToPowerOfTwo(capacity == 0 ? 1 : capacity)),
+            mask_(ring_.size() - 1),
+            start_(std::chrono::steady_clock::now()) {
+        }
+
+        uint16_t AccessTraceRecorder::CurrentThreadIndex() {
+            static std::atomic<uint16_t> next_index{ 0 };
+            thread_local uint16_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+            return index;
+        }
+
+        std::vector<TraceRecord> AccessTraceRecorder::Snapshot() const {
+            std::vector<TraceRecord> out;
+            uint64_t count = write_pos_ < ring_.size() ? write_pos_ : ring_.size();
+            out.reserve(static_cast<size_t>(count));
+
+            uint64_t first = write_pos_ - count;
+            for (uint64_t i = first; i < write_pos_; ++i) {
+                out.push_back(ring_[i & mask_]);
+            }
+            return out;
+        }
+
+        bool WriteTraceFile(const std::string& path, const std::vector<TraceRecord>& records) {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) {
+                return false;
+            }
+
+            uint32_t record_size = sizeof(TraceRecord);
+            uint32_t reserved = 0;
+            uint64_t count = records.size();
+
+            out.write(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+            out.write(reinterpret_cast<const char*>(&record_size), sizeof(record_size));
+            out.write(reinterpret_cast<const char*>(&reserved), sizeof(reserved));
+            out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+            if (!records.empty()) {
+                out.write(reinterpret_cast<const char*>(records.data()),
+                    static_cast<std::streamsize>(records.size() * sizeof(TraceRecord)));
+            }
+            return static_cast<bool>(out);
+        }
+
+        std::vector<TraceRecord> ReadTraceFile(const std::string& path) {
+            std::ifstream in(path, std::ios::binary);
+            if (!in.is_open()) {
+                throw std::runtime_error("Could not open trace file: " + path);
+            }
+
+            char magic[8];
+            uint32_t record_size = 0;
+            uint32_t reserved = 0;
+            uint64_t count = 0;
+
+            in.read(magic, sizeof(magic));
+            in.read(reinterpret_cast<char*>(&record_size), sizeof(record_size));
+            in.read(reinterpret_cast<char*>(&reserved), sizeof(reserved));
+            in.read(reinterpret_cast<char*>(&count), sizeof(count));
+
+            if (!in || std::memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0) {
+                throw std::runtime_error("Not a CMSE trace file: " + path);
+            }
+            if (record_size != sizeof(TraceRecord)) {
+                throw std::runtime_error("Unsupported trace record size in: " + path);
+            }
+
+            // Validate the declared count against the actual payload before allocating.
+            std::streampos payload_start = in.tellg();
+            in.seekg(0, std::ios::end);
+            uint64_t payload_bytes = static_cast<uint64_t>(in.tellg() - payload_start);
+            in.seekg(payload_start);
+            if (count > payload_bytes / sizeof(TraceRecord)) {
+                throw std::runtime_error("Truncated trace file: " + path);
+            }
+
+            std::vector<TraceRecord> records(static_cast<size_t>(count));
+            if (count > 0) {
+                in.read(reinterpret_cast<char*>(records.data()),
+                    static_cast<std::streamsize>(count * sizeof(TraceRecord)));
+            }
+            return records;
+        }
+
+    } // namespace bufferpool
+} // namespace cmse
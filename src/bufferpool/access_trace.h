@@ -0,0 +1,100 @@
+/**
+ * access_trace.h
+ *
+ * Opt-in recording of buffer pool accesses into a fixed-size ring buffer,
+ * plus a compact binary file format so traces can be replayed offline
+ * (see trace_replay.h and the cmse_trace_replay tool).
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../common/types.h"
+
+namespace cmse {
+    namespace bufferpool {
+
+        enum class TraceOp : uint8_t {
+            Fetch = 0,
+            New = 1,
+            Unpin = 2,
+            Flush = 3,
+            Delete = 4
+        };
+
+        // TraceRecord::flags bits
+        constexpr uint8_t TRACE_FLAG_HIT = 0x1;   // Fetch: page was resident
+        constexpr uint8_t TRACE_FLAG_DIRTY = 0x2; // Unpin: caller passed is_dirty = true
+
+        /**
+         * TraceRecord
+         * One recorded event. 16 bytes, written to trace files as-is (little-endian hosts).
+         */
+        struct TraceRecord {
+            uint64_t timestamp_ns; // Nanoseconds since the recorder was created
+            page_id_t page_id;
+            uint16_t thread_id;    // Small dense per-process thread index
+            TraceOp op;
+            uint8_t flags;
+        };
+        static_assert(sizeof(TraceRecord) == 16, "TraceRecord layout is part of the file format");
+
+        /**
+         * AccessTraceRecorder
+         * Fixed-capacity ring buffer of TraceRecords. When full, the oldest records are overwritten.
+         * NOT thread-safe: BufferPoolManager records while holding its latch.
+         */
+        class AccessTraceRecorder {
+        public:
+            /**
+             * @param capacity Maximum number of records kept (rounded up to a power of two).
+             */
+            explicit AccessTraceRecorder(size_t capacity);
+
+            inline void Record(TraceOp op, page_id_t page_id, uint8_t flags = 0) {
+                TraceRecord& rec = ring_[write_pos_ & mask_];
+                rec.timestamp_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start_).count());
+                rec.page_id = page_id;
+                rec.thread_id = CurrentThreadIndex();
+                rec.op = op;
+                rec.flags = flags;
+                write_pos_++;
+            }
+
+            // Returns the retained records, oldest first.
+            std::vector<TraceRecord> Snapshot() const;
+
+            size_t Capacity() const { return ring_.size(); }
+
+            // Total number of records ever written (including overwritten ones).
+            uint64_t TotalRecorded() const { return write_pos_; }
+
+        private:
+            static uint16_t CurrentThreadIndex();
+
+            std::vector<TraceRecord> ring_;
+            uint64_t mask_;
+            uint64_t write_pos_ = 0;
+            std::chrono::steady_clock::time_point start_;
+        };
+
+        /**
+         * Writes records to a binary trace file.
+         * Layout: "CMSETRC1" | uint32 record_size | uint32 reserved | uint64 count | records...
+         * @return false if the file could not be written.
+         */
+        bool WriteTraceFile(const std::string& path, const std::vector<TraceRecord>& records);
+
+        /**
+         * Reads a binary trace file written by WriteTraceFile.
+         * @throws std::runtime_error if the file is missing or malformed.
+         */
+        std::vector<TraceRecord> ReadTraceFile(const std::string& path);
+
+    } // namespace bufferpool
+} // namespace cmse
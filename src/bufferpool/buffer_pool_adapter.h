@@ -0,0 +1,38 @@
+/**
+ * buffer_pool_adapter.h
+ *
+ * Binds BufferPoolManager to the adapter::BufferPoolAdapter interface used by VersionManager.
+ */
+
+#pragma once
+
+#include "../adapter/bpm_adapter.h"
+#include "buffer_pool_manager.h"
+
+namespace cmse {
+    namespace bufferpool {
+
+        template <size_t PageSize>
+        class BasicBufferPoolManagerAdapter : public adapter::BasicBufferPoolAdapter<PageSize> {
+        public:
+            using Page = BasicPage<PageSize>;
+
+            /**
+             * @param bpm The buffer pool to forward to (not owned).
+             */
+            explicit BasicBufferPoolManagerAdapter(BasicBufferPoolManager<PageSize>* bpm) : bpm_(bpm) {}
+
+            Page* FetchPage(page_id_t page_id) override { return bpm_->FetchPage(page_id); }
+            bool UnpinPage(page_id_t page_id, bool is_dirty) override { return bpm_->UnpinPage(page_id, is_dirty); }
+            Page* NewPage(page_id_t& out_page_id) override { return bpm_->NewPage(out_page_id); }
+            bool FlushPage(page_id_t page_id) override { return bpm_->FlushPage(page_id); }
+            void FlushAll() override { bpm_->FlushAllPages(); }
+
+        private:
+            BasicBufferPoolManager<PageSize>* bpm_;
+        };
+
+        using BufferPoolManagerAdapter = BasicBufferPoolManagerAdapter<PAGE_SIZE>;
+
+    } // namespace bufferpool
+} // namespace cmse
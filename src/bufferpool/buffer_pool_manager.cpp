@@ -5,17 +5,46 @@
  */
 
 #include "buffer_pool_manager.h"
+#include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <new>
 
 namespace cmse {
     namespace bufferpool {
 
-        BufferPoolManager::BufferPoolManager(size_t pool_size, cmse::disk::DiskManager* disk_manager)
-            : pool_size_(pool_size), disk_manager_(disk_manager) {
+        namespace {
+            constexpr size_t CACHE_LINE_SIZE = 64;
+        }
+
+        template <size_t PageSize>
+        BasicBufferPoolManager<PageSize>::FrameSegment::FrameSegment(frame_id_t first, size_t frames, HugePagePolicy huge_pages)
+            : first_frame(first), count(frames), arena(frames * PageSize, huge_pages) {
+            this->frames = static_cast<FrameMeta*>(::operator new(count * sizeof(FrameMeta), std::align_val_t(CACHE_LINE_SIZE)));
+            views = new Page[count];
+            for (size_t i = 0; i < count; ++i) {
+                new (&this->frames[i]) FrameMeta();
+                views[i] = Page(arena.Data() + i * PageSize, &this->frames[i]);
+            }
+        }
+
+        template <size_t PageSize>
+        BasicBufferPoolManager<PageSize>::FrameSegment::~FrameSegment() {
+            delete[] views;
+            ::operator delete(frames, std::align_val_t(CACHE_LINE_SIZE));
+        }
+
+        template <size_t PageSize>
+        BasicBufferPoolManager<PageSize>::BasicBufferPoolManager(size_t pool_size, DiskManager* disk_manager, HugePagePolicy huge_pages)
+            : pool_size_(pool_size), disk_manager_(disk_manager), huge_pages_(huge_pages) {
 
-            // Allocate contiguous memory for pages
-            pages_ = new Page[pool_size_];
+            // Page bytes: one contiguous, page-aligned (huge pages if possible) arena. Frame
+            // descriptors: a separate dense array, so scanning pins or dirty bits never strides
+            // through the 4KB pages.
+            segments_.push_back(std::make_unique<FrameSegment>(0, pool_size_, huge_pages_));
+            for (size_t i = 0; i < pool_size_; ++i) {
+                pages_.push_back(&segments_.back()->views[i]);
+            }
 
             // Initialize LRU Replacer
             replacer_ = new LRUReplacer(pool_size);
@@ -26,71 +55,98 @@ namespace cmse {
             }
         }
 
-        BufferPoolManager::~BufferPoolManager() {
+        template <size_t PageSize>
+        BasicBufferPoolManager<PageSize>::~BasicBufferPoolManager() {
             FlushAllPages();
-            delete[] pages_;
             delete replacer_;
         }
 
-        bool BufferPoolManager::FindFreeFrame(frame_id_t* frame_id) {
-            // 1. Try to get from free list first (cheapest)
+        template <size_t PageSize>
+        void BasicBufferPoolManager<PageSize>::EvictFrame(frame_id_t frame_id) {
+            Page* victim_page = pages_[frame_id];
+            FrameMeta& victim = Meta(frame_id);
+
+            // If the page in this victim frame is dirty, we MUST write it to disk.
+            if (victim.is_dirty) {
+                // BUG FIX: Use GetHeader() to get the start of the raw 4KB block.
+                // Previously used GetData(), which skipped the header and caused offset errors on disk.
+                disk_manager_->WritePage(victim.page_id, reinterpret_cast<char*>(victim_page->GetHeader()));
+                MarkClean(victim);
+                counters_.Add(PoolCounter::EvictionsDirty);
+                counters_.Add(PoolCounter::BytesWritten, PageSize);
+            }
+            else {
+                counters_.Add(PoolCounter::EvictionsClean);
+            }
+
+            // Remove the old mapping from the page table
+            page_table_.erase(victim.page_id);
+
+            // Reset memory for the new user
+            victim_page->ResetMemory();
+            victim = FrameMeta();
+        }
+
+        template <size_t PageSize>
+        bool BasicBufferPoolManager<PageSize>::FindFreeFrame(frame_id_t* frame_id) {
+            // 1. Try to get from free list first (cheapest). Retired frames never return to it.
             if (!free_list_.empty()) {
                 *frame_id = free_list_.front();
                 free_list_.pop_front();
+                counters_.Add(PoolCounter::FreeListHits);
                 return true;
             }
 
             // 2. Try to get a victim from LRU Replacer
             if (replacer_->Victim(frame_id)) {
                 // We found a victim frame.
-                Page* victim_page = &pages_[*frame_id];
-
-                // If the page in this victim frame is dirty, we MUST write it to disk.
-                if (victim_page->is_dirty_) {
-                    // BUG FIX: Use GetHeader() to get the start of the raw 4KB block.
-                    // Previously used GetData(), which skipped the header and caused offset errors on disk.
-                    disk_manager_->WritePage(victim_page->GetPageId(), reinterpret_cast<char*>(victim_page->GetHeader()));
-                    victim_page->is_dirty_ = false;
-                }
-
-                // Remove the old mapping from the page table
-                page_table_.erase(victim_page->GetPageId());
-
-                // Reset memory for the new user
-                victim_page->ResetMemory();
-                victim_page->pin_count_ = 0;
-                victim_page->is_dirty_ = false;
-
+                EvictFrame(*frame_id);
                 return true;
             }
 
             // No free frame available (All pages are pinned)
+            counters_.Add(PoolCounter::PinWaits);
             return false;
         }
 
-        Page* BufferPoolManager::FetchPage(page_id_t page_id) {
-            std::lock_guard<std::mutex> lock(latch_);
+        template <size_t PageSize>
+        BasicPage<PageSize>* BasicBufferPoolManager<PageSize>::FetchPage(page_id_t page_id) {
+            CMSE_LATENCY_SCOPE(latencies_.fetch_page);
+            std::lock_guard<utils::Latch> lock(latch_);
+
+            if (mrc_estimator_) {
+                mrc_estimator_->Access(page_id);
+            }
 
             // 1. Check if page is already in buffer pool
             if (page_table_.find(page_id) != page_table_.end()) {
                 frame_id_t frame_id = page_table_[page_id];
-                Page* page = &pages_[frame_id];
+                Page* page = pages_[frame_id];
 
                 // Mark usage in replacer (Pin it so it won't be evicted)
                 replacer_->Pin(frame_id);
-                page->pin_count_++;
+                pinned_frames_ += Meta(frame_id).pin_count++ == 0 ? 1 : 0;
+                Meta(frame_id).prefetched = false;
 
+                counters_.Add(PoolCounter::Hits);
+                if (trace_) {
+                    trace_->Record(TraceOp::Fetch, page_id, TRACE_FLAG_HIT);
+                }
                 return page;
             }
 
             // 2. Page not in memory, find a frame for it
+            counters_.Add(PoolCounter::Misses);
+            if (trace_) {
+                trace_->Record(TraceOp::Fetch, page_id);
+            }
             frame_id_t free_frame_id;
             if (!FindFreeFrame(&free_frame_id)) {
                 return nullptr; // Buffer full and all pages pinned
             }
 
             // 3. Read page from disk
-            Page* page = &pages_[free_frame_id];
+            Page* page = pages_[free_frame_id];
 
             // Safety: Reset memory before reading
             page->ResetMemory();
@@ -103,11 +159,14 @@ namespace cmse {
             // We should cast Page* to char* or add a friend/getter for raw data.
             // For now, let's assume Page class exposes 'GetHeader()' which is the start of data.
             disk_manager_->ReadPage(page_id, reinterpret_cast<char*>(page->GetHeader()));
+            counters_.Add(PoolCounter::BytesRead, PageSize);
 
             // 4. Setup metadata
             page->GetHeader()->page_id = page_id; // Ensure ID matches
-            page->pin_count_ = 1;
-            page->is_dirty_ = false;
+            Meta(free_frame_id).page_id = page_id;
+            Meta(free_frame_id).pin_count = 1;
+            Meta(free_frame_id).is_dirty = false;
+            pinned_frames_++;
 
             // 5. Update mappings
             page_table_[page_id] = free_frame_id;
@@ -118,8 +177,10 @@ namespace cmse {
             return page;
         }
 
-        Page* BufferPoolManager::NewPage(page_id_t& page_id) {
-            std::lock_guard<std::mutex> lock(latch_);
+        template <size_t PageSize>
+        BasicPage<PageSize>* BasicBufferPoolManager<PageSize>::NewPage(page_id_t& page_id) {
+            CMSE_LATENCY_SCOPE(latencies_.new_page);
+            std::lock_guard<utils::Latch> lock(latch_);
 
             // 1. Find a frame for the new page
             frame_id_t free_frame_id;
@@ -129,9 +190,13 @@ namespace cmse {
 
             // 2. Allocate a new page ID from disk manager
             page_id = disk_manager_->AllocatePage();
+            counters_.Add(PoolCounter::NewPages);
+            if (trace_) {
+                trace_->Record(TraceOp::New, page_id);
+            }
 
             // 3. Setup the page object
-            Page* page = &pages_[free_frame_id];
+            Page* page = pages_[free_frame_id];
             page->ResetMemory();
 
             // Initialize Header
@@ -140,8 +205,10 @@ namespace cmse {
             page->GetHeader()->key_count = 0;
             page->GetHeader()->creation_version = 0; // TODO: Implement Versioning Logic later
 
-            page->pin_count_ = 1;
-            page->is_dirty_ = true; // New pages are implicitly dirty until saved? usually yes.
+            Meta(free_frame_id).page_id = page_id;
+            Meta(free_frame_id).pin_count = 1;
+            pinned_frames_++;
+            MarkDirty(Meta(free_frame_id)); // New pages are implicitly dirty until saved? usually yes.
 
             // 4. Update mappings
             page_table_[page_id] = free_frame_id;
@@ -152,55 +219,76 @@ namespace cmse {
             return page;
         }
 
-        bool BufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty) {
-            std::lock_guard<std::mutex> lock(latch_);
+        template <size_t PageSize>
+        bool BasicBufferPoolManager<PageSize>::UnpinPage(page_id_t page_id, bool is_dirty) {
+            CMSE_LATENCY_SCOPE(latencies_.unpin_page);
+            std::lock_guard<utils::Latch> lock(latch_);
 
             if (page_table_.find(page_id) == page_table_.end()) {
                 return false;
             }
 
             frame_id_t frame_id = page_table_[page_id];
-            Page* page = &pages_[frame_id];
+            FrameMeta& frame = Meta(frame_id);
 
-            if (page->pin_count_ <= 0) {
+            if (frame.pin_count <= 0) {
                 return false;
             }
 
             // Decrement pin count
-            page->pin_count_--;
+            frame.pin_count--;
+
+            if (trace_) {
+                trace_->Record(TraceOp::Unpin, page_id, is_dirty ? TRACE_FLAG_DIRTY : 0);
+            }
 
             // Update dirty flag
             if (is_dirty) {
-                page->is_dirty_ = true;
+                MarkDirty(frame);
             }
 
-            // If pin count reaches 0, the page is candidate for eviction
-            if (page->pin_count_ == 0) {
-                replacer_->Unpin(frame_id);
+            // If pin count reaches 0, the page is candidate for eviction. A frame retired by a
+            // shrink is drained right away instead.
+            if (frame.pin_count == 0) {
+                pinned_frames_--;
+                if (static_cast<size_t>(frame_id) >= pool_size_) {
+                    EvictFrame(frame_id);
+                    ReleaseDrainedSegments();
+                }
+                else {
+                    replacer_->Unpin(frame_id);
+                }
             }
 
             return true;
         }
 
-        bool BufferPoolManager::FlushPage(page_id_t page_id) {
-            std::lock_guard<std::mutex> lock(latch_);
+        template <size_t PageSize>
+        bool BasicBufferPoolManager<PageSize>::FlushPage(page_id_t page_id) {
+            CMSE_LATENCY_SCOPE(latencies_.flush_page);
+            std::lock_guard<utils::Latch> lock(latch_);
 
             if (page_table_.find(page_id) == page_table_.end()) {
                 return false;
             }
 
             frame_id_t frame_id = page_table_[page_id];
-            Page* page = &pages_[frame_id];
+            Page* page = pages_[frame_id];
 
             // Use GetHeader() to get the raw buffer start pointer
             disk_manager_->WritePage(page_id, reinterpret_cast<char*>(page->GetHeader()));
-            page->is_dirty_ = false;
+            MarkClean(Meta(frame_id));
+            counters_.Add(PoolCounter::BytesWritten, PageSize);
+            if (trace_) {
+                trace_->Record(TraceOp::Flush, page_id);
+            }
 
             return true;
         }
 
-        bool BufferPoolManager::DeletePage(page_id_t page_id) {
-            std::lock_guard<std::mutex> lock(latch_);
+        template <size_t PageSize>
+        bool BasicBufferPoolManager<PageSize>::DeletePage(page_id_t page_id) {
+            std::lock_guard<utils::Latch> lock(latch_);
 
             // 1. If page is not in memory, consider it "done" (or handle deallocation on disk if needed)
             if (page_table_.find(page_id) == page_table_.end()) {
@@ -208,10 +296,10 @@ namespace cmse {
             }
 
             frame_id_t frame_id = page_table_[page_id];
-            Page* page = &pages_[frame_id];
+            Page* page = pages_[frame_id];
 
             // 2. If pinned, cannot delete
-            if (page->pin_count_ > 0) {
+            if (Meta(frame_id).pin_count > 0) {
                 return false;
             }
 
@@ -221,32 +309,345 @@ namespace cmse {
 
             // 4. Remove from Page Table
             page_table_.erase(page_id);
+            if (trace_) {
+                trace_->Record(TraceOp::Delete, page_id);
+            }
 
             // 5. Reset Metadata
             page->ResetMemory();
-            page->pin_count_ = 0;
-            page->is_dirty_ = false;
+            MarkClean(Meta(frame_id));
+            Meta(frame_id) = FrameMeta();
             page->GetHeader()->page_id = INVALID_PAGE_ID;
 
-            // 6. Return frame to Free List
-            free_list_.push_back(frame_id);
+            // 6. Return frame to Free List (unless a shrink retired it)
+            if (static_cast<size_t>(frame_id) < pool_size_) {
+                free_list_.push_back(frame_id);
+            }
+            else {
+                ReleaseDrainedSegments();
+            }
 
             // Note: We might want to call disk_manager_->DeallocatePage(page_id) if supported.
             return true;
         }
 
-        void BufferPoolManager::FlushAllPages() {
-            // We iterate over the page table to flush only valid pages
-            std::lock_guard<std::mutex> lock(latch_);
+        template <size_t PageSize>
+        void BasicBufferPoolManager<PageSize>::FlushAllPages() {
+            // Sweep the dense descriptor arrays; only dirty frames touch their page bytes.
+            std::lock_guard<utils::Latch> lock(latch_);
+
+            for (const auto& segment : segments_) {
+                for (size_t i = 0; i < segment->count; ++i) {
+                    FrameMeta& frame = segment->frames[i];
+                    if (frame.is_dirty && frame.page_id != INVALID_PAGE_ID) {
+                        disk_manager_->WritePage(frame.page_id, segment->arena.Data() + i * PageSize);
+                        MarkClean(frame);
+                        counters_.Add(PoolCounter::BytesWritten, PageSize);
+                    }
+                }
+            }
+        }
+
+        // =================================================================
+        // Warm-up
+        // =================================================================
 
-            for (auto const& [pid, fid] : page_table_) {
-                Page* page = &pages_[fid];
-                if (page->is_dirty_) {
-                    disk_manager_->WritePage(pid, reinterpret_cast<char*>(page->GetHeader()));
-                    page->is_dirty_ = false;
+        template <size_t PageSize>
+        std::vector<page_id_t> BasicBufferPoolManager<PageSize>::GetResidentPageIds() {
+            std::lock_guard<utils::Latch> lock(latch_);
+            std::vector<page_id_t> page_ids;
+            page_ids.reserve(page_table_.size());
+
+            // Pinned pages are in use right now: hottest of all.
+            for (const auto& entry : page_table_) {
+                if (Meta(entry.second).pin_count > 0) {
+                    page_ids.push_back(entry.first);
                 }
             }
+            for (frame_id_t frame_id : replacer_->RecencyOrder()) {
+                page_ids.push_back(Meta(frame_id).page_id);
+            }
+            return page_ids;
         }
 
+        template <size_t PageSize>
+        bool BasicBufferPoolManager<PageSize>::PrefetchPages(const std::vector<page_id_t>& page_ids, size_t* loaded) {
+            std::lock_guard<utils::Latch> lock(latch_);
+            size_t count = 0;
+            bool room = true;
+
+            for (page_id_t page_id : page_ids) {
+                if (page_id == INVALID_PAGE_ID || page_table_.find(page_id) != page_table_.end()) {
+                    continue;
+                }
+                if (free_list_.empty()) {
+                    room = false; // Never displace pages that live traffic brought in
+                    break;
+                }
+                frame_id_t frame_id = free_list_.front();
+                free_list_.pop_front();
+
+                Page* page = pages_[frame_id];
+                disk_manager_->ReadPage(page_id, reinterpret_cast<char*>(page->GetHeader()));
+                counters_.Add(PoolCounter::Prefetched);
+                counters_.Add(PoolCounter::BytesRead, PageSize);
+                page->GetHeader()->page_id = page_id;
+
+                FrameMeta& frame = Meta(frame_id);
+                frame.page_id = page_id;
+                frame.pin_count = 0;
+                frame.is_dirty = false;
+                frame.prefetched = true;
+                page_table_[page_id] = frame_id;
+                replacer_->Demote(frame_id); // Behind every page traffic has used
+                count++;
+            }
+            if (loaded != nullptr) {
+                *loaded = count;
+            }
+            return room;
+        }
+
+        template <size_t PageSize>
+        void BasicBufferPoolManager<PageSize>::RankPrefetchedPages(const std::vector<page_id_t>& hottest_first) {
+            std::lock_guard<utils::Latch> lock(latch_);
+
+            // Demoting hottest first leaves the coldest at the LRU end. Pages fetched since
+            // the prefetch have real recency and stay where they are.
+            for (page_id_t page_id : hottest_first) {
+                auto it = page_table_.find(page_id);
+                if (it != page_table_.end() && Meta(it->second).prefetched && Meta(it->second).pin_count == 0) {
+                    replacer_->Demote(it->second);
+                }
+            }
+        }
+
+        // =================================================================
+        // Resizing
+        // =================================================================
+
+        template <size_t PageSize>
+        bool BasicBufferPoolManager<PageSize>::ResizePool(size_t new_size) {
+            if (new_size == 0) {
+                return false;
+            }
+
+            std::unique_lock<utils::Latch> lock(latch_);
+            size_t old_size = pool_size_;
+            if (new_size > old_size) {
+                // Frames of segments that are still mapped (retired by an earlier shrink) come back
+                // first; only the rest needs a new segment.
+                size_t mapped = pages_.size();
+                size_t reuse_end = std::min(new_size, mapped);
+                size_t grow = new_size - reuse_end;
+                std::unique_ptr<FrameSegment> segment;
+                if (grow > 0) {
+                    // Map and zero the new arena without holding the latch.
+                    lock.unlock();
+                    segment = std::make_unique<FrameSegment>(static_cast<frame_id_t>(mapped), grow, huge_pages_);
+                    lock.lock();
+                    if (pages_.size() != mapped || pool_size_ != old_size) {
+                        return false; // Another resize ran meanwhile
+                    }
+                }
+
+                page_table_.reserve(new_size);
+                pool_size_ = new_size;
+                for (size_t fid = old_size; fid < reuse_end; ++fid) {
+                    // Drained frames are free again; an undrained unpinned one rejoins the
+                    // replacer; a pinned one gets there on its last unpin, like any active frame.
+                    const FrameMeta& frame = Meta(static_cast<frame_id_t>(fid));
+                    if (frame.page_id == INVALID_PAGE_ID) {
+                        free_list_.push_back(static_cast<frame_id_t>(fid));
+                    }
+                    else if (frame.pin_count == 0) {
+                        replacer_->Unpin(static_cast<frame_id_t>(fid));
+                    }
+                }
+                if (segment) {
+                    for (size_t i = 0; i < segment->count; ++i) {
+                        pages_.push_back(&segment->views[i]);
+                        free_list_.push_back(static_cast<frame_id_t>(mapped + i));
+                    }
+                    segments_.push_back(std::move(segment));
+                }
+                return true;
+            }
+
+            // Shrink. Step 1 (one short hold): retire the tail. Its frames leave the free list
+            // and the replacer, so nothing new is loaded into them.
+            pool_size_ = new_size;
+            free_list_.remove_if([new_size](frame_id_t fid) { return static_cast<size_t>(fid) >= new_size; });
+            for (size_t fid = new_size; fid < old_size; ++fid) {
+                replacer_->Pin(static_cast<frame_id_t>(fid));
+            }
+
+            // Step 2 (batches): evict the unpinned pages of retired frames. Between batches,
+            // fetches proceed; one that hits a retired frame pins it, and the unpin drains it.
+            for (size_t batch = new_size; batch < old_size; batch += RESIZE_BATCH) {
+                if (batch != new_size) {
+                    lock.unlock();
+                    lock.lock();
+                }
+                size_t end = std::min(std::min(old_size, batch + RESIZE_BATCH), pages_.size());
+                for (size_t fid = std::max(batch, pool_size_); fid < end; ++fid) {
+                    FrameMeta& frame = Meta(static_cast<frame_id_t>(fid));
+                    if (frame.page_id != INVALID_PAGE_ID && frame.pin_count == 0) {
+                        EvictFrame(static_cast<frame_id_t>(fid));
+                    }
+                }
+            }
+
+            // Step 3: unmap the segments that are now empty.
+            ReleaseDrainedSegments();
+            return true;
+        }
+
+        template <size_t PageSize>
+        void BasicBufferPoolManager<PageSize>::ReleaseDrainedSegments() {
+            while (segments_.size() > 1) {
+                FrameSegment& last = *segments_.back();
+                if (static_cast<size_t>(last.first_frame) < pool_size_) {
+                    return;
+                }
+                for (size_t i = 0; i < last.count; ++i) {
+                    if (last.frames[i].page_id != INVALID_PAGE_ID || last.frames[i].pin_count > 0) {
+                        return;
+                    }
+                }
+                pages_.resize(last.first_frame);
+                segments_.pop_back();
+            }
+        }
+
+        template <size_t PageSize>
+        size_t BasicBufferPoolManager<PageSize>::GetPoolSize() {
+            std::lock_guard<utils::Latch> lock(latch_);
+            return pool_size_;
+        }
+
+        template <size_t PageSize>
+        ArenaBacking BasicBufferPoolManager<PageSize>::GetArenaBacking() {
+            std::lock_guard<utils::Latch> lock(latch_);
+            return segments_.front()->arena.Backing();
+        }
+
+        template <size_t PageSize>
+        BufferPoolStats BasicBufferPoolManager<PageSize>::GetStats() {
+            BufferPoolStats stats;
+            stats.hits = counters_.Sum(PoolCounter::Hits);
+            stats.misses = counters_.Sum(PoolCounter::Misses);
+            stats.new_pages = counters_.Sum(PoolCounter::NewPages);
+            stats.free_list_hits = counters_.Sum(PoolCounter::FreeListHits);
+            stats.evictions_clean = counters_.Sum(PoolCounter::EvictionsClean);
+            stats.evictions_dirty = counters_.Sum(PoolCounter::EvictionsDirty);
+            stats.pin_waits = counters_.Sum(PoolCounter::PinWaits);
+            stats.bytes_read = counters_.Sum(PoolCounter::BytesRead);
+            stats.bytes_written = counters_.Sum(PoolCounter::BytesWritten);
+            stats.prefetched = counters_.Sum(PoolCounter::Prefetched);
+
+            std::lock_guard<utils::Latch> lock(latch_);
+            stats.pool_size = pool_size_;
+            stats.resident_pages = page_table_.size();
+            stats.free_frames = free_list_.size();
+            stats.mapped_frames = pages_.size();
+            stats.pinned_frames = pinned_frames_;
+            stats.dirty_frames = dirty_frames_;
+            return stats;
+        }
+
+        template <size_t PageSize>
+        void BasicBufferPoolManager<PageSize>::ResetStats() {
+            counters_.Reset();
+#ifdef CMSE_LATENCY_HISTOGRAMS
+            latencies_.fetch_page.reset();
+            latencies_.new_page.reset();
+            latencies_.unpin_page.reset();
+            latencies_.flush_page.reset();
+#endif
+        }
+
+        template <size_t PageSize>
+        void BasicBufferPoolManager<PageSize>::EnableAccessTrace(size_t capacity) {
+            auto recorder = std::make_unique<AccessTraceRecorder>(capacity);
+            std::lock_guard<utils::Latch> lock(latch_);
+            trace_ = std::move(recorder);
+        }
+
+        template <size_t PageSize>
+        void BasicBufferPoolManager<PageSize>::DisableAccessTrace() {
+            std::unique_ptr<AccessTraceRecorder> old;
+            {
+                std::lock_guard<utils::Latch> lock(latch_);
+                old = std::move(trace_);
+            }
+            // 'old' is freed outside the latch.
+        }
+
+        template <size_t PageSize>
+        std::vector<TraceRecord> BasicBufferPoolManager<PageSize>::GetAccessTrace() {
+            std::lock_guard<utils::Latch> lock(latch_);
+            if (!trace_) {
+                return {};
+            }
+            return trace_->Snapshot();
+        }
+
+        template <size_t PageSize>
+        bool BasicBufferPoolManager<PageSize>::SaveAccessTrace(const std::string& path) {
+            std::vector<TraceRecord> records;
+            {
+                std::lock_guard<utils::Latch> lock(latch_);
+                if (!trace_) {
+                    return false;
+                }
+                records = trace_->Snapshot();
+            }
+            return WriteTraceFile(path, records);
+        }
+
+        template <size_t PageSize>
+        void BasicBufferPoolManager<PageSize>::EnableMissRatioEstimation(double sampling_rate, size_t max_samples) {
+            auto estimator = std::make_unique<ShardsMrcEstimator>(sampling_rate, max_samples);
+            std::lock_guard<utils::Latch> lock(latch_);
+            mrc_estimator_ = std::move(estimator);
+        }
+
+        template <size_t PageSize>
+        void BasicBufferPoolManager<PageSize>::DisableMissRatioEstimation() {
+            std::unique_ptr<ShardsMrcEstimator> old;
+            {
+                std::lock_guard<utils::Latch> lock(latch_);
+                old = std::move(mrc_estimator_);
+            }
+        }
+
+        template <size_t PageSize>
+        MissRatioCurve BasicBufferPoolManager<PageSize>::GetEstimatedMissRatioCurve(const std::vector<size_t>& cache_sizes) {
+            std::lock_guard<utils::Latch> lock(latch_);
+            if (!mrc_estimator_) {
+                return {};
+            }
+            return mrc_estimator_->Curve(cache_sizes);
+        }
+
+        template <size_t PageSize>
+        std::vector<utils::LatencySummary> BasicBufferPoolManager<PageSize>::GetLatencySummaries() const {
+#ifdef CMSE_LATENCY_HISTOGRAMS
+            return {
+                latencies_.fetch_page.summarize(),
+                latencies_.new_page.summarize(),
+                latencies_.unpin_page.summarize(),
+                latencies_.flush_page.summarize(),
+            };
+#else
+            return {};
+#endif
+        }
+
+#define CMSE_INSTANTIATE_BUFFER_POOL_MANAGER(size) template class BasicBufferPoolManager<size>;
+        CMSE_FOR_EACH_PAGE_SIZE(CMSE_INSTANTIATE_BUFFER_POOL_MANAGER)
+#undef CMSE_INSTANTIATE_BUFFER_POOL_MANAGER
+
     } // namespace bufferpool
 } // namespace cmse
\ No newline at end of file
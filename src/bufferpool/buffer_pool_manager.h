@@ -3,36 +3,58 @@
  *
  * BufferPoolManager reads/writes pages to/from disk via DiskManager and caches them in memory.
  * It uses LRUReplacer to keep track of unpinned pages and decides which page to evict.
+ * Page bytes are kept in one aligned arena and frame metadata (pins, dirty bits) in a separate
+ * dense array; the Page objects handed out are views over both.
  */
 
 #pragma once
 
 #include <list>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "../common/types.h"
 #include "../disk/disk_manager.h"
 #include "../page/page.h"
+#include "../utils/latch.h"
+#include "../utils/latency_histogram.h"
+#include "access_trace.h"
+#include "buffer_pool_stats.h"
+#include "frame_arena.h"
 #include "lru_replacer.h" // <--- Include the new LRU Replacer
+#include "shards_mrc.h"
 
 namespace cmse {
     namespace bufferpool {
 
-        class BufferPoolManager {
+        /**
+         * BasicBufferPoolManager
+         * Caches the pages of one file. The page size is a template parameter shared with the
+         * file's disk manager and the page views handed out, so frames, I/O and views agree on
+         * it at compile time. BufferPoolManager is the PAGE_SIZE pool; instantiated (in
+         * buffer_pool_manager.cpp) for CMSE_FOR_EACH_PAGE_SIZE.
+         */
+        template <size_t PageSize>
+        class BasicBufferPoolManager {
         public:
+            using Page = BasicPage<PageSize>;
+            using DiskManager = disk::BasicDiskManager<PageSize>;
+
             /**
              * Creates a new BufferPoolManager.
              * @param pool_size The size of the buffer pool.
              * @param disk_manager The disk manager.
+             * @param huge_pages Whether the frame arena may use huge pages (see FrameArena).
              */
-            BufferPoolManager(size_t pool_size, cmse::disk::DiskManager* disk_manager);
+            BasicBufferPoolManager(size_t pool_size, DiskManager* disk_manager, HugePagePolicy huge_pages = HugePagePolicy::Auto);
 
             /**
              * Destroys the BufferPoolManager.
              */
-            ~BufferPoolManager();
+            ~BasicBufferPoolManager();
 
             /**
              * Fetches the requested page from the buffer pool.
@@ -75,6 +97,114 @@ namespace cmse {
              */
             void FlushAllPages();
 
+            /**
+             * Lists the resident pages, hottest first: pinned pages, then the replacer's
+             * candidates from most to least recently used. This is the order a warm-up should
+             * keep when the list is longer than the pool (see ResidentSetPersister).
+             */
+            std::vector<page_id_t> GetResidentPageIds();
+
+            /**
+             * Loads pages that are not resident into free frames, without pinning them and
+             * without evicting anything. They enter the replacer at the LRU end. The whole batch is read under one latch hold, so
+             * callers (WarmupLoader) pass small sorted batches. Counted as Prefetched, not as
+             * misses.
+             * @param[out] loaded Number of pages read from disk (optional).
+             * @return false if it stopped because the free list ran out.
+             */
+            bool PrefetchPages(const std::vector<page_id_t>& page_ids, size_t* loaded = nullptr);
+
+            /**
+             * Orders the prefetched pages that have not been fetched since by the given ranking
+             * (hottest first), all of them behind the pages traffic has used. A sorted
+             * prefetch loses the snapshot's recency order; this puts it back.
+             */
+            void RankPrefetchedPages(const std::vector<page_id_t>& hottest_first);
+
+            /**
+             * Changes the number of frames while the pool is in use.
+             * Growing maps a new arena segment (outside the latch) and puts its frames on the
+             * free list. Shrinking retires the frames with id >= new_size: they leave the free
+             * list and the replacer at once, then unpinned ones are evicted (dirty pages written
+             * back) in batches of RESIZE_BATCH frames per latch hold, so concurrent fetches only
+             * wait for one batch. Frames still pinned are evicted by their last UnpinPage. A
+             * grown segment's memory is released once every frame in it is drained; the
+             * construction-time segment stays mapped.
+             * @param new_size The number of frames to keep (at least 1).
+             * @return false if new_size is 0 or a new segment could not be allocated.
+             */
+            bool ResizePool(size_t new_size);
+
+            /**
+             * @return The current number of frames (the target of the last ResizePool).
+             */
+            size_t GetPoolSize();
+
+            /**
+             * @return What backs the first frame arena (huge pages, regular pages or heap).
+             */
+            ArenaBacking GetArenaBacking();
+
+            /**
+             * Returns a snapshot of the pool counters and gauges.
+             * Counters are read without taking the pool latch; gauges copy a few sizes and
+             * counters under it (no sweep over the frames).
+             */
+            BufferPoolStats GetStats();
+
+            /**
+             * Resets all cumulative counters to zero (gauges are unaffected).
+             */
+            void ResetStats();
+
+            /**
+             * Returns p50/p99/p999 latency for FetchPage, NewPage, UnpinPage and FlushPage.
+             * Empty unless built with CMSE_ENABLE_LATENCY_HISTOGRAMS.
+             */
+            std::vector<utils::LatencySummary> GetLatencySummaries() const;
+
+            /**
+             * Starts recording Fetch/New/Unpin/Flush/Delete events into a ring buffer.
+             * Replaces any trace that is already being recorded.
+             * @param capacity Number of most recent events to retain.
+             */
+            void EnableAccessTrace(size_t capacity);
+
+            /**
+             * Stops recording and discards the ring buffer.
+             */
+            void DisableAccessTrace();
+
+            /**
+             * @return The retained trace records, oldest first (empty if tracing is off).
+             */
+            std::vector<TraceRecord> GetAccessTrace();
+
+            /**
+             * Writes the retained trace to a binary file readable by cmse_trace_replay.
+             * @return false if tracing is off or the file could not be written.
+             */
+            bool SaveAccessTrace(const std::string& path);
+
+            /**
+             * Starts online miss-ratio curve estimation over FetchPage accesses (SHARDS sampling).
+             * Replaces any running estimator, discarding its history.
+             * @param sampling_rate Initial fraction of pages sampled (e.g. 0.01).
+             * @param max_samples Upper bound on tracked pages (bounds memory; lowers the rate if hit).
+             */
+            void EnableMissRatioEstimation(double sampling_rate = 0.01, size_t max_samples = 8192);
+
+            /**
+             * Stops miss-ratio curve estimation.
+             */
+            void DisableMissRatioEstimation();
+
+            /**
+             * Estimated LRU miss ratio of this workload for hypothetical pool sizes.
+             * @return An empty curve if estimation is off.
+             */
+            MissRatioCurve GetEstimatedMissRatioCurve(const std::vector<size_t>& cache_sizes);
+
         private:
             /**
              * Helper to find a free frame.
@@ -84,9 +214,57 @@ namespace cmse {
              */
             bool FindFreeFrame(frame_id_t* frame_id);
 
-            size_t pool_size_;
-            cmse::disk::DiskManager* disk_manager_;
-            Page* pages_; // Array of pages
+            /**
+             * Writes back (if dirty) and unmaps the unpinned page held by 'frame_id', leaving the
+             * frame empty. Does not touch the free list or the replacer.
+             */
+            void EvictFrame(frame_id_t frame_id);
+
+            /**
+             * Releases tail segments whose frames are all retired and drained.
+             */
+            void ReleaseDrainedSegments();
+
+            // Frame descriptors of a frame are reached through its Page view.
+            inline FrameMeta& Meta(frame_id_t frame_id) { return *pages_[frame_id]->meta_; }
+
+            // Set / clear a frame's dirty bit, keeping dirty_frames_ in step.
+            inline void MarkDirty(FrameMeta& frame) {
+                dirty_frames_ += frame.is_dirty ? 0 : 1;
+                frame.is_dirty = true;
+            }
+            inline void MarkClean(FrameMeta& frame) {
+                dirty_frames_ -= frame.is_dirty ? 1 : 0;
+                frame.is_dirty = false;
+            }
+
+            /**
+             * FrameSegment
+             * Frames [first_frame, first_frame + count): page bytes in one arena and a dense,
+             * cache-line aligned descriptor array. The initial pool is one segment; each grow
+             * adds one. Metadata and page bytes live apart so sweeps over frames stay within a
+             * few cache lines.
+             */
+            struct FrameSegment {
+                FrameSegment(frame_id_t first, size_t frames, HugePagePolicy huge_pages);
+                ~FrameSegment();
+
+                frame_id_t first_frame;
+                size_t count;
+                FrameArena arena;    // count pages, PAGE_SIZE-aligned (PageSize bytes each)
+                FrameMeta* frames;   // count descriptors
+                Page* views;         // count page views
+            };
+
+            static constexpr size_t RESIZE_BATCH = 64;
+
+            size_t pool_size_;        // Active frames: ids [0, pool_size_)
+            DiskManager* disk_manager_;
+            HugePagePolicy huge_pages_;
+
+            // Segments in frame id order; frames past pool_size_ are retiring until drained.
+            std::vector<std::unique_ptr<FrameSegment>> segments_;
+            std::vector<Page*> pages_;    // Frame id -> page view (views never move)
             LRUReplacer* replacer_; // <--- The LRU Replacement Policy
 
             // List of free frames that do not hold any page data.
@@ -95,8 +273,38 @@ namespace cmse {
             // Map from PageId to FrameId
             std::unordered_map<page_id_t, frame_id_t> page_table_;
 
-            std::mutex latch_; // Concurrency protection
+            // Frames with pin_count > 0 / is_dirty set, maintained where those change (latch_).
+            size_t pinned_frames_ = 0;
+            size_t dirty_frames_ = 0;
+
+            utils::Latch latch_{ "buffer_pool" }; // Concurrency protection
+
+            // Per-thread event counters (hits, misses, evictions, I/O bytes).
+            StripedCounters counters_;
+
+            // Opt-in access trace (nullptr when disabled). Written only while holding latch_.
+            std::unique_ptr<AccessTraceRecorder> trace_;
+
+            // Opt-in SHARDS miss-ratio curve estimator (nullptr when disabled). Guarded by latch_.
+            std::unique_ptr<ShardsMrcEstimator> mrc_estimator_;
+
+#ifdef CMSE_LATENCY_HISTOGRAMS
+            // Per-operation latency histograms (includes time spent waiting for latch_).
+            struct OperationLatencies {
+                utils::LatencyRecorder fetch_page{ "fetch_page" };
+                utils::LatencyRecorder new_page{ "new_page" };
+                utils::LatencyRecorder unpin_page{ "unpin_page" };
+                utils::LatencyRecorder flush_page{ "flush_page" };
+            };
+            OperationLatencies latencies_;
+#endif
         };
 
+#define CMSE_EXTERN_BUFFER_POOL_MANAGER(size) extern template class BasicBufferPoolManager<size>;
+        CMSE_FOR_EACH_PAGE_SIZE(CMSE_EXTERN_BUFFER_POOL_MANAGER)
+#undef CMSE_EXTERN_BUFFER_POOL_MANAGER
+
+        using BufferPoolManager = BasicBufferPoolManager<PAGE_SIZE>;
+
     } // namespace bufferpool
 } // namespace cmse
\ No newline at end of file
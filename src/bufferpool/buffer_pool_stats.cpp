@@ -0,0 +1,99 @@
+/**
+ * buffer_pool_stats.cpp
+ *
+ * Implementation of the striped counters and the Prometheus text renderer.
+ */
+
+#include "buffer_pool_stats.h"
+
+#include <sstream>
+
+namespace cmse {
+    namespace bufferpool {
+
+        StripedCounters::StripedCounters() {
+            Reset();
+        }
+
+        size_t StripedCounters::ShardIndex() {
+            static std::atomic<size_t> next_shard{ 0 };
+            thread_local size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % NUM_SHARDS;
+            return shard;
+        }
+
+        uint64_t StripedCounters::Sum(PoolCounter counter) const {
+            uint64_t total = 0;
+            for (const auto& shard : shards_) {
+                total += shard.values[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+
+        void StripedCounters::Reset() {
+            for (auto& shard : shards_) {
+                for (auto& value : shard.values) {
+                    value.store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        namespace {
+
+            using PoolList = std::vector<std::pair<std::string, BufferPoolStats>>;
+
+            void WriteHeader(std::ostringstream& out, const char* name, const char* type, const char* help) {
+                out << "# HELP " << name << " " << help << "\n";
+                out << "# TYPE " << name << " " << type << "\n";
+            }
+
+            // One family whose samples are a single field of each pool's snapshot.
+            void WriteMetric(std::ostringstream& out, const char* name, const char* type, const char* help,
+                const PoolList& pools, uint64_t BufferPoolStats::* field) {
+                WriteHeader(out, name, type, help);
+                for (const auto& [label, stats] : pools) {
+                    out << name << "{pool=\"" << label << "\"} " << stats.*field << "\n";
+                }
+            }
+
+        } // namespace
+
+        std::string ToPrometheusText(const PoolList& pools) {
+            std::ostringstream out;
+
+            WriteMetric(out, "cmse_bpm_hits_total", "counter", "FetchPage requests served from memory.", pools, &BufferPoolStats::hits);
+            WriteMetric(out, "cmse_bpm_misses_total", "counter", "FetchPage requests that read from disk.", pools, &BufferPoolStats::misses);
+            WriteMetric(out, "cmse_bpm_new_pages_total", "counter", "Pages allocated through NewPage.", pools, &BufferPoolStats::new_pages);
+            WriteMetric(out, "cmse_bpm_free_list_hits_total", "counter", "Frames taken from the free list.", pools, &BufferPoolStats::free_list_hits);
+
+            WriteHeader(out, "cmse_bpm_evictions_total", "counter", "Frames evicted by the replacer.");
+            for (const auto& [label, stats] : pools) {
+                out << "cmse_bpm_evictions_total{pool=\"" << label << "\",kind=\"clean\"} " << stats.evictions_clean << "\n";
+                out << "cmse_bpm_evictions_total{pool=\"" << label << "\",kind=\"dirty\"} " << stats.evictions_dirty << "\n";
+            }
+
+            WriteMetric(out, "cmse_bpm_pin_waits_total", "counter", "Requests that found every frame pinned.", pools, &BufferPoolStats::pin_waits);
+            WriteMetric(out, "cmse_bpm_read_bytes_total", "counter", "Bytes read from disk.", pools, &BufferPoolStats::bytes_read);
+            WriteMetric(out, "cmse_bpm_written_bytes_total", "counter", "Bytes written to disk.", pools, &BufferPoolStats::bytes_written);
+            WriteMetric(out, "cmse_bpm_prefetched_total", "counter", "Pages loaded ahead of use (warm-up).", pools, &BufferPoolStats::prefetched);
+
+            WriteMetric(out, "cmse_bpm_pool_size", "gauge", "Number of frames in the pool.", pools, &BufferPoolStats::pool_size);
+            WriteMetric(out, "cmse_bpm_mapped_frames", "gauge", "Frames backed by memory (includes retired frames still draining).", pools, &BufferPoolStats::mapped_frames);
+            WriteMetric(out, "cmse_bpm_resident_pages", "gauge", "Pages currently mapped in the page table.", pools, &BufferPoolStats::resident_pages);
+            WriteMetric(out, "cmse_bpm_free_frames", "gauge", "Frames on the free list.", pools, &BufferPoolStats::free_frames);
+            WriteMetric(out, "cmse_bpm_pinned_frames", "gauge", "Frames with a pin count above zero.", pools, &BufferPoolStats::pinned_frames);
+            WriteMetric(out, "cmse_bpm_dirty_frames", "gauge", "Frames whose page differs from disk.", pools, &BufferPoolStats::dirty_frames);
+
+            WriteHeader(out, "cmse_bpm_hit_ratio", "gauge", "Hits divided by FetchPage requests.");
+            for (const auto& [label, stats] : pools) {
+                out << "cmse_bpm_hit_ratio{pool=\"" << label << "\"} " << stats.HitRatio() << "\n";
+            }
+
+            return out.str();
+        }
+
+        std::string ToPrometheusText(const BufferPoolStats& stats, const std::string& pool_label) {
+            return ToPrometheusText(PoolList{ { pool_label, stats } });
+        }
+
+    } // namespace bufferpool
+} // namespace cmse
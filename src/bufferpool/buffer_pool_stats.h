@@ -0,0 +1,115 @@
+/**
+ * buffer_pool_stats.h
+ *
+ * Counters and snapshot types describing BufferPoolManager behaviour
+ * (hit ratio, evictions, I/O volume). Used to size pools from measured data.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cmse {
+    namespace bufferpool {
+
+        /**
+         * Identifiers of the event counters kept by the buffer pool.
+         */
+        enum class PoolCounter : size_t {
+            Hits = 0,        // FetchPage found the page resident
+            Misses,          // FetchPage had to read the page from disk
+            NewPages,        // NewPage allocations
+            FreeListHits,    // Frames taken from the free list (no eviction needed)
+            EvictionsClean,  // Victims evicted without write-back
+            EvictionsDirty,  // Victims written back before eviction
+            PinWaits,        // Requests that found every frame pinned (caller must retry)
+            BytesRead,       // Bytes read from disk by the pool
+            BytesWritten,    // Bytes written to disk by the pool (evictions + flushes)
+            Prefetched,      // Pages loaded by PrefetchPages (warm-up), not by a FetchPage miss
+            Count
+        };
+
+        /**
+         * BufferPoolStats
+         * Point-in-time snapshot returned by BufferPoolManager::GetStats().
+         * Counters are cumulative since construction (or the last ResetStats()).
+         */
+        struct BufferPoolStats {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t new_pages = 0;
+            uint64_t free_list_hits = 0;
+            uint64_t evictions_clean = 0;
+            uint64_t evictions_dirty = 0;
+            uint64_t pin_waits = 0;
+            uint64_t bytes_read = 0;
+            uint64_t bytes_written = 0;
+            uint64_t prefetched = 0;
+
+            // Gauges (current state, not cumulative)
+            uint64_t pool_size = 0;
+            uint64_t mapped_frames = 0;   // Frames with memory; above pool_size while a shrink drains
+            uint64_t resident_pages = 0;
+            uint64_t free_frames = 0;
+            uint64_t pinned_frames = 0;
+            uint64_t dirty_frames = 0;
+
+            // hits / (hits + misses); 0 when no fetch has been issued.
+            double HitRatio() const {
+                uint64_t total = hits + misses;
+                return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+            }
+        };
+
+        /**
+         * StripedCounters
+         * Lock-free event counters sharded per thread.
+         * Each thread is assigned a cache-line aligned shard on first use, so concurrent
+         * increments from different threads do not contend on the same cache line.
+         * Reads sum all shards and are therefore slightly racy (good enough for metrics).
+         */
+        class StripedCounters {
+        public:
+            static constexpr size_t NUM_SHARDS = 64;
+            static constexpr size_t NUM_COUNTERS = static_cast<size_t>(PoolCounter::Count);
+
+            StripedCounters();
+
+            inline void Add(PoolCounter counter, uint64_t delta = 1) {
+                shards_[ShardIndex()].values[static_cast<size_t>(counter)].fetch_add(delta, std::memory_order_relaxed);
+            }
+
+            uint64_t Sum(PoolCounter counter) const;
+
+            void Reset();
+
+        private:
+            struct alignas(64) Shard {
+                std::array<std::atomic<uint64_t>, NUM_COUNTERS> values;
+            };
+
+            // Returns this thread's shard index (assigned round-robin on first call).
+            static size_t ShardIndex();
+
+            std::array<Shard, NUM_SHARDS> shards_;
+        };
+
+        /**
+         * Renders stats snapshots of several pools in the Prometheus text exposition format.
+         * Each metric family gets its HELP/TYPE lines once, followed by one sample per pool, so
+         * all pools of a process can share one dump file.
+         * @param pools (value of the 'pool' label, snapshot) pairs; labels must be distinct.
+         */
+        std::string ToPrometheusText(const std::vector<std::pair<std::string, BufferPoolStats>>& pools);
+
+        // Renders the snapshot of a single pool (see above).
+        std::string ToPrometheusText(const BufferPoolStats& stats, const std::string& pool_label);
+
+    } // namespace bufferpool
+} // namespace cmse
@@ -0,0 +1,133 @@
+/**
+ * frame_arena.cpp
+ *
+ * Huge-page backed frame arena with fallbacks (see frame_arena.h).
+ */
+
+#include "frame_arena.h"
+#include "../common/types.h"
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace cmse {
+    namespace bufferpool {
+
+        namespace {
+            constexpr size_t HUGE_PAGE_SIZE = size_t{ 2 } << 20; // x86-64 / AArch64 default
+
+            size_t RoundUp(size_t n, size_t to) {
+                return (n + to - 1) / to * to;
+            }
+        }
+
+        const char* ArenaBackingName(ArenaBacking backing) {
+            switch (backing) {
+            case ArenaBacking::Heap: return "heap";
+            case ArenaBacking::RegularPages: return "regular_pages";
+            case ArenaBacking::TransparentHuge: return "transparent_huge_pages";
+            case ArenaBacking::ExplicitHuge: return "explicit_huge_pages";
+            }
+            return "?";
+        }
+
+        FrameArena::FrameArena(size_t bytes, HugePagePolicy policy) : bytes_(bytes) {
+            if (bytes_ < HUGE_PAGE_SIZE) {
+                policy = HugePagePolicy::Off; // A huge page would mostly hold no frames
+            }
+#if defined(__linux__)
+            if (bytes_ > 0) {
+                const int prot = PROT_READ | PROT_WRITE;
+                const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_HUGETLB
+                // 1. Explicit huge pages: fails at once unless the administrator reserved enough.
+                if (policy == HugePagePolicy::Auto) {
+                    size_t length = RoundUp(bytes_, HUGE_PAGE_SIZE);
+                    void* p = mmap(nullptr, length, prot, flags | MAP_HUGETLB, -1, 0);
+                    if (p != MAP_FAILED) {
+                        mapping_ = p;
+                        mapped_bytes_ = length;
+                        data_ = static_cast<char*>(p);
+                        backing_ = ArenaBacking::ExplicitHuge;
+                        return;
+                    }
+                }
+#endif
+                // 2. Regular mapping. For transparent huge pages, over-map by one huge page so the
+                //    arena can start on a 2MB boundary (the kernel only promotes aligned ranges).
+                size_t length = policy == HugePagePolicy::Auto ? RoundUp(bytes_, HUGE_PAGE_SIZE) + HUGE_PAGE_SIZE : bytes_;
+                void* p = mmap(nullptr, length, prot, flags, -1, 0);
+                if (p != MAP_FAILED) {
+                    mapping_ = p;
+                    mapped_bytes_ = length;
+                    data_ = static_cast<char*>(p);
+                    backing_ = ArenaBacking::RegularPages;
+#ifdef MADV_HUGEPAGE
+                    if (policy == HugePagePolicy::Auto) {
+                        uintptr_t aligned = RoundUp(reinterpret_cast<uintptr_t>(p), HUGE_PAGE_SIZE);
+                        data_ = reinterpret_cast<char*>(aligned);
+                        if (madvise(data_, RoundUp(bytes_, HUGE_PAGE_SIZE), MADV_HUGEPAGE) == 0) {
+                            backing_ = ArenaBacking::TransparentHuge;
+                        }
+                    }
+#endif
+                    return;
+                }
+            }
+#elif defined(_WIN32)
+            if (bytes_ > 0) {
+                // 1. Large pages: needs SeLockMemoryPrivilege, otherwise VirtualAlloc fails.
+                SIZE_T large_page = policy == HugePagePolicy::Auto ? GetLargePageMinimum() : 0;
+                if (large_page > 0) {
+                    size_t length = RoundUp(bytes_, large_page);
+                    void* p = VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+                    if (p != nullptr) {
+                        mapping_ = p;
+                        mapped_bytes_ = length;
+                        data_ = static_cast<char*>(p);
+                        backing_ = ArenaBacking::ExplicitHuge;
+                        return;
+                    }
+                }
+                // 2. Regular pages (64KB-aligned, zero-filled).
+                void* p = VirtualAlloc(nullptr, bytes_, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+                if (p != nullptr) {
+                    mapping_ = p;
+                    mapped_bytes_ = bytes_;
+                    data_ = static_cast<char*>(p);
+                    backing_ = ArenaBacking::RegularPages;
+                    return;
+                }
+            }
+#else
+            (void)policy;
+#endif
+            // 3. Fallback: page-aligned heap memory.
+            data_ = static_cast<char*>(::operator new(bytes_, std::align_val_t(PAGE_SIZE)));
+            std::memset(data_, 0, bytes_);
+            backing_ = ArenaBacking::Heap;
+        }
+
+        FrameArena::~FrameArena() {
+            if (mapping_ == nullptr) {
+                ::operator delete(data_, std::align_val_t(PAGE_SIZE));
+                return;
+            }
+#if defined(__linux__)
+            munmap(mapping_, mapped_bytes_);
+#elif defined(_WIN32)
+            VirtualFree(mapping_, 0, MEM_RELEASE);
+#endif
+        }
+
+    } // namespace bufferpool
+} // namespace cmse
@@ -0,0 +1,69 @@
+/**
+ * frame_arena.h
+ *
+ * Page-aligned memory for the page bytes of a BufferPoolManager, backed by huge pages when the
+ * platform provides them.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace cmse {
+    namespace bufferpool {
+
+        /**
+         * How the pool asks for its frame arena.
+         */
+        enum class HugePagePolicy {
+            Off,   // Regular (4KB) pages
+            Auto   // Huge pages if available, regular pages otherwise
+        };
+
+        /**
+         * What the arena actually got.
+         */
+        enum class ArenaBacking {
+            Heap,              // Aligned operator new (no virtual-memory API available)
+            RegularPages,      // Anonymous mapping with base pages
+            TransparentHuge,   // Anonymous mapping advised MADV_HUGEPAGE (the kernel may promote it)
+            ExplicitHuge       // MAP_HUGETLB / MEM_LARGE_PAGES: guaranteed huge pages
+        };
+
+        const char* ArenaBackingName(ArenaBacking backing);
+
+        /**
+         * FrameArena
+         * One contiguous allocation of 'bytes' for the pool's frames. Random hits over a pool of
+         * millions of 4KB frames miss the dTLB on almost every access; with 2MB pages one TLB entry
+         * covers 512 frames.
+         *
+         * With HugePagePolicy::Auto, Linux tries mmap(MAP_HUGETLB) (pages reserved in
+         * /proc/sys/vm/nr_hugepages), then a 2MB-aligned anonymous mapping with
+         * madvise(MADV_HUGEPAGE) (transparent huge pages); Windows tries VirtualAlloc with
+         * MEM_LARGE_PAGES (needs SeLockMemoryPrivilege), then plain VirtualAlloc. The memory is
+         * always at least PAGE_SIZE-aligned, as direct I/O requires, and zero-filled. Arenas
+         * smaller than one huge page always use regular pages.
+         */
+        class FrameArena {
+        public:
+            FrameArena(size_t bytes, HugePagePolicy policy);
+            ~FrameArena();
+
+            FrameArena(const FrameArena&) = delete;
+            FrameArena& operator=(const FrameArena&) = delete;
+
+            char* Data() const { return data_; }
+            size_t Size() const { return bytes_; }
+            ArenaBacking Backing() const { return backing_; }
+
+        private:
+            char* data_ = nullptr;     // First usable byte (aligned)
+            size_t bytes_ = 0;
+            void* mapping_ = nullptr;  // Start of the reservation to release (may precede data_)
+            size_t mapped_bytes_ = 0;
+            ArenaBacking backing_ = ArenaBacking::Heap;
+        };
+
+    } // namespace bufferpool
+} // namespace cmse
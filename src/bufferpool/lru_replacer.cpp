@@ -17,7 +17,7 @@ namespace cmse {
         LRUReplacer::~LRUReplacer() = default;
 
         bool LRUReplacer::Victim(frame_id_t* frame_id) {
-            std::lock_guard<std::mutex> lock(mutex_);
+            std::lock_guard<utils::Latch> lock(mutex_);
 
             // 1. If the list is empty, we cannot evict anything.
             if (lru_list_.empty()) {
@@ -37,7 +37,7 @@ namespace cmse {
         }
 
         void LRUReplacer::Pin(frame_id_t frame_id) {
-            std::lock_guard<std::mutex> lock(mutex_);
+            std::lock_guard<utils::Latch> lock(mutex_);
 
             // If the frame is in the replacer (map), it means it was a candidate for eviction.
             // Since it is being pinned now (used by a thread), we must remove it from the replacer.
@@ -52,7 +52,7 @@ namespace cmse {
         }
 
         void LRUReplacer::Unpin(frame_id_t frame_id) {
-            std::lock_guard<std::mutex> lock(mutex_);
+            std::lock_guard<utils::Latch> lock(mutex_);
 
             // If the frame is already in the replacer, we typically don't add it again.
             // However, some implementations might move it to the front to update 'recency'.
@@ -69,10 +69,27 @@ namespace cmse {
             lru_map_[frame_id] = lru_list_.begin();
         }
 
+        void LRUReplacer::Demote(frame_id_t frame_id) {
+            std::lock_guard<utils::Latch> lock(mutex_);
+
+            auto it = lru_map_.find(frame_id);
+            if (it != lru_map_.end()) {
+                lru_list_.splice(lru_list_.end(), lru_list_, it->second);
+                return;
+            }
+            lru_list_.push_back(frame_id);
+            lru_map_[frame_id] = std::prev(lru_list_.end());
+        }
+
         size_t LRUReplacer::Size() {
-            std::lock_guard<std::mutex> lock(mutex_);
+            std::lock_guard<utils::Latch> lock(mutex_);
             return lru_list_.size();
         }
 
+        std::vector<frame_id_t> LRUReplacer::RecencyOrder() {
+            std::lock_guard<utils::Latch> lock(mutex_);
+            return std::vector<frame_id_t>(lru_list_.begin(), lru_list_.end());
+        }
+
     } // namespace bufferpool
 } // namespace cmse
\ No newline at end of file
@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "../common/types.h"
+#include "../utils/latch.h"
 
 namespace cmse {
     namespace bufferpool {
@@ -61,12 +62,26 @@ namespace cmse {
              */
             void Unpin(frame_id_t frame_id);
 
+            /**
+             * Moves the frame to the least recently used end (adding it if absent), so it
+             * becomes the next victim. Used for prefetched pages, which nobody has used yet.
+             *
+             * @param frame_id the id of the frame to demote.
+             */
+            void Demote(frame_id_t frame_id);
+
             /** @return the number of elements in the replacer that can be evicted. */
             size_t Size();
 
+            /**
+             * @return The tracked frames in recency order, most recently used first
+             *         (the eviction order reversed).
+             */
+            std::vector<frame_id_t> RecencyOrder();
+
         private:
             // Protects the replacer data structures for thread safety.
-            std::mutex mutex_;
+            utils::Latch mutex_{ "lru_replacer" };
 
             // Doubly linked list to track usage order.
             // Front = Most Recently Used (MRU)
@@ -0,0 +1,170 @@
+/**
+ * resident_set.cpp
+ *
+ * Resident-set snapshot file I/O, the periodic persister and the warm-up loader.
+ */
+
+#include "resident_set.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "../utils/atomic_file.h"
+
+namespace cmse {
+    namespace bufferpool {
+
+        namespace {
+            constexpr char RESIDENT_SET_MAGIC[8] = { 'C', 'M', 'S', 'E', 'R', 'E', 'S', '1' };
+        }
+
+        // =================================================================
+        // Snapshot file
+        // =================================================================
+
+        bool WriteResidentSetFile(const std::string& path, const std::vector<page_id_t>& page_ids) {
+            uint32_t id_size = sizeof(page_id_t);
+            uint32_t reserved = 0;
+            uint64_t count = page_ids.size();
+
+            std::string content;
+            content.reserve(sizeof(RESIDENT_SET_MAGIC) + sizeof(id_size) + sizeof(reserved) + sizeof(count) + page_ids.size() * sizeof(page_id_t));
+            content.append(RESIDENT_SET_MAGIC, sizeof(RESIDENT_SET_MAGIC));
+            content.append(reinterpret_cast<const char*>(&id_size), sizeof(id_size));
+            content.append(reinterpret_cast<const char*>(&reserved), sizeof(reserved));
+            content.append(reinterpret_cast<const char*>(&count), sizeof(count));
+            content.append(reinterpret_cast<const char*>(page_ids.data()), page_ids.size() * sizeof(page_id_t));
+
+            return utils::writeFileAtomically(path, content);
+        }
+
+        bool ReadResidentSetFile(const std::string& path, std::vector<page_id_t>* page_ids) {
+            std::ifstream in(path, std::ios::binary);
+            if (!in.is_open()) {
+                return false;
+            }
+
+            char magic[8];
+            uint32_t id_size = 0;
+            uint32_t reserved = 0;
+            uint64_t count = 0;
+
+            in.read(magic, sizeof(magic));
+            in.read(reinterpret_cast<char*>(&id_size), sizeof(id_size));
+            in.read(reinterpret_cast<char*>(&reserved), sizeof(reserved));
+            in.read(reinterpret_cast<char*>(&count), sizeof(count));
+            if (!in || std::memcmp(magic, RESIDENT_SET_MAGIC, sizeof(magic)) != 0 || id_size != sizeof(page_id_t)) {
+                return false;
+            }
+
+            // Validate the declared count against the actual payload before allocating.
+            std::streampos payload_start = in.tellg();
+            in.seekg(0, std::ios::end);
+            uint64_t payload_bytes = static_cast<uint64_t>(in.tellg() - payload_start);
+            in.seekg(payload_start);
+            if (count > payload_bytes / sizeof(page_id_t)) {
+                return false;
+            }
+
+            page_ids->resize(static_cast<size_t>(count));
+            if (count > 0) {
+                in.read(reinterpret_cast<char*>(page_ids->data()), static_cast<std::streamsize>(count * sizeof(page_id_t)));
+            }
+            return static_cast<bool>(in);
+        }
+
+        // =================================================================
+        // ResidentSetPersister
+        // =================================================================
+
+        ResidentSetPersister::ResidentSetPersister(BufferPoolManager* bpm, std::string path, std::chrono::milliseconds interval)
+            : bpm_(bpm), path_(std::move(path)), worker_(interval, [this] { persistNow(); }) {
+        }
+
+        ResidentSetPersister::~ResidentSetPersister() {
+            stop();
+        }
+
+        bool ResidentSetPersister::persistNow() {
+            if (!WriteResidentSetFile(path_, bpm_->GetResidentPageIds())) {
+                std::cerr << "[ResidentSetPersister] Error: Could not write " << path_ << std::endl;
+                return false;
+            }
+            return true;
+        }
+
+        // =================================================================
+        // WarmupLoader
+        // =================================================================
+
+        WarmupLoader::WarmupLoader(BufferPoolManager* bpm, std::string path, WarmupOptions options)
+            : bpm_(bpm), path_(std::move(path)), options_(options) {
+            options_.batch_pages = std::max<size_t>(options_.batch_pages, 1);
+        }
+
+        WarmupLoader::~WarmupLoader() {
+            cancel();
+            if (worker_.joinable()) {
+                worker_.join();
+            }
+        }
+
+        WarmupStats WarmupLoader::run() {
+            auto start = std::chrono::steady_clock::now();
+            WarmupStats stats;
+
+            std::vector<page_id_t> page_ids;
+            stats.snapshot_found = ReadResidentSetFile(path_, &page_ids);
+            stats.snapshot_pages = page_ids.size();
+
+            // 1. Hottest first: keep what fits.
+            size_t keep = options_.max_pages != 0 ? options_.max_pages : bpm_->GetPoolSize();
+            if (page_ids.size() > keep) {
+                page_ids.resize(keep);
+            }
+
+            // 2. Ascending page order for the disk.
+            std::vector<page_id_t> hottest_first = page_ids;
+            std::sort(page_ids.begin(), page_ids.end());
+            page_ids.erase(std::unique(page_ids.begin(), page_ids.end()), page_ids.end());
+            stats.requested_pages = page_ids.size();
+
+            // 3. Batches of free-frame-only prefetches.
+            std::vector<page_id_t> batch;
+            for (size_t i = 0; i < page_ids.size() && !cancel_.load(std::memory_order_relaxed); i += options_.batch_pages) {
+                batch.assign(page_ids.begin() + i, page_ids.begin() + std::min(page_ids.size(), i + options_.batch_pages));
+                size_t loaded = 0;
+                bool room = bpm_->PrefetchPages(batch, &loaded);
+                stats.loaded_pages += loaded;
+                stats.batches++;
+                if (!room) {
+                    stats.pool_filled = true;
+                    break;
+                }
+            }
+
+            // 4. Restore the snapshot's recency order among the loaded pages.
+            bpm_->RankPrefetchedPages(hottest_first);
+
+            stats.elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            return stats;
+        }
+
+        void WarmupLoader::start() {
+            if (worker_.joinable()) {
+                return;
+            }
+            worker_ = std::thread([this]() { stats_ = run(); });
+        }
+
+        WarmupStats WarmupLoader::wait() {
+            if (worker_.joinable()) {
+                worker_.join();
+            }
+            return stats_;
+        }
+
+    } // namespace bufferpool
+} // namespace cmse
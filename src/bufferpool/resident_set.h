@@ -0,0 +1,129 @@
+/**
+ * resident_set.h
+ *
+ * Warm restarts for the buffer pool: the ids of the resident pages are persisted
+ * periodically (hottest first), and after a restart a background loader reads them back
+ * into the empty pool in sorted batches instead of waiting for misses to refill it.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../common/types.h"
+#include "../utils/periodic_worker.h"
+#include "buffer_pool_manager.h"
+
+namespace cmse {
+    namespace bufferpool {
+
+        /**
+         * Writes a resident-set snapshot. The file is replaced atomically
+         * (utils::writeFileAtomically), so a crash mid-write leaves the previous snapshot.
+         * Layout: "CMSERES1" | uint32 id_size | uint32 reserved | uint64 count | page ids...
+         * @return false if the file could not be written.
+         */
+        bool WriteResidentSetFile(const std::string& path, const std::vector<page_id_t>& page_ids);
+
+        /**
+         * Reads a snapshot written by WriteResidentSetFile.
+         * @return false if the file is missing or malformed (a cold start, not an error).
+         */
+        bool ReadResidentSetFile(const std::string& path, std::vector<page_id_t>* page_ids);
+
+        /**
+         * ResidentSetPersister
+         * Periodically writes BufferPoolManager::GetResidentPageIds() to a snapshot file on a
+         * utils::PeriodicWorker: start() spawns the thread, stop() (or the destructor) joins it
+         * and writes one final snapshot.
+         */
+        class ResidentSetPersister {
+        public:
+            ResidentSetPersister(BufferPoolManager* bpm, std::string path, std::chrono::milliseconds interval);
+            ~ResidentSetPersister();
+
+            ResidentSetPersister(const ResidentSetPersister&) = delete;
+            ResidentSetPersister& operator=(const ResidentSetPersister&) = delete;
+
+            // Starts the background thread. No-op if already running.
+            void start() { worker_.start(); }
+
+            // Stops the background thread and writes a final snapshot. No-op if not running.
+            void stop() { worker_.stop(); }
+
+            // Writes a snapshot on the calling thread. Returns false if it could not be written.
+            bool persistNow();
+
+        private:
+            BufferPoolManager* bpm_;
+            std::string path_;
+            utils::PeriodicWorker worker_;
+        };
+
+        struct WarmupOptions {
+            size_t batch_pages = 64;   // Pages per PrefetchPages call (one latch hold)
+            size_t max_pages = 0;      // Hottest pages to load; 0 = the pool size
+        };
+
+        struct WarmupStats {
+            bool snapshot_found = false;
+            size_t snapshot_pages = 0;     // Ids in the snapshot
+            size_t requested_pages = 0;    // Ids kept after the max_pages cut and dedup
+            size_t loaded_pages = 0;       // Read from disk (the rest were already resident)
+            size_t batches = 0;
+            bool pool_filled = false;      // Stopped early: no free frame left
+            double elapsed_ms = 0;
+        };
+
+        /**
+         * WarmupLoader
+         * Reads a resident-set snapshot and prefetches it into a BufferPoolManager:
+         *  1. Keeps the hottest max_pages ids (the snapshot is ordered hottest first).
+         *  2. Sorts them by page id, so the disk sees an ascending sweep instead of the
+         *     random order in which the pages were last used.
+         *  3. Loads them batch_pages at a time through PrefetchPages, which only fills free
+         *     frames: pages fetched by live traffic in the meantime are never displaced, and
+         *     the loader stops once the pool is full.
+         *  4. Re-ranks the loaded pages in snapshot order (RankPrefetchedPages), so the
+         *     hottest are evicted last, as before the restart.
+         * Run it synchronously (run()) before serving, or in the background (start()) while
+         * serving; traffic waits for at most one batch.
+         */
+        class WarmupLoader {
+        public:
+            WarmupLoader(BufferPoolManager* bpm, std::string path, WarmupOptions options = WarmupOptions());
+
+            // Cancels and joins a background load.
+            ~WarmupLoader();
+
+            WarmupLoader(const WarmupLoader&) = delete;
+            WarmupLoader& operator=(const WarmupLoader&) = delete;
+
+            // Loads on the calling thread.
+            WarmupStats run();
+
+            // Loads on a background thread. No-op if already started.
+            void start();
+
+            // Joins the background thread and returns its stats.
+            WarmupStats wait();
+
+            // Makes a running load stop after its current batch.
+            void cancel() { cancel_.store(true, std::memory_order_relaxed); }
+
+        private:
+            BufferPoolManager* bpm_;
+            std::string path_;
+            WarmupOptions options_;
+
+            std::thread worker_;
+            std::atomic<bool> cancel_{ false };
+            WarmupStats stats_;
+        };
+
+    } // namespace bufferpool
+} // namespace cmse
@@ -0,0 +1,107 @@
+/**
+ * shards_mrc.h
+ *
+ * Online miss-ratio curve estimation with SHARDS (Waldspurger et al., FAST '15).
+ *
+ * A page is sampled iff hash(page_id) falls below a threshold, so every access to a
+ * sampled page is seen and reuse distances among sampled pages are exact. A distance
+ * measured among sampled pages is scaled by 1 / sampling_rate to estimate the true LRU
+ * stack distance. Unsampled accesses cost one hash and one compare.
+ *
+ * The fixed-size variant is used: at most 'max_samples' distinct pages are tracked.
+ * When the limit is exceeded, the page with the largest hash is dropped and the
+ * threshold (and therefore the rate) is lowered to exclude it.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../common/hash.h"
+#include "../common/types.h"
+#include "../utils/latency_histogram.h"
+#include "trace_replay.h"
+
+namespace cmse {
+    namespace bufferpool {
+
+        class ShardsMrcEstimator {
+        public:
+            /**
+             * @param sampling_rate Initial fraction of pages sampled (0, 1].
+             * @param max_samples Maximum number of distinct sampled pages tracked.
+             */
+            ShardsMrcEstimator(double sampling_rate, size_t max_samples);
+
+            /**
+             * Observes one page access. Not thread-safe (BufferPoolManager calls it under its latch).
+             */
+            inline void Access(page_id_t page_id) {
+                total_accesses_++;
+                uint64_t hash = Hash(page_id);
+                if (hash >= threshold_) {
+                    return;
+                }
+                AccessSampled(page_id, hash);
+            }
+
+            /**
+             * Estimated LRU miss ratio for each hypothetical cache size (in frames).
+             */
+            MissRatioCurve Curve(const std::vector<size_t>& cache_sizes) const;
+
+            // Current sampling rate (may decrease as max_samples is enforced).
+            double SamplingRate() const { return static_cast<double>(threshold_) / static_cast<double>(HASH_MODULUS); }
+
+            uint64_t TotalAccesses() const { return total_accesses_; }
+            uint64_t SampledAccesses() const { return sampled_accesses_; }
+            size_t TrackedPages() const { return last_access_.size(); }
+
+        private:
+            static constexpr uint64_t HASH_MODULUS = uint64_t{ 1 } << 24;
+
+            // Mixed page id, reduced to [0, HASH_MODULUS).
+            static inline uint64_t Hash(page_id_t page_id) {
+                return Mix64(static_cast<uint32_t>(page_id)) & (HASH_MODULUS - 1);
+            }
+
+            void AccessSampled(page_id_t page_id, uint64_t hash);
+
+            // Drops the largest-hash pages until at most max_samples remain.
+            void EnforceSampleLimit();
+
+            // Renumbers live timestamps to 0..k-1 once the logical clock reaches the tree capacity.
+            void Compact();
+
+            // --- Fenwick tree over logical access times of tracked pages ---
+            void TreeAdd(size_t pos, int delta);
+            int64_t TreePrefix(size_t pos) const;
+
+            uint64_t threshold_;
+            size_t max_samples_;
+
+            // Tracked page -> logical time of its last access
+            std::unordered_map<page_id_t, uint64_t> last_access_;
+            std::set<std::pair<uint64_t, page_id_t>> by_hash_; // Largest hash = next to drop
+
+            std::vector<int32_t> tree_;
+            uint64_t clock_ = 0;
+            int64_t live_marks_ = 0;
+
+            // Scaled reuse distances, bucketed log-linearly (same buckets as latency histograms).
+            std::vector<uint64_t> distance_buckets_;
+            uint64_t total_accesses_ = 0;
+            uint64_t sampled_accesses_ = 0;
+
+            // SHARDS_adj bookkeeping: expected number of sampled accesses, accumulated per
+            // rate epoch so the unsampled fast path does no floating point work.
+            double expected_sampled_before_ = 0.0;
+            uint64_t accesses_at_rate_change_ = 0;
+        };
+
+    } // namespace bufferpool
+} // namespace cmse
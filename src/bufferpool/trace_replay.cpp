@@ -0,0 +1,123 @@
+/**
+ * trace_replay.cpp
+ *
+ * Mattson stack-distance computation for exact LRU miss-ratio curves.
+ */
+
+#include "trace_replay.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace cmse {
+    namespace bufferpool {
+
+        namespace {
+
+            /**
+             * Fenwick (binary indexed) tree over access positions.
+             * Position t holds 1 iff the access at time t is the most recent access of its page.
+             * The stack distance of a re-access is then the number of 1s in (last_time, now].
+             */
+            class FenwickTree {
+            public:
+                explicit FenwickTree(size_t n) : tree_(n + 1, 0) {}
+
+                void Add(size_t pos, int delta) {
+                    for (size_t i = pos + 1; i < tree_.size(); i += i & (~i + 1)) {
+                        tree_[i] += delta;
+                    }
+                }
+
+                // Sum of positions [0, pos].
+                int64_t Prefix(size_t pos) const {
+                    int64_t sum = 0;
+                    for (size_t i = pos + 1; i > 0; i -= i & (~i + 1)) {
+                        sum += tree_[i];
+                    }
+                    return sum;
+                }
+
+            private:
+                std::vector<int64_t> tree_;
+            };
+
+        } // namespace
+
+        std::vector<page_id_t> ExtractAccesses(const std::vector<TraceRecord>& trace) {
+            std::vector<page_id_t> accesses;
+            accesses.reserve(trace.size());
+            for (const auto& rec : trace) {
+                if (rec.op == TraceOp::Fetch || rec.op == TraceOp::New) {
+                    accesses.push_back(rec.page_id);
+                }
+            }
+            return accesses;
+        }
+
+        size_t CountDistinctPages(const std::vector<page_id_t>& accesses) {
+            std::unordered_set<page_id_t> distinct(accesses.begin(), accesses.end());
+            return distinct.size();
+        }
+
+        std::vector<size_t> DefaultCacheSizes(size_t max_size) {
+            std::vector<size_t> sizes;
+            size_t size = 1;
+            sizes.push_back(size);
+            while (size < max_size) {
+                size <<= 1;
+                sizes.push_back(size);
+            }
+            return sizes;
+        }
+
+        MissRatioCurve ComputeLruMissRatioCurve(const std::vector<page_id_t>& accesses, const std::vector<size_t>& cache_sizes) {
+            const size_t n = accesses.size();
+            FenwickTree tree(n);
+            std::unordered_map<page_id_t, size_t> last_access;
+            last_access.reserve(n / 4 + 1);
+
+            // distance_counts[d] = number of re-accesses at stack distance d (1-based).
+            // First accesses (cold misses) are never hits at any size and are not counted here.
+            std::vector<uint64_t> distance_counts(1, 0);
+
+            for (size_t t = 0; t < n; ++t) {
+                page_id_t page_id = accesses[t];
+                auto it = last_access.find(page_id);
+
+                if (it == last_access.end()) {
+                    last_access.emplace(page_id, t);
+                }
+                else {
+                    size_t prev = it->second;
+                    // Distinct pages touched since the previous access, plus the page itself.
+                    size_t distance = static_cast<size_t>(tree.Prefix(n - 1) - tree.Prefix(prev)) + 1;
+                    if (distance >= distance_counts.size()) {
+                        distance_counts.resize(distance + 1, 0);
+                    }
+                    distance_counts[distance]++;
+
+                    tree.Add(prev, -1);
+                    it->second = t;
+                }
+                tree.Add(t, 1);
+            }
+
+            // hits(C) = number of re-accesses with distance <= C.
+            std::vector<uint64_t> cumulative(distance_counts.size(), 0);
+            for (size_t d = 1; d < distance_counts.size(); ++d) {
+                cumulative[d] = cumulative[d - 1] + distance_counts[d];
+            }
+
+            MissRatioCurve curve;
+            curve.reserve(cache_sizes.size());
+            for (size_t size : cache_sizes) {
+                uint64_t hits = cumulative[std::min(size, cumulative.size() - 1)];
+                double miss_ratio = n == 0 ? 0.0 : static_cast<double>(n - hits) / static_cast<double>(n);
+                curve.push_back({ size, miss_ratio });
+            }
+            return curve;
+        }
+
+    } // namespace bufferpool
+} // namespace cmse
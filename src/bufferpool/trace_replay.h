@@ -0,0 +1,134 @@
+/**
+ * trace_replay.h
+ *
+ * Offline replay of recorded access traces to compute hit/miss-ratio curves.
+ *
+ * Two modes:
+ * - ComputeLruMissRatioCurve: Mattson's stack algorithm. One pass yields the exact
+ *   LRU miss ratio for every cache size at once.
+ * - SimulateMissRatioCurve<Replacer>: drives any replacer with the LRUReplacer
+ *   interface (Victim/Pin/Unpin) for several pool sizes in the same single pass.
+ *
+ * Replay model: every Fetch/New is an access that pins and immediately unpins the page
+ * (pin durations are not modelled). Unpin/Flush/Delete records are ignored.
+ */
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "../common/types.h"
+#include "access_trace.h"
+
+namespace cmse {
+    namespace bufferpool {
+
+        struct MissRatioPoint {
+            size_t cache_size;
+            double miss_ratio;
+        };
+
+        using MissRatioCurve = std::vector<MissRatioPoint>;
+
+        // Returns the page ids of all Fetch/New records, in trace order.
+        std::vector<page_id_t> ExtractAccesses(const std::vector<TraceRecord>& trace);
+
+        // Number of distinct pages in 'accesses'.
+        size_t CountDistinctPages(const std::vector<page_id_t>& accesses);
+
+        // Powers of two from 1 up to (and including) the first size >= max_size.
+        std::vector<size_t> DefaultCacheSizes(size_t max_size);
+
+        /**
+         * Exact LRU miss-ratio curve via stack distances (Fenwick tree, O(N log N)).
+         * @param accesses Page accesses in order.
+         * @param cache_sizes Sizes (in frames) at which to evaluate the curve.
+         */
+        MissRatioCurve ComputeLruMissRatioCurve(const std::vector<page_id_t>& accesses, const std::vector<size_t>& cache_sizes);
+
+        /**
+         * ReplacerSimulator
+         * A page table + free frames around a real replacer, mimicking BufferPoolManager's
+         * frame management without any page data or I/O.
+         */
+        template <typename ReplacerT>
+        class ReplacerSimulator {
+        public:
+            explicit ReplacerSimulator(size_t pool_size)
+                : pool_size_(pool_size), replacer_(pool_size), frame_to_page_(pool_size, INVALID_PAGE_ID) {
+            }
+
+            // Returns true on a hit.
+            bool Access(page_id_t page_id) {
+                auto it = page_table_.find(page_id);
+                if (it != page_table_.end()) {
+                    replacer_.Pin(it->second);
+                    replacer_.Unpin(it->second);
+                    hits_++;
+                    return true;
+                }
+
+                misses_++;
+                frame_id_t frame;
+                if (next_free_frame_ < pool_size_) {
+                    frame = static_cast<frame_id_t>(next_free_frame_++);
+                }
+                else if (replacer_.Victim(&frame)) {
+                    page_table_.erase(frame_to_page_[frame]);
+                }
+                else {
+                    return false; // pool_size == 0
+                }
+
+                frame_to_page_[frame] = page_id;
+                page_table_[page_id] = frame;
+                replacer_.Pin(frame);
+                replacer_.Unpin(frame);
+                return false;
+            }
+
+            double MissRatio() const {
+                uint64_t total = hits_ + misses_;
+                return total == 0 ? 0.0 : static_cast<double>(misses_) / static_cast<double>(total);
+            }
+
+        private:
+            size_t pool_size_;
+            ReplacerT replacer_;
+            size_t next_free_frame_ = 0;
+            std::vector<page_id_t> frame_to_page_;
+            std::unordered_map<page_id_t, frame_id_t> page_table_;
+            uint64_t hits_ = 0;
+            uint64_t misses_ = 0;
+        };
+
+        /**
+         * Miss-ratio curve for an arbitrary replacer: one simulator per size,
+         * all fed from a single pass over the accesses.
+         */
+        template <typename ReplacerT>
+        MissRatioCurve SimulateMissRatioCurve(const std::vector<page_id_t>& accesses, const std::vector<size_t>& cache_sizes) {
+            // Replacers hold a mutex and are not movable, so keep simulators on the heap.
+            std::vector<std::unique_ptr<ReplacerSimulator<ReplacerT>>> sims;
+            sims.reserve(cache_sizes.size());
+            for (size_t size : cache_sizes) {
+                sims.push_back(std::make_unique<ReplacerSimulator<ReplacerT>>(size));
+            }
+
+            for (page_id_t page_id : accesses) {
+                for (auto& sim : sims) {
+                    sim->Access(page_id);
+                }
+            }
+
+            MissRatioCurve curve;
+            for (size_t i = 0; i < cache_sizes.size(); ++i) {
+                curve.push_back({ cache_sizes[i], sims[i]->MissRatio() });
+            }
+            return curve;
+        }
+
+    } // namespace bufferpool
+} // namespace cmse
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+
+namespace cmse {
+
+    /**
+     * Mix64
+     * splitmix64 finalizer. Spreads small or consecutive integers (page ids, resource ids)
+     * over all 64 bits, so any subset of the result bits can be used as a hash.
+     */
+    inline uint64_t Mix64(uint64_t value) {
+        uint64_t x = value + 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+} // namespace cmse
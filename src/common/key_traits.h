@@ -0,0 +1,136 @@
+#pragma once
+#include "types.h"
+#include <limits>
+#include <tuple>
+
+namespace cmse {
+
+    /**
+     * ResourceTimeKey
+     * Composite index key for per-resource timelines, ordered by (resource_id, timestamp_ms).
+     * All events of one resource are contiguous in the leaves, so "resource X between T1 and T2"
+     * is a single range scan over [{X, T1}, {X, T2}].
+     */
+    struct ResourceTimeKey {
+        int64_t resource_id = 0;
+        int64_t timestamp_ms = 0;   // Milliseconds since epoch (same unit as LogRecord::toString)
+
+        // Bounds of the prefix 'resource_id' (every timestamp).
+        static ResourceTimeKey prefixBegin(int64_t resource_id) {
+            return { resource_id, std::numeric_limits<int64_t>::min() };
+        }
+        static ResourceTimeKey prefixEnd(int64_t resource_id) {
+            return { resource_id, std::numeric_limits<int64_t>::max() };
+        }
+
+        static ResourceTimeKey fromRecord(const LogRecord& record) {
+            return { record.resource_id,
+                std::chrono::duration_cast<std::chrono::milliseconds>(record.timestamp.time_since_epoch()).count() };
+        }
+
+        friend bool operator<(const ResourceTimeKey& a, const ResourceTimeKey& b) {
+            return std::tie(a.resource_id, a.timestamp_ms) < std::tie(b.resource_id, b.timestamp_ms);
+        }
+        friend bool operator==(const ResourceTimeKey& a, const ResourceTimeKey& b) {
+            return a.resource_id == b.resource_id && a.timestamp_ms == b.timestamp_ms;
+        }
+        friend bool operator!=(const ResourceTimeKey& a, const ResourceTimeKey& b) { return !(a == b); }
+        friend bool operator>(const ResourceTimeKey& a, const ResourceTimeKey& b) { return b < a; }
+        friend bool operator<=(const ResourceTimeKey& a, const ResourceTimeKey& b) { return !(b < a); }
+        friend bool operator>=(const ResourceTimeKey& a, const ResourceTimeKey& b) { return !(a < b); }
+    };
+
+    /**
+     * RollupKey
+     * Key of the time-bucketed rollup tables, ordered by (bucket_start_ms, resource_id, event_code).
+     * All rows of one bucket are contiguous, so a time window is a single range scan.
+     * event_code is a dictionary id of the event type (see rollup::RollupStore): a 16-byte string
+     * would not leave room for MAX_KEYS keys in a leaf page.
+     */
+    struct RollupKey {
+        int64_t bucket_start_ms = 0;
+        int64_t resource_id = 0;
+        int64_t event_code = 0;
+
+        // Bounds of every row whose bucket starts in [first_bucket_ms, last_bucket_ms].
+        static RollupKey bucketsBegin(int64_t first_bucket_ms) {
+            return { first_bucket_ms, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::min() };
+        }
+        static RollupKey bucketsEnd(int64_t last_bucket_ms) {
+            return { last_bucket_ms, std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::max() };
+        }
+
+        friend bool operator<(const RollupKey& a, const RollupKey& b) {
+            return std::tie(a.bucket_start_ms, a.resource_id, a.event_code) < std::tie(b.bucket_start_ms, b.resource_id, b.event_code);
+        }
+        friend bool operator==(const RollupKey& a, const RollupKey& b) {
+            return a.bucket_start_ms == b.bucket_start_ms && a.resource_id == b.resource_id && a.event_code == b.event_code;
+        }
+        friend bool operator!=(const RollupKey& a, const RollupKey& b) { return !(a == b); }
+        friend bool operator>(const RollupKey& a, const RollupKey& b) { return b < a; }
+        friend bool operator<=(const RollupKey& a, const RollupKey& b) { return !(b < a); }
+        friend bool operator>=(const RollupKey& a, const RollupKey& b) { return !(a < b); }
+    };
+
+    /**
+     * KeyTraits
+     * What the index templates need from a key type beyond ordering: the smallest and
+     * largest key (empty node ranges), the key just below another (range clipping on split)
+     * and the leading key component hashed by leaf filters (see adapter::LeafFilter).
+     */
+    template <typename K>
+    struct KeyTraits {
+        static K lowest() { return std::numeric_limits<K>::min(); }
+        static K highest() { return std::numeric_limits<K>::max(); }
+        static K predecessor(const K& key) { return key == lowest() ? key : key - 1; }
+        static int64_t filterKey(const K& key) { return static_cast<int64_t>(key); }
+    };
+
+    template <>
+    struct KeyTraits<ResourceTimeKey> {
+        static ResourceTimeKey lowest() {
+            return { std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::min() };
+        }
+        static ResourceTimeKey highest() {
+            return { std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::max() };
+        }
+        static ResourceTimeKey predecessor(const ResourceTimeKey& key) {
+            if (key.timestamp_ms != std::numeric_limits<int64_t>::min()) {
+                return { key.resource_id, key.timestamp_ms - 1 };
+            }
+            if (key.resource_id != std::numeric_limits<int64_t>::min()) {
+                return { key.resource_id - 1, std::numeric_limits<int64_t>::max() };
+            }
+            return key;
+        }
+        static int64_t filterKey(const ResourceTimeKey& key) { return key.resource_id; }
+    };
+
+    template <>
+    struct KeyTraits<RollupKey> {
+        static RollupKey lowest() {
+            constexpr int64_t min = std::numeric_limits<int64_t>::min();
+            return { min, min, min };
+        }
+        static RollupKey highest() {
+            constexpr int64_t max = std::numeric_limits<int64_t>::max();
+            return { max, max, max };
+        }
+        static RollupKey predecessor(const RollupKey& key) {
+            constexpr int64_t min = std::numeric_limits<int64_t>::min();
+            constexpr int64_t max = std::numeric_limits<int64_t>::max();
+            if (key.event_code != min) {
+                return { key.bucket_start_ms, key.resource_id, key.event_code - 1 };
+            }
+            if (key.resource_id != min) {
+                return { key.bucket_start_ms, key.resource_id - 1, max };
+            }
+            if (key.bucket_start_ms != min) {
+                return { key.bucket_start_ms - 1, max, max };
+            }
+            return key;
+        }
+        static int64_t filterKey(const RollupKey& key) { return key.bucket_start_ms; }
+    };
+
+} // namespace cmse
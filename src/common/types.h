@@ -17,10 +17,21 @@ namespace cmse {
     using KeyType = int64_t;
     using ValueType = int64_t;    // Usually RecordID or offset (RID)
 
+    // Dense id of a record in the log store, assigned in ingest order (32-bit for bitmap indexes)
+    using record_id_t = uint32_t;
+
     // Constants
     constexpr page_id_t INVALID_PAGE_ID = -1;
-    constexpr int PAGE_SIZE = 4096; // 4KB Page Size
+    constexpr int PAGE_SIZE = 4096; // 4KB Page Size (default; see CMSE_FOR_EACH_PAGE_SIZE)
     constexpr version_t INVALID_VERSION = -1;
+    constexpr record_id_t INVALID_RECORD_ID = UINT32_MAX;
+
+    // Page sizes a file can use: BasicDiskManager and BasicBufferPoolManager are explicitly
+    // instantiated (and declared extern) for each by expanding X(size) over this list, as are
+    // the B+Tree (adapter and version manager) and the trie, whose node capacities follow the
+    // page size. The bitmap index and the LogStore lay their pages out for PAGE_SIZE; larger
+    // pages suit sequential, scan-heavy files.
+#define CMSE_FOR_EACH_PAGE_SIZE(X) X(4096) X(8192) X(16384) X(32768) X(65536)
 
     // --- Log Record Structure (Dataset) ---
     struct LogRecord {
@@ -8,7 +8,8 @@
 namespace cmse {
     namespace disk {
 
-        DiskManager::DiskManager(const std::string& db_file) : file_name_(db_file) {
+        template <size_t PageSize>
+        BasicDiskManager<PageSize>::BasicDiskManager(const std::string& db_file) : file_name_(db_file) {
             // 1. Check existence safely
             bool file_exists = std::filesystem::exists(file_name_);
 
@@ -46,7 +47,8 @@ namespace cmse {
             }
         }
 
-        DiskManager::~DiskManager() {
+        template <size_t PageSize>
+        BasicDiskManager<PageSize>::~BasicDiskManager() {
             if (db_file_ != nullptr) {
                 fflush(db_file_);
                 fclose(db_file_);
@@ -54,34 +56,38 @@ namespace cmse {
             }
         }
 
-        void DiskManager::ReadPage(page_id_t page_id, char* data) {
-            std::lock_guard<std::mutex> lock(db_io_latch_);
-            size_t offset = static_cast<size_t>(page_id) * PAGE_SIZE;
+        template <size_t PageSize>
+        void BasicDiskManager<PageSize>::ReadPage(page_id_t page_id, char* data) {
+            CMSE_LATENCY_SCOPE(read_latency_);
+            std::lock_guard<utils::Latch> lock(db_io_latch_);
+            size_t offset = static_cast<size_t>(page_id) * PageSize;
 
             fseek(db_file_, 0, SEEK_END);
             long file_size = ftell(db_file_);
 
             if (static_cast<long>(offset) >= file_size) {
-                std::memset(data, 0, PAGE_SIZE);
+                std::memset(data, 0, PageSize);
                 return;
             }
 
             fseek(db_file_, (long)offset, SEEK_SET);
-            size_t read_count = fread(data, 1, PAGE_SIZE, db_file_);
+            size_t read_count = fread(data, 1, PageSize, db_file_);
 
-            if (read_count < PAGE_SIZE) {
-                std::memset(data + read_count, 0, PAGE_SIZE - read_count);
+            if (read_count < PageSize) {
+                std::memset(data + read_count, 0, PageSize - read_count);
             }
         }
 
-        void DiskManager::WritePage(page_id_t page_id, const char* data) {
-            std::lock_guard<std::mutex> lock(db_io_latch_);
-            size_t offset = static_cast<size_t>(page_id) * PAGE_SIZE;
+        template <size_t PageSize>
+        void BasicDiskManager<PageSize>::WritePage(page_id_t page_id, const char* data) {
+            CMSE_LATENCY_SCOPE(write_latency_);
+            std::lock_guard<utils::Latch> lock(db_io_latch_);
+            size_t offset = static_cast<size_t>(page_id) * PageSize;
 
             fseek(db_file_, (long)offset, SEEK_SET);
-            size_t written = fwrite(data, 1, PAGE_SIZE, db_file_);
+            size_t written = fwrite(data, 1, PageSize, db_file_);
 
-            if (written != PAGE_SIZE) {
+            if (written != PageSize) {
                 throw std::runtime_error("I/O error while writing page");
             }
 
@@ -89,14 +95,29 @@ namespace cmse {
             num_flushes_++;
         }
 
-        page_id_t DiskManager::AllocatePage() {
-            std::lock_guard<std::mutex> lock(db_io_latch_);
+        template <size_t PageSize>
+        page_id_t BasicDiskManager<PageSize>::AllocatePage() {
+            std::lock_guard<utils::Latch> lock(db_io_latch_);
             return next_page_id_++;
         }
 
-        int DiskManager::GetNumFlushes() const {
+        template <size_t PageSize>
+        int BasicDiskManager<PageSize>::GetNumFlushes() const {
             return num_flushes_;
         }
 
+        template <size_t PageSize>
+        std::vector<utils::LatencySummary> BasicDiskManager<PageSize>::GetLatencySummaries() const {
+#ifdef CMSE_LATENCY_HISTOGRAMS
+            return { read_latency_.summarize(), write_latency_.summarize() };
+#else
+            return {};
+#endif
+        }
+
+#define CMSE_INSTANTIATE_DISK_MANAGER(size) template class BasicDiskManager<size>;
+        CMSE_FOR_EACH_PAGE_SIZE(CMSE_INSTANTIATE_DISK_MANAGER)
+#undef CMSE_INSTANTIATE_DISK_MANAGER
+
     } // namespace disk
 } // namespace cmse
\ No newline at end of file
@@ -3,7 +3,10 @@
 #include <string>
 #include <mutex>
 #include <cstdio> // FILE*, fopen_s, etc.
+#include <vector>
 #include "../common/types.h"
+#include "../utils/latch.h"
+#include "../utils/latency_histogram.h"
 
 namespace cmse {
     namespace disk {
@@ -11,28 +14,46 @@ namespace cmse {
         /**
          * DiskManager takes care of the allocation and deallocation of pages within a database.
          * It performs the reading and writing of pages to and from disk.
+         * A file has one page size, fixed by the template parameter (DiskManager: PAGE_SIZE).
+         * Instantiated (in disk_manager.cpp) for CMSE_FOR_EACH_PAGE_SIZE.
          */
-        class DiskManager {
+        template <size_t PageSize>
+        class BasicDiskManager {
         public:
-            explicit DiskManager(const std::string& db_file);
-            ~DiskManager();
+            explicit BasicDiskManager(const std::string& db_file);
+            ~BasicDiskManager();
 
-            DiskManager(const DiskManager&) = delete;
-            DiskManager& operator=(const DiskManager&) = delete;
+            BasicDiskManager(const BasicDiskManager&) = delete;
+            BasicDiskManager& operator=(const BasicDiskManager&) = delete;
 
             void ReadPage(page_id_t page_id, char* data);
             void WritePage(page_id_t page_id, const char* data);
             page_id_t AllocatePage();
             int GetNumFlushes() const;
 
+            // p50/p99/p999 latency of ReadPage and WritePage (including the fflush).
+            // Empty unless built with CMSE_ENABLE_LATENCY_HISTOGRAMS.
+            std::vector<utils::LatencySummary> GetLatencySummaries() const;
+
         private:
             std::string file_name_;
             FILE* db_file_ = nullptr;
 
             page_id_t next_page_id_ = 0;
             int num_flushes_ = 0;
-            std::mutex db_io_latch_;
+            utils::Latch db_io_latch_{ "disk_io" };
+
+#ifdef CMSE_LATENCY_HISTOGRAMS
+            utils::LatencyRecorder read_latency_{ "disk_read" };
+            utils::LatencyRecorder write_latency_{ "disk_write" };
+#endif
         };
 
+#define CMSE_EXTERN_DISK_MANAGER(size) extern template class BasicDiskManager<size>;
+        CMSE_FOR_EACH_PAGE_SIZE(CMSE_EXTERN_DISK_MANAGER)
+#undef CMSE_EXTERN_DISK_MANAGER
+
+        using DiskManager = BasicDiskManager<PAGE_SIZE>;
+
     } // namespace disk
 } // namespace cmse
\ No newline at end of file
@@ -0,0 +1,233 @@
+#include "bitmap_index.h"
+#include <algorithm>
+#include <cstring>
+
+namespace cmse::index {
+
+    BitmapIndex::BitmapIndex(adapter::BufferPoolAdapter* bpm) : bpm_(bpm) {}
+
+    std::string BitmapIndex::eventTypeOf(const LogRecord& record) {
+        const char* begin = record.event_type;
+        const char* end = std::find(begin, begin + sizeof(record.event_type), '\0');
+        return std::string(begin, end);
+    }
+
+    // =================================================================
+    // Maintenance
+    // =================================================================
+
+    void BitmapIndex::onIngest(record_id_t rid, const LogRecord& record) {
+        add(eventTypeOf(record), rid);
+    }
+
+    void BitmapIndex::add(const std::string& event_type, record_id_t rid) {
+        std::lock_guard<std::mutex> lock(latch_);
+        Entry& entry = entries_[event_type];
+        entry.bitmap.add(rid);
+        entry.dirty = true;
+    }
+
+    // =================================================================
+    // Queries
+    // =================================================================
+
+    RoaringBitmap BitmapIndex::lookup(const std::string& event_type) {
+        std::lock_guard<std::mutex> lock(latch_);
+        auto it = entries_.find(event_type);
+        return it == entries_.end() ? RoaringBitmap() : it->second.bitmap;
+    }
+
+    uint64_t BitmapIndex::cardinality(const std::string& event_type) {
+        std::lock_guard<std::mutex> lock(latch_);
+        auto it = entries_.find(event_type);
+        return it == entries_.end() ? 0 : it->second.bitmap.cardinality();
+    }
+
+    RoaringBitmap BitmapIndex::anyOf(const std::vector<std::string>& event_types) {
+        std::lock_guard<std::mutex> lock(latch_);
+        RoaringBitmap result;
+        for (const auto& type : event_types) {
+            auto it = entries_.find(type);
+            if (it != entries_.end()) {
+                result |= it->second.bitmap;
+            }
+        }
+        return result;
+    }
+
+    RoaringBitmap BitmapIndex::anyOf(const std::vector<std::string>& event_types, const RoaringBitmap& filter) {
+        // Intersect each type first: the OR then only touches the (small) filtered containers.
+        std::lock_guard<std::mutex> lock(latch_);
+        RoaringBitmap result;
+        for (const auto& type : event_types) {
+            auto it = entries_.find(type);
+            if (it != entries_.end()) {
+                result |= it->second.bitmap & filter;
+            }
+        }
+        return result;
+    }
+
+    std::vector<std::string> BitmapIndex::eventTypes() {
+        std::lock_guard<std::mutex> lock(latch_);
+        std::vector<std::string> types;
+        for (const auto& [type, entry] : entries_) {
+            types.push_back(type);
+        }
+        return types;
+    }
+
+    size_t BitmapIndex::sizeInBytes() {
+        std::lock_guard<std::mutex> lock(latch_);
+        size_t bytes = 0;
+        for (const auto& [type, entry] : entries_) {
+            bytes += entry.bitmap.sizeInBytes();
+        }
+        return bytes;
+    }
+
+    // =================================================================
+    // Persistence
+    // =================================================================
+
+    bool BitmapIndex::writeChain(Entry* entry) {
+        std::string bytes;
+        entry->bitmap.serialize(&bytes);
+        size_t needed = std::max<size_t>(1, (bytes.size() + BLOB_PAYLOAD - 1) / BLOB_PAYLOAD);
+
+        // Grow the chain first so every page knows its successor.
+        while (entry->chain.size() < needed) {
+            page_id_t page_id;
+            Page* page = bpm_->NewPage(page_id);
+            if (page == nullptr) {
+                return false;
+            }
+            bpm_->UnpinPage(page_id, true);
+            entry->chain.push_back(page_id);
+        }
+        entry->chain.resize(needed);
+
+        for (size_t i = 0; i < needed; ++i) {
+            Page* page = bpm_->FetchPage(entry->chain[i]);
+            if (page == nullptr) {
+                return false;
+            }
+            size_t offset = i * BLOB_PAYLOAD;
+            size_t length = std::min(BLOB_PAYLOAD, bytes.size() - std::min(bytes.size(), offset));
+
+            BlobHeader header{ i + 1 < needed ? entry->chain[i + 1] : INVALID_PAGE_ID, static_cast<uint32_t>(length) };
+            std::memcpy(page->GetData(), &header, sizeof(header));
+            if (length > 0) {
+                std::memcpy(page->GetData() + sizeof(header), bytes.data() + offset, length);
+            }
+            bpm_->UnpinPage(entry->chain[i], true);
+            bpm_->FlushPage(entry->chain[i]);
+        }
+
+        entry->byte_length = static_cast<uint32_t>(bytes.size());
+        entry->dirty = false;
+        return true;
+    }
+
+    page_id_t BitmapIndex::flush() {
+        std::lock_guard<std::mutex> lock(latch_);
+        if (entries_.size() > MAX_DIRECTORY_ENTRIES) {
+            return INVALID_PAGE_ID;
+        }
+
+        for (auto& [type, entry] : entries_) {
+            if (entry.dirty && !writeChain(&entry)) {
+                return INVALID_PAGE_ID;
+            }
+        }
+
+        Page* page = nullptr;
+        if (directory_page_id_ == INVALID_PAGE_ID) {
+            page = bpm_->NewPage(directory_page_id_);
+        }
+        else {
+            page = bpm_->FetchPage(directory_page_id_);
+        }
+        if (page == nullptr) {
+            return INVALID_PAGE_ID;
+        }
+
+        DirectoryHeader header{ DIRECTORY_MAGIC, static_cast<uint32_t>(entries_.size()) };
+        std::memcpy(page->GetData(), &header, sizeof(header));
+        DirectoryEntry* slots = reinterpret_cast<DirectoryEntry*>(page->GetData() + sizeof(header));
+        size_t i = 0;
+        for (const auto& [type, entry] : entries_) {
+            DirectoryEntry& slot = slots[i++];
+            std::memset(slot.event_type, 0, sizeof(slot.event_type));
+            std::memcpy(slot.event_type, type.data(), std::min(type.size(), sizeof(slot.event_type)));
+            slot.first_page_id = entry.chain.front();
+            slot.byte_length = entry.byte_length;
+        }
+        page->GetHeader()->key_count = header.entry_count;
+        bpm_->UnpinPage(directory_page_id_, true);
+        bpm_->FlushPage(directory_page_id_);
+        return directory_page_id_;
+    }
+
+    bool BitmapIndex::readChain(page_id_t first_page_id, uint32_t byte_length, Entry* entry) {
+        std::string bytes;
+        bytes.reserve(byte_length);
+        page_id_t page_id = first_page_id;
+
+        while (page_id != INVALID_PAGE_ID) {
+            if (entry->chain.size() > byte_length / BLOB_PAYLOAD + 1) {
+                return false; // Cycle or corrupt link
+            }
+            Page* page = bpm_->FetchPage(page_id);
+            if (page == nullptr) {
+                return false;
+            }
+            BlobHeader header;
+            std::memcpy(&header, page->GetData(), sizeof(header));
+            if (header.used > BLOB_PAYLOAD) {
+                bpm_->UnpinPage(page_id, false);
+                return false;
+            }
+            bytes.append(page->GetData() + sizeof(header), header.used);
+            bpm_->UnpinPage(page_id, false);
+
+            entry->chain.push_back(page_id);
+            page_id = header.next_page_id;
+        }
+
+        entry->byte_length = byte_length;
+        return bytes.size() == byte_length && RoaringBitmap::deserialize(bytes.data(), bytes.size(), &entry->bitmap);
+    }
+
+    bool BitmapIndex::load(page_id_t directory_page_id) {
+        std::lock_guard<std::mutex> lock(latch_);
+        Page* page = bpm_->FetchPage(directory_page_id);
+        if (page == nullptr) {
+            return false;
+        }
+
+        DirectoryHeader header;
+        std::memcpy(&header, page->GetData(), sizeof(header));
+        if (header.magic != DIRECTORY_MAGIC || header.entry_count > MAX_DIRECTORY_ENTRIES) {
+            bpm_->UnpinPage(directory_page_id, false);
+            return false;
+        }
+        std::vector<DirectoryEntry> slots(header.entry_count);
+        std::memcpy(slots.data(), page->GetData() + sizeof(header), sizeof(DirectoryEntry) * header.entry_count);
+        bpm_->UnpinPage(directory_page_id, false);
+
+        std::map<std::string, Entry> loaded;
+        for (const auto& slot : slots) {
+            const char* end = std::find(slot.event_type, slot.event_type + sizeof(slot.event_type), '\0');
+            Entry& entry = loaded[std::string(slot.event_type, end)];
+            if (!readChain(slot.first_page_id, slot.byte_length, &entry)) {
+                return false;
+            }
+        }
+
+        entries_ = std::move(loaded);
+        directory_page_id_ = directory_page_id;
+        return true;
+    }
+
+} // namespace cmse::index
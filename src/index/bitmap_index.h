@@ -0,0 +1,103 @@
+#pragma once
+#include "../common/types.h"
+#include "../adapter/bpm_adapter.h"
+#include "../storage/log_store.h"
+#include "roaring_bitmap.h"
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cmse::index {
+
+    /**
+     * BitmapIndex
+     * Secondary index on LogRecord::event_type: one RoaringBitmap of record ids per distinct
+     * event type. Registered as an IngestListener it is maintained incrementally as records are
+     * appended; queries combine bitmaps (OR across types, AND with e.g. LogStore::timeRange).
+     *
+     * Persistence: flush() writes the bitmaps that changed since the last flush to page chains
+     * and returns a directory page id from which load() rebuilds the index.
+     *   Directory page: [u32 magic][u32 entries] then entries {event_type[16], first_page_id, byte_length}
+     *   Blob page:      [next_page_id][u32 used] then serialized bitmap bytes
+     * Chains are rewritten in place and grown as needed; surplus pages are abandoned
+     * (no free-space map yet, as in VersionManager).
+     *
+     * Thread safety: all methods are internally synchronized; queries return copies.
+     */
+    class BitmapIndex : public storage::IngestListener {
+    public:
+        static constexpr uint32_t DIRECTORY_MAGIC = 0x424D4958; // "BMIX"
+
+        explicit BitmapIndex(adapter::BufferPoolAdapter* bpm);
+
+        void onIngest(record_id_t rid, const LogRecord& record) override;
+
+        void add(const std::string& event_type, record_id_t rid);
+
+        // Records of one event type (empty if never seen).
+        RoaringBitmap lookup(const std::string& event_type);
+
+        // Number of records of one event type (no copy; used for cost estimates).
+        uint64_t cardinality(const std::string& event_type);
+
+        // Records whose event type is any of 'event_types' (OR).
+        RoaringBitmap anyOf(const std::vector<std::string>& event_types);
+
+        // Records whose event type is any of 'event_types' AND whose id is in 'filter'
+        // (e.g. a LogStore::timeRange result).
+        RoaringBitmap anyOf(const std::vector<std::string>& event_types, const RoaringBitmap& filter);
+
+        std::vector<std::string> eventTypes();
+
+        // Serialized bytes of all bitmaps (the on-page footprint excluding headers).
+        size_t sizeInBytes();
+
+        // Writes dirty bitmaps and the directory to pages and flushes them.
+        // Returns the directory page id, or INVALID_PAGE_ID on buffer-pool failure or if there are
+        // more event types than fit in one directory page.
+        page_id_t flush();
+
+        // Replaces the in-memory state with the index stored at 'directory_page_id'.
+        bool load(page_id_t directory_page_id);
+
+        // Event type of a record as a string (event_type is not guaranteed to be terminated).
+        static std::string eventTypeOf(const LogRecord& record);
+
+    private:
+        struct DirectoryHeader {
+            uint32_t magic;
+            uint32_t entry_count;
+        };
+
+        struct DirectoryEntry {
+            char event_type[16];
+            page_id_t first_page_id;
+            uint32_t byte_length;
+        };
+
+        struct BlobHeader {
+            page_id_t next_page_id;
+            uint32_t used;
+        };
+
+        static constexpr size_t MAX_DIRECTORY_ENTRIES = (PAGE_SIZE - sizeof(PageHeader) - sizeof(DirectoryHeader)) / sizeof(DirectoryEntry);
+        static constexpr size_t BLOB_PAYLOAD = PAGE_SIZE - sizeof(PageHeader) - sizeof(BlobHeader);
+
+        struct Entry {
+            RoaringBitmap bitmap;
+            std::vector<page_id_t> chain; // Pages currently holding the serialized bitmap
+            uint32_t byte_length = 0;
+            bool dirty = false;
+        };
+
+        bool writeChain(Entry* entry);
+        bool readChain(page_id_t first_page_id, uint32_t byte_length, Entry* entry);
+
+        adapter::BufferPoolAdapter* bpm_;
+        std::map<std::string, Entry> entries_;
+        page_id_t directory_page_id_ = INVALID_PAGE_ID;
+        std::mutex latch_;
+    };
+
+} // namespace cmse::index
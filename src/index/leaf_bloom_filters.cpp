@@ -0,0 +1,210 @@
+#include "leaf_bloom_filters.h"
+#include "../common/hash.h"
+#include <algorithm>
+#include <cstring>
+
+namespace cmse::index {
+
+    namespace {
+        constexpr uint64_t BLOCK_BITS = LeafBloomFilters::BLOCK_BYTES * 8;
+        constexpr int BITS_PER_PROBE = 9; // log2(BLOCK_BITS)
+        static_assert(BLOCK_BITS == (uint64_t{ 1 } << BITS_PER_PROBE), "a probe indexes one block");
+        // The probes use the low bits of the hash and the block is chosen from the top four.
+        static_assert(LeafBloomFilters::PROBES * BITS_PER_PROBE <= 60, "not enough hash bits");
+        static_assert(LeafBloomFilters::BLOCKS_PER_FILTER <= 16, "not enough hash bits");
+    }
+
+    LeafBloomFilters::LeafBloomFilters(adapter::BufferPoolAdapter* bpm) : bpm_(bpm) {}
+
+    // =================================================================
+    // Hashing
+    // =================================================================
+
+    uint64_t LeafBloomFilters::hash(int64_t key) {
+        return Mix64(static_cast<uint64_t>(key));
+    }
+
+    void LeafBloomFilters::setBits(uint8_t* filter, int64_t key) {
+        uint64_t h = hash(key);
+        uint8_t* block = filter + ((h >> 60) % BLOCKS_PER_FILTER) * BLOCK_BYTES;
+        for (int i = 0; i < PROBES; ++i, h >>= BITS_PER_PROBE) {
+            uint64_t bit = h & (BLOCK_BITS - 1);
+            block[bit >> 3] |= static_cast<uint8_t>(1u << (bit & 7));
+        }
+    }
+
+    bool LeafBloomFilters::testBits(const uint8_t* filter, int64_t key) {
+        uint64_t h = hash(key);
+        const uint8_t* block = filter + ((h >> 60) % BLOCKS_PER_FILTER) * BLOCK_BYTES;
+        for (int i = 0; i < PROBES; ++i, h >>= BITS_PER_PROBE) {
+            uint64_t bit = h & (BLOCK_BITS - 1);
+            if ((block[bit >> 3] & (1u << (bit & 7))) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // =================================================================
+    // LeafFilter
+    // =================================================================
+
+    bool LeafBloomFilters::addLeaf(page_id_t leaf_page_id, const std::vector<int64_t>& filter_keys) {
+        std::lock_guard<std::mutex> lock(latch_);
+        if (slots_.count(leaf_page_id) > 0) {
+            return true; // Leaves are immutable once registered
+        }
+
+        uint32_t slot = static_cast<uint32_t>(leaves_.size());
+        bits_.resize(bits_.size() + FILTER_BYTES, 0);
+        uint8_t* filter = bits_.data() + static_cast<size_t>(slot) * FILTER_BYTES;
+        for (int64_t key : filter_keys) {
+            setBits(filter, key);
+        }
+        leaves_.push_back(leaf_page_id);
+        slots_.emplace(leaf_page_id, slot);
+        return true;
+    }
+
+    bool LeafBloomFilters::hasLeaf(page_id_t leaf_page_id) {
+        std::lock_guard<std::mutex> lock(latch_);
+        return slots_.count(leaf_page_id) > 0;
+    }
+
+    bool LeafBloomFilters::mayContain(page_id_t leaf_page_id, int64_t filter_key) {
+        std::lock_guard<std::mutex> lock(latch_);
+        auto it = slots_.find(leaf_page_id);
+        if (it == slots_.end()) {
+            return true;
+        }
+        bool maybe = testBits(bits_.data() + static_cast<size_t>(it->second) * FILTER_BYTES, filter_key);
+
+        stats_.probes++;
+        stats_.negatives += maybe ? 0 : 1;
+        return maybe;
+    }
+
+    // =================================================================
+    // Persistence
+    // =================================================================
+
+    bool LeafBloomFilters::writePage(size_t index) {
+        page_id_t page_id = pages_[index];
+        Page* page = bpm_->FetchPage(page_id);
+        if (page == nullptr) {
+            return false;
+        }
+
+        size_t first = index * FILTERS_PER_PAGE;
+        size_t count = std::min(FILTERS_PER_PAGE, leaves_.size() - first);
+        FilterPageHeader header{ index + 1 < pages_.size() ? pages_[index + 1] : INVALID_PAGE_ID, static_cast<uint32_t>(count) };
+        char* data = page->GetData();
+        std::memcpy(data, &header, sizeof(header));
+        std::memcpy(data + sizeof(header), leaves_.data() + first, count * sizeof(page_id_t));
+        std::memcpy(data + sizeof(header) + FILTERS_PER_PAGE * sizeof(page_id_t), bits_.data() + first * FILTER_BYTES, count * FILTER_BYTES);
+        page->GetHeader()->key_count = static_cast<uint32_t>(count);
+
+        bpm_->UnpinPage(page_id, true);
+        bpm_->FlushPage(page_id);
+        return true;
+    }
+
+    page_id_t LeafBloomFilters::flush() {
+        std::lock_guard<std::mutex> lock(latch_);
+        if (leaves_.empty()) {
+            return INVALID_PAGE_ID;
+        }
+
+        // The last flushed page is rewritten too: it may gain filters or a next link.
+        size_t first_dirty = std::min(flushed_slots_ / FILTERS_PER_PAGE, pages_.empty() ? 0 : pages_.size() - 1);
+        size_t needed = (leaves_.size() + FILTERS_PER_PAGE - 1) / FILTERS_PER_PAGE;
+        while (pages_.size() < needed) {
+            page_id_t page_id;
+            if (bpm_->NewPage(page_id) == nullptr) {
+                return INVALID_PAGE_ID;
+            }
+            bpm_->UnpinPage(page_id, true);
+            pages_.push_back(page_id);
+        }
+
+        for (size_t i = first_dirty; i < pages_.size(); ++i) {
+            if (!writePage(i)) {
+                return INVALID_PAGE_ID;
+            }
+        }
+        flushed_slots_ = leaves_.size();
+        return pages_.front();
+    }
+
+    bool LeafBloomFilters::load(page_id_t first_page_id) {
+        std::lock_guard<std::mutex> lock(latch_);
+        std::unordered_map<page_id_t, uint32_t> slots;
+        std::vector<page_id_t> leaves;
+        std::vector<uint8_t> bits;
+        std::vector<page_id_t> pages;
+
+        page_id_t page_id = first_page_id;
+        while (page_id != INVALID_PAGE_ID) {
+            if (std::find(pages.begin(), pages.end(), page_id) != pages.end()) {
+                return false; // Cycle
+            }
+            Page* page = bpm_->FetchPage(page_id);
+            if (page == nullptr) {
+                return false;
+            }
+            const char* data = page->GetData();
+            FilterPageHeader header;
+            std::memcpy(&header, data, sizeof(header));
+            // Only the last page of a chain may be partially filled.
+            if (header.count == 0 || header.count > FILTERS_PER_PAGE || (header.count < FILTERS_PER_PAGE && header.next_page_id != INVALID_PAGE_ID)) {
+                bpm_->UnpinPage(page_id, false);
+                return false;
+            }
+
+            size_t first = leaves.size();
+            leaves.resize(first + header.count);
+            bits.resize(leaves.size() * FILTER_BYTES);
+            std::memcpy(leaves.data() + first, data + sizeof(header), header.count * sizeof(page_id_t));
+            std::memcpy(bits.data() + first * FILTER_BYTES, data + sizeof(header) + FILTERS_PER_PAGE * sizeof(page_id_t), header.count * FILTER_BYTES);
+            bpm_->UnpinPage(page_id, false);
+
+            pages.push_back(page_id);
+            page_id = header.next_page_id;
+        }
+
+        for (size_t slot = 0; slot < leaves.size(); ++slot) {
+            slots.emplace(leaves[slot], static_cast<uint32_t>(slot));
+        }
+        slots_ = std::move(slots);
+        leaves_ = std::move(leaves);
+        bits_ = std::move(bits);
+        pages_ = std::move(pages);
+        flushed_slots_ = leaves_.size();
+        return true;
+    }
+
+    // =================================================================
+    // Introspection
+    // =================================================================
+
+    size_t LeafBloomFilters::leafCount() {
+        std::lock_guard<std::mutex> lock(latch_);
+        return slots_.size();
+    }
+
+    size_t LeafBloomFilters::pageCount() {
+        std::lock_guard<std::mutex> lock(latch_);
+        return (leaves_.size() + FILTERS_PER_PAGE - 1) / FILTERS_PER_PAGE;
+    }
+
+    LeafBloomFilters::Stats LeafBloomFilters::stats() {
+        std::lock_guard<std::mutex> lock(latch_);
+        return stats_;
+    }
+
+    void LeafBloomFilters::resetStats() {
+        std::lock_guard<std::mutex> lock(latch_);
+        stats_ = Stats();
+    }
+
+} // namespace cmse::index
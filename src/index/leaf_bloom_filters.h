@@ -0,0 +1,92 @@
+#pragma once
+#include "../common/types.h"
+#include "../adapter/bpm_adapter.h"
+#include "../adapter/leaf_filter.h"
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace cmse::index {
+
+    /**
+     * LeafBloomFilters
+     * Blocked Bloom filters over the leaves of a B+Tree (see adapter::LeafFilter), so lookups of
+     * keys that are absent skip the leaf fetch. Each leaf gets a fixed-size filter of
+     * BLOCKS_PER_FILTER cache-line blocks; a key sets (and a probe tests) PROBES bits inside a
+     * single block, so a probe touches one cache line. A full int64 leaf on 4KB pages
+     * (adapter::MAX_KEYS keys) gets ~8 bits per key, ~11 at the usual fill, about 1-2% false
+     * positives; leaves of larger pages get proportionally fewer bits per key.
+     *
+     * The filter bits live in memory next to the leaf -> slot directory (FILTER_BYTES per leaf),
+     * so a probe never costs a page fetch and the filters hold no buffer-pool frames however
+     * large the tree grows.
+     *
+     * Persistence: flush() packs the filters FILTERS_PER_PAGE to a page in a chain and returns
+     * its first page id, from which load() rebuilds them (as BitmapIndex does). Leaves are
+     * immutable once registered, so only the pages holding leaves added since the last flush are
+     * rewritten. Without a flushed chain, VersionManager::buildLeafFilters() registers the leaves
+     * of a committed version again.
+     *   Filter page: [next_page_id][u32 count] then page_id_t leaves[FILTERS_PER_PAGE],
+     *                then FILTERS_PER_PAGE x [u8 bits[FILTER_BYTES]]
+     *
+     * Thread safety: all methods are internally synchronized.
+     */
+    class LeafBloomFilters : public adapter::LeafFilter {
+    public:
+        static constexpr size_t BLOCK_BYTES = 64;       // One cache line
+        static constexpr size_t BLOCKS_PER_FILTER = 4;
+        static constexpr size_t FILTER_BYTES = BLOCK_BYTES * BLOCKS_PER_FILTER;
+        static constexpr int PROBES = 6;                 // Bits set per key
+
+        struct FilterPageHeader {
+            page_id_t next_page_id;
+            uint32_t count;
+        };
+        static constexpr size_t FILTERS_PER_PAGE =
+            (PAGE_SIZE - sizeof(PageHeader) - sizeof(FilterPageHeader)) / (sizeof(page_id_t) + FILTER_BYTES);
+
+        struct Stats {
+            uint64_t probes = 0;     // mayContain() calls on registered leaves
+            uint64_t negatives = 0;  // ... that ruled the leaf out (leaf fetches saved)
+        };
+
+        explicit LeafBloomFilters(adapter::BufferPoolAdapter* bpm);
+
+        bool addLeaf(page_id_t leaf_page_id, const std::vector<int64_t>& filter_keys) override;
+        bool hasLeaf(page_id_t leaf_page_id) override;
+        bool mayContain(page_id_t leaf_page_id, int64_t filter_key) override;
+
+        // Writes the filters added since the last flush to the page chain and flushes it.
+        // Returns the first page id, or INVALID_PAGE_ID on buffer-pool failure or while empty.
+        page_id_t flush();
+
+        // Replaces the in-memory state with the filters stored at 'first_page_id'.
+        bool load(page_id_t first_page_id);
+
+        size_t leafCount();
+
+        // Pages the filters occupy once flushed.
+        size_t pageCount();
+
+        Stats stats();
+        void resetStats();
+
+    private:
+        static uint64_t hash(int64_t key);
+        static void setBits(uint8_t* filter, int64_t key);
+        static bool testBits(const uint8_t* filter, int64_t key);
+
+        // Writes filter page 'index' (slots index * FILTERS_PER_PAGE onward) to pages_[index].
+        bool writePage(size_t index);
+
+        adapter::BufferPoolAdapter* bpm_;
+        std::unordered_map<page_id_t, uint32_t> slots_;  // Leaf page id -> filter slot
+        std::vector<page_id_t> leaves_;                  // Filter slot -> leaf page id
+        std::vector<uint8_t> bits_;                      // FILTER_BYTES per slot
+        std::vector<page_id_t> pages_;                   // Flushed chain, FILTERS_PER_PAGE slots each
+        size_t flushed_slots_ = 0;                       // Slots already on pages_
+        Stats stats_;
+        std::mutex latch_;
+    };
+
+} // namespace cmse::index
@@ -0,0 +1,422 @@
+#include "roaring_bitmap.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace cmse::index {
+
+    // =================================================================
+    // Bit Helpers
+    // =================================================================
+
+    int RoaringBitmap::countTrailingZeros(uint64_t word) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(word);
+#endif
+    }
+
+    int RoaringBitmap::popCount(uint64_t word) {
+#if defined(_MSC_VER)
+        return static_cast<int>(__popcnt64(word));
+#else
+        return __builtin_popcountll(word);
+#endif
+    }
+
+    // =================================================================
+    // Containers
+    // =================================================================
+
+    void RoaringBitmap::Container::toBitset() {
+        bits.assign(BITSET_WORDS, 0);
+        for (uint16_t low : array) {
+            bits[low >> 6] |= uint64_t{ 1 } << (low & 63);
+        }
+        array.clear();
+        array.shrink_to_fit();
+    }
+
+    void RoaringBitmap::Container::toArray() {
+        std::vector<uint16_t> values;
+        values.reserve(cardinality);
+        for (size_t w = 0; w < bits.size(); ++w) {
+            uint64_t word = bits[w];
+            while (word != 0) {
+                values.push_back(static_cast<uint16_t>(w * 64 + countTrailingZeros(word)));
+                word &= word - 1;
+            }
+        }
+        array = std::move(values);
+        bits.clear();
+        bits.shrink_to_fit();
+    }
+
+    RoaringBitmap::Container& RoaringBitmap::containerFor(uint16_t key) {
+        auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+            [](const Container& c, uint16_t k) { return c.key < k; });
+        if (it == containers_.end() || it->key != key) {
+            Container c;
+            c.key = key;
+            it = containers_.insert(it, std::move(c));
+        }
+        return *it;
+    }
+
+    const RoaringBitmap::Container* RoaringBitmap::findContainer(uint16_t key) const {
+        auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+            [](const Container& c, uint16_t k) { return c.key < k; });
+        return (it == containers_.end() || it->key != key) ? nullptr : &*it;
+    }
+
+    // =================================================================
+    // Point Operations
+    // =================================================================
+
+    void RoaringBitmap::add(uint32_t value) {
+        Container& c = containerFor(static_cast<uint16_t>(value >> 16));
+        uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+
+        if (c.isBitset()) {
+            uint64_t& word = c.bits[low >> 6];
+            uint64_t mask = uint64_t{ 1 } << (low & 63);
+            if ((word & mask) == 0) {
+                word |= mask;
+                c.cardinality++;
+            }
+            return;
+        }
+
+        // Ingest appends increasing ids, so check the tail before searching.
+        if (c.array.empty() || c.array.back() < low) {
+            c.array.push_back(low);
+        }
+        else {
+            auto it = std::lower_bound(c.array.begin(), c.array.end(), low);
+            if (*it == low) {
+                return;
+            }
+            c.array.insert(it, low);
+        }
+        c.cardinality++;
+        if (c.cardinality > ARRAY_MAX) {
+            c.toBitset();
+        }
+    }
+
+    void RoaringBitmap::addRange(uint32_t lo, uint32_t hi) {
+        if (hi < lo) {
+            return;
+        }
+        RoaringBitmap range;
+        for (uint32_t key = lo >> 16; key <= (hi >> 16); ++key) {
+            uint32_t first = key == (lo >> 16) ? (lo & 0xFFFF) : 0;
+            uint32_t last = key == (hi >> 16) ? (hi & 0xFFFF) : 0xFFFF;
+
+            Container c;
+            c.key = static_cast<uint16_t>(key);
+            c.cardinality = last - first + 1;
+            if (c.cardinality <= ARRAY_MAX) {
+                c.array.resize(c.cardinality);
+                for (uint32_t v = first; v <= last; ++v) {
+                    c.array[v - first] = static_cast<uint16_t>(v);
+                }
+            }
+            else {
+                c.bits.assign(BITSET_WORDS, 0);
+                for (uint32_t v = first; v <= last; ++v) {
+                    c.bits[v >> 6] |= uint64_t{ 1 } << (v & 63);
+                }
+            }
+            range.containers_.push_back(std::move(c));
+            if (key == 0xFFFF) {
+                break; // Avoid wrap-around of 'key'
+            }
+        }
+        *this |= range;
+    }
+
+    bool RoaringBitmap::contains(uint32_t value) const {
+        const Container* c = findContainer(static_cast<uint16_t>(value >> 16));
+        if (c == nullptr) {
+            return false;
+        }
+        uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+        if (c->isBitset()) {
+            return (c->bits[low >> 6] >> (low & 63)) & 1;
+        }
+        return std::binary_search(c->array.begin(), c->array.end(), low);
+    }
+
+    uint64_t RoaringBitmap::cardinality() const {
+        uint64_t total = 0;
+        for (const auto& c : containers_) {
+            total += c.cardinality;
+        }
+        return total;
+    }
+
+    // =================================================================
+    // Set Operations
+    // =================================================================
+
+    void RoaringBitmap::intersect(Container& a, const Container& b) {
+        if (a.isBitset() && b.isBitset()) {
+            uint32_t card = 0;
+            for (size_t w = 0; w < BITSET_WORDS; ++w) {
+                a.bits[w] &= b.bits[w];
+                card += static_cast<uint32_t>(popCount(a.bits[w]));
+            }
+            a.cardinality = card;
+            if (card <= ARRAY_MAX) {
+                a.toArray();
+            }
+            return;
+        }
+
+        std::vector<uint16_t> out;
+        if (a.isBitset()) {
+            // bitset & array: keep the array values present in the bitset.
+            for (uint16_t low : b.array) {
+                if ((a.bits[low >> 6] >> (low & 63)) & 1) {
+                    out.push_back(low);
+                }
+            }
+            a.bits.clear();
+            a.bits.shrink_to_fit();
+        }
+        else if (b.isBitset()) {
+            for (uint16_t low : a.array) {
+                if ((b.bits[low >> 6] >> (low & 63)) & 1) {
+                    out.push_back(low);
+                }
+            }
+        }
+        else {
+            std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), std::back_inserter(out));
+        }
+        a.array = std::move(out);
+        a.cardinality = static_cast<uint32_t>(a.array.size());
+    }
+
+    void RoaringBitmap::unite(Container& a, const Container& b) {
+        if (!a.isBitset() && !b.isBitset()) {
+            std::vector<uint16_t> out;
+            out.reserve(a.array.size() + b.array.size());
+            std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), std::back_inserter(out));
+            a.array = std::move(out);
+            a.cardinality = static_cast<uint32_t>(a.array.size());
+            if (a.cardinality > ARRAY_MAX) {
+                a.toBitset();
+            }
+            return;
+        }
+
+        if (!a.isBitset()) {
+            a.toBitset();
+        }
+        if (b.isBitset()) {
+            for (size_t w = 0; w < BITSET_WORDS; ++w) {
+                a.bits[w] |= b.bits[w];
+            }
+        }
+        else {
+            for (uint16_t low : b.array) {
+                a.bits[low >> 6] |= uint64_t{ 1 } << (low & 63);
+            }
+        }
+        uint32_t card = 0;
+        for (uint64_t word : a.bits) {
+            card += static_cast<uint32_t>(popCount(word));
+        }
+        a.cardinality = card;
+    }
+
+    RoaringBitmap& RoaringBitmap::operator&=(const RoaringBitmap& other) {
+        std::vector<Container> out;
+        size_t j = 0;
+        for (auto& c : containers_) {
+            while (j < other.containers_.size() && other.containers_[j].key < c.key) {
+                ++j;
+            }
+            if (j == other.containers_.size()) {
+                break;
+            }
+            if (other.containers_[j].key != c.key) {
+                continue;
+            }
+            intersect(c, other.containers_[j]);
+            if (c.cardinality > 0) {
+                out.push_back(std::move(c));
+            }
+        }
+        containers_ = std::move(out);
+        return *this;
+    }
+
+    RoaringBitmap& RoaringBitmap::operator|=(const RoaringBitmap& other) {
+        std::vector<Container> out;
+        out.reserve(containers_.size() + other.containers_.size());
+        size_t i = 0;
+        size_t j = 0;
+        while (i < containers_.size() || j < other.containers_.size()) {
+            if (j == other.containers_.size() || (i < containers_.size() && containers_[i].key < other.containers_[j].key)) {
+                out.push_back(std::move(containers_[i++]));
+            }
+            else if (i == containers_.size() || other.containers_[j].key < containers_[i].key) {
+                out.push_back(other.containers_[j++]);
+            }
+            else {
+                unite(containers_[i], other.containers_[j++]);
+                out.push_back(std::move(containers_[i++]));
+            }
+        }
+        containers_ = std::move(out);
+        return *this;
+    }
+
+    bool RoaringBitmap::operator==(const RoaringBitmap& other) const {
+        if (containers_.size() != other.containers_.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < containers_.size(); ++i) {
+            const Container& a = containers_[i];
+            const Container& b = other.containers_[i];
+            if (a.key != b.key || a.cardinality != b.cardinality) {
+                return false;
+            }
+            // Equal cardinality => same representation (conversions depend only on cardinality),
+            // except for bitsets created by addRange/OR that shrank below ARRAY_MAX; compare values.
+            if (a.isBitset() == b.isBitset()) {
+                if (a.array != b.array || a.bits != b.bits) {
+                    return false;
+                }
+            }
+            else {
+                const Container& arr = a.isBitset() ? b : a;
+                const Container& bs = a.isBitset() ? a : b;
+                for (uint16_t low : arr.array) {
+                    if (((bs.bits[low >> 6] >> (low & 63)) & 1) == 0) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    std::vector<uint32_t> RoaringBitmap::toVector() const {
+        std::vector<uint32_t> out;
+        out.reserve(cardinality());
+        forEach([&out](uint32_t v) { out.push_back(v); });
+        return out;
+    }
+
+    size_t RoaringBitmap::sizeInBytes() const {
+        size_t bytes = 0;
+        for (const auto& c : containers_) {
+            bytes += c.isBitset() ? BITSET_WORDS * sizeof(uint64_t) : c.array.size() * sizeof(uint16_t);
+        }
+        return bytes;
+    }
+
+    // =================================================================
+    // Serialization
+    // =================================================================
+
+    namespace {
+        template <typename T>
+        void put(std::string* out, T value) {
+            char buf[sizeof(T)];
+            for (size_t i = 0; i < sizeof(T); ++i) {
+                buf[i] = static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF);
+            }
+            out->append(buf, sizeof(T));
+        }
+
+        template <typename T>
+        bool get(const char* data, size_t size, size_t* pos, T* value) {
+            if (*pos + sizeof(T) > size) {
+                return false;
+            }
+            uint64_t v = 0;
+            for (size_t i = 0; i < sizeof(T); ++i) {
+                v |= static_cast<uint64_t>(static_cast<unsigned char>(data[*pos + i])) << (8 * i);
+            }
+            *value = static_cast<T>(v);
+            *pos += sizeof(T);
+            return true;
+        }
+    }
+
+    void RoaringBitmap::serialize(std::string* out) const {
+        put<uint32_t>(out, static_cast<uint32_t>(containers_.size()));
+        for (const auto& c : containers_) {
+            put<uint16_t>(out, c.key);
+            put<uint8_t>(out, c.isBitset() ? 1 : 0);
+            put<uint32_t>(out, c.cardinality);
+            if (c.isBitset()) {
+                for (uint64_t word : c.bits) {
+                    put<uint64_t>(out, word);
+                }
+            }
+            else {
+                for (uint16_t low : c.array) {
+                    put<uint16_t>(out, low);
+                }
+            }
+        }
+    }
+
+    bool RoaringBitmap::deserialize(const char* data, size_t size, RoaringBitmap* out) {
+        size_t pos = 0;
+        uint32_t count = 0;
+        if (!get(data, size, &pos, &count)) {
+            return false;
+        }
+
+        RoaringBitmap result;
+        result.containers_.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            Container c;
+            uint8_t is_bitset = 0;
+            if (!get(data, size, &pos, &c.key) || !get(data, size, &pos, &is_bitset) || !get(data, size, &pos, &c.cardinality)) {
+                return false;
+            }
+            if (!result.containers_.empty() && result.containers_.back().key >= c.key) {
+                return false; // Keys must be strictly increasing
+            }
+            if (is_bitset) {
+                c.bits.resize(BITSET_WORDS);
+                for (auto& word : c.bits) {
+                    if (!get(data, size, &pos, &word)) {
+                        return false;
+                    }
+                }
+            }
+            else {
+                if (c.cardinality > ARRAY_MAX) {
+                    return false;
+                }
+                c.array.resize(c.cardinality);
+                for (auto& low : c.array) {
+                    if (!get(data, size, &pos, &low)) {
+                        return false;
+                    }
+                }
+            }
+            result.containers_.push_back(std::move(c));
+        }
+
+        *out = std::move(result);
+        return true;
+    }
+
+} // namespace cmse::index
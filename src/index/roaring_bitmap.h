@@ -0,0 +1,116 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace cmse::index {
+
+    /**
+     * RoaringBitmap
+     * Compressed set of 32-bit integers (Chambi et al., "Better bitmap performance with
+     * Roaring bitmaps"). Values are partitioned by their high 16 bits into containers;
+     * a container holds the low 16 bits either as a sorted array (sparse, <= 4096 values)
+     * or as a 65536-bit bitset (dense), whichever is smaller.
+     *
+     * Not thread-safe; owners (e.g. BitmapIndex) synchronize access.
+     */
+    class RoaringBitmap {
+    public:
+        // Array containers above this size are converted to bitsets (both are 8 KB here).
+        static constexpr size_t ARRAY_MAX = 4096;
+
+        void add(uint32_t value);
+
+        // Adds every value in [lo, hi] (inclusive).
+        void addRange(uint32_t lo, uint32_t hi);
+
+        bool contains(uint32_t value) const;
+        uint64_t cardinality() const;
+        bool empty() const { return containers_.empty(); }
+        void clear() { containers_.clear(); }
+
+        RoaringBitmap& operator&=(const RoaringBitmap& other);
+        RoaringBitmap& operator|=(const RoaringBitmap& other);
+        friend RoaringBitmap operator&(RoaringBitmap a, const RoaringBitmap& b) { return a &= b; }
+        friend RoaringBitmap operator|(RoaringBitmap a, const RoaringBitmap& b) { return a |= b; }
+
+        bool operator==(const RoaringBitmap& other) const;
+        bool operator!=(const RoaringBitmap& other) const { return !(*this == other); }
+
+        // Calls fn(value) for every value in ascending order.
+        // If fn returns bool, returning false stops the iteration.
+        template <typename Fn>
+        void forEach(Fn&& fn) const {
+            auto visit = [&fn](uint32_t value) {
+                if constexpr (std::is_same_v<std::invoke_result_t<Fn&, uint32_t>, bool>) {
+                    return fn(value);
+                }
+                else {
+                    fn(value);
+                    return true;
+                }
+            };
+            for (const auto& c : containers_) {
+                uint32_t high = static_cast<uint32_t>(c.key) << 16;
+                if (!c.isBitset()) {
+                    for (uint16_t low : c.array) {
+                        if (!visit(high | low)) {
+                            return;
+                        }
+                    }
+                    continue;
+                }
+                for (size_t w = 0; w < c.bits.size(); ++w) {
+                    uint64_t word = c.bits[w];
+                    while (word != 0) {
+                        int bit = countTrailingZeros(word);
+                        if (!visit(high | static_cast<uint32_t>(w * 64 + bit))) {
+                            return;
+                        }
+                        word &= word - 1;
+                    }
+                }
+            }
+        }
+
+        std::vector<uint32_t> toVector() const;
+
+        // Bytes of container payload (the compressed footprint, excluding std::vector overhead).
+        size_t sizeInBytes() const;
+        size_t containerCount() const { return containers_.size(); }
+
+        // Portable little-endian serialization:
+        // [u32 containers] then per container [u16 key][u8 is_bitset][u32 cardinality][payload].
+        void serialize(std::string* out) const;
+        static bool deserialize(const char* data, size_t size, RoaringBitmap* out);
+
+    private:
+        static constexpr size_t BITSET_WORDS = 65536 / 64;
+
+        struct Container {
+            uint16_t key = 0;
+            uint32_t cardinality = 0;
+            std::vector<uint16_t> array;  // Used while sparse (sorted)
+            std::vector<uint64_t> bits;   // Used while dense (BITSET_WORDS words)
+
+            bool isBitset() const { return !bits.empty(); }
+            void toBitset();
+            void toArray();
+        };
+
+        static int countTrailingZeros(uint64_t word);
+        static int popCount(uint64_t word);
+
+        // Container for 'key', created if absent.
+        Container& containerFor(uint16_t key);
+        const Container* findContainer(uint16_t key) const;
+
+        static void intersect(Container& a, const Container& b);
+        static void unite(Container& a, const Container& b);
+
+        std::vector<Container> containers_; // Sorted by key
+    };
+
+} // namespace cmse::index
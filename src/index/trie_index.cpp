@@ -0,0 +1,407 @@
+#include "trie_index.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace cmse::index {
+
+    template <size_t PageSize>
+    BasicTrieIndex<PageSize>::BasicTrieIndex(BufferPoolAdapter* bpm) : bpm_(bpm) {}
+
+    template <size_t PageSize>
+    std::string BasicTrieIndex<PageSize>::resourceNameOf(const LogRecord& record) {
+        const char* begin = record.resource_name;
+        const char* end = std::find(begin, begin + sizeof(record.resource_name), '\0');
+        return std::string(begin, end);
+    }
+
+    // =================================================================
+    // Maintenance
+    // =================================================================
+
+    template <size_t PageSize>
+    void BasicTrieIndex<PageSize>::onIngest(record_id_t /*rid*/, const LogRecord& record) {
+        insert(resourceNameOf(record), record.resource_id);
+    }
+
+    template <size_t PageSize>
+    bool BasicTrieIndex<PageSize>::insert(const std::string& key, ValueType value) {
+        std::lock_guard<std::mutex> lock(latch_);
+
+        if (root_page_id_ == INVALID_PAGE_ID) {
+            page_id_t root_id;
+            Page* root = bpm_->NewPage(root_id);
+            if (root == nullptr) {
+                return false;
+            }
+            adapter_.initNode(root);
+            bpm_->UnpinPage(root_id, true);
+            root_page_id_ = root_id;
+            nodes_.push_back(root_id);
+        }
+
+        // Walk (and extend) the path of 'key', remembering it for the count update.
+        std::vector<page_id_t> path{ root_page_id_ };
+        page_id_t current = root_page_id_;
+        for (char c : key) {
+            Page* page = bpm_->FetchPage(current);
+            if (page == nullptr) {
+                return false;
+            }
+            page_id_t child_id = adapter_.findChild(page, c);
+            if (child_id != INVALID_PAGE_ID) {
+                bpm_->UnpinPage(current, false);
+            }
+            else {
+                Page* child = bpm_->NewPage(child_id);
+                if (child == nullptr) {
+                    bpm_->UnpinPage(current, false);
+                    return false;
+                }
+                adapter_.initNode(child);
+                bool linked = adapter_.insertChild(page, c, child_id);
+                bpm_->UnpinPage(child_id, true);
+                bpm_->UnpinPage(current, linked);
+                if (!linked) {
+                    return false; // The new page is abandoned (no free-space map yet)
+                }
+                nodes_.push_back(child_id);
+            }
+            path.push_back(child_id);
+            current = child_id;
+        }
+
+        Page* node = bpm_->FetchPage(current);
+        if (node == nullptr) {
+            return false;
+        }
+        if (adapter_.isTerminal(node)) {
+            bool listed = adapter_.getValue(node) == value;
+            page_id_t postings = adapter_.getPostingsPage(node);
+            bpm_->UnpinPage(current, false);
+            return listed || addPosting(current, postings, value);
+        }
+        adapter_.setTerminal(node, true, value);
+        bpm_->UnpinPage(current, true);
+
+        // A new key adds one terminal to every subtree on its path (including its own node).
+        for (page_id_t page_id : path) {
+            Page* page = bpm_->FetchPage(page_id);
+            if (page == nullptr) {
+                return false;
+            }
+            adapter_.adjustSubtreeCount(page, 1);
+            bpm_->UnpinPage(page_id, true);
+        }
+        return true;
+    }
+
+    template <size_t PageSize>
+    bool BasicTrieIndex<PageSize>::addPosting(page_id_t node_id, page_id_t first_page_id, ValueType value) {
+        // Skip values already listed; append to the last page if it has room.
+        page_id_t last_page_id = INVALID_PAGE_ID;
+        for (page_id_t page_id = first_page_id; page_id != INVALID_PAGE_ID;) {
+            Page* page = bpm_->FetchPage(page_id);
+            if (page == nullptr) {
+                return false;
+            }
+            int count = adapter_.getPostingCount(page);
+            for (int i = 0; i < count; ++i) {
+                if (adapter_.getPostingAt(page, i) == value) {
+                    bpm_->UnpinPage(page_id, false);
+                    return true;
+                }
+            }
+            page_id_t next_page_id = adapter_.getNextPostings(page);
+            if (next_page_id == INVALID_PAGE_ID && adapter_.appendPosting(page, value)) {
+                bpm_->UnpinPage(page_id, true);
+                return true;
+            }
+            bpm_->UnpinPage(page_id, false);
+            last_page_id = page_id;
+            page_id = next_page_id;
+        }
+
+        // No chain yet, or its last page is full: link a new page from the node or that page.
+        page_id_t new_page_id;
+        Page* new_page = bpm_->NewPage(new_page_id);
+        if (new_page == nullptr) {
+            return false;
+        }
+        adapter_.initPostings(new_page);
+        adapter_.appendPosting(new_page, value);
+        bpm_->UnpinPage(new_page_id, true);
+
+        page_id_t link_id = last_page_id != INVALID_PAGE_ID ? last_page_id : node_id;
+        Page* link = bpm_->FetchPage(link_id);
+        if (link == nullptr) {
+            return false; // The new page is abandoned (no free-space map yet)
+        }
+        if (last_page_id != INVALID_PAGE_ID) {
+            adapter_.setNextPostings(link, new_page_id);
+        }
+        else {
+            adapter_.setPostingsPage(link, new_page_id);
+        }
+        bpm_->UnpinPage(link_id, true);
+        postings_.push_back(new_page_id);
+        return true;
+    }
+
+    // =================================================================
+    // Queries
+    // =================================================================
+
+    template <size_t PageSize>
+    page_id_t BasicTrieIndex<PageSize>::findNode(const std::string& prefix, bool* ok) {
+        *ok = true;
+        page_id_t current = root_page_id_;
+        for (size_t i = 0; i < prefix.size() && current != INVALID_PAGE_ID; ++i) {
+            Page* page = bpm_->FetchPage(current);
+            if (page == nullptr) {
+                *ok = false;
+                return INVALID_PAGE_ID;
+            }
+            page_id_t child_id = adapter_.findChild(page, prefix[i]);
+            bpm_->UnpinPage(current, false);
+            current = child_id;
+        }
+        return current;
+    }
+
+    template <size_t PageSize>
+    bool BasicTrieIndex<PageSize>::lookup(const std::string& key, ValueType* out_val) {
+        std::lock_guard<std::mutex> lock(latch_);
+        bool ok;
+        page_id_t node_id = findNode(key, &ok);
+        if (node_id == INVALID_PAGE_ID) {
+            return false;
+        }
+        Page* node = bpm_->FetchPage(node_id);
+        if (node == nullptr) {
+            return false;
+        }
+        bool found = adapter_.isTerminal(node);
+        if (found && out_val != nullptr) {
+            *out_val = adapter_.getValue(node);
+        }
+        bpm_->UnpinPage(node_id, false);
+        return found;
+    }
+
+    template <size_t PageSize>
+    bool BasicTrieIndex<PageSize>::lookupAll(const std::string& key, std::vector<ValueType>* out) {
+        std::lock_guard<std::mutex> lock(latch_);
+        bool ok;
+        page_id_t node_id = findNode(key, &ok);
+        if (node_id == INVALID_PAGE_ID) {
+            return false;
+        }
+        Page* node = bpm_->FetchPage(node_id);
+        if (node == nullptr) {
+            return false;
+        }
+        bool found = adapter_.isTerminal(node);
+        page_id_t postings = INVALID_PAGE_ID;
+        if (found) {
+            out->push_back(adapter_.getValue(node));
+            postings = adapter_.getPostingsPage(node);
+        }
+        bpm_->UnpinPage(node_id, false);
+        return found && readPostings(postings, SIZE_MAX, out);
+    }
+
+    template <size_t PageSize>
+    bool BasicTrieIndex<PageSize>::readPostings(page_id_t first_page_id, size_t max_count, std::vector<ValueType>* out) {
+        for (page_id_t page_id = first_page_id; page_id != INVALID_PAGE_ID && out->size() < max_count;) {
+            Page* page = bpm_->FetchPage(page_id);
+            if (page == nullptr) {
+                return false;
+            }
+            int count = adapter_.getPostingCount(page);
+            for (int i = 0; i < count && out->size() < max_count; ++i) {
+                out->push_back(adapter_.getPostingAt(page, i));
+            }
+            page_id_t next_page_id = adapter_.getNextPostings(page);
+            bpm_->UnpinPage(page_id, false);
+            page_id = next_page_id;
+        }
+        return true;
+    }
+
+    template <size_t PageSize>
+    int64_t BasicTrieIndex<PageSize>::prefixCount(const std::string& prefix) {
+        std::lock_guard<std::mutex> lock(latch_);
+        bool ok;
+        page_id_t node_id = findNode(prefix, &ok);
+        if (node_id == INVALID_PAGE_ID) {
+            return 0;
+        }
+        Page* node = bpm_->FetchPage(node_id);
+        if (node == nullptr) {
+            return 0;
+        }
+        int64_t count = adapter_.getSubtreeCount(node);
+        bpm_->UnpinPage(node_id, false);
+        return count;
+    }
+
+    template <size_t PageSize>
+    bool BasicTrieIndex<PageSize>::prefixScan(const std::string& prefix, size_t max_count, std::vector<Entry>* out) {
+        std::lock_guard<std::mutex> lock(latch_);
+        bool ok;
+        page_id_t node_id = findNode(prefix, &ok);
+        if (node_id == INVALID_PAGE_ID || max_count == 0) {
+            return ok;
+        }
+        std::string key = prefix;
+        return scanNode(node_id, &key, out->size() + max_count, out);
+    }
+
+    template <size_t PageSize>
+    bool BasicTrieIndex<PageSize>::scanNode(page_id_t page_id, std::string* key, size_t max_count, std::vector<Entry>* out) {
+        Page* page = bpm_->FetchPage(page_id);
+        if (page == nullptr) {
+            return false;
+        }
+        page_id_t postings = INVALID_PAGE_ID;
+        if (adapter_.isTerminal(page)) {
+            out->emplace_back(*key, adapter_.getValue(page));
+            postings = adapter_.getPostingsPage(page);
+        }
+        // Copy the edges and unpin first, so only one page is pinned at a time.
+        std::vector<adapter::TrieNodeEntry> children;
+        int count = adapter_.getChildCount(page);
+        children.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            children.push_back(adapter_.getChildAt(page, i));
+        }
+        bpm_->UnpinPage(page_id, false);
+
+        if (postings != INVALID_PAGE_ID && out->size() < max_count) {
+            std::vector<ValueType> values;
+            if (!readPostings(postings, max_count - out->size(), &values)) {
+                return false;
+            }
+            for (ValueType value : values) {
+                out->emplace_back(*key, value);
+            }
+        }
+
+        for (const auto& child : children) {
+            if (out->size() >= max_count) {
+                break;
+            }
+            key->push_back(child.key_char);
+            bool ok = scanNode(child.child_page_id, key, max_count, out);
+            key->pop_back();
+            if (!ok) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <size_t PageSize>
+    int64_t BasicTrieIndex<PageSize>::size() {
+        std::lock_guard<std::mutex> lock(latch_);
+        if (root_page_id_ == INVALID_PAGE_ID) {
+            return 0;
+        }
+        Page* root = bpm_->FetchPage(root_page_id_);
+        if (root == nullptr) {
+            return 0;
+        }
+        int64_t count = adapter_.getSubtreeCount(root);
+        bpm_->UnpinPage(root_page_id_, false);
+        return count;
+    }
+
+    template <size_t PageSize>
+    size_t BasicTrieIndex<PageSize>::nodeCount() {
+        std::lock_guard<std::mutex> lock(latch_);
+        return nodes_.size();
+    }
+
+    template <size_t PageSize>
+    size_t BasicTrieIndex<PageSize>::postingPageCount() {
+        std::lock_guard<std::mutex> lock(latch_);
+        return postings_.size();
+    }
+
+    // =================================================================
+    // Persistence
+    // =================================================================
+
+    template <size_t PageSize>
+    page_id_t BasicTrieIndex<PageSize>::flush() {
+        std::lock_guard<std::mutex> lock(latch_);
+        for (page_id_t page_id : nodes_) {
+            bpm_->FlushPage(page_id);
+        }
+        for (page_id_t page_id : postings_) {
+            bpm_->FlushPage(page_id);
+        }
+        return root_page_id_;
+    }
+
+    template <size_t PageSize>
+    bool BasicTrieIndex<PageSize>::load(page_id_t root_page_id) {
+        std::lock_guard<std::mutex> lock(latch_);
+        nodes_.clear();
+        postings_.clear();
+        root_page_id_ = INVALID_PAGE_ID;
+        if (root_page_id == INVALID_PAGE_ID) {
+            return true;
+        }
+        if (!collectNodes(root_page_id)) {
+            nodes_.clear();
+            postings_.clear();
+            return false;
+        }
+        root_page_id_ = root_page_id;
+        return true;
+    }
+
+    template <size_t PageSize>
+    bool BasicTrieIndex<PageSize>::collectNodes(page_id_t page_id) {
+        Page* page = bpm_->FetchPage(page_id);
+        if (page == nullptr) {
+            return false;
+        }
+        nodes_.push_back(page_id);
+        page_id_t postings = adapter_.isTerminal(page) ? adapter_.getPostingsPage(page) : INVALID_PAGE_ID;
+        std::vector<page_id_t> children;
+        int count = adapter_.getChildCount(page);
+        for (int i = 0; i < count; ++i) {
+            children.push_back(adapter_.getChildAt(page, i).child_page_id);
+        }
+        bpm_->UnpinPage(page_id, false);
+
+        while (postings != INVALID_PAGE_ID) {
+            Page* posting_page = bpm_->FetchPage(postings);
+            if (posting_page == nullptr) {
+                return false;
+            }
+            postings_.push_back(postings);
+            page_id_t next_page_id = adapter_.getNextPostings(posting_page);
+            bpm_->UnpinPage(postings, false);
+            postings = next_page_id;
+        }
+
+        for (page_id_t child_id : children) {
+            if (!collectNodes(child_id)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // =================================================================
+    // Instantiations
+    // =================================================================
+
+#define CMSE_INSTANTIATE_TRIE_INDEX(size) template class BasicTrieIndex<size>;
+    CMSE_FOR_EACH_PAGE_SIZE(CMSE_INSTANTIATE_TRIE_INDEX)
+#undef CMSE_INSTANTIATE_TRIE_INDEX
+
+} // namespace cmse::index
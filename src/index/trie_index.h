@@ -0,0 +1,107 @@
+#pragma once
+#include "../common/types.h"
+#include "../adapter/bpm_adapter.h"
+#include "../adapter/trie_adapter.h"
+#include "../storage/log_store.h"
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cmse::index {
+
+    /**
+     * TrieIndex
+     * Page-backed trie over LogRecord::resource_name (one page per node, see adapter::TrieAdapter).
+     * Each distinct name is a terminal holding every resource_id seen with it: the first in the
+     * node, any others in a chain of posting pages (none in the common one-id-per-name case).
+     * Registered as an IngestListener it is maintained incrementally; a (name, id) pair already
+     * present only costs the walk (plus a pass over the name's posting pages, if it has any).
+     *
+     * Every node keeps the number of terminals below it (subtree_terminals), so the number of
+     * names under a prefix is known after reading prefix.size() + 1 pages, without visiting the
+     * subtree. The query planner uses this to estimate the selectivity of name-prefix predicates.
+     *
+     * Nodes are written in place (creation_version 0, outside any version). flush() writes them
+     * back and returns the root page id, from which load() reopens the index.
+     *
+     * PageSize is the page size of the pool holding the nodes; instantiated for
+     * CMSE_FOR_EACH_PAGE_SIZE (TrieIndex: PAGE_SIZE).
+     *
+     * Thread safety: all methods are internally synchronized.
+     */
+    template <size_t PageSize = PAGE_SIZE>
+    class BasicTrieIndex : public storage::IngestListener {
+    public:
+        using Page = BasicPage<PageSize>;
+        using BufferPoolAdapter = adapter::BasicBufferPoolAdapter<PageSize>;
+        using Entry = std::pair<std::string, ValueType>;
+
+        explicit BasicTrieIndex(BufferPoolAdapter* bpm);
+
+        void onIngest(record_id_t rid, const LogRecord& record) override;
+
+        // Adds 'value' to the values of 'key' (no-op if it is already one of them). Returns false
+        // on buffer-pool failure or if a node cannot take another child.
+        bool insert(const std::string& key, ValueType value);
+
+        // First value inserted for 'key'. Returns false if 'key' is not present (or on
+        // buffer-pool failure).
+        bool lookup(const std::string& key, ValueType* out_val);
+
+        // Appends every value of 'key', in insertion order. Returns false if 'key' is not present
+        // or a page could not be fetched.
+        bool lookupAll(const std::string& key, std::vector<ValueType>* out);
+
+        // Number of keys starting with 'prefix' ("" = all keys); 0 on buffer-pool failure.
+        int64_t prefixCount(const std::string& prefix);
+
+        // Appends up to 'max_count' (key, value) entries whose key starts with 'prefix': keys in
+        // unsigned byte order, one entry per value of a key. Returns false if a page could not be
+        // fetched (the output then holds a prefix).
+        bool prefixScan(const std::string& prefix, size_t max_count, std::vector<Entry>* out);
+
+        // Number of distinct keys.
+        int64_t size();
+        size_t nodeCount();
+        size_t postingPageCount();
+
+        // Writes every node back. Returns the root page id (INVALID_PAGE_ID while empty).
+        page_id_t flush();
+
+        // Replaces the in-memory state with the trie rooted at 'root_page_id'.
+        bool load(page_id_t root_page_id);
+
+        // Resource name of a record as a string (resource_name is not guaranteed to be terminated).
+        static std::string resourceNameOf(const LogRecord& record);
+
+    private:
+        // Page of the node reached by 'prefix', or INVALID_PAGE_ID if there is none.
+        // Sets *ok to false on buffer-pool failure.
+        page_id_t findNode(const std::string& prefix, bool* ok);
+
+        // Adds 'value' to the posting chain of a terminal whose node value differs.
+        bool addPosting(page_id_t node_id, page_id_t first_page_id, ValueType value);
+
+        // Appends the values of the posting chain starting at 'first_page_id' until 'out' holds
+        // 'max_count' values.
+        bool readPostings(page_id_t first_page_id, size_t max_count, std::vector<ValueType>* out);
+
+        bool scanNode(page_id_t page_id, std::string* key, size_t max_count, std::vector<Entry>* out);
+        bool collectNodes(page_id_t page_id);
+
+        BufferPoolAdapter* bpm_;
+        adapter::BasicTrieAdapter<PageSize> adapter_;
+        page_id_t root_page_id_ = INVALID_PAGE_ID;
+        std::vector<page_id_t> nodes_;
+        std::vector<page_id_t> postings_;  // Posting pages of all terminals
+        std::mutex latch_;
+    };
+
+#define CMSE_EXTERN_TRIE_INDEX(size) extern template class BasicTrieIndex<size>;
+    CMSE_FOR_EACH_PAGE_SIZE(CMSE_EXTERN_TRIE_INDEX)
+#undef CMSE_EXTERN_TRIE_INDEX
+
+    using TrieIndex = BasicTrieIndex<PAGE_SIZE>;
+
+} // namespace cmse::index
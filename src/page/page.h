@@ -1,11 +1,12 @@
 #pragma once
 #include "../common/types.h"
+#include <cstddef>
 #include <cstring>
 
 namespace cmse {
 
     // Helper forward declaration
-    namespace bufferpool { class BufferPoolManager; }
+    namespace bufferpool { template <size_t PageSize> class BasicBufferPoolManager; }
 
     /**
      * PageHeader
@@ -20,16 +21,42 @@ namespace cmse {
         uint8_t reserved[3];                          // Padding for alignment
     };
 
+    /**
+     * FrameMeta
+     * In-memory state of one buffer pool frame (never written to disk). The pool keeps these in
+     * a dense, cache-line aligned array apart from the page bytes, so sweeps over pins and dirty
+     * bits (flush, eviction, stats) read four frames per cache line instead of one per 4KB page.
+     */
+    struct FrameMeta {
+        page_id_t page_id = INVALID_PAGE_ID;  // Page held by the frame (mirrors the header)
+        int32_t pin_count = 0;
+        bool is_dirty = false;
+        bool prefetched = false;              // Loaded by a warm-up and not fetched since
+        uint8_t reserved[6];                  // Pads the descriptor to 16 bytes
+    };
+    static_assert(sizeof(FrameMeta) == 16, "four frame descriptors per cache line");
+
     /**
      * Page
-     * Wrapper around the raw 4KB data array.
-     * Note: This class is merely a container. It does not own the memory (managed by BufferPool).
+     * Thin view of one frame: its PageSize bytes of page data (in the pool's page arena) and its
+     * FrameMeta. Page is the default PAGE_SIZE view; pools over files with other page sizes hand
+     * out BasicPage<their size>.
+     * Note: This class is merely a view. It does not own the memory (managed by BufferPool).
+     * A view without metadata (e.g. over a stack buffer in tests) reports a pin count of 0.
      */
-    class Page {
-        // Allow BufferPoolManager to access private members like pin_count_
-        friend class cmse::bufferpool::BufferPoolManager;
+    template <size_t PageSize>
+    class BasicPage {
+        static_assert(PageSize >= 4096 && (PageSize & (PageSize - 1)) == 0, "page size must be a power of two of at least 4KB");
+
+        // Allow BufferPoolManager to access private members like meta_
+        friend class cmse::bufferpool::BasicBufferPoolManager<PageSize>;
 
     public:
+        static constexpr size_t SIZE = PageSize;
+
+        BasicPage() = default;
+        explicit BasicPage(char* data, FrameMeta* meta = nullptr) : data_(data), meta_(meta) {}
+
         // Returns pointer to the data payload (skipping the header)
         inline char* GetData() { return data_ + sizeof(PageHeader); }
         inline const char* GetData() const { return data_ + sizeof(PageHeader); }
@@ -41,17 +68,16 @@ namespace cmse {
         inline page_id_t GetPageId() { return GetHeader()->page_id; }
 
         // --- NEW: Added Accessor for Testing ---
-        inline int GetPinCount() const { return pin_count_; }
+        inline int GetPinCount() const { return meta_ != nullptr ? meta_->pin_count : 0; }
 
         // Zeros out the page data
-        void ResetMemory() { std::memset(data_, 0, PAGE_SIZE); }
+        void ResetMemory() { std::memset(data_, 0, PageSize); }
 
     private:
-        char data_[PAGE_SIZE]; // Actual 4KB data
-
-        // In-memory metadata (not written to disk)
-        bool is_dirty_ = false;
-        int pin_count_ = 0;
+        char* data_ = nullptr;       // PageSize bytes in the page arena
+        FrameMeta* meta_ = nullptr;  // Descriptor in the pool's metadata array
     };
 
-} // namespace cmse
\ No newline at end of file
+    using Page = BasicPage<PAGE_SIZE>;
+
+} // namespace cmse
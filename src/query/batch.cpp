@@ -0,0 +1,225 @@
+#include "batch.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace cmse::query {
+
+    // =================================================================
+    // Values
+    // =================================================================
+
+    Symbol Symbol::from(const std::string& text) {
+        Symbol symbol;
+        std::memset(symbol.bytes, 0, sizeof(symbol.bytes));
+        std::memcpy(symbol.bytes, text.data(), std::min(text.size(), sizeof(symbol.bytes)));
+        return symbol;
+    }
+
+    Symbol Symbol::from(const char (&field)[16]) {
+        Symbol symbol;
+        std::memcpy(symbol.bytes, field, sizeof(symbol.bytes));
+        // Normalize: everything after the terminator is zero, so equality is a 16-byte compare.
+        char* end = std::find(symbol.bytes, symbol.bytes + sizeof(symbol.bytes), '\0');
+        std::memset(end, 0, symbol.bytes + sizeof(symbol.bytes) - end);
+        return symbol;
+    }
+
+    std::string Symbol::str() const {
+        const char* end = std::find(bytes, bytes + sizeof(bytes), '\0');
+        return std::string(bytes, end);
+    }
+
+    bool Symbol::operator==(const Symbol& other) const {
+        return std::memcmp(bytes, other.bytes, sizeof(bytes)) == 0;
+    }
+
+    std::string valueToString(const Value& value) {
+        if (std::holds_alternative<int64_t>(value)) {
+            return std::to_string(std::get<int64_t>(value));
+        }
+        return std::get<std::string>(value);
+    }
+
+    // =================================================================
+    // ColumnVector
+    // =================================================================
+
+    size_t ColumnVector::size() const {
+        switch (type) {
+        case ColumnType::Int64: return ints.size();
+        case ColumnType::Symbol: return symbols.size();
+        case ColumnType::Text: return texts.size();
+        }
+        return 0;
+    }
+
+    void ColumnVector::clear() {
+        ints.clear();
+        symbols.clear();
+        texts.clear();
+    }
+
+    void ColumnVector::reserve(size_t rows) {
+        switch (type) {
+        case ColumnType::Int64: ints.reserve(rows); break;
+        case ColumnType::Symbol: symbols.reserve(rows); break;
+        case ColumnType::Text: texts.reserve(rows); break;
+        }
+    }
+
+    void ColumnVector::appendFrom(const ColumnVector& src, size_t row) {
+        switch (type) {
+        case ColumnType::Int64: ints.push_back(src.ints[row]); break;
+        case ColumnType::Symbol: symbols.push_back(src.symbols[row]); break;
+        case ColumnType::Text: texts.push_back(src.texts[row]); break;
+        }
+    }
+
+    Value ColumnVector::valueAt(size_t row) const {
+        switch (type) {
+        case ColumnType::Int64: return ints[row];
+        case ColumnType::Symbol: return symbols[row].str();
+        case ColumnType::Text: return texts[row];
+        }
+        return int64_t{ 0 };
+    }
+
+    // =================================================================
+    // Schema / Batch
+    // =================================================================
+
+    void Schema::add(const std::string& name, ColumnType type) {
+        names.push_back(name);
+        types.push_back(type);
+    }
+
+    int Schema::find(const std::string& name) const {
+        auto it = std::find(names.begin(), names.end(), name);
+        return it == names.end() ? -1 : static_cast<int>(it - names.begin());
+    }
+
+    Batch::Batch(const Schema& batch_schema) : schema(batch_schema), columns(batch_schema.size()) {
+        for (size_t i = 0; i < columns.size(); ++i) {
+            columns[i].type = schema.types[i];
+            columns[i].reserve(BATCH_SIZE);
+        }
+        selection.reserve(BATCH_SIZE);
+    }
+
+    void Batch::clear() {
+        for (auto& column : columns) {
+            column.clear();
+        }
+        rows = 0;
+        selection.clear();
+    }
+
+    void Batch::selectAll() {
+        selection.resize(rows);
+        for (size_t i = 0; i < rows; ++i) {
+            selection[i] = static_cast<uint16_t>(i);
+        }
+    }
+
+    void Batch::appendRow(const Batch& src, size_t row) {
+        for (size_t c = 0; c < columns.size(); ++c) {
+            columns[c].appendFrom(src.columns[c], row);
+        }
+        selection.push_back(static_cast<uint16_t>(rows++));
+    }
+
+    // =================================================================
+    // Log Record Schema
+    // =================================================================
+
+    const char* logColumnName(LogColumn column) {
+        switch (column) {
+        case LogColumn::RecordId: return "rid";
+        case LogColumn::Timestamp: return "timestamp";
+        case LogColumn::ResourceId: return "resource_id";
+        case LogColumn::ResourceName: return "resource_name";
+        case LogColumn::EventType: return "event_type";
+        }
+        return "";
+    }
+
+    ColumnType logColumnType(LogColumn column) {
+        switch (column) {
+        case LogColumn::ResourceName: return ColumnType::Text;
+        case LogColumn::EventType: return ColumnType::Symbol;
+        default: return ColumnType::Int64;
+        }
+    }
+
+    std::vector<LogColumn> allLogColumns() {
+        return { LogColumn::RecordId, LogColumn::Timestamp, LogColumn::ResourceId, LogColumn::ResourceName, LogColumn::EventType };
+    }
+
+    Schema logSchema(const std::vector<LogColumn>& columns) {
+        Schema schema;
+        for (LogColumn column : columns) {
+            schema.add(logColumnName(column), logColumnType(column));
+        }
+        return schema;
+    }
+
+    void appendLogRecord(Batch* batch, const std::vector<LogColumn>& columns, record_id_t rid, const LogRecord& record) {
+        for (size_t c = 0; c < columns.size(); ++c) {
+            ColumnVector& column = batch->columns[c];
+            switch (columns[c]) {
+            case LogColumn::RecordId:
+                column.ints.push_back(rid);
+                break;
+            case LogColumn::Timestamp:
+                column.ints.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(record.timestamp.time_since_epoch()).count());
+                break;
+            case LogColumn::ResourceId:
+                column.ints.push_back(record.resource_id);
+                break;
+            case LogColumn::ResourceName: {
+                const char* end = std::find(record.resource_name, record.resource_name + sizeof(record.resource_name), '\0');
+                column.texts.emplace_back(record.resource_name, end);
+                break;
+            }
+            case LogColumn::EventType:
+                column.symbols.push_back(Symbol::from(record.event_type));
+                break;
+            }
+        }
+        batch->rows++;
+    }
+
+    // =================================================================
+    // ResultSet
+    // =================================================================
+
+    const Value& ResultSet::at(size_t row, const std::string& column) const {
+        int index = schema.find(column);
+        if (index < 0) {
+            throw std::out_of_range("unknown column: " + column);
+        }
+        return rows.at(row).at(static_cast<size_t>(index));
+    }
+
+    std::string ResultSet::toString(size_t max_rows) const {
+        std::ostringstream out;
+        for (size_t c = 0; c < schema.size(); ++c) {
+            out << (c ? " | " : "") << schema.names[c];
+        }
+        out << "\n";
+        for (size_t r = 0; r < rows.size() && r < max_rows; ++r) {
+            for (size_t c = 0; c < rows[r].size(); ++c) {
+                out << (c ? " | " : "") << valueToString(rows[r][c]);
+            }
+            out << "\n";
+        }
+        if (rows.size() > max_rows) {
+            out << "... (" << rows.size() << " rows)\n";
+        }
+        return out.str();
+    }
+
+} // namespace cmse::query
@@ -0,0 +1,119 @@
+#pragma once
+#include "../common/types.h"
+#include <cstdint>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace cmse::query {
+
+    // Rows per batch produced by sources (configurable per source, 1..MAX_BATCH_SIZE).
+    // Selection vectors index rows with uint16_t, which bounds MAX_BATCH_SIZE.
+    constexpr size_t BATCH_SIZE = 2048;
+    constexpr size_t MAX_BATCH_SIZE = 4096;
+
+    enum class ColumnType {
+        Int64,   // Ids, timestamps (epoch ms), aggregates
+        Symbol,  // Fixed 16-byte string (LogRecord::event_type); compared with one SIMD op
+        Text     // Variable-length string (LogRecord::resource_name)
+    };
+
+    /**
+     * Symbol
+     * Zero-padded 16-byte string, laid out exactly like LogRecord::event_type.
+     */
+    struct Symbol {
+        char bytes[16];
+
+        static Symbol from(const std::string& text);
+        static Symbol from(const char (&field)[16]);
+        std::string str() const;
+
+        bool operator==(const Symbol& other) const;
+        bool operator!=(const Symbol& other) const { return !(*this == other); }
+    };
+
+    // A single output value (results and group keys).
+    using Value = std::variant<int64_t, std::string>;
+    std::string valueToString(const Value& value);
+
+    /**
+     * ColumnVector
+     * One column of a batch. Only the vector matching 'type' is used.
+     */
+    struct ColumnVector {
+        ColumnType type = ColumnType::Int64;
+        std::vector<int64_t> ints;
+        std::vector<Symbol> symbols;
+        std::vector<std::string> texts;
+
+        size_t size() const;
+        void clear();
+        void reserve(size_t rows);
+
+        // Appends row 'row' of 'src' (same type).
+        void appendFrom(const ColumnVector& src, size_t row);
+        Value valueAt(size_t row) const;
+    };
+
+    struct Schema {
+        std::vector<std::string> names;
+        std::vector<ColumnType> types;
+
+        void add(const std::string& name, ColumnType type);
+        // Index of column 'name', or -1.
+        int find(const std::string& name) const;
+        size_t size() const { return names.size(); }
+    };
+
+    /**
+     * Batch
+     * Columnar chunk of rows flowing through a pipeline. 'selection' lists the rows that are
+     * still live (ascending); filters shrink it instead of moving column data.
+     */
+    struct Batch {
+        Schema schema;
+        std::vector<ColumnVector> columns;
+        size_t rows = 0;
+        std::vector<uint16_t> selection;
+
+        Batch() = default;
+        explicit Batch(const Schema& batch_schema);
+
+        // Drops all rows (keeps schema and capacity).
+        void clear();
+        // Marks rows [0, rows) as selected; call after filling the columns.
+        void selectAll();
+        size_t selectedCount() const { return selection.size(); }
+
+        // Appends row 'row' of 'src' (same schema); the new row is selected.
+        void appendRow(const Batch& src, size_t row);
+    };
+
+    // --- Log Record Schema ---
+
+    // Columns of LogRecord as exposed by the sources, in schema order.
+    enum class LogColumn { RecordId, Timestamp, ResourceId, ResourceName, EventType };
+
+    const char* logColumnName(LogColumn column);
+    ColumnType logColumnType(LogColumn column);
+    std::vector<LogColumn> allLogColumns();
+    Schema logSchema(const std::vector<LogColumn>& columns);
+
+    // Appends 'record' to 'batch' (whose columns follow 'columns').
+    void appendLogRecord(Batch* batch, const std::vector<LogColumn>& columns, record_id_t rid, const LogRecord& record);
+
+    /**
+     * ResultSet
+     * Materialized rows at the end of a pipeline.
+     */
+    struct ResultSet {
+        Schema schema;
+        std::vector<std::vector<Value>> rows;
+
+        // Value of 'column' in row 'row' (throws std::out_of_range on bad indexes).
+        const Value& at(size_t row, const std::string& column) const;
+        std::string toString(size_t max_rows = 20) const;
+    };
+
+} // namespace cmse::query
@@ -0,0 +1,113 @@
+#include "filter_kernels.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CMSE_KERNELS_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CMSE_KERNELS_SSE2 1
+#endif
+
+namespace cmse::query {
+
+    namespace {
+        // Scalar reference; also handles the tail of the SIMD loops.
+        void compareInt64Scalar(const int64_t* values, size_t n, CompareOp op, int64_t a, int64_t b, uint8_t* out) {
+            switch (op) {
+            case CompareOp::Eq: for (size_t i = 0; i < n; ++i) out[i] = values[i] == a; break;
+            case CompareOp::Ne: for (size_t i = 0; i < n; ++i) out[i] = values[i] != a; break;
+            case CompareOp::Lt: for (size_t i = 0; i < n; ++i) out[i] = values[i] < a; break;
+            case CompareOp::Le: for (size_t i = 0; i < n; ++i) out[i] = values[i] <= a; break;
+            case CompareOp::Gt: for (size_t i = 0; i < n; ++i) out[i] = values[i] > a; break;
+            case CompareOp::Ge: for (size_t i = 0; i < n; ++i) out[i] = values[i] >= a; break;
+            case CompareOp::Between: for (size_t i = 0; i < n; ++i) out[i] = (values[i] >= a) & (values[i] <= b); break;
+            }
+        }
+
+#if defined(CMSE_KERNELS_AVX2)
+        // Expands the 4 lane bits of a 64-bit compare into 4 mask bytes.
+        inline void storeMask4(__m256i cmp, uint8_t* out) {
+            int bits = _mm256_movemask_pd(_mm256_castsi256_pd(cmp));
+            out[0] = bits & 1;
+            out[1] = (bits >> 1) & 1;
+            out[2] = (bits >> 2) & 1;
+            out[3] = (bits >> 3) & 1;
+        }
+#endif
+    }
+
+    void compareInt64(const int64_t* values, size_t n, CompareOp op, int64_t a, int64_t b, uint8_t* out) {
+        size_t i = 0;
+#if defined(CMSE_KERNELS_AVX2)
+        // AVX2 only has == and >; the other operators are built from them.
+        const __m256i va = _mm256_set1_epi64x(a);
+        const __m256i vb = _mm256_set1_epi64x(b);
+        const __m256i ones = _mm256_set1_epi64x(-1);
+        for (; i + 4 <= n; i += 4) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+            __m256i cmp;
+            switch (op) {
+            case CompareOp::Eq: cmp = _mm256_cmpeq_epi64(v, va); break;
+            case CompareOp::Ne: cmp = _mm256_xor_si256(_mm256_cmpeq_epi64(v, va), ones); break;
+            case CompareOp::Lt: cmp = _mm256_cmpgt_epi64(va, v); break;
+            case CompareOp::Le: cmp = _mm256_xor_si256(_mm256_cmpgt_epi64(v, va), ones); break;
+            case CompareOp::Gt: cmp = _mm256_cmpgt_epi64(v, va); break;
+            case CompareOp::Ge: cmp = _mm256_xor_si256(_mm256_cmpgt_epi64(va, v), ones); break;
+            default:
+                // a <= v <= b  ==  !(a > v) && !(v > b)
+                cmp = _mm256_andnot_si256(_mm256_or_si256(_mm256_cmpgt_epi64(va, v), _mm256_cmpgt_epi64(v, vb)), ones);
+                break;
+            }
+            storeMask4(cmp, out + i);
+        }
+#endif
+        compareInt64Scalar(values + i, n - i, op, a, b, out + i);
+    }
+
+    void matchSymbol(const Symbol* values, size_t n, const Symbol& needle, uint8_t* out) {
+        static_assert(sizeof(Symbol) == 16, "Symbol must be one 128-bit lane");
+        size_t i = 0;
+#if defined(CMSE_KERNELS_AVX2)
+        // Two symbols per 256-bit compare.
+        const __m256i vneedle = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(needle.bytes)));
+        for (; i + 2 <= n; i += 2) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+            unsigned bits = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, vneedle)));
+            out[i] |= (bits & 0xFFFFu) == 0xFFFFu;
+            out[i + 1] |= (bits >> 16) == 0xFFFFu;
+        }
+#elif defined(CMSE_KERNELS_SSE2)
+        const __m128i vneedle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(needle.bytes));
+        for (; i < n; ++i) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values[i].bytes));
+            out[i] |= _mm_movemask_epi8(_mm_cmpeq_epi8(v, vneedle)) == 0xFFFF;
+        }
+#endif
+        for (; i < n; ++i) {
+            out[i] |= values[i] == needle;
+        }
+    }
+
+    size_t compactSelection(const uint8_t* mask, const uint16_t* selection, size_t count, uint16_t* out) {
+        // Branch-free: always write, advance only on a match.
+        size_t kept = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint16_t row = selection[i];
+            out[kept] = row;
+            kept += mask[row];
+        }
+        return kept;
+    }
+
+    const char* filterKernelIsa() {
+#if defined(CMSE_KERNELS_AVX2)
+        return "avx2";
+#elif defined(CMSE_KERNELS_SSE2)
+        return "sse2";
+#else
+        return "scalar";
+#endif
+    }
+
+} // namespace cmse::query
@@ -0,0 +1,33 @@
+#pragma once
+#include "batch.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace cmse::query {
+
+    enum class CompareOp { Eq, Ne, Lt, Le, Gt, Ge, Between };
+
+    /**
+     * Filter kernels
+     * Evaluate one predicate over a whole column and write a byte mask (1 = match) for every
+     * row. Kernels ignore the selection vector on purpose: evaluating all rows keeps the loops
+     * branch-free and SIMD-friendly, and compactSelection() applies the mask afterwards.
+     *
+     * The SIMD path is chosen at compile time: AVX2 when the compiler targets it
+     * (CMSE_ENABLE_AVX2), otherwise SSE2 for symbols and a scalar loop for int64.
+     */
+
+    // out[i] = values[i] <op> a   (Between: a <= values[i] <= b)
+    void compareInt64(const int64_t* values, size_t n, CompareOp op, int64_t a, int64_t b, uint8_t* out);
+
+    // out[i] |= (values[i] == needle); call once per IN-list entry after zeroing 'out'.
+    void matchSymbol(const Symbol* values, size_t n, const Symbol& needle, uint8_t* out);
+
+    // Writes the entries of 'selection' whose row is set in 'mask' to 'out' (may alias
+    // 'selection'). Returns the new count.
+    size_t compactSelection(const uint8_t* mask, const uint16_t* selection, size_t count, uint16_t* out);
+
+    // "avx2", "sse2" or "scalar".
+    const char* filterKernelIsa();
+
+} // namespace cmse::query
@@ -0,0 +1,64 @@
+#include "name_dictionary.h"
+#include "../index/bitmap_index.h"
+#include "../index/trie_index.h"
+#include <mutex>
+
+namespace cmse::query {
+
+    uint32_t NameDictionary::intern(const std::string& value, std::unordered_map<std::string, uint32_t>* ids, std::vector<std::string>* values) {
+        auto it = ids->find(value);
+        if (it != ids->end()) {
+            return it->second;
+        }
+        uint32_t id = static_cast<uint32_t>(values->size());
+        ids->emplace(value, id);
+        values->push_back(value);
+        return id;
+    }
+
+    void NameDictionary::onIngest(record_id_t rid, const LogRecord& record) {
+        std::string name = index::TrieIndex::resourceNameOf(record);
+        std::string type = index::BitmapIndex::eventTypeOf(record);
+
+        std::unique_lock<std::shared_mutex> lock(latch_);
+        if (rid >= columns_.name_ids.size()) {
+            columns_.name_ids.resize(rid + 1, NO_ID);
+            columns_.type_ids.resize(rid + 1, NO_ID);
+        }
+        columns_.name_ids[rid] = intern(name, &name_ids_, &columns_.names);
+        columns_.type_ids[rid] = intern(type, &type_ids_, &columns_.types);
+    }
+
+    uint32_t NameDictionary::nameId(const std::string& name) {
+        std::shared_lock<std::shared_mutex> lock(latch_);
+        auto it = name_ids_.find(name);
+        return it == name_ids_.end() ? NO_ID : it->second;
+    }
+
+    uint32_t NameDictionary::eventTypeId(const std::string& event_type) {
+        std::shared_lock<std::shared_mutex> lock(latch_);
+        auto it = type_ids_.find(event_type);
+        return it == type_ids_.end() ? NO_ID : it->second;
+    }
+
+    size_t NameDictionary::nameCount() {
+        std::shared_lock<std::shared_mutex> lock(latch_);
+        return columns_.names.size();
+    }
+
+    size_t NameDictionary::eventTypeCount() {
+        std::shared_lock<std::shared_mutex> lock(latch_);
+        return columns_.types.size();
+    }
+
+    uint64_t NameDictionary::rowCount() {
+        std::shared_lock<std::shared_mutex> lock(latch_);
+        return columns_.name_ids.size();
+    }
+
+    void NameDictionary::readColumns(const std::function<void(const Columns&)>& fn) {
+        std::shared_lock<std::shared_mutex> lock(latch_);
+        fn(columns_);
+    }
+
+} // namespace cmse::query
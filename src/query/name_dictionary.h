@@ -0,0 +1,58 @@
+#pragma once
+#include "../common/types.h"
+#include "../storage/log_store.h"
+#include <functional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cmse::query {
+
+    /**
+     * NameDictionary
+     * Interns LogRecord::resource_name and event_type on ingest and keeps one dense id per
+     * record for each (two uint32 columns indexed by record id). Group-by queries on names then
+     * hash 4-byte ids instead of strings and never touch the log pages (see ParallelHashAggregator).
+     *
+     * Ids are assigned in first-seen order and never change. Like the bitmap directory, the
+     * dictionary lives in memory; register it before ingest starts, otherwise earlier records
+     * have no ids (NO_ID).
+     *
+     * Thread safety: internally synchronized; readColumns() holds a shared lock, so any number of
+     * readers (and their worker threads) can scan while ingest waits.
+     */
+    class NameDictionary : public storage::IngestListener {
+    public:
+        static constexpr uint32_t NO_ID = UINT32_MAX;
+
+        struct Columns {
+            std::vector<uint32_t> name_ids;   // Per record id
+            std::vector<uint32_t> type_ids;   // Per record id
+            std::vector<std::string> names;   // Indexed by name id
+            std::vector<std::string> types;   // Indexed by type id
+        };
+
+        void onIngest(record_id_t rid, const LogRecord& record) override;
+
+        // Id of a name / event type (NO_ID if never seen).
+        uint32_t nameId(const std::string& name);
+        uint32_t eventTypeId(const std::string& event_type);
+
+        size_t nameCount();
+        size_t eventTypeCount();
+        uint64_t rowCount();
+
+        // Runs 'fn' with the columns under a shared lock (no ingest in between).
+        void readColumns(const std::function<void(const Columns&)>& fn);
+
+    private:
+        static uint32_t intern(const std::string& value, std::unordered_map<std::string, uint32_t>* ids, std::vector<std::string>* values);
+
+        Columns columns_;
+        std::unordered_map<std::string, uint32_t> name_ids_;
+        std::unordered_map<std::string, uint32_t> type_ids_;
+        std::shared_mutex latch_;
+    };
+
+} // namespace cmse::query
@@ -0,0 +1,550 @@
+#include "operators.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <set>
+
+namespace cmse::query {
+
+    namespace {
+        const char* compareOpName(CompareOp op) {
+            switch (op) {
+            case CompareOp::Eq: return "=";
+            case CompareOp::Ne: return "!=";
+            case CompareOp::Lt: return "<";
+            case CompareOp::Le: return "<=";
+            case CompareOp::Gt: return ">";
+            case CompareOp::Ge: return ">=";
+            case CompareOp::Between: return "BETWEEN";
+            }
+            return "?";
+        }
+
+        // <0, 0, >0 like strcmp.
+        int compareValues(const ColumnVector& a, size_t i, const ColumnVector& b, size_t j) {
+            switch (a.type) {
+            case ColumnType::Int64:
+                return a.ints[i] < b.ints[j] ? -1 : (a.ints[i] > b.ints[j] ? 1 : 0);
+            case ColumnType::Symbol:
+                return std::memcmp(a.symbols[i].bytes, b.symbols[j].bytes, sizeof(Symbol::bytes));
+            case ColumnType::Text:
+                return a.texts[i].compare(b.texts[j]);
+            }
+            return 0;
+        }
+
+        bool resolve(const Schema& input, const std::string& column, int* index, std::string* error) {
+            *index = input.find(column);
+            if (*index < 0 && error != nullptr) {
+                *error = "unknown column '" + column + "'";
+            }
+            return *index >= 0;
+        }
+    }
+
+    // =================================================================
+    // Operator
+    // =================================================================
+
+    void Operator::finish() {
+        if (next_ != nullptr) {
+            next_->finish();
+        }
+    }
+
+    bool Operator::emit(Batch& batch) {
+        rows_out_ += batch.selectedCount();
+        return next_ == nullptr || next_->consume(batch);
+    }
+
+    // =================================================================
+    // Filter
+    // =================================================================
+
+    Predicate Predicate::compare(const std::string& column, CompareOp op, int64_t value) {
+        Predicate p;
+        p.column = column;
+        p.op = op;
+        p.a = value;
+        return p;
+    }
+
+    Predicate Predicate::between(const std::string& column, int64_t lo, int64_t hi) {
+        Predicate p = compare(column, CompareOp::Between, lo);
+        p.b = hi;
+        return p;
+    }
+
+    Predicate Predicate::in(const std::string& column, std::vector<std::string> values) {
+        Predicate p;
+        p.column = column;
+        p.values = std::move(values);
+        return p;
+    }
+
+    Predicate Predicate::equals(const std::string& column, const std::string& value) {
+        return in(column, { value });
+    }
+
+    Predicate Predicate::startsWith(const std::string& column, const std::string& prefix) {
+        Predicate p = in(column, { prefix });
+        p.prefix = true;
+        return p;
+    }
+
+    std::string Predicate::toString() const {
+        if (prefix) {
+            std::string list;
+            for (const auto& v : values) {
+                list += (list.empty() ? "'" : " OR '") + v + "%'";
+            }
+            return column + " LIKE " + list;
+        }
+        if (!values.empty()) {
+            std::string list;
+            for (const auto& v : values) {
+                list += (list.empty() ? "" : ", ") + v;
+            }
+            return column + " IN (" + list + ")";
+        }
+        if (op == CompareOp::Between) {
+            return column + " BETWEEN " + std::to_string(a) + " AND " + std::to_string(b);
+        }
+        return column + " " + compareOpName(op) + " " + std::to_string(a);
+    }
+
+    FilterOperator::FilterOperator(std::vector<Predicate> predicates) : predicates_(std::move(predicates)) {}
+
+    bool FilterOperator::open(const Schema& input, std::string* error) {
+        resetCounters();
+        column_index_.assign(predicates_.size(), -1);
+        symbols_.assign(predicates_.size(), {});
+        for (size_t p = 0; p < predicates_.size(); ++p) {
+            const Predicate& pred = predicates_[p];
+            if (!resolve(input, pred.column, &column_index_[p], error)) {
+                return false;
+            }
+            bool is_int = input.types[column_index_[p]] == ColumnType::Int64;
+            if (is_int != pred.values.empty()) {
+                if (error != nullptr) {
+                    *error = "predicate '" + pred.toString() + "' does not match the column type";
+                }
+                return false;
+            }
+            if (pred.prefix && input.types[column_index_[p]] != ColumnType::Text) {
+                if (error != nullptr) {
+                    *error = "predicate '" + pred.toString() + "' needs a text column";
+                }
+                return false;
+            }
+            if (input.types[column_index_[p]] == ColumnType::Symbol) {
+                for (const auto& v : pred.values) {
+                    symbols_[p].push_back(Symbol::from(v));
+                }
+            }
+        }
+        mask_.resize(MAX_BATCH_SIZE);
+        output_ = input;
+        return true;
+    }
+
+    bool FilterOperator::consume(Batch& batch) {
+        rows_in_ += batch.selectedCount();
+        if (mask_.size() < batch.rows) {
+            mask_.resize(batch.rows);
+        }
+
+        for (size_t p = 0; p < predicates_.size() && !batch.selection.empty(); ++p) {
+            const Predicate& pred = predicates_[p];
+            const ColumnVector& column = batch.columns[column_index_[p]];
+            switch (column.type) {
+            case ColumnType::Int64:
+                compareInt64(column.ints.data(), batch.rows, pred.op, pred.a, pred.b, mask_.data());
+                break;
+            case ColumnType::Symbol:
+                std::fill(mask_.begin(), mask_.begin() + batch.rows, uint8_t{ 0 });
+                for (const Symbol& needle : symbols_[p]) {
+                    matchSymbol(column.symbols.data(), batch.rows, needle, mask_.data());
+                }
+                break;
+            case ColumnType::Text:
+                // Variable-length: only the selected rows are compared.
+                for (uint16_t row : batch.selection) {
+                    const std::string& text = column.texts[row];
+                    mask_[row] = pred.prefix
+                        ? std::any_of(pred.values.begin(), pred.values.end(), [&](const std::string& v) { return text.compare(0, v.size(), v) == 0; })
+                        : std::find(pred.values.begin(), pred.values.end(), text) != pred.values.end();
+                }
+                break;
+            }
+            size_t kept = compactSelection(mask_.data(), batch.selection.data(), batch.selection.size(), batch.selection.data());
+            batch.selection.resize(kept);
+        }
+
+        if (batch.selection.empty()) {
+            return true;
+        }
+        return emit(batch);
+    }
+
+    std::string FilterOperator::name() const {
+        std::string text;
+        for (const auto& pred : predicates_) {
+            text += (text.empty() ? "" : " AND ") + pred.toString();
+        }
+        return "Filter(" + text + ")";
+    }
+
+    // =================================================================
+    // Project
+    // =================================================================
+
+    ProjectOperator::ProjectOperator(std::vector<std::string> columns) : columns_(std::move(columns)) {}
+
+    bool ProjectOperator::open(const Schema& input, std::string* error) {
+        resetCounters();
+        output_ = Schema();
+        column_index_.assign(columns_.size(), -1);
+        std::set<int> seen;
+        for (size_t c = 0; c < columns_.size(); ++c) {
+            if (!resolve(input, columns_[c], &column_index_[c], error)) {
+                return false;
+            }
+            if (!seen.insert(column_index_[c]).second) {
+                if (error != nullptr) {
+                    *error = "column '" + columns_[c] + "' projected twice";
+                }
+                return false;
+            }
+            output_.add(columns_[c], input.types[column_index_[c]]);
+        }
+        out_ = Batch(output_);
+        return true;
+    }
+
+    bool ProjectOperator::consume(Batch& batch) {
+        rows_in_ += batch.selectedCount();
+        // Borrow the columns (and selection) for the downstream call, then give them back
+        // so the source keeps its buffers.
+        for (size_t c = 0; c < column_index_.size(); ++c) {
+            std::swap(out_.columns[c], batch.columns[column_index_[c]]);
+        }
+        std::swap(out_.selection, batch.selection);
+        out_.rows = batch.rows;
+
+        bool more = emit(out_);
+
+        for (size_t c = 0; c < column_index_.size(); ++c) {
+            std::swap(out_.columns[c], batch.columns[column_index_[c]]);
+        }
+        std::swap(out_.selection, batch.selection);
+        return more;
+    }
+
+    std::string ProjectOperator::name() const {
+        std::string text;
+        for (const auto& c : columns_) {
+            text += (text.empty() ? "" : ", ") + c;
+        }
+        return "Project(" + text + ")";
+    }
+
+    // =================================================================
+    // Hash Aggregate
+    // =================================================================
+
+    HashAggregateOperator::HashAggregateOperator(std::vector<std::string> group_by, std::vector<AggregateSpec> aggregates)
+        : group_by_(std::move(group_by)), aggregates_(std::move(aggregates)) {}
+
+    bool HashAggregateOperator::open(const Schema& input, std::string* error) {
+        resetCounters();
+        groups_.clear();
+        values_.clear();
+        output_ = Schema();
+
+        Schema key_schema;
+        group_index_.assign(group_by_.size(), -1);
+        for (size_t g = 0; g < group_by_.size(); ++g) {
+            if (!resolve(input, group_by_[g], &group_index_[g], error)) {
+                return false;
+            }
+            key_schema.add(group_by_[g], input.types[group_index_[g]]);
+            output_.add(group_by_[g], input.types[group_index_[g]]);
+        }
+        keys_ = Batch(key_schema);
+
+        agg_index_.assign(aggregates_.size(), -1);
+        for (size_t a = 0; a < aggregates_.size(); ++a) {
+            const AggregateSpec& spec = aggregates_[a];
+            if (spec.func != AggFunc::Count) {
+                if (!resolve(input, spec.column, &agg_index_[a], error)) {
+                    return false;
+                }
+                if (input.types[agg_index_[a]] != ColumnType::Int64) {
+                    if (error != nullptr) {
+                        *error = "aggregate '" + spec.as + "' needs an Int64 column";
+                    }
+                    return false;
+                }
+            }
+            output_.add(spec.as, ColumnType::Int64);
+        }
+        return true;
+    }
+
+    void HashAggregateOperator::appendKey(const Batch& batch, size_t row, std::string* key) const {
+        for (int index : group_index_) {
+            const ColumnVector& column = batch.columns[index];
+            switch (column.type) {
+            case ColumnType::Int64:
+                key->append(reinterpret_cast<const char*>(&column.ints[row]), sizeof(int64_t));
+                break;
+            case ColumnType::Symbol:
+                key->append(column.symbols[row].bytes, sizeof(Symbol::bytes));
+                break;
+            case ColumnType::Text: {
+                uint32_t length = static_cast<uint32_t>(column.texts[row].size());
+                key->append(reinterpret_cast<const char*>(&length), sizeof(length));
+                key->append(column.texts[row]);
+                break;
+            }
+            }
+        }
+    }
+
+    bool HashAggregateOperator::consume(Batch& batch) {
+        rows_in_ += batch.selectedCount();
+        const size_t num_aggs = aggregates_.size();
+
+        for (uint16_t row : batch.selection) {
+            key_buffer_.clear();
+            appendKey(batch, row, &key_buffer_);
+
+            auto it = groups_.find(key_buffer_);
+            size_t group;
+            if (it == groups_.end()) {
+                group = groups_.size();
+                groups_.emplace(key_buffer_, group);
+                for (size_t g = 0; g < group_index_.size(); ++g) {
+                    keys_.columns[g].appendFrom(batch.columns[group_index_[g]], row);
+                }
+                keys_.rows++;
+                for (const auto& spec : aggregates_) {
+                    values_.push_back(spec.func == AggFunc::Min ? std::numeric_limits<int64_t>::max()
+                        : spec.func == AggFunc::Max ? std::numeric_limits<int64_t>::min() : 0);
+                }
+            }
+            else {
+                group = it->second;
+            }
+
+            int64_t* acc = &values_[group * num_aggs];
+            for (size_t a = 0; a < num_aggs; ++a) {
+                switch (aggregates_[a].func) {
+                case AggFunc::Count: acc[a]++; break;
+                case AggFunc::Sum: acc[a] += batch.columns[agg_index_[a]].ints[row]; break;
+                case AggFunc::Min: acc[a] = std::min(acc[a], batch.columns[agg_index_[a]].ints[row]); break;
+                case AggFunc::Max: acc[a] = std::max(acc[a], batch.columns[agg_index_[a]].ints[row]); break;
+                }
+            }
+        }
+        return true; // Needs all input
+    }
+
+    void HashAggregateOperator::finish() {
+        const size_t num_keys = group_index_.size();
+        const size_t num_aggs = aggregates_.size();
+
+        // A global aggregate over no rows still produces one row (COUNT = 0).
+        if (num_keys == 0 && groups_.empty()) {
+            groups_.emplace(std::string(), 0);
+            keys_.rows = 1;
+            values_.assign(num_aggs, 0); // MIN/MAX of no rows also report 0
+        }
+
+        Batch out(output_);
+        for (size_t group = 0; group < keys_.rows; ++group) {
+            for (size_t g = 0; g < num_keys; ++g) {
+                out.columns[g].appendFrom(keys_.columns[g], group);
+            }
+            for (size_t a = 0; a < num_aggs; ++a) {
+                out.columns[num_keys + a].ints.push_back(values_[group * num_aggs + a]);
+            }
+            out.rows++;
+            if (out.rows == BATCH_SIZE || group + 1 == keys_.rows) {
+                out.selectAll();
+                if (!emit(out)) {
+                    break;
+                }
+                out.clear();
+            }
+        }
+        Operator::finish();
+    }
+
+    std::string HashAggregateOperator::name() const {
+        std::string text;
+        for (const auto& g : group_by_) {
+            text += (text.empty() ? "" : ", ") + g;
+        }
+        return "HashAggregate(by: " + (text.empty() ? std::string("-") : text) + ", groups: " + std::to_string(groups_.size()) + ")";
+    }
+
+    // =================================================================
+    // Top-N
+    // =================================================================
+
+    TopNOperator::TopNOperator(std::string column, size_t n, bool descending)
+        : column_(std::move(column)), n_(n), descending_(descending) {}
+
+    bool TopNOperator::open(const Schema& input, std::string* error) {
+        resetCounters();
+        if (!resolve(input, column_, &column_index_, error)) {
+            return false;
+        }
+        column_type_ = input.types[column_index_];
+        output_ = input;
+        buffer_ = Batch(input);
+        arrival_.clear();
+        next_arrival_ = 0;
+        has_threshold_ = false;
+        threshold_ = ColumnVector();
+        threshold_.type = column_type_;
+        return true;
+    }
+
+    bool TopNOperator::better(size_t lhs, size_t rhs) const {
+        const ColumnVector& column = buffer_.columns[column_index_];
+        int cmp = compareValues(column, lhs, column, rhs);
+        if (cmp != 0) {
+            return descending_ ? cmp > 0 : cmp < 0;
+        }
+        return arrival_[lhs] < arrival_[rhs];
+    }
+
+    bool TopNOperator::beatsThreshold(const Batch& batch, size_t row) const {
+        // Later arrivals lose ties, so equal keys cannot enter a full top-N.
+        int cmp = compareValues(batch.columns[column_index_], row, threshold_, 0);
+        return descending_ ? cmp > 0 : cmp < 0;
+    }
+
+    void TopNOperator::prune() {
+        std::vector<size_t> order(buffer_.rows);
+        std::iota(order.begin(), order.end(), size_t{ 0 });
+        size_t keep = std::min(n_, order.size());
+        std::partial_sort(order.begin(), order.begin() + keep, order.end(),
+            [this](size_t l, size_t r) { return better(l, r); });
+        order.resize(keep);
+
+        Batch kept(buffer_.schema);
+        std::vector<uint64_t> kept_arrival;
+        for (size_t row : order) {
+            kept.appendRow(buffer_, row);
+            kept_arrival.push_back(arrival_[row]);
+        }
+        buffer_ = std::move(kept);
+        arrival_ = std::move(kept_arrival);
+
+        if (keep == n_ && keep > 0) {
+            threshold_.clear();
+            threshold_.appendFrom(buffer_.columns[column_index_], keep - 1);
+            has_threshold_ = true;
+        }
+    }
+
+    bool TopNOperator::consume(Batch& batch) {
+        rows_in_ += batch.selectedCount();
+        if (n_ == 0) {
+            return false;
+        }
+        for (uint16_t row : batch.selection) {
+            if (has_threshold_ && !beatsThreshold(batch, row)) {
+                continue;
+            }
+            buffer_.appendRow(batch, row);
+            arrival_.push_back(next_arrival_++);
+        }
+        if (buffer_.rows >= std::max(2 * n_, BATCH_SIZE)) {
+            prune();
+        }
+        return true;
+    }
+
+    void TopNOperator::finish() {
+        prune(); // Sorted best-first
+
+        Batch out(output_);
+        for (size_t row = 0; row < buffer_.rows; ++row) {
+            out.appendRow(buffer_, row);
+            if (out.rows == BATCH_SIZE || row + 1 == buffer_.rows) {
+                if (!emit(out)) {
+                    break;
+                }
+                out.clear();
+            }
+        }
+        Operator::finish();
+    }
+
+    std::string TopNOperator::name() const {
+        return "TopN(" + column_ + (descending_ ? " DESC" : " ASC") + ", " + std::to_string(n_) + ")";
+    }
+
+    // =================================================================
+    // Limit
+    // =================================================================
+
+    LimitOperator::LimitOperator(size_t limit) : limit_(limit) {}
+
+    bool LimitOperator::open(const Schema& input, std::string* /*error*/) {
+        resetCounters();
+        remaining_ = limit_;
+        output_ = input;
+        return true;
+    }
+
+    bool LimitOperator::consume(Batch& batch) {
+        rows_in_ += batch.selectedCount();
+        if (remaining_ == 0) {
+            return false;
+        }
+        if (batch.selection.size() > remaining_) {
+            batch.selection.resize(remaining_);
+        }
+        remaining_ -= batch.selection.size();
+        bool more = emit(batch);
+        return more && remaining_ > 0;
+    }
+
+    std::string LimitOperator::name() const {
+        return "Limit(" + std::to_string(limit_) + ")";
+    }
+
+    // =================================================================
+    // Sink
+    // =================================================================
+
+    bool CollectSink::open(const Schema& input, std::string* /*error*/) {
+        resetCounters();
+        output_ = input;
+        out_->schema = input;
+        out_->rows.clear();
+        return true;
+    }
+
+    bool CollectSink::consume(Batch& batch) {
+        rows_in_ += batch.selectedCount();
+        for (uint16_t row : batch.selection) {
+            std::vector<Value> values;
+            values.reserve(batch.columns.size());
+            for (const auto& column : batch.columns) {
+                values.push_back(column.valueAt(row));
+            }
+            out_->rows.push_back(std::move(values));
+        }
+        rows_out_ = rows_in_;
+        return true;
+    }
+
+} // namespace cmse::query
@@ -0,0 +1,214 @@
+#pragma once
+#include "batch.h"
+#include "filter_kernels.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cmse::query {
+
+    /**
+     * Operator
+     * Push-based pipeline stage: the source calls consume() with each batch, the operator
+     * processes it and pushes its output to the next stage. consume() returns false once no
+     * more input is needed (e.g. LIMIT reached), which stops the source early.
+     * Pipeline breakers (aggregate, top-N) buffer input and emit in finish().
+     *
+     * Lifecycle: open() (resolves columns, resets state) -> consume()* -> finish().
+     */
+    class Operator {
+    public:
+        virtual ~Operator() = default;
+
+        // Resolves column references against 'input' and sets outputSchema().
+        // Returns false with *error set on unknown columns or type mismatches.
+        virtual bool open(const Schema& input, std::string* error) = 0;
+
+        // Processes one batch (which the operator may modify). Returns false to stop the input.
+        virtual bool consume(Batch& batch) = 0;
+
+        // End of input: flush buffered rows and finish the next stage.
+        virtual void finish();
+
+        virtual std::string name() const = 0;
+
+        void setNext(Operator* next) { next_ = next; }
+        const Schema& outputSchema() const { return output_; }
+
+        uint64_t rowsIn() const { return rows_in_; }
+        uint64_t rowsOut() const { return rows_out_; }
+
+    protected:
+        // Pushes the selected rows of 'batch' downstream.
+        bool emit(Batch& batch);
+        void resetCounters() { rows_in_ = rows_out_ = 0; }
+
+        Operator* next_ = nullptr;
+        Schema output_;
+        uint64_t rows_in_ = 0;
+        uint64_t rows_out_ = 0;
+    };
+
+    // --- Filter ---
+
+    /**
+     * Predicate
+     * Int64 columns: any CompareOp against 'a' (and 'b' for Between).
+     * Symbol/Text columns: equality with any entry of 'values' (IN list).
+     * Text columns only: 'prefix' matches values starting with any entry of 'values'.
+     */
+    struct Predicate {
+        std::string column;
+        CompareOp op = CompareOp::Eq;
+        int64_t a = 0;
+        int64_t b = 0;
+        std::vector<std::string> values;
+        bool prefix = false;
+
+        static Predicate compare(const std::string& column, CompareOp op, int64_t value);
+        static Predicate between(const std::string& column, int64_t lo, int64_t hi);
+        static Predicate in(const std::string& column, std::vector<std::string> values);
+        static Predicate equals(const std::string& column, const std::string& value);
+        static Predicate startsWith(const std::string& column, const std::string& prefix);
+
+        std::string toString() const;
+    };
+
+    // Conjunction of predicates, evaluated column-at-a-time with the filter kernels.
+    class FilterOperator : public Operator {
+    public:
+        explicit FilterOperator(std::vector<Predicate> predicates);
+
+        bool open(const Schema& input, std::string* error) override;
+        bool consume(Batch& batch) override;
+        std::string name() const override;
+
+    private:
+        std::vector<Predicate> predicates_;
+        std::vector<int> column_index_;
+        std::vector<std::vector<Symbol>> symbols_; // Per predicate, for Symbol columns
+        std::vector<uint8_t> mask_;
+    };
+
+    // --- Project ---
+
+    // Keeps (and reorders) the named columns. Columns are swapped, not copied.
+    class ProjectOperator : public Operator {
+    public:
+        explicit ProjectOperator(std::vector<std::string> columns);
+
+        bool open(const Schema& input, std::string* error) override;
+        bool consume(Batch& batch) override;
+        std::string name() const override;
+
+    private:
+        std::vector<std::string> columns_;
+        std::vector<int> column_index_;
+        Batch out_;
+    };
+
+    // --- Hash Aggregate ---
+
+    enum class AggFunc { Count, Sum, Min, Max };
+
+    struct AggregateSpec {
+        AggFunc func = AggFunc::Count;
+        std::string column;   // Ignored for Count
+        std::string as;       // Output column name
+
+        static AggregateSpec count(const std::string& as) { return { AggFunc::Count, "", as }; }
+        static AggregateSpec sum(const std::string& column, const std::string& as) { return { AggFunc::Sum, column, as }; }
+        static AggregateSpec min(const std::string& column, const std::string& as) { return { AggFunc::Min, column, as }; }
+        static AggregateSpec max(const std::string& column, const std::string& as) { return { AggFunc::Max, column, as }; }
+    };
+
+    // GROUP BY 'group_by' (empty = one global group) computing Int64 aggregates.
+    // Output: the group columns followed by one Int64 column per aggregate, in first-seen order.
+    class HashAggregateOperator : public Operator {
+    public:
+        HashAggregateOperator(std::vector<std::string> group_by, std::vector<AggregateSpec> aggregates);
+
+        bool open(const Schema& input, std::string* error) override;
+        bool consume(Batch& batch) override;
+        void finish() override;
+        std::string name() const override;
+
+        size_t groupCount() const { return groups_.size(); }
+
+    private:
+        void appendKey(const Batch& batch, size_t row, std::string* key) const;
+
+        std::vector<std::string> group_by_;
+        std::vector<AggregateSpec> aggregates_;
+        std::vector<int> group_index_;
+        std::vector<int> agg_index_;
+
+        std::unordered_map<std::string, size_t> groups_;
+        Batch keys_;                  // One row per group (group columns only)
+        std::vector<int64_t> values_; // groups x aggregates
+        std::string key_buffer_;
+    };
+
+    // --- Top-N ---
+
+    // Keeps the 'n' rows with the largest (descending) or smallest 'column' values.
+    // Ties keep arrival order. Rows that cannot enter the current top-N are skipped early.
+    class TopNOperator : public Operator {
+    public:
+        TopNOperator(std::string column, size_t n, bool descending);
+
+        bool open(const Schema& input, std::string* error) override;
+        bool consume(Batch& batch) override;
+        void finish() override;
+        std::string name() const override;
+
+    private:
+        // Orders buffer rows best-first.
+        bool better(size_t lhs, size_t rhs) const;
+        bool beatsThreshold(const Batch& batch, size_t row) const;
+        void prune();
+
+        std::string column_;
+        size_t n_;
+        bool descending_;
+        int column_index_ = -1;
+        ColumnType column_type_ = ColumnType::Int64;
+
+        Batch buffer_;
+        std::vector<uint64_t> arrival_;
+        uint64_t next_arrival_ = 0;
+        bool has_threshold_ = false;
+        ColumnVector threshold_; // Worst key of the last pruned top-N (one value)
+    };
+
+    // --- Limit ---
+
+    class LimitOperator : public Operator {
+    public:
+        explicit LimitOperator(size_t limit);
+
+        bool open(const Schema& input, std::string* error) override;
+        bool consume(Batch& batch) override;
+        std::string name() const override;
+
+    private:
+        size_t limit_;
+        size_t remaining_ = 0;
+    };
+
+    // --- Sink ---
+
+    // Terminal stage: materializes rows into a ResultSet.
+    class CollectSink : public Operator {
+    public:
+        explicit CollectSink(ResultSet* out) : out_(out) {}
+
+        bool open(const Schema& input, std::string* error) override;
+        bool consume(Batch& batch) override;
+        std::string name() const override { return "Collect"; }
+
+    private:
+        ResultSet* out_;
+    };
+
+} // namespace cmse::query
@@ -0,0 +1,263 @@
+#include "parallel_aggregate.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace cmse::query {
+
+    const char* groupColumnName(GroupColumn column) {
+        switch (column) {
+        case GroupColumn::ResourceName: return "resource_name";
+        case GroupColumn::EventType: return "event_type";
+        }
+        return "?";
+    }
+
+    namespace {
+        constexpr uint64_t EMPTY_KEY = UINT64_MAX; // Never a packed key: ids are below NO_ID
+
+        struct Slot {
+            uint64_t key;
+            uint64_t count;
+        };
+
+        inline uint64_t HashKey(uint64_t key) {
+            key ^= key >> 31;
+            key *= 0x9E3779B97F4A7C15ull;
+            return key ^ (key >> 29);
+        }
+
+        inline size_t NextPowerOfTwo(size_t n) {
+            size_t p = 2;
+            while (p < n) {
+                p <<= 1;
+            }
+            return p;
+        }
+
+        /**
+         * CountTable
+         * Linear-probing table of (key, count). The slot comes from the hash bits below the top
+         * 'skip_bits' (those already chose the partition), so a partition's table is not
+         * clustered into a fraction of its slots.
+         */
+        class CountTable {
+        public:
+            CountTable(size_t capacity, int skip_bits) : slots_(NextPowerOfTwo(capacity), Slot{ EMPTY_KEY, 0 }), skip_bits_(skip_bits) {
+                int log2 = 0;
+                while ((size_t{ 1 } << log2) < slots_.size()) {
+                    ++log2;
+                }
+                shift_ = 64 - log2;
+                mask_ = slots_.size() - 1;
+            }
+
+            // Returns the number of occupied slots after the update.
+            size_t add(uint64_t key, uint64_t hash, uint64_t count) {
+                size_t i = static_cast<size_t>((hash << skip_bits_) >> shift_);
+                while (true) {
+                    Slot& slot = slots_[i];
+                    if (slot.key == key) {
+                        slot.count += count;
+                        return used_;
+                    }
+                    if (slot.key == EMPTY_KEY) {
+                        slot = { key, count };
+                        return ++used_;
+                    }
+                    i = (i + 1) & mask_;
+                }
+            }
+
+            // Calls fn(slot) for every occupied slot; with 'reset', empties the table as it goes.
+            template <typename Fn>
+            void drain(bool reset, Fn fn) {
+                for (Slot& slot : slots_) {
+                    if (slot.key != EMPTY_KEY) {
+                        fn(slot);
+                        if (reset) {
+                            slot.key = EMPTY_KEY;
+                        }
+                    }
+                }
+                if (reset) {
+                    used_ = 0;
+                }
+            }
+
+            size_t capacity() const { return slots_.size(); }
+
+        private:
+            std::vector<Slot> slots_;
+            int skip_bits_;
+            int shift_ = 0;
+            size_t mask_ = 0;
+            size_t used_ = 0;
+        };
+
+        // Runs fn(worker) on 'threads' workers (the calling thread is worker 0).
+        template <typename Fn>
+        void RunWorkers(size_t threads, Fn fn) {
+            std::vector<std::thread> workers;
+            for (size_t w = 1; w < threads; ++w) {
+                workers.emplace_back(fn, w);
+            }
+            fn(0);
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+    }
+
+    ParallelHashAggregator::ParallelHashAggregator(NameDictionary* dictionary, ParallelAggregateOptions options)
+        : dictionary_(dictionary), options_(options) {
+        if (options_.threads == 0) {
+            options_.threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        options_.radix_bits = std::clamp(options_.radix_bits, 0, 16);
+        options_.local_slots = std::max<size_t>(options_.local_slots, 16);
+        options_.morsel_rows = std::max<size_t>(options_.morsel_rows, 1);
+    }
+
+    bool ParallelHashAggregator::countBy(const std::vector<GroupColumn>& group_by, const index::RoaringBitmap* rows, ResultSet* out, std::string* error) {
+        *out = ResultSet();
+        stats_ = ParallelAggregateStats();
+        if (group_by.empty() || group_by.size() > 2 || (group_by.size() == 2 && group_by[0] == group_by[1])) {
+            if (error != nullptr) {
+                *error = "countBy: group by one or two distinct columns";
+            }
+            return false;
+        }
+        for (GroupColumn column : group_by) {
+            out->schema.add(groupColumnName(column), ColumnType::Text);
+        }
+        out->schema.add("count", ColumnType::Int64);
+
+        // Record ids to visit: an explicit list, or every row.
+        std::vector<uint32_t> row_list;
+        if (rows != nullptr) {
+            row_list = rows->toVector();
+        }
+
+        const size_t threads = options_.threads;
+        const int radix_bits = options_.radix_bits;
+        const size_t partitions = size_t{ 1 } << radix_bits;
+        stats_.threads = threads;
+        stats_.partitions = partitions;
+
+        dictionary_->readColumns([&](const NameDictionary::Columns& columns) {
+            const uint32_t* first = group_by[0] == GroupColumn::ResourceName ? columns.name_ids.data() : columns.type_ids.data();
+            const uint32_t* second = group_by.size() < 2 ? nullptr
+                : group_by[1] == GroupColumn::ResourceName ? columns.name_ids.data() : columns.type_ids.data();
+            const size_t row_count = columns.name_ids.size();
+            const size_t input_rows = rows != nullptr ? row_list.size() : row_count;
+
+            // --- Phase 1: thread-local pre-aggregation, spilled into radix partitions ---
+            std::vector<std::vector<std::vector<Slot>>> spilled(threads, std::vector<std::vector<Slot>>(partitions));
+            std::vector<uint64_t> worker_rows(threads, 0);
+            std::vector<uint64_t> worker_spilled(threads, 0);
+            std::atomic<size_t> next_morsel{ 0 };
+
+            RunWorkers(threads, [&](size_t w) {
+                CountTable local(options_.local_slots, 0);
+                auto& parts = spilled[w];
+                uint64_t spilled_entries = 0; // Per-worker counters are published once, at the end
+                auto spill = [&]() {
+                    local.drain(true, [&](const Slot& slot) {
+                        uint64_t hash = HashKey(slot.key);
+                        parts[radix_bits == 0 ? 0 : static_cast<size_t>(hash >> (64 - radix_bits))].push_back(slot);
+                        spilled_entries++;
+                    });
+                };
+                const size_t spill_at = local.capacity() / 2;
+                uint64_t counted = 0;
+
+                while (true) {
+                    size_t begin = next_morsel.fetch_add(options_.morsel_rows);
+                    if (begin >= input_rows) {
+                        break;
+                    }
+                    size_t end = std::min(input_rows, begin + options_.morsel_rows);
+                    for (size_t i = begin; i < end; ++i) {
+                        size_t rid = rows != nullptr ? row_list[i] : i;
+                        if (rid >= row_count) {
+                            continue;
+                        }
+                        if (first[rid] == NameDictionary::NO_ID) {
+                            continue;
+                        }
+                        uint64_t key = first[rid];
+                        if (second != nullptr) {
+                            if (second[rid] == NameDictionary::NO_ID) {
+                                continue;
+                            }
+                            key = (key << 32) | second[rid];
+                        }
+                        counted++;
+                        if (local.add(key, HashKey(key), 1) >= spill_at) {
+                            spill();
+                        }
+                    }
+                }
+                spill();
+                worker_rows[w] = counted;
+                worker_spilled[w] = spilled_entries;
+            });
+
+            // --- Phase 2: merge each partition across threads ---
+            std::vector<std::vector<Slot>> merged(partitions);
+            std::atomic<size_t> next_partition{ 0 };
+            RunWorkers(std::min(threads, partitions), [&](size_t /*w*/) {
+                while (true) {
+                    size_t p = next_partition.fetch_add(1);
+                    if (p >= partitions) {
+                        break;
+                    }
+                    size_t total = 0;
+                    for (size_t t = 0; t < threads; ++t) {
+                        total += spilled[t][p].size();
+                    }
+                    if (total == 0) {
+                        continue;
+                    }
+                    CountTable table(total * 2, radix_bits);
+                    for (size_t t = 0; t < threads; ++t) {
+                        for (const Slot& slot : spilled[t][p]) {
+                            table.add(slot.key, HashKey(slot.key), slot.count);
+                        }
+                        std::vector<Slot>().swap(spilled[t][p]); // Release as we go
+                    }
+                    table.drain(false, [&](const Slot& slot) { merged[p].push_back(slot); });
+                }
+            });
+
+            // --- Decode ---
+            size_t groups = 0;
+            for (const auto& part : merged) {
+                groups += part.size();
+            }
+            out->rows.reserve(groups);
+            for (const auto& part : merged) {
+                for (const Slot& slot : part) {
+                    std::vector<Value> row;
+                    uint32_t a = second != nullptr ? static_cast<uint32_t>(slot.key >> 32) : static_cast<uint32_t>(slot.key);
+                    row.emplace_back(group_by[0] == GroupColumn::ResourceName ? columns.names[a] : columns.types[a]);
+                    if (second != nullptr) {
+                        uint32_t b = static_cast<uint32_t>(slot.key);
+                        row.emplace_back(group_by[1] == GroupColumn::ResourceName ? columns.names[b] : columns.types[b]);
+                    }
+                    row.emplace_back(static_cast<int64_t>(slot.count));
+                    out->rows.push_back(std::move(row));
+                }
+            }
+            for (size_t w = 0; w < threads; ++w) {
+                stats_.rows += worker_rows[w];
+                stats_.spilled += worker_spilled[w];
+            }
+        });
+
+        stats_.groups = out->rows.size();
+        return true;
+    }
+
+} // namespace cmse::query
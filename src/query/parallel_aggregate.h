@@ -0,0 +1,60 @@
+#pragma once
+#include "batch.h"
+#include "name_dictionary.h"
+#include "../index/roaring_bitmap.h"
+#include <string>
+#include <vector>
+
+namespace cmse::query {
+
+    enum class GroupColumn { ResourceName, EventType };
+
+    const char* groupColumnName(GroupColumn column);
+
+    struct ParallelAggregateOptions {
+        size_t threads = 0;           // 0 = std::thread::hardware_concurrency()
+        int radix_bits = 6;           // 2^radix_bits partitions in the merge phase
+        size_t local_slots = 16384;   // Thread-local pre-aggregation table (16 bytes per slot: 256 KB, L2-sized)
+        size_t morsel_rows = 16384;   // Rows handed to a worker at a time
+    };
+
+    struct ParallelAggregateStats {
+        size_t threads = 0;
+        uint64_t rows = 0;            // Rows aggregated
+        uint64_t groups = 0;
+        uint64_t spilled = 0;         // Pre-aggregated entries written to the partitions
+        size_t partitions = 0;
+    };
+
+    /**
+     * ParallelHashAggregator
+     * COUNT(*) GROUP BY resource_name and/or event_type over the interned id columns of a
+     * NameDictionary, in two phases:
+     *  1. Workers take morsels of rows and count into a small thread-local open-addressing
+     *     table keyed by the packed ids (cache-resident). When it is half full, its entries are
+     *     scattered into per-thread partition buffers by the top radix bits of the key hash.
+     *  2. Workers take partitions and merge every thread's buffer of that partition into one
+     *     table sized for it; partitions are disjoint, so no locks are needed.
+     * Skewed inputs (few groups) never leave the thread-local tables until the end; large
+     * group counts stream through the partitions with each merge table staying small.
+     *
+     * Output: the group columns (Text) and "count" (Int64), one row per group, in no particular
+     * order. Rows without ids (ingested before the dictionary was registered) are skipped.
+     */
+    class ParallelHashAggregator {
+    public:
+        explicit ParallelHashAggregator(NameDictionary* dictionary, ParallelAggregateOptions options = ParallelAggregateOptions());
+
+        // 'group_by' takes one or two distinct columns; 'rows' (optional) restricts the input to
+        // those record ids. Returns false with *error set on an invalid group_by.
+        bool countBy(const std::vector<GroupColumn>& group_by, const index::RoaringBitmap* rows, ResultSet* out, std::string* error = nullptr);
+
+        const ParallelAggregateStats& lastStats() const { return stats_; }
+
+    private:
+        NameDictionary* dictionary_;
+        ParallelAggregateOptions options_;
+        ParallelAggregateStats stats_;
+    };
+
+} // namespace cmse::query
@@ -0,0 +1,70 @@
+#include "pipeline.h"
+#include <sstream>
+
+namespace cmse::query {
+
+    Pipeline::Pipeline(std::unique_ptr<Source> source) : source_(std::move(source)) {}
+
+    Pipeline& Pipeline::filter(std::vector<Predicate> predicates) {
+        operators_.push_back(std::make_unique<FilterOperator>(std::move(predicates)));
+        return *this;
+    }
+
+    Pipeline& Pipeline::project(std::vector<std::string> columns) {
+        operators_.push_back(std::make_unique<ProjectOperator>(std::move(columns)));
+        return *this;
+    }
+
+    Pipeline& Pipeline::aggregate(std::vector<std::string> group_by, std::vector<AggregateSpec> aggregates) {
+        operators_.push_back(std::make_unique<HashAggregateOperator>(std::move(group_by), std::move(aggregates)));
+        return *this;
+    }
+
+    Pipeline& Pipeline::topN(const std::string& column, size_t n, bool descending) {
+        operators_.push_back(std::make_unique<TopNOperator>(column, n, descending));
+        return *this;
+    }
+
+    Pipeline& Pipeline::limit(size_t n) {
+        operators_.push_back(std::make_unique<LimitOperator>(n));
+        return *this;
+    }
+
+    bool Pipeline::execute(ResultSet* out, std::string* error) {
+        CollectSink sink(out);
+
+        // Open front to back so each stage sees its input schema, then link the chain.
+        const Schema* schema = &source_->schema();
+        for (auto& op : operators_) {
+            if (!op->open(*schema, error)) {
+                return false;
+            }
+            schema = &op->outputSchema();
+        }
+        sink.open(*schema, error);
+
+        for (size_t i = 0; i < operators_.size(); ++i) {
+            operators_[i]->setNext(i + 1 < operators_.size() ? operators_[i + 1].get() : &sink);
+        }
+        Operator* first = operators_.empty() ? static_cast<Operator*>(&sink) : operators_.front().get();
+
+        bool ok = source_->run(first);
+        if (!operators_.empty()) {
+            operators_.back()->setNext(nullptr); // 'sink' goes out of scope
+        }
+        if (!ok && error != nullptr) {
+            *error = "storage failure while reading " + source_->name();
+        }
+        return ok;
+    }
+
+    std::string Pipeline::explain() const {
+        std::ostringstream out;
+        out << source_->name() << "  rows=" << source_->rowsProduced() << "\n";
+        for (const auto& op : operators_) {
+            out << "  -> " << op->name() << "  in=" << op->rowsIn() << " out=" << op->rowsOut() << "\n";
+        }
+        return out.str();
+    }
+
+} // namespace cmse::query
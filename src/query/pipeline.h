@@ -0,0 +1,48 @@
+#pragma once
+#include "batch.h"
+#include "operators.h"
+#include "sources.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cmse::query {
+
+    /**
+     * Pipeline
+     * Builder and executor for a push-based query: one source followed by a chain of
+     * operators, ending in a CollectSink. Example ("top 5 resources by ERROR count"):
+     *
+     *   Pipeline p(std::make_unique<LogScanSource>(&store));
+     *   p.filter({ Predicate::equals("event_type", "ERROR") })
+     *    .aggregate({ "resource_id" }, { AggregateSpec::count("errors") })
+     *    .topN("errors", 5)
+     *    .execute(&result, &error);
+     *
+     * A pipeline can be executed more than once (each run re-opens every operator).
+     */
+    class Pipeline {
+    public:
+        explicit Pipeline(std::unique_ptr<Source> source);
+
+        Pipeline& filter(std::vector<Predicate> predicates);
+        Pipeline& project(std::vector<std::string> columns);
+        Pipeline& aggregate(std::vector<std::string> group_by, std::vector<AggregateSpec> aggregates);
+        Pipeline& topN(const std::string& column, size_t n, bool descending = true);
+        Pipeline& limit(size_t n);
+
+        // Runs the query into 'out'. Returns false with *error set on a plan error
+        // (unknown column, type mismatch) or a storage failure.
+        bool execute(ResultSet* out, std::string* error = nullptr);
+
+        // Source and operators with the row counts of the last execution, one per line.
+        std::string explain() const;
+
+        Source* source() { return source_.get(); }
+
+    private:
+        std::unique_ptr<Source> source_;
+        std::vector<std::unique_ptr<Operator>> operators_;
+    };
+
+} // namespace cmse::query
@@ -0,0 +1,367 @@
+#include "planner.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace cmse::query {
+
+    namespace {
+        constexpr int64_t MIN_TS = std::numeric_limits<int64_t>::min();
+        constexpr int64_t MAX_TS = std::numeric_limits<int64_t>::max();
+
+        std::string formatRows(double value) {
+            std::ostringstream out;
+            out << std::fixed << std::setprecision(value < 100 ? 1 : 0) << value;
+            return out.str();
+        }
+    }
+
+    // =================================================================
+    // LogQuery / Plan Output
+    // =================================================================
+
+    std::vector<Predicate> LogQuery::predicates() const {
+        std::vector<Predicate> result;
+        if (resource_ids) {
+            result.push_back(Predicate::between("resource_id", resource_ids->first, resource_ids->second));
+        }
+        if (time_ms) {
+            result.push_back(Predicate::between("timestamp", time_ms->first, time_ms->second));
+        }
+        if (!event_types.empty()) {
+            result.push_back(Predicate::in("event_type", event_types));
+        }
+        if (!name_prefix.empty()) {
+            result.push_back(Predicate::startsWith("resource_name", name_prefix));
+        }
+        return result;
+    }
+
+    std::string LogQuery::toString() const {
+        std::string text;
+        for (const auto& pred : predicates()) {
+            text += (text.empty() ? "" : " AND ") + pred.toString();
+        }
+        return text.empty() ? "(all records)" : text;
+    }
+
+    const char* accessPathName(AccessPath path) {
+        switch (path) {
+        case AccessPath::SeqScan: return "SeqScan";
+        case AccessPath::IndexRange: return "IndexRange";
+        case AccessPath::TriePrefix: return "TriePrefix";
+        case AccessPath::BitmapIntersection: return "BitmapIntersection";
+        }
+        return "?";
+    }
+
+    std::string QueryPlan::toString() const {
+        std::ostringstream out;
+        out << "Query: " << query.toString() << "\n";
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            const PlanCandidate& c = candidates[i];
+            out << (i == chosen ? "* " : "  ") << std::left << std::setw(20) << accessPathName(c.path)
+                << " access=" << formatRows(c.access_rows) << " out=" << formatRows(c.output_rows)
+                << " pages=" << formatRows(c.pages) << " cost=" << formatRows(c.cost)
+                << "  [" << c.basis << "]\n";
+        }
+        return out.str();
+    }
+
+    std::string PlanReport::toString() const {
+        std::ostringstream out;
+        out << plan.toString();
+        if (!plan.candidates.empty()) {
+            const PlanCandidate& best = plan.best();
+            out << "Chosen " << accessPathName(best.path)
+                << ": access est=" << formatRows(best.access_rows) << " actual=" << actual_access_rows
+                << ", output est=" << formatRows(best.output_rows) << " actual=" << actual_output_rows << "\n";
+        }
+        return out.str();
+    }
+
+    // =================================================================
+    // Setup
+    // =================================================================
+
+    QueryPlanner::QueryPlanner(storage::LogStore* store) : store_(store) {}
+
+    void QueryPlanner::setTimelineIndex(versioning::CompositeVersionManager* tree, version_t version) {
+        timeline_ = tree;
+        timeline_version_ = version;
+        analyzed_ = false;
+    }
+
+    void QueryPlanner::setEventIndex(index::BitmapIndex* events) {
+        events_ = events;
+    }
+
+    void QueryPlanner::setNameIndex(index::TrieIndex* names) {
+        names_ = names;
+    }
+
+    bool QueryPlanner::analyze(size_t sample_rows) {
+        if (!TableStatistics::analyze(store_, sample_rows, &stats_)) {
+            return false;
+        }
+        timeline_height_ = 0;
+        timeline_leaf_entries_ = 0;
+        timeline_leaf_pages_ = 0;
+        if (timeline_ != nullptr) {
+            versioning::CompositeVersionManager::RangeEstimate full;
+            if (!timeline_->estimateRange(timeline_version_, KeyTraits<ResourceTimeKey>::lowest(), KeyTraits<ResourceTimeKey>::highest(), &full)) {
+                return false;
+            }
+            timeline_height_ = full.height;
+            timeline_leaf_entries_ = full.leaf_pages > 0 ? full.entries / full.leaf_pages : 0;
+            timeline_leaf_pages_ = full.leaf_pages;
+        }
+        analyzed_ = true;
+        return true;
+    }
+
+    // =================================================================
+    // Estimation
+    // =================================================================
+
+    double QueryPlanner::heapPages(double rows) const {
+        double pages = static_cast<double>(store_->pageCount());
+        if (pages <= 0 || rows <= 0) {
+            return 0;
+        }
+        return pages * (1.0 - std::pow(1.0 - 1.0 / pages, rows));
+    }
+
+    double QueryPlanner::residualSelectivity(const LogQuery& query, AccessPath path) const {
+        double selectivity = 1.0;
+        if (query.resource_ids && path != AccessPath::IndexRange && path != AccessPath::TriePrefix) {
+            selectivity *= stats_.resource_ids.selectivity(query.resource_ids->first, query.resource_ids->second);
+        }
+        // A multi-resource key range also covers timestamps outside the window for the
+        // resources strictly inside it, so only a single-resource range covers the time predicate.
+        bool range_covers_time = path == AccessPath::IndexRange && query.resource_ids && query.resource_ids->first == query.resource_ids->second;
+        if (query.time_ms && !range_covers_time && path != AccessPath::TriePrefix && path != AccessPath::BitmapIntersection) {
+            selectivity *= stats_.timestamps.selectivity(query.time_ms->first, query.time_ms->second);
+        }
+        if (!query.event_types.empty() && path != AccessPath::BitmapIntersection) {
+            selectivity *= stats_.eventTypeSelectivity(query.event_types);
+        }
+        if (!query.name_prefix.empty() && path != AccessPath::TriePrefix) {
+            selectivity *= stats_.namePrefixSelectivity(query.name_prefix);
+        }
+        return selectivity;
+    }
+
+    PlanCandidate QueryPlanner::estimateSeqScan(const LogQuery& query) {
+        PlanCandidate c;
+        c.path = AccessPath::SeqScan;
+        c.access_rows = static_cast<double>(store_->size());
+        c.output_rows = c.access_rows * residualSelectivity(query, c.path);
+        c.pages = static_cast<double>(store_->pageCount());
+        c.cost = c.pages + c.access_rows * ROW_COST;
+        c.basis = "histograms over " + std::to_string(stats_.sample_rows) + " sampled rows";
+        return c;
+    }
+
+    std::optional<PlanCandidate> QueryPlanner::estimateIndexRange(const LogQuery& query) {
+        if (timeline_ == nullptr || !query.resource_ids) {
+            return std::nullopt;
+        }
+        int64_t t_lo = query.time_ms ? query.time_ms->first : MIN_TS;
+        int64_t t_hi = query.time_ms ? query.time_ms->second : MAX_TS;
+        versioning::CompositeVersionManager::RangeEstimate est;
+        if (!timeline_->estimateRange(timeline_version_, { query.resource_ids->first, t_lo }, { query.resource_ids->second, t_hi }, &est)) {
+            return std::nullopt;
+        }
+
+        PlanCandidate c;
+        c.path = AccessPath::IndexRange;
+        c.access_rows = est.entries;
+        c.output_rows = c.access_rows * residualSelectivity(query, c.path);
+        c.pages = est.height + est.leaf_pages + heapPages(c.access_rows);
+        c.cost = c.pages + c.access_rows * (INDEX_ENTRY_COST + ROW_COST);
+        c.basis = "node density/min-max, " + std::to_string(est.pages_read) + " tree pages read";
+        return c;
+    }
+
+    std::optional<PlanCandidate> QueryPlanner::estimateTriePrefix(const LogQuery& query) {
+        if (names_ == nullptr || timeline_ == nullptr || query.name_prefix.empty()) {
+            return std::nullopt;
+        }
+        double total_names = static_cast<double>(names_->size());
+        double names = static_cast<double>(names_->prefixCount(query.name_prefix));
+
+        // Records are assumed evenly spread over names; the per-resource ranges apply the
+        // time window, and resources outside the id range are dropped before the lookups.
+        double rows = total_names > 0 ? static_cast<double>(store_->size()) * names / total_names : 0;
+        if (query.time_ms) {
+            rows *= stats_.timestamps.selectivity(query.time_ms->first, query.time_ms->second);
+        }
+        if (query.resource_ids) {
+            rows *= stats_.resource_ids.selectivity(query.resource_ids->first, query.resource_ids->second);
+        }
+
+        PlanCandidate c;
+        c.path = AccessPath::TriePrefix;
+        c.access_rows = rows;
+        c.output_rows = rows * residualSelectivity(query, c.path);
+        double suffix_nodes = std::max(1.0, stats_.averageNameLength() - static_cast<double>(query.name_prefix.size()));
+        double trie_pages = static_cast<double>(query.name_prefix.size()) + 1 + names * suffix_nodes;
+        // The batched walk fetches each timeline node once: at most one leaf per name plus the
+        // leaves its rows fill, and no more internal nodes than leaves below them.
+        double leaf_pages = timeline_leaf_entries_ > 0 ? rows / timeline_leaf_entries_ : 0;
+        double leaves = std::min(names + leaf_pages, std::max(timeline_leaf_pages_, leaf_pages));
+        double internal = std::min(names * std::max(0, timeline_height_ - 1), leaves);
+        c.pages = trie_pages + leaves + internal + heapPages(rows);
+        c.cost = c.pages + (names + rows) * INDEX_ENTRY_COST + rows * ROW_COST;
+        c.basis = "subtree_terminals: " + formatRows(names) + " of " + formatRows(total_names) + " names";
+        return c;
+    }
+
+    std::optional<PlanCandidate> QueryPlanner::estimateBitmap(const LogQuery& query) {
+        if (events_ == nullptr || query.event_types.empty()) {
+            return std::nullopt;
+        }
+        double members = 0;
+        for (const auto& type : query.event_types) {
+            members += static_cast<double>(events_->cardinality(type));
+        }
+        double rows = members;
+        double zone_pages = 0;
+        if (query.time_ms) {
+            rows *= stats_.timestamps.selectivity(query.time_ms->first, query.time_ms->second);
+            zone_pages = 2; // Pages straddling the window edges are read by LogStore::timeRange
+        }
+
+        PlanCandidate c;
+        c.path = AccessPath::BitmapIntersection;
+        c.access_rows = rows;
+        c.output_rows = rows * residualSelectivity(query, c.path);
+        c.pages = zone_pages + heapPages(rows);
+        c.cost = c.pages + members * BITMAP_ENTRY_COST + rows * ROW_COST;
+        c.basis = "bitmap cardinality " + formatRows(members);
+        return c;
+    }
+
+    QueryPlan QueryPlanner::plan(const LogQuery& query) {
+        if (!analyzed_) {
+            analyze();
+        }
+        QueryPlan result;
+        result.query = query;
+        result.candidates.push_back(estimateSeqScan(query));
+        for (auto candidate : { estimateIndexRange(query), estimateTriePrefix(query), estimateBitmap(query) }) {
+            if (candidate) {
+                result.candidates.push_back(*candidate);
+            }
+        }
+        for (size_t i = 1; i < result.candidates.size(); ++i) {
+            if (result.candidates[i].cost < result.candidates[result.chosen].cost) {
+                result.chosen = i;
+            }
+        }
+        return result;
+    }
+
+    // =================================================================
+    // Execution
+    // =================================================================
+
+    bool QueryPlanner::resolveIndexRange(const LogQuery& query, index::RoaringBitmap* out) {
+        int64_t t_lo = query.time_ms ? query.time_ms->first : MIN_TS;
+        int64_t t_hi = query.time_ms ? query.time_ms->second : MAX_TS;
+        std::vector<versioning::CompositeVersionManager::Entry> entries;
+        if (!timeline_->scanRange(timeline_version_, { query.resource_ids->first, t_lo }, { query.resource_ids->second, t_hi }, UINT32_MAX, &entries)) {
+            return false;
+        }
+        for (const auto& entry : entries) {
+            out->add(static_cast<record_id_t>(entry.second));
+        }
+        return true;
+    }
+
+    bool QueryPlanner::resolveTriePrefix(const LogQuery& query, index::RoaringBitmap* out) {
+        std::vector<index::TrieIndex::Entry> names;
+        if (!names_->prefixScan(query.name_prefix, UINT32_MAX, &names)) {
+            return false;
+        }
+        // Index-to-index join: the resource ids of the matching trie terminals become key ranges
+        // of the timeline tree, served by one batched walk in key order (scanRanges sorts them).
+        int64_t t_lo = query.time_ms ? query.time_ms->first : MIN_TS;
+        int64_t t_hi = query.time_ms ? query.time_ms->second : MAX_TS;
+        std::vector<std::pair<ResourceTimeKey, ResourceTimeKey>> ranges;
+        ranges.reserve(names.size());
+        for (const auto& name : names) {
+            if (!query.resource_ids || (query.resource_ids->first <= name.second && name.second <= query.resource_ids->second)) {
+                ranges.push_back({ { name.second, t_lo }, { name.second, t_hi } });
+            }
+        }
+
+        std::vector<versioning::CompositeVersionManager::Entry> entries;
+        if (!timeline_->scanRanges(timeline_version_, std::move(ranges), &entries)) {
+            return false;
+        }
+        for (const auto& entry : entries) {
+            out->add(static_cast<record_id_t>(entry.second));
+        }
+        return true;
+    }
+
+    bool QueryPlanner::resolveBitmap(const LogQuery& query, index::RoaringBitmap* out) {
+        if (!query.time_ms) {
+            *out = events_->anyOf(query.event_types);
+            return true;
+        }
+        index::RoaringBitmap window;
+        if (!store_->timeRange(query.time_ms->first, query.time_ms->second, &window)) {
+            return false;
+        }
+        *out = events_->anyOf(query.event_types, window);
+        return true;
+    }
+
+    bool QueryPlanner::build(const QueryPlan& plan, std::unique_ptr<Pipeline>* out, std::string* error) {
+        AccessPath path = plan.best().path;
+        std::unique_ptr<Source> source;
+        if (path == AccessPath::SeqScan) {
+            source = std::make_unique<LogScanSource>(store_);
+        }
+        else {
+            index::RoaringBitmap rids;
+            bool ok = path == AccessPath::IndexRange ? resolveIndexRange(plan.query, &rids)
+                : path == AccessPath::TriePrefix ? resolveTriePrefix(plan.query, &rids)
+                : resolveBitmap(plan.query, &rids);
+            if (!ok) {
+                if (error != nullptr) {
+                    *error = std::string("storage failure while resolving ") + accessPathName(path);
+                }
+                return false;
+            }
+            source = std::make_unique<RecordIdSource>(store_, std::move(rids));
+        }
+
+        *out = std::make_unique<Pipeline>(std::move(source));
+        std::vector<Predicate> predicates = plan.query.predicates();
+        if (!predicates.empty()) {
+            (*out)->filter(std::move(predicates));
+        }
+        return true;
+    }
+
+    bool QueryPlanner::execute(const LogQuery& query, ResultSet* out, PlanReport* report, std::string* error) {
+        QueryPlan chosen = plan(query);
+        std::unique_ptr<Pipeline> pipeline;
+        if (!build(chosen, &pipeline, error) || !pipeline->execute(out, error)) {
+            return false;
+        }
+        if (report != nullptr) {
+            report->plan = std::move(chosen);
+            report->actual_access_rows = pipeline->source()->rowsProduced();
+            report->actual_output_rows = out->rows.size();
+        }
+        return true;
+    }
+
+} // namespace cmse::query
@@ -0,0 +1,147 @@
+#pragma once
+#include "pipeline.h"
+#include "statistics.h"
+#include "../index/bitmap_index.h"
+#include "../index/trie_index.h"
+#include "../storage/log_store.h"
+#include "../versioning/version_manager.h"
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cmse::query {
+
+    /**
+     * LogQuery
+     * Conjunctive selection over the log store. Unset members do not restrict.
+     */
+    struct LogQuery {
+        std::optional<std::pair<int64_t, int64_t>> resource_ids;   // Inclusive
+        std::optional<std::pair<int64_t, int64_t>> time_ms;        // Inclusive, epoch milliseconds
+        std::vector<std::string> event_types;                      // IN list
+        std::string name_prefix;                                   // resource_name LIKE 'prefix%'
+
+        // The query as filter predicates over the log schema.
+        std::vector<Predicate> predicates() const;
+        std::string toString() const;
+    };
+
+    enum class AccessPath {
+        SeqScan,             // Every page of the log store
+        IndexRange,          // (resource_id, timestamp) B+Tree range scan
+        TriePrefix,          // Names under a prefix -> per-resource B+Tree ranges
+        BitmapIntersection   // Event-type bitmaps (AND the time range from the zone maps)
+    };
+
+    const char* accessPathName(AccessPath path);
+
+    // Estimated size and cost of one access path. Cost unit: one page fetch.
+    struct PlanCandidate {
+        AccessPath path = AccessPath::SeqScan;
+        double access_rows = 0;  // Records fetched by the access path
+        double output_rows = 0;  // Records left after the remaining predicates
+        double pages = 0;        // Page fetches (index + log store)
+        double cost = 0;
+        std::string basis;       // Which statistics the estimate came from
+    };
+
+    struct QueryPlan {
+        LogQuery query;
+        std::vector<PlanCandidate> candidates;  // Every applicable path, in AccessPath order
+        size_t chosen = 0;                      // Cheapest candidate
+
+        const PlanCandidate& best() const { return candidates[chosen]; }
+        std::string toString() const;
+    };
+
+    // A plan with the row counts observed when it ran.
+    struct PlanReport {
+        QueryPlan plan;
+        uint64_t actual_access_rows = 0;
+        uint64_t actual_output_rows = 0;
+
+        std::string toString() const;
+    };
+
+    /**
+     * QueryPlanner
+     * Cost-based choice of the access path for a LogQuery:
+     *  - SeqScan: every page, predicates applied by a filter.
+     *  - IndexRange: needs a resource_id range; the size comes from the B+Tree node statistics
+     *    (VersionManager::estimateRange: density and min/max of the boundary paths).
+     *  - TriePrefix: needs a name prefix; names under it come from the trie's subtree_terminals.
+     *    Their resource ids drive one batched, key-sorted walk of the timeline tree.
+     *  - BitmapIntersection: needs event types; exact bitmap cardinalities.
+     * The selectivity of the predicates an access path does not cover comes from sampled
+     * histograms (TableStatistics), combined assuming independence.
+     *
+     * Index values must be record ids (as written by the ingest code and the tests). Whatever
+     * the path, the full query is re-checked by a FilterOperator, so every plan returns the same
+     * rows; the plan only decides how many records are fetched to find them.
+     *
+     * Not thread-safe: use one planner per thread (the indexes themselves are synchronized).
+     */
+    class QueryPlanner {
+    public:
+        static constexpr double ROW_COST = 0.01;            // Decode and filter one record
+        static constexpr double INDEX_ENTRY_COST = 0.002;   // Read one B+Tree / trie entry
+        static constexpr double BITMAP_ENTRY_COST = 0.0005; // Visit one bitmap member
+        static constexpr size_t DEFAULT_SAMPLE_ROWS = 4096;
+
+        explicit QueryPlanner(storage::LogStore* store);
+
+        // Optional indexes (not owned). A path whose index is not set is never considered.
+        // TriePrefix needs both the name index and the timeline index.
+        void setTimelineIndex(versioning::CompositeVersionManager* tree, version_t version);
+        void setEventIndex(index::BitmapIndex* events);
+        void setNameIndex(index::TrieIndex* names);
+
+        // Re-samples the statistics (plan() does it once on first use; call again after large ingests).
+        bool analyze(size_t sample_rows = DEFAULT_SAMPLE_ROWS);
+        const TableStatistics& statistics() const { return stats_; }
+
+        QueryPlan plan(const LogQuery& query);
+
+        // Pipeline of the chosen path: its source followed by a filter with every predicate of
+        // the query. Further operators can be appended before execute().
+        // Returns false with *error set on a storage failure while resolving an index.
+        bool build(const QueryPlan& plan, std::unique_ptr<Pipeline>* out, std::string* error = nullptr);
+
+        // plan() + build() + execute(); 'report' (optional) receives estimated and actual rows.
+        bool execute(const LogQuery& query, ResultSet* out, PlanReport* report, std::string* error = nullptr);
+
+    private:
+        // Estimated fraction of records matching the predicates not covered by 'path'.
+        double residualSelectivity(const LogQuery& query, AccessPath path) const;
+
+        PlanCandidate estimateSeqScan(const LogQuery& query);
+        std::optional<PlanCandidate> estimateIndexRange(const LogQuery& query);
+        std::optional<PlanCandidate> estimateTriePrefix(const LogQuery& query);
+        std::optional<PlanCandidate> estimateBitmap(const LogQuery& query);
+
+        // Record ids of the chosen index path.
+        bool resolveIndexRange(const LogQuery& query, index::RoaringBitmap* out);
+        bool resolveTriePrefix(const LogQuery& query, index::RoaringBitmap* out);
+        bool resolveBitmap(const LogQuery& query, index::RoaringBitmap* out);
+
+        // Expected distinct pages touched by 'rows' random records (Cardenas' formula).
+        double heapPages(double rows) const;
+
+        storage::LogStore* store_;
+        versioning::CompositeVersionManager* timeline_ = nullptr;
+        version_t timeline_version_ = INVALID_VERSION;
+        index::BitmapIndex* events_ = nullptr;
+        index::TrieIndex* names_ = nullptr;
+
+        TableStatistics stats_;
+        bool analyzed_ = false;
+
+        // Shape of the timeline tree (from a full-range estimate in analyze()).
+        int timeline_height_ = 0;
+        double timeline_leaf_entries_ = 0;
+        double timeline_leaf_pages_ = 0;
+    };
+
+} // namespace cmse::query
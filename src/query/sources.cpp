@@ -0,0 +1,90 @@
+#include "sources.h"
+#include <algorithm>
+
+namespace cmse::query {
+
+    // =================================================================
+    // Source
+    // =================================================================
+
+    Source::Source(std::vector<LogColumn> columns) : columns_(std::move(columns)), schema_(logSchema(columns_)) {}
+
+    void Source::setBatchSize(size_t rows) {
+        batch_size_ = std::clamp<size_t>(rows, 1, MAX_BATCH_SIZE);
+    }
+
+    bool Source::push(Batch& batch, Operator* sink) {
+        batch.selectAll();
+        rows_produced_ += batch.rows;
+        bool more = sink->consume(batch);
+        batch.clear();
+        return more;
+    }
+
+    // =================================================================
+    // LogScanSource
+    // =================================================================
+
+    LogScanSource::LogScanSource(storage::LogStore* store, std::vector<LogColumn> columns)
+        : Source(std::move(columns)), store_(store) {}
+
+    bool LogScanSource::run(Operator* sink) {
+        rows_produced_ = 0;
+        Batch batch(schema_);
+        std::vector<LogRecord> records;
+        bool ok = true;
+        bool more = true;
+
+        size_t num_pages = store_->pageCount();
+        for (size_t p = 0; p < num_pages && more; ++p) {
+            if (!store_->readPage(p, &records)) {
+                ok = false;
+                break;
+            }
+            record_id_t first = static_cast<record_id_t>(p * storage::LogStore::RECORDS_PER_PAGE);
+            for (size_t slot = 0; slot < records.size(); ++slot) {
+                appendLogRecord(&batch, columns_, first + static_cast<record_id_t>(slot), records[slot]);
+                if (batch.rows == batch_size_ && !push(batch, sink)) {
+                    more = false;
+                    break;
+                }
+            }
+        }
+        if (more && batch.rows > 0) {
+            push(batch, sink);
+        }
+        sink->finish();
+        return ok;
+    }
+
+    // =================================================================
+    // RecordIdSource
+    // =================================================================
+
+    RecordIdSource::RecordIdSource(storage::LogStore* store, index::RoaringBitmap rids, std::vector<LogColumn> columns)
+        : Source(std::move(columns)), store_(store), rids_(std::move(rids)) {}
+
+    bool RecordIdSource::run(Operator* sink) {
+        rows_produced_ = 0;
+        Batch batch(schema_);
+        bool more = true;
+
+        bool ok = store_->forEach(rids_, [&](record_id_t rid, const LogRecord& record) {
+            appendLogRecord(&batch, columns_, rid, record);
+            if (batch.rows == batch_size_) {
+                more = push(batch, sink);
+            }
+            return more;
+        });
+        if (more && batch.rows > 0) {
+            push(batch, sink);
+        }
+        sink->finish();
+        return ok;
+    }
+
+    std::string RecordIdSource::name() const {
+        return "RecordIds(" + std::to_string(rids_.cardinality()) + ")";
+    }
+
+} // namespace cmse::query
@@ -0,0 +1,175 @@
+#pragma once
+#include "batch.h"
+#include "operators.h"
+#include "../index/roaring_bitmap.h"
+#include "../storage/log_store.h"
+#include "../versioning/version_manager.h"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cmse::query {
+
+    /**
+     * Source
+     * Start of a pipeline: produces LogRecord batches (only the requested columns) and pushes
+     * them into the first operator until the input is exhausted or the pipeline stops it.
+     */
+    class Source {
+    public:
+        explicit Source(std::vector<LogColumn> columns = allLogColumns());
+        virtual ~Source() = default;
+
+        const Schema& schema() const { return schema_; }
+
+        // Rows per batch, clamped to [1, MAX_BATCH_SIZE].
+        void setBatchSize(size_t rows);
+        size_t batchSize() const { return batch_size_; }
+
+        // Pushes all batches into 'sink' and then calls sink->finish().
+        // Returns false on a storage failure (the sink is still finished).
+        virtual bool run(Operator* sink) = 0;
+
+        virtual std::string name() const = 0;
+        uint64_t rowsProduced() const { return rows_produced_; }
+
+    protected:
+        // Hands a full batch to the sink and clears it. Returns false when the sink is done.
+        bool push(Batch& batch, Operator* sink);
+
+        std::vector<LogColumn> columns_;
+        Schema schema_;
+        size_t batch_size_ = BATCH_SIZE;
+        uint64_t rows_produced_ = 0;
+    };
+
+    // Sequential scan of every record in the store.
+    class LogScanSource : public Source {
+    public:
+        explicit LogScanSource(storage::LogStore* store, std::vector<LogColumn> columns = allLogColumns());
+
+        bool run(Operator* sink) override;
+        std::string name() const override { return "LogScan"; }
+
+    private:
+        storage::LogStore* store_;
+    };
+
+    // Records listed in a bitmap (e.g. a BitmapIndex / time-range result), in rid order.
+    class RecordIdSource : public Source {
+    public:
+        RecordIdSource(storage::LogStore* store, index::RoaringBitmap rids, std::vector<LogColumn> columns = allLogColumns());
+
+        bool run(Operator* sink) override;
+        std::string name() const override;
+
+    private:
+        storage::LogStore* store_;
+        index::RoaringBitmap rids_;
+    };
+
+    /**
+     * IndexRangeSource
+     * Records whose B+Tree key lies in [start, end] (values are record ids), in key order.
+     * Works for any versioned tree (KeyType, ResourceTimeKey, ...).
+     *
+     * ORDER BY key DESC / LIMIT can be pushed down: setDescending() walks the tree from end
+     * (VersionManager::scanRangeReverse), one batch of entries at a time, so a LimitOperator or
+     * TopNOperator that stops the pipeline also stops the scan; setLimit() caps the entries read.
+     * A limit is only exact if no later operator drops rows (otherwise keep a LimitOperator
+     * after the filter and leave the source unlimited).
+     */
+    template <typename KeyT>
+    class IndexRangeSource : public Source {
+    public:
+        using Entry = typename versioning::BasicVersionManager<KeyT>::Entry;
+
+        IndexRangeSource(versioning::BasicVersionManager<KeyT>* tree, version_t version, const KeyT& start, const KeyT& end,
+            storage::LogStore* store, std::vector<LogColumn> columns = allLogColumns())
+            : Source(std::move(columns)), tree_(tree), version_(version), start_(start), end_(end), store_(store) {}
+
+        void setDescending(bool descending) { descending_ = descending; }
+        void setLimit(size_t limit) { limit_ = limit; }
+
+        bool run(Operator* sink) override {
+            rows_produced_ = 0;
+            Batch batch(schema_);
+            bool ok = descending_ ? runDescending(batch, sink) : runAscending(batch, sink);
+            if (batch.rows > 0) {
+                push(batch, sink);
+            }
+            sink->finish();
+            return ok;
+        }
+
+        std::string name() const override {
+            std::string text = "IndexRange";
+            if (descending_) {
+                text += " DESC";
+            }
+            if (limit_ != SIZE_MAX) {
+                text += " LIMIT " + std::to_string(limit_);
+            }
+            return text;
+        }
+
+    private:
+        bool runAscending(Batch& batch, Operator* sink) {
+            std::vector<Entry> entries;
+            bool ok = tree_->scanRange(version_, start_, end_, std::min<size_t>(limit_, UINT32_MAX), &entries);
+            bool open = true;
+            return emit(entries, batch, sink, &open) && ok;
+        }
+
+        // One batch of entries per tree walk; each walk resumes just below the last key returned.
+        bool runDescending(Batch& batch, Operator* sink) {
+            std::vector<Entry> entries;
+            KeyT end = end_;
+            size_t remaining = limit_;
+            bool open = true;
+            while (open && remaining > 0) {
+                size_t wanted = std::min(remaining, batch_size_);
+                entries.clear();
+                if (!tree_->scanRangeReverse(version_, start_, end, wanted, &entries)) {
+                    return false;
+                }
+                if (!emit(entries, batch, sink, &open)) {
+                    return false;
+                }
+                remaining -= entries.size();
+                if (entries.size() < wanted || entries.back().first == start_) {
+                    break; // Range exhausted
+                }
+                end = KeyTraits<KeyT>::predecessor(entries.back().first);
+            }
+            return true;
+        }
+
+        // Fetches the records of 'entries' into batches. Clears *open once the sink is done.
+        bool emit(const std::vector<Entry>& entries, Batch& batch, Operator* sink, bool* open) {
+            LogRecord record;
+            for (const Entry& entry : entries) {
+                record_id_t rid = static_cast<record_id_t>(entry.second);
+                if (!store_->get(rid, &record)) {
+                    return false;
+                }
+                appendLogRecord(&batch, columns_, rid, record);
+                if (batch.rows == batch_size_ && !push(batch, sink)) {
+                    *open = false;
+                    return true;
+                }
+            }
+            return true;
+        }
+
+        versioning::BasicVersionManager<KeyT>* tree_;
+        version_t version_;
+        KeyT start_;
+        KeyT end_;
+        storage::LogStore* store_;
+        bool descending_ = false;
+        size_t limit_ = SIZE_MAX;
+    };
+
+} // namespace cmse::query
@@ -0,0 +1,126 @@
+#include "statistics.h"
+#include <algorithm>
+
+namespace cmse::query {
+
+    // =================================================================
+    // EquiDepthHistogram
+    // =================================================================
+
+    void EquiDepthHistogram::build(std::vector<int64_t> values, size_t buckets) {
+        buckets_.clear();
+        total_ = values.size();
+        if (values.empty()) {
+            return;
+        }
+        std::sort(values.begin(), values.end());
+        size_t depth = std::max<size_t>(1, (values.size() + std::max<size_t>(buckets, 1) - 1) / std::max<size_t>(buckets, 1));
+
+        size_t begin = 0;
+        while (begin < values.size()) {
+            size_t end = std::min(begin + depth, values.size());
+            while (end < values.size() && values[end] == values[end - 1]) {
+                ++end; // Keep a run of equal values together
+            }
+            buckets_.push_back({ values[begin], values[end - 1], static_cast<uint64_t>(end - begin) });
+            begin = end;
+        }
+    }
+
+    double EquiDepthHistogram::selectivity(int64_t lo, int64_t hi) const {
+        if (total_ == 0 || hi < lo) {
+            return 0.0;
+        }
+        double matched = 0;
+        for (const Bucket& bucket : buckets_) {
+            int64_t overlap_lo = std::max(bucket.lo, lo);
+            int64_t overlap_hi = std::min(bucket.hi, hi);
+            if (overlap_hi < overlap_lo) {
+                continue;
+            }
+            // Computed in double: the widths of timestamp buckets can exceed int64 differences.
+            double width = static_cast<double>(bucket.hi) - static_cast<double>(bucket.lo) + 1.0;
+            double overlap = static_cast<double>(overlap_hi) - static_cast<double>(overlap_lo) + 1.0;
+            matched += bucket.count * std::min(1.0, overlap / width);
+        }
+        return matched / static_cast<double>(total_);
+    }
+
+    // =================================================================
+    // TableStatistics
+    // =================================================================
+
+    double TableStatistics::eventTypeSelectivity(const std::vector<std::string>& types) const {
+        if (sample_rows == 0) {
+            return 0.0;
+        }
+        uint64_t matched = 0;
+        for (const auto& type : types) {
+            auto it = event_types.find(type);
+            if (it != event_types.end()) {
+                matched += it->second;
+            }
+        }
+        return std::min(1.0, static_cast<double>(matched) / static_cast<double>(sample_rows));
+    }
+
+    double TableStatistics::namePrefixSelectivity(const std::string& prefix) const {
+        if (names.empty()) {
+            return 0.0;
+        }
+        auto first = std::lower_bound(names.begin(), names.end(), prefix);
+        auto last = first;
+        while (last != names.end() && last->compare(0, prefix.size(), prefix) == 0) {
+            ++last;
+        }
+        return static_cast<double>(last - first) / static_cast<double>(names.size());
+    }
+
+    double TableStatistics::averageNameLength() const {
+        if (names.empty()) {
+            return 0.0;
+        }
+        size_t total = 0;
+        for (const auto& name : names) {
+            total += name.size();
+        }
+        return static_cast<double>(total) / static_cast<double>(names.size());
+    }
+
+    bool TableStatistics::analyze(storage::LogStore* store, size_t sample_rows, TableStatistics* out) {
+        *out = TableStatistics();
+        out->row_count = store->size();
+        out->page_count = store->pageCount();
+        if (out->page_count == 0) {
+            return true;
+        }
+
+        size_t wanted_pages = std::max<size_t>(1, (sample_rows + storage::LogStore::RECORDS_PER_PAGE - 1) / storage::LogStore::RECORDS_PER_PAGE);
+        size_t step = std::max<size_t>(1, out->page_count / wanted_pages);
+
+        std::vector<int64_t> ids;
+        std::vector<int64_t> times;
+        std::vector<LogRecord> records;
+        for (size_t p = 0; p < out->page_count; p += step) {
+            if (!store->readPage(p, &records)) {
+                return false;
+            }
+            for (const LogRecord& record : records) {
+                ids.push_back(record.resource_id);
+                times.push_back(storage::LogStore::timestampMillis(record));
+
+                const char* type_end = std::find(record.event_type, record.event_type + sizeof(record.event_type), '\0');
+                out->event_types[std::string(record.event_type, type_end)]++;
+                const char* name_end = std::find(record.resource_name, record.resource_name + sizeof(record.resource_name), '\0');
+                out->names.emplace_back(record.resource_name, name_end);
+            }
+        }
+
+        out->sample_rows = ids.size();
+        out->resource_ids.build(std::move(ids));
+        out->timestamps.build(std::move(times));
+        std::sort(out->names.begin(), out->names.end());
+        return true;
+    }
+
+} // namespace cmse::query
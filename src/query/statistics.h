@@ -0,0 +1,73 @@
+#pragma once
+#include "../common/types.h"
+#include "../storage/log_store.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace cmse::query {
+
+    /**
+     * EquiDepthHistogram
+     * Histogram over a sample of int64 values where every bucket holds about the same number
+     * of samples. A run of equal values is never split, so a frequent value ends up in a
+     * bucket of its own and its selectivity is exact; inside other buckets values are assumed
+     * uniform over [lo, hi].
+     */
+    class EquiDepthHistogram {
+    public:
+        static constexpr size_t DEFAULT_BUCKETS = 64;
+
+        struct Bucket {
+            int64_t lo;
+            int64_t hi;
+            uint64_t count;
+        };
+
+        // Replaces the histogram with one built from 'values' (any order).
+        void build(std::vector<int64_t> values, size_t buckets = DEFAULT_BUCKETS);
+
+        // Estimated fraction of values in [lo, hi] (inclusive); 0 for an empty histogram.
+        double selectivity(int64_t lo, int64_t hi) const;
+
+        const std::vector<Bucket>& buckets() const { return buckets_; }
+        uint64_t sampleCount() const { return total_; }
+
+    private:
+        std::vector<Bucket> buckets_;
+        uint64_t total_ = 0;
+    };
+
+    /**
+     * TableStatistics
+     * Sampled statistics of a LogStore for the query planner: histograms of resource_id and
+     * timestamp, event-type frequencies and the sorted sampled resource names (name-prefix
+     * selectivity is a binary search).
+     *
+     * The sample is a block sample: evenly spaced pages are read whole, which touches
+     * sample_rows / RECORDS_PER_PAGE pages instead of one page per sampled record.
+     */
+    struct TableStatistics {
+        uint64_t row_count = 0;
+        size_t page_count = 0;
+        uint64_t sample_rows = 0;
+
+        EquiDepthHistogram resource_ids;
+        EquiDepthHistogram timestamps;
+        std::map<std::string, uint64_t> event_types;    // Sampled records per type
+        std::vector<std::string> names;                 // Sampled resource names, sorted (with duplicates)
+
+        // Estimated fraction of records whose event type is any of 'types'.
+        double eventTypeSelectivity(const std::vector<std::string>& types) const;
+
+        // Estimated fraction of records whose resource name starts with 'prefix'.
+        double namePrefixSelectivity(const std::string& prefix) const;
+
+        // Average length of the sampled resource names.
+        double averageNameLength() const;
+
+        // Samples about 'sample_rows' records of 'store'. Returns false on buffer-pool failure.
+        static bool analyze(storage::LogStore* store, size_t sample_rows, TableStatistics* out);
+    };
+
+} // namespace cmse::query
@@ -0,0 +1,230 @@
+#include "rollup_store.h"
+#include "../index/bitmap_index.h"
+#include <algorithm>
+#include <limits>
+
+namespace cmse::rollup {
+
+    RollupStore::RollupStore(adapter::BufferPoolAdapter* bpm, std::vector<int64_t> bucket_widths_ms, size_t flush_threshold)
+        : flush_threshold_(std::max<size_t>(flush_threshold, 1)) {
+        bucket_widths_ms.erase(std::remove_if(bucket_widths_ms.begin(), bucket_widths_ms.end(), [](int64_t w) { return w <= 0; }),
+            bucket_widths_ms.end());
+        std::sort(bucket_widths_ms.begin(), bucket_widths_ms.end());
+        bucket_widths_ms.erase(std::unique(bucket_widths_ms.begin(), bucket_widths_ms.end()), bucket_widths_ms.end());
+
+        widths_ = std::move(bucket_widths_ms);
+        for (int64_t width : widths_) {
+            tables_.push_back(std::make_unique<Table>(bpm, width));
+        }
+    }
+
+    int64_t RollupStore::bucketStart(int64_t timestamp_ms, int64_t width_ms) {
+        int64_t q = timestamp_ms / width_ms;
+        if (timestamp_ms % width_ms < 0) {
+            --q;
+        }
+        return q * width_ms;
+    }
+
+    // =================================================================
+    // Maintenance
+    // =================================================================
+
+    void RollupStore::onIngest(record_id_t /*rid*/, const LogRecord& record) {
+        std::lock_guard<std::mutex> lock(latch_);
+
+        std::string type = index::BitmapIndex::eventTypeOf(record);
+        auto it = codes_.find(type);
+        if (it == codes_.end()) {
+            it = codes_.emplace(type, static_cast<int64_t>(event_types_.size())).first;
+            event_types_.push_back(type);
+        }
+
+        int64_t ts = storage::LogStore::timestampMillis(record);
+        for (auto& table : tables_) {
+            ++table->pending[RollupKey{ bucketStart(ts, table->width_ms), record.resource_id, it->second }];
+        }
+        if (++pending_records_ >= flush_threshold_) {
+            flushLocked(); // On failure the deltas stay pending and are retried next time
+        }
+    }
+
+    bool RollupStore::flush() {
+        std::lock_guard<std::mutex> lock(latch_);
+        return flushLocked();
+    }
+
+    bool RollupStore::flushLocked() {
+        for (auto& table : tables_) {
+            if (table->pending.empty()) {
+                continue;
+            }
+            auto& tree = table->tree;
+            version_t base = tree.latestVersion();
+            version_t version = tree.createVersion();
+
+            for (const auto& [key, delta] : table->pending) {
+                ValueType current = 0;
+                if (base != INVALID_VERSION) {
+                    tree.lookup(base, key, &current); // Absent: stays 0
+                }
+                if (!tree.applyUpdate(version, base, key, current + delta)) {
+                    tree.abortVersion(version);
+                    return false;
+                }
+            }
+            if (!tree.commitVersion(version)) {
+                return false;
+            }
+            table->pending.clear();
+        }
+        pending_records_ = 0;
+        ++flushes_;
+        return true;
+    }
+
+    // =================================================================
+    // Queries
+    // =================================================================
+
+    bool RollupStore::collectLocked(Table& table, int64_t first_bucket_ms, int64_t last_bucket_ms, std::map<RollupKey, int64_t>* out) {
+        out->clear();
+        RollupKey start = RollupKey::bucketsBegin(first_bucket_ms);
+        RollupKey end = RollupKey::bucketsEnd(last_bucket_ms);
+
+        version_t version = table.tree.latestVersion();
+        if (version != INVALID_VERSION) {
+            std::vector<versioning::RollupVersionManager::Entry> entries;
+            if (!table.tree.scanRange(version, start, end, std::numeric_limits<size_t>::max(), &entries)) {
+                return false;
+            }
+            for (const auto& [key, count] : entries) {
+                out->emplace_hint(out->end(), key, count);
+            }
+        }
+        for (auto it = table.pending.lower_bound(start); it != table.pending.end() && !(end < it->first); ++it) {
+            (*out)[it->first] += it->second;
+        }
+        return true;
+    }
+
+    bool RollupStore::scanBuckets(int64_t bucket_width_ms, int64_t first_bucket_ms, int64_t last_bucket_ms, std::vector<RollupRow>* out) {
+        std::lock_guard<std::mutex> lock(latch_);
+        out->clear();
+
+        auto it = std::find(widths_.begin(), widths_.end(), bucket_width_ms);
+        if (it == widths_.end()) {
+            return false;
+        }
+        std::map<RollupKey, int64_t> rows;
+        if (!collectLocked(*tables_[it - widths_.begin()], first_bucket_ms, last_bucket_ms, &rows)) {
+            return false;
+        }
+        out->reserve(rows.size());
+        for (const auto& [key, count] : rows) {
+            out->push_back({ key.bucket_start_ms, key.resource_id, event_types_[key.event_code], count });
+        }
+        return true;
+    }
+
+    bool RollupStore::coverLocked(size_t levels, int64_t begin_ms, int64_t end_ms, const CountQuery& query,
+        std::optional<int64_t> event_code, CountResult* out, std::vector<std::pair<int64_t, int64_t>>* edges) {
+        if (begin_ms >= end_ms) {
+            return true;
+        }
+        if (levels == 0) {
+            edges->emplace_back(begin_ms, end_ms);
+            return true;
+        }
+
+        Table& table = *tables_[levels - 1];
+        int64_t width = table.width_ms;
+        int64_t first = bucketStart(begin_ms, width);
+        if (first < begin_ms) {
+            first += width;
+        }
+        int64_t last_end = bucketStart(end_ms, width); // Buckets [first, last_end) lie inside the window
+        if (first >= last_end) {
+            return coverLocked(levels - 1, begin_ms, end_ms, query, event_code, out, edges);
+        }
+
+        std::map<RollupKey, int64_t> rows;
+        if (!collectLocked(table, first, last_end - width, &rows)) {
+            return false;
+        }
+        out->rollup_rows_read += rows.size();
+        for (const auto& [key, count] : rows) {
+            if (query.resource_id && key.resource_id != *query.resource_id) {
+                continue;
+            }
+            if (event_code && key.event_code != *event_code) {
+                continue;
+            }
+            out->count += static_cast<uint64_t>(count);
+        }
+
+        return coverLocked(levels - 1, begin_ms, first, query, event_code, out, edges)
+            && coverLocked(levels - 1, last_end, end_ms, query, event_code, out, edges);
+    }
+
+    bool RollupStore::count(const CountQuery& query, storage::LogStore* raw, CountResult* out) {
+        *out = CountResult{};
+        std::vector<std::pair<int64_t, int64_t>> edges;
+        {
+            std::lock_guard<std::mutex> lock(latch_);
+            std::optional<int64_t> event_code;
+            if (query.event_type) {
+                auto it = codes_.find(*query.event_type);
+                event_code = it != codes_.end() ? it->second : -1; // Never ingested: no bucket matches
+            }
+            if (!coverLocked(tables_.size(), query.begin_ms, query.end_ms, query, event_code, out, &edges)) {
+                return false;
+            }
+        }
+        if (edges.empty()) {
+            return true;
+        }
+        if (raw == nullptr) {
+            return false;
+        }
+
+        // The rollup latch is released: the store latch may be held by an ingesting thread
+        // that is waiting in onIngest.
+        for (const auto& [begin_ms, end_ms] : edges) {
+            index::RoaringBitmap rids;
+            if (!raw->timeRange(begin_ms, end_ms - 1, &rids)) {
+                return false;
+            }
+            bool ok = raw->forEach(rids, [&](record_id_t, const LogRecord& record) {
+                ++out->raw_records_read;
+                if (query.resource_id && record.resource_id != *query.resource_id) {
+                    return;
+                }
+                if (query.event_type && index::BitmapIndex::eventTypeOf(record) != *query.event_type) {
+                    return;
+                }
+                ++out->count;
+            });
+            if (!ok) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<std::string> RollupStore::eventTypes() {
+        std::lock_guard<std::mutex> lock(latch_);
+        return event_types_;
+    }
+
+    size_t RollupStore::pendingRecords() {
+        std::lock_guard<std::mutex> lock(latch_);
+        return pending_records_;
+    }
+
+    uint64_t RollupStore::flushCount() {
+        std::lock_guard<std::mutex> lock(latch_);
+        return flushes_;
+    }
+
+} // namespace cmse::rollup
@@ -0,0 +1,124 @@
+#pragma once
+#include "../common/types.h"
+#include "../common/key_traits.h"
+#include "../adapter/bpm_adapter.h"
+#include "../adapter/btree_adapter.h"
+#include "../storage/log_store.h"
+#include "../versioning/version_manager.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cmse::rollup {
+
+    // One materialized rollup row: number of events of one type for one resource in one bucket.
+    struct RollupRow {
+        int64_t bucket_start_ms = 0;
+        int64_t resource_id = 0;
+        std::string event_type;
+        int64_t count = 0;
+    };
+
+    // "How many events in [begin_ms, end_ms)", optionally for one resource and/or event type.
+    struct CountQuery {
+        int64_t begin_ms = 0;   // Inclusive, epoch milliseconds
+        int64_t end_ms = 0;     // Exclusive
+        std::optional<int64_t> resource_id;
+        std::optional<std::string> event_type;
+    };
+
+    struct CountResult {
+        uint64_t count = 0;
+        uint64_t rollup_rows_read = 0;    // Bucket rows visited in the rollup tables
+        uint64_t raw_records_read = 0;    // LogStore records visited for the partial edges
+    };
+
+    /**
+     * RollupStore
+     * Time-bucketed event counts keyed by (bucket_start, resource_id, event_type), maintained
+     * on ingest. Each bucket width (e.g. minute and hour) is its own versioned B+Tree whose
+     * value is the count, so a query over a long window reads a few hundred bucket rows
+     * instead of every record in it.
+     *
+     * Maintenance: onIngest only bumps an in-memory delta; every 'flush_threshold' records
+     * (or on flush()) the deltas are folded into one new committed version per table, so the
+     * copy-on-write cost is paid once per batch rather than once per record. Queries merge
+     * the committed counts with the pending deltas and are always exact.
+     *
+     * count() covers the window with the coarsest buckets that fit entirely inside it, then
+     * finer buckets, and reads raw records (LogStore::timeRange) only for the unaligned edges.
+     *
+     * Event types are dictionary-encoded (first-seen order) to keep the key at 24 bytes; the
+     * dictionary, like the version table, lives in memory. The store must be registered as a
+     * listener before ingest starts, otherwise earlier records are missing from the buckets.
+     *
+     * Thread safety: all methods are internally synchronized.
+     */
+    class RollupStore : public storage::IngestListener {
+    public:
+        static constexpr int64_t MINUTE_MS = 60 * 1000;
+        static constexpr int64_t HOUR_MS = 60 * MINUTE_MS;
+        static constexpr size_t DEFAULT_FLUSH_THRESHOLD = 4096;
+
+        // Bucket widths are sorted and de-duplicated; non-positive widths are ignored.
+        explicit RollupStore(adapter::BufferPoolAdapter* bpm, std::vector<int64_t> bucket_widths_ms = { MINUTE_MS, HOUR_MS },
+            size_t flush_threshold = DEFAULT_FLUSH_THRESHOLD);
+
+        void onIngest(record_id_t rid, const LogRecord& record) override;
+
+        // Folds the pending deltas into the rollup trees. Returns false on buffer-pool failure;
+        // the deltas are kept (queries stay exact) and retried on the next flush.
+        bool flush();
+
+        // Rows of the 'bucket_width_ms' table whose bucket starts in [first_bucket_ms, last_bucket_ms],
+        // in key order. Returns false if there is no such table or on buffer-pool failure.
+        bool scanBuckets(int64_t bucket_width_ms, int64_t first_bucket_ms, int64_t last_bucket_ms, std::vector<RollupRow>* out);
+
+        // Answers 'query' from the buckets; 'raw' supplies the records of the edges not covered by
+        // a whole bucket and may be null only if the window is aligned to the finest width.
+        // Returns false on a storage failure or if the edges are needed but 'raw' is null.
+        bool count(const CountQuery& query, storage::LogStore* raw, CountResult* out);
+
+        const std::vector<int64_t>& bucketWidths() const { return widths_; }
+        std::vector<std::string> eventTypes();
+        size_t pendingRecords();
+        uint64_t flushCount();
+
+        // Start of the bucket of width 'width_ms' containing 'timestamp_ms' (floor, also for negatives).
+        static int64_t bucketStart(int64_t timestamp_ms, int64_t width_ms);
+
+    private:
+        struct Table {
+            int64_t width_ms;
+            adapter::RollupBTreeAdapter adapter;
+            versioning::RollupVersionManager tree;
+            std::map<RollupKey, int64_t> pending;   // Deltas not yet in 'tree'
+
+            Table(adapter::BufferPoolAdapter* bpm, int64_t width) : width_ms(width), tree(bpm, &adapter) {}
+        };
+
+        bool flushLocked();
+
+        // Committed counts merged with the pending deltas for buckets [first, last].
+        bool collectLocked(Table& table, int64_t first_bucket_ms, int64_t last_bucket_ms, std::map<RollupKey, int64_t>* out);
+
+        // Sums [begin, end) from tables [0, levels) (coarsest first); windows left over below the
+        // finest width are appended to 'edges'.
+        bool coverLocked(size_t levels, int64_t begin_ms, int64_t end_ms, const CountQuery& query,
+            std::optional<int64_t> event_code, CountResult* out, std::vector<std::pair<int64_t, int64_t>>* edges);
+
+        std::vector<int64_t> widths_;
+        std::vector<std::unique_ptr<Table>> tables_;    // Ascending width
+        std::unordered_map<std::string, int64_t> codes_;
+        std::vector<std::string> event_types_;          // Indexed by code
+        size_t flush_threshold_;
+        size_t pending_records_ = 0;
+        uint64_t flushes_ = 0;
+        std::mutex latch_;
+    };
+
+} // namespace cmse::rollup
@@ -0,0 +1,92 @@
+#include "sketch_store.h"
+#include "rollup_store.h"
+#include "../index/bitmap_index.h"
+#include <algorithm>
+
+namespace cmse::rollup {
+
+    SketchStore::SketchStore(SketchOptions options) : options_(options) {
+        options_.bucket_width_ms = std::max<int64_t>(options_.bucket_width_ms, 1);
+    }
+
+    // =================================================================
+    // Maintenance
+    // =================================================================
+
+    void SketchStore::onIngest(record_id_t /*rid*/, const LogRecord& record) {
+        int64_t bucket = RollupStore::bucketStart(storage::LogStore::timestampMillis(record), options_.bucket_width_ms);
+        std::string type = index::BitmapIndex::eventTypeOf(record);
+
+        std::lock_guard<std::mutex> lock(latch_);
+        auto& types = buckets_[bucket];
+        auto it = types.find(type);
+        if (it == types.end()) {
+            it = types.emplace(std::move(type), TypeSketch(options_)).first;
+        }
+        TypeSketch& sketch = it->second;
+        sketch.distinct.add(record.resource_id);
+        sketch.counts.add(record.resource_id);
+        sketch.top.add(record.resource_id);
+        sketch.events++;
+    }
+
+    // =================================================================
+    // Queries
+    // =================================================================
+
+    bool SketchStore::summarize(int64_t begin_ms, int64_t end_ms, const std::optional<std::string>& event_type, WindowSketch* out) {
+        *out = WindowSketch(options_);
+        if (end_ms <= begin_ms) {
+            return false;
+        }
+        out->begin_ms = RollupStore::bucketStart(begin_ms, options_.bucket_width_ms);
+        out->end_ms = RollupStore::bucketStart(end_ms - 1, options_.bucket_width_ms) + options_.bucket_width_ms;
+
+        std::lock_guard<std::mutex> lock(latch_);
+        for (auto it = buckets_.lower_bound(out->begin_ms); it != buckets_.end() && it->first < out->end_ms; ++it) {
+            for (const auto& [type, sketch] : it->second) {
+                if (event_type && type != *event_type) {
+                    continue;
+                }
+                out->distinct.merge(sketch.distinct);
+                out->counts.merge(sketch.counts);
+                out->top.merge(sketch.top);
+                out->events += sketch.events;
+                out->sketches_merged++;
+            }
+        }
+        return true;
+    }
+
+    double SketchStore::distinctResources(int64_t begin_ms, int64_t end_ms, const std::optional<std::string>& event_type) {
+        WindowSketch window(options_);
+        return summarize(begin_ms, end_ms, event_type, &window) ? window.distinct.estimate() : 0.0;
+    }
+
+    std::vector<HeavyHitter> SketchStore::topResources(int64_t begin_ms, int64_t end_ms, size_t k, const std::optional<std::string>& event_type) {
+        WindowSketch window(options_);
+        return summarize(begin_ms, end_ms, event_type, &window) ? window.top.top(k) : std::vector<HeavyHitter>();
+    }
+
+    uint64_t SketchStore::resourceEvents(int64_t begin_ms, int64_t end_ms, int64_t resource_id, const std::optional<std::string>& event_type) {
+        WindowSketch window(options_);
+        return summarize(begin_ms, end_ms, event_type, &window) ? window.counts.estimate(resource_id) : 0;
+    }
+
+    size_t SketchStore::bucketCount() {
+        std::lock_guard<std::mutex> lock(latch_);
+        return buckets_.size();
+    }
+
+    size_t SketchStore::sizeInBytes() {
+        std::lock_guard<std::mutex> lock(latch_);
+        size_t bytes = 0;
+        for (const auto& [bucket, types] : buckets_) {
+            for (const auto& [type, sketch] : types) {
+                bytes += sketch.distinct.sizeInBytes() + sketch.counts.sizeInBytes() + sketch.top.sizeInBytes();
+            }
+        }
+        return bytes;
+    }
+
+} // namespace cmse::rollup
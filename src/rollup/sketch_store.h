@@ -0,0 +1,85 @@
+#pragma once
+#include "../common/types.h"
+#include "../storage/log_store.h"
+#include "sketches.h"
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace cmse::rollup {
+
+    // Shape of the sketches kept per bucket and event type.
+    struct SketchOptions {
+        int64_t bucket_width_ms = 60 * 60 * 1000;
+        int hll_precision = HyperLogLog::DEFAULT_PRECISION;
+        size_t count_min_width = CountMinSketch::DEFAULT_WIDTH;
+        size_t count_min_depth = CountMinSketch::DEFAULT_DEPTH;
+        size_t top_capacity = SpaceSaving::DEFAULT_CAPACITY;
+    };
+
+    // Sketches of resource_id over one window, merged from its buckets.
+    struct WindowSketch {
+        HyperLogLog distinct;       // Distinct resources
+        CountMinSketch counts;      // Events per resource
+        SpaceSaving top;            // Noisiest resources
+        uint64_t events = 0;
+        int64_t begin_ms = 0;       // Window actually covered: whole buckets, [begin_ms, end_ms)
+        int64_t end_ms = 0;
+        size_t sketches_merged = 0;
+
+        explicit WindowSketch(const SketchOptions& options = SketchOptions())
+            : distinct(options.hll_precision), counts(options.count_min_width, options.count_min_depth), top(options.top_capacity) {}
+    };
+
+    /**
+     * SketchStore
+     * Approximate per-window statistics of resource_id, maintained on ingest: one HyperLogLog
+     * (distinct resources), Count-Min (events per resource) and SpaceSaving (heavy hitters) per
+     * (time bucket, event type). All three merge, so a window is answered by merging the
+     * sketches of its buckets: "distinct resources with ERROR today" merges 24 hourly sketches
+     * instead of scanning the day's records. Errors are bounded by the sketch sizes (see the
+     * sketch classes); a default bucket/type costs ~10 KB.
+     *
+     * Windows are rounded outward to whole buckets; WindowSketch reports the range covered.
+     * Unlike RollupStore the sketches live in memory only (rebuild by replaying the log store).
+     *
+     * Thread safety: all methods are internally synchronized.
+     */
+    class SketchStore : public storage::IngestListener {
+    public:
+        explicit SketchStore(SketchOptions options = SketchOptions());
+
+        void onIngest(record_id_t rid, const LogRecord& record) override;
+
+        // Merges the sketches of every bucket overlapping [begin_ms, end_ms) for 'event_type'
+        // (every type if unset). Returns false if the window is empty.
+        bool summarize(int64_t begin_ms, int64_t end_ms, const std::optional<std::string>& event_type, WindowSketch* out);
+
+        // Shorthands over summarize(); 0 / empty for an empty window.
+        double distinctResources(int64_t begin_ms, int64_t end_ms, const std::optional<std::string>& event_type = std::nullopt);
+        std::vector<HeavyHitter> topResources(int64_t begin_ms, int64_t end_ms, size_t k, const std::optional<std::string>& event_type = std::nullopt);
+        uint64_t resourceEvents(int64_t begin_ms, int64_t end_ms, int64_t resource_id, const std::optional<std::string>& event_type = std::nullopt);
+
+        const SketchOptions& options() const { return options_; }
+        size_t bucketCount();
+        size_t sizeInBytes();
+
+    private:
+        struct TypeSketch {
+            HyperLogLog distinct;
+            CountMinSketch counts;
+            SpaceSaving top;
+            uint64_t events = 0;
+
+            explicit TypeSketch(const SketchOptions& options)
+                : distinct(options.hll_precision), counts(options.count_min_width, options.count_min_depth), top(options.top_capacity) {}
+        };
+
+        SketchOptions options_;
+        std::map<int64_t, std::map<std::string, TypeSketch>> buckets_;  // Bucket start -> event type -> sketches
+        std::mutex latch_;
+    };
+
+} // namespace cmse::rollup
@@ -0,0 +1,219 @@
+#include "sketches.h"
+#include "../common/hash.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace cmse::rollup {
+
+    namespace {
+        inline uint64_t Hash(int64_t value) {
+            return Mix64(static_cast<uint64_t>(value));
+        }
+
+        // Leading zero bits of a non-zero word.
+        inline int LeadingZeros(uint64_t word) {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanReverse64(&index, word);
+            return 63 - static_cast<int>(index);
+#else
+            return __builtin_clzll(word);
+#endif
+        }
+    }
+
+    // =================================================================
+    // HyperLogLog
+    // =================================================================
+
+    HyperLogLog::HyperLogLog(int precision)
+        : precision_(std::clamp(precision, MIN_PRECISION, MAX_PRECISION)), registers_(size_t{ 1 } << precision_, 0) {
+    }
+
+    void HyperLogLog::add(int64_t value) {
+        uint64_t h = Hash(value);
+        size_t index = static_cast<size_t>(h >> (64 - precision_));
+        // Rank of the first set bit in the remaining 64 - precision bits (a sentinel bit caps it).
+        uint64_t rest = (h << precision_) | (uint64_t{ 1 } << (precision_ - 1));
+        uint8_t rank = static_cast<uint8_t>(LeadingZeros(rest) + 1);
+        registers_[index] = std::max(registers_[index], rank);
+    }
+
+    bool HyperLogLog::merge(const HyperLogLog& other) {
+        if (other.precision_ != precision_) {
+            return false;
+        }
+        // Branch-free byte max over raw pointers so the loop vectorizes.
+        uint8_t* own = registers_.data();
+        const uint8_t* theirs = other.registers_.data();
+        for (size_t i = 0, n = registers_.size(); i < n; ++i) {
+            own[i] = own[i] < theirs[i] ? theirs[i] : own[i];
+        }
+        return true;
+    }
+
+    double HyperLogLog::estimate() const {
+        // Histogram of the register values first: 65 powers of two instead of one per register.
+        uint32_t histogram[65] = {};
+        for (uint8_t r : registers_) {
+            histogram[r]++;
+        }
+        double m = static_cast<double>(registers_.size());
+        double sum = 0;
+        for (int r = 0; r <= 64; ++r) {
+            sum += histogram[r] * std::ldexp(1.0, -r);
+        }
+        size_t zeros = histogram[0];
+        double alpha = precision_ == 4 ? 0.673 : precision_ == 5 ? 0.697 : precision_ == 6 ? 0.709 : 0.7213 / (1.0 + 1.079 / m);
+        double raw = alpha * m * m / sum;
+        // Linear counting while many registers are empty (64-bit hashes need no large-range fix).
+        if (raw <= 2.5 * m && zeros > 0) {
+            return m * std::log(m / static_cast<double>(zeros));
+        }
+        return raw;
+    }
+
+    double HyperLogLog::relativeError() const {
+        return 1.04 / std::sqrt(static_cast<double>(registers_.size()));
+    }
+
+    // =================================================================
+    // CountMinSketch
+    // =================================================================
+
+    CountMinSketch::CountMinSketch(size_t width, size_t depth)
+        : width_(std::max<size_t>(width, 1)), depth_(std::max<size_t>(depth, 1)), counters_(width_ * depth_, 0) {
+    }
+
+    void CountMinSketch::add(int64_t key, uint32_t count) {
+        // Row hashes h1 + i * h2 (Kirsch-Mitzenmacher) from one 64-bit hash.
+        uint64_t h = Hash(key);
+        uint64_t h1 = h & 0xFFFFFFFFu;
+        uint64_t h2 = (h >> 32) | 1;
+        for (size_t row = 0; row < depth_; ++row) {
+            counters_[row * width_ + (h1 + row * h2) % width_] += count;
+        }
+        total_ += count;
+    }
+
+    bool CountMinSketch::merge(const CountMinSketch& other) {
+        if (other.width_ != width_ || other.depth_ != depth_) {
+            return false;
+        }
+        for (size_t i = 0; i < counters_.size(); ++i) {
+            counters_[i] += other.counters_[i];
+        }
+        total_ += other.total_;
+        return true;
+    }
+
+    uint64_t CountMinSketch::estimate(int64_t key) const {
+        uint64_t h = Hash(key);
+        uint64_t h1 = h & 0xFFFFFFFFu;
+        uint64_t h2 = (h >> 32) | 1;
+        uint64_t result = UINT64_MAX;
+        for (size_t row = 0; row < depth_; ++row) {
+            result = std::min<uint64_t>(result, counters_[row * width_ + (h1 + row * h2) % width_]);
+        }
+        return result;
+    }
+
+    uint64_t CountMinSketch::errorBound() const {
+        return static_cast<uint64_t>(std::ceil(std::exp(1.0) / static_cast<double>(width_) * static_cast<double>(total_)));
+    }
+
+    // =================================================================
+    // SpaceSaving
+    // =================================================================
+
+    SpaceSaving::SpaceSaving(size_t capacity) : capacity_(std::max<size_t>(capacity, 1)) {
+        entries_.reserve(capacity_);
+    }
+
+    uint64_t SpaceSaving::minCount() const {
+        if (entries_.size() < capacity_) {
+            return 0;
+        }
+        uint64_t result = UINT64_MAX;
+        for (const HeavyHitter& entry : entries_) {
+            result = std::min(result, entry.count);
+        }
+        return result;
+    }
+
+    void SpaceSaving::add(int64_t key, uint64_t count) {
+        total_ += count;
+        // One pass finds the key or, failing that, the smallest counter.
+        size_t victim = 0;
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            if (entries_[i].key == key) {
+                entries_[i].count += count;
+                return;
+            }
+            if (entries_[i].count < entries_[victim].count) {
+                victim = i;
+            }
+        }
+        if (entries_.size() < capacity_) {
+            entries_.push_back({ key, count, 0 });
+            return;
+        }
+        // Replace the smallest counter; the newcomer inherits its count as error.
+        HeavyHitter& entry = entries_[victim];
+        entry = { key, entry.count + count, entry.count };
+    }
+
+    void SpaceSaving::merge(const SpaceSaving& other) {
+        uint64_t own_min = minCount();
+        uint64_t other_min = other.minCount();
+
+        // Charge every key the other side's minimum, then combine keys tracked on both sides:
+        // their sum replaces both charges.
+        std::vector<HeavyHitter> combined;
+        combined.reserve(entries_.size() + other.entries_.size());
+        for (const HeavyHitter& entry : entries_) {
+            combined.push_back({ entry.key, entry.count + other_min, entry.error + other_min });
+        }
+        for (const HeavyHitter& entry : other.entries_) {
+            combined.push_back({ entry.key, entry.count + own_min, entry.error + own_min });
+        }
+        std::sort(combined.begin(), combined.end(), [](const HeavyHitter& a, const HeavyHitter& b) { return a.key < b.key; });
+
+        entries_.clear();
+        for (size_t i = 0; i < combined.size(); ++i) {
+            if (i + 1 < combined.size() && combined[i + 1].key == combined[i].key) {
+                const HeavyHitter& a = combined[i];
+                const HeavyHitter& b = combined[i + 1];
+                entries_.push_back({ a.key, a.count + b.count - own_min - other_min, a.error + b.error - own_min - other_min });
+                ++i;
+            }
+            else {
+                entries_.push_back(combined[i]);
+            }
+        }
+        if (entries_.size() > capacity_) {
+            std::nth_element(entries_.begin(), entries_.begin() + capacity_, entries_.end(), [](const HeavyHitter& a, const HeavyHitter& b) {
+                return a.count != b.count ? a.count > b.count : a.key < b.key;
+            });
+            entries_.resize(capacity_);
+        }
+        total_ += other.total_;
+    }
+
+    std::vector<HeavyHitter> SpaceSaving::top(size_t k) const {
+        std::vector<HeavyHitter> result = entries_;
+        auto larger = [](const HeavyHitter& a, const HeavyHitter& b) {
+            return a.count != b.count ? a.count > b.count : a.key < b.key;
+        };
+        std::sort(result.begin(), result.end(), larger);
+        if (result.size() > k) {
+            result.resize(k);
+        }
+        return result;
+    }
+
+} // namespace cmse::rollup
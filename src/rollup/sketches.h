@@ -0,0 +1,118 @@
+#pragma once
+#include "../common/types.h"
+#include <vector>
+
+namespace cmse::rollup {
+
+    /**
+     * HyperLogLog
+     * Distinct-count estimate in 2^precision one-byte registers (4 KB at the default precision
+     * of 12, standard error 1.04 / sqrt(2^precision) = 1.6%). Small cardinalities use linear
+     * counting, which is nearly exact. Two sketches of the same precision merge by taking the
+     * register-wise maximum, so per-bucket sketches combine into any window losslessly.
+     */
+    class HyperLogLog {
+    public:
+        static constexpr int DEFAULT_PRECISION = 12;
+        static constexpr int MIN_PRECISION = 4;
+        static constexpr int MAX_PRECISION = 16;
+
+        // 'precision' is clamped to [MIN_PRECISION, MAX_PRECISION].
+        explicit HyperLogLog(int precision = DEFAULT_PRECISION);
+
+        void add(int64_t value);
+
+        // Returns false (and leaves this sketch unchanged) if the precisions differ.
+        bool merge(const HyperLogLog& other);
+
+        double estimate() const;
+
+        // Standard error of estimate() relative to the true count.
+        double relativeError() const;
+
+        int precision() const { return precision_; }
+        size_t sizeInBytes() const { return registers_.size(); }
+
+    private:
+        int precision_;
+        std::vector<uint8_t> registers_;
+    };
+
+    /**
+     * CountMinSketch
+     * Frequency estimate of any key in depth x width counters. estimate() never undercounts and,
+     * with probability 1 - e^-depth, overcounts by at most errorBound() = e / width * total().
+     * Sketches of the same shape merge by adding their counters.
+     */
+    class CountMinSketch {
+    public:
+        static constexpr size_t DEFAULT_WIDTH = 256;
+        static constexpr size_t DEFAULT_DEPTH = 4;
+
+        explicit CountMinSketch(size_t width = DEFAULT_WIDTH, size_t depth = DEFAULT_DEPTH);
+
+        void add(int64_t key, uint32_t count = 1);
+
+        // Returns false (and leaves this sketch unchanged) if the shapes differ.
+        bool merge(const CountMinSketch& other);
+
+        uint64_t estimate(int64_t key) const;
+        uint64_t errorBound() const;
+        uint64_t total() const { return total_; }
+
+        size_t width() const { return width_; }
+        size_t depth() const { return depth_; }
+        size_t sizeInBytes() const { return counters_.size() * sizeof(uint32_t); }
+
+    private:
+        size_t width_;
+        size_t depth_;
+        uint64_t total_ = 0;
+        std::vector<uint32_t> counters_;   // Row-major, depth_ rows of width_
+    };
+
+    // One entry of a SpaceSaving summary: the true count lies in [count - error, count].
+    struct HeavyHitter {
+        int64_t key = 0;
+        uint64_t count = 0;
+        uint64_t error = 0;
+    };
+
+    /**
+     * SpaceSaving
+     * Top-k summary in 'capacity' counters (Metwally et al.). An untracked key takes over the
+     * smallest counter and inherits its count as error, so every count is an upper bound and
+     * any key occurring more than total / capacity times is tracked. Merging follows Agarwal et
+     * al. ("Mergeable Summaries"): counts are added, a key missing from a full summary is charged
+     * that summary's minimum, and the largest 'capacity' counters are kept.
+     *
+     * The counters are a plain array searched linearly: at the default capacity one pass over
+     * 64 keys costs about as much as a hash probe, and merges need no hashing at all.
+     */
+    class SpaceSaving {
+    public:
+        static constexpr size_t DEFAULT_CAPACITY = 64;
+
+        explicit SpaceSaving(size_t capacity = DEFAULT_CAPACITY);
+
+        void add(int64_t key, uint64_t count = 1);
+        void merge(const SpaceSaving& other);
+
+        // Up to 'k' entries with the largest counts, in descending count order (ties by key).
+        std::vector<HeavyHitter> top(size_t k) const;
+
+        uint64_t total() const { return total_; }
+        size_t capacity() const { return capacity_; }
+        size_t size() const { return entries_.size(); }
+        size_t sizeInBytes() const { return entries_.size() * sizeof(HeavyHitter); }
+
+    private:
+        // Smallest count among the tracked keys (0 while not full).
+        uint64_t minCount() const;
+
+        size_t capacity_;
+        uint64_t total_ = 0;
+        std::vector<HeavyHitter> entries_;
+    };
+
+} // namespace cmse::rollup
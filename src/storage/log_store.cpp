@@ -0,0 +1,141 @@
+#include "log_store.h"
+#include <algorithm>
+#include <cstring>
+
+namespace cmse::storage {
+
+    static_assert(LogStore::RECORDS_PER_PAGE > 0, "LogRecord does not fit in a page");
+
+    LogStore::LogStore(adapter::BufferPoolAdapter* bpm) : bpm_(bpm) {}
+
+    void LogStore::addListener(IngestListener* listener) {
+        std::lock_guard<std::mutex> lock(latch_);
+        listeners_.push_back(listener);
+    }
+
+    int64_t LogStore::timestampMillis(const LogRecord& record) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(record.timestamp.time_since_epoch()).count();
+    }
+
+    // =================================================================
+    // Ingest
+    // =================================================================
+
+    record_id_t LogStore::append(const LogRecord& record) {
+        std::lock_guard<std::mutex> lock(latch_);
+        if (size_ >= INVALID_RECORD_ID) {
+            return INVALID_RECORD_ID;
+        }
+
+        Page* page = nullptr;
+        if (pages_.empty() || pages_.back().count == RECORDS_PER_PAGE) {
+            PageInfo info;
+            page = bpm_->NewPage(info.page_id);
+            if (page == nullptr) {
+                return INVALID_RECORD_ID;
+            }
+            pages_.push_back(info);
+        }
+        else {
+            page = bpm_->FetchPage(pages_.back().page_id);
+            if (page == nullptr) {
+                return INVALID_RECORD_ID;
+            }
+        }
+
+        PageInfo& info = pages_.back();
+        std::memcpy(page->GetData() + info.count * sizeof(LogRecord), &record, sizeof(LogRecord));
+
+        int64_t ts = timestampMillis(record);
+        info.min_ts = info.count == 0 ? ts : std::min(info.min_ts, ts);
+        info.max_ts = info.count == 0 ? ts : std::max(info.max_ts, ts);
+        info.count++;
+        page->GetHeader()->key_count = info.count;
+        bpm_->UnpinPage(info.page_id, true);
+
+        record_id_t rid = static_cast<record_id_t>(size_++);
+        for (IngestListener* listener : listeners_) {
+            listener->onIngest(rid, record);
+        }
+        return rid;
+    }
+
+    // =================================================================
+    // Reads
+    // =================================================================
+
+    bool LogStore::get(record_id_t rid, LogRecord* out) {
+        std::lock_guard<std::mutex> lock(latch_);
+        if (rid >= size_) {
+            return false;
+        }
+        const PageInfo& info = pages_[rid / RECORDS_PER_PAGE];
+        Page* page = bpm_->FetchPage(info.page_id);
+        if (page == nullptr) {
+            return false;
+        }
+        std::memcpy(out, page->GetData() + (rid % RECORDS_PER_PAGE) * sizeof(LogRecord), sizeof(LogRecord));
+        bpm_->UnpinPage(info.page_id, false);
+        return true;
+    }
+
+    bool LogStore::readPage(size_t page_index, std::vector<LogRecord>* out) {
+        std::lock_guard<std::mutex> lock(latch_);
+        if (page_index >= pages_.size()) {
+            return false;
+        }
+        const PageInfo& info = pages_[page_index];
+        Page* page = bpm_->FetchPage(info.page_id);
+        if (page == nullptr) {
+            return false;
+        }
+        const LogRecord* records = reinterpret_cast<const LogRecord*>(page->GetData());
+        out->assign(records, records + info.count);
+        bpm_->UnpinPage(info.page_id, false);
+        return true;
+    }
+
+    bool LogStore::timeRange(int64_t begin_ms, int64_t end_ms, index::RoaringBitmap* out) {
+        std::lock_guard<std::mutex> lock(latch_);
+        out->clear();
+
+        for (size_t p = 0; p < pages_.size(); ++p) {
+            const PageInfo& info = pages_[p];
+            if (info.count == 0 || info.max_ts < begin_ms || info.min_ts > end_ms) {
+                continue;
+            }
+            uint32_t first = static_cast<uint32_t>(p * RECORDS_PER_PAGE);
+
+            // Fully covered by the window: no need to read the page.
+            if (begin_ms <= info.min_ts && info.max_ts <= end_ms) {
+                out->addRange(first, first + info.count - 1);
+                continue;
+            }
+
+            Page* page = bpm_->FetchPage(info.page_id);
+            if (page == nullptr) {
+                return false;
+            }
+            const LogRecord* records = reinterpret_cast<const LogRecord*>(page->GetData());
+            for (uint32_t slot = 0; slot < info.count; ++slot) {
+                int64_t ts = timestampMillis(records[slot]);
+                if (begin_ms <= ts && ts <= end_ms) {
+                    out->add(first + slot);
+                }
+            }
+            bpm_->UnpinPage(info.page_id, false);
+        }
+        return true;
+    }
+
+    uint64_t LogStore::size() {
+        std::lock_guard<std::mutex> lock(latch_);
+        return size_;
+    }
+
+    size_t LogStore::pageCount() {
+        std::lock_guard<std::mutex> lock(latch_);
+        return pages_.size();
+    }
+
+} // namespace cmse::storage
@@ -0,0 +1,127 @@
+#pragma once
+#include "../common/types.h"
+#include "../adapter/bpm_adapter.h"
+#include "../index/roaring_bitmap.h"
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace cmse::storage {
+
+    /**
+     * IngestListener
+     * Receives every record appended to a LogStore, in record-id order.
+     * Used by secondary structures (indexes, rollups) that are maintained incrementally.
+     * Called with the store latch held: implementations must be quick and must not call back
+     * into the store.
+     */
+    class IngestListener {
+    public:
+        virtual ~IngestListener() = default;
+        virtual void onIngest(record_id_t rid, const LogRecord& record) = 0;
+    };
+
+    /**
+     * LogStore
+     * Append-only heap of LogRecords packed into buffer-pool pages.
+     * Record ids are sequence numbers, so rid -> (page, slot) is arithmetic and a set of rids
+     * (e.g. a RoaringBitmap) fetches each page at most once when visited in order.
+     *
+     * Each page keeps a min/max timestamp (zone map) in memory so time-range lookups only read
+     * pages that partially overlap the window. The page directory itself is not persisted.
+     *
+     * Thread safety: all methods are internally synchronized.
+     */
+    class LogStore {
+    public:
+        static constexpr size_t RECORDS_PER_PAGE = (PAGE_SIZE - sizeof(PageHeader)) / sizeof(LogRecord);
+
+        explicit LogStore(adapter::BufferPoolAdapter* bpm);
+
+        // Listeners are not owned and must outlive the store (or be registered before ingest).
+        void addListener(IngestListener* listener);
+
+        // Appends a record and notifies listeners.
+        // Returns its id, or INVALID_RECORD_ID if no page could be allocated.
+        record_id_t append(const LogRecord& record);
+
+        // Copies record 'rid' into 'out'. Returns false if it does not exist.
+        bool get(record_id_t rid, LogRecord* out);
+
+        // Calls fn(rid, record) for every rid in 'rids', in ascending order; each page is fetched
+        // once. If fn returns bool, returning false stops early.
+        // Returns false if a page could not be fetched.
+        template <typename Fn>
+        bool forEach(const index::RoaringBitmap& rids, Fn&& fn);
+
+        // Copies all records of page 'page_index' (ids page_index * RECORDS_PER_PAGE onwards).
+        bool readPage(size_t page_index, std::vector<LogRecord>* out);
+
+        // Ids of the records with timestamp in [begin_ms, end_ms] (inclusive, epoch milliseconds).
+        bool timeRange(int64_t begin_ms, int64_t end_ms, index::RoaringBitmap* out);
+
+        uint64_t size();
+        size_t pageCount();
+
+        // Epoch milliseconds of a record timestamp (the granularity of the zone maps).
+        static int64_t timestampMillis(const LogRecord& record);
+
+    private:
+        struct PageInfo {
+            page_id_t page_id = INVALID_PAGE_ID;
+            uint32_t count = 0;
+            int64_t min_ts = 0;
+            int64_t max_ts = 0;
+        };
+
+        adapter::BufferPoolAdapter* bpm_;
+        std::vector<IngestListener*> listeners_;
+        std::vector<PageInfo> pages_;
+        uint64_t size_ = 0;
+        std::mutex latch_;
+    };
+
+    // =================================================================
+    // Template Definitions
+    // =================================================================
+
+    template <typename Fn>
+    bool LogStore::forEach(const index::RoaringBitmap& rids, Fn&& fn) {
+        std::lock_guard<std::mutex> lock(latch_);
+        Page* page = nullptr;
+        size_t page_index = 0;
+        bool ok = true;
+
+        rids.forEach([&](uint32_t rid) {
+            if (rid >= size_) {
+                return false; // Ascending: every later id is out of range too
+            }
+            size_t index = rid / RECORDS_PER_PAGE;
+            if (page == nullptr || index != page_index) {
+                if (page != nullptr) {
+                    bpm_->UnpinPage(pages_[page_index].page_id, false);
+                }
+                page_index = index;
+                page = bpm_->FetchPage(pages_[page_index].page_id);
+                if (page == nullptr) {
+                    ok = false;
+                    return false;
+                }
+            }
+            const LogRecord* records = reinterpret_cast<const LogRecord*>(page->GetData());
+            if constexpr (std::is_same_v<std::invoke_result_t<Fn&, record_id_t, const LogRecord&>, bool>) {
+                return fn(static_cast<record_id_t>(rid), records[rid % RECORDS_PER_PAGE]);
+            }
+            else {
+                fn(static_cast<record_id_t>(rid), records[rid % RECORDS_PER_PAGE]);
+                return true;
+            }
+        });
+
+        if (page != nullptr) {
+            bpm_->UnpinPage(pages_[page_index].page_id, false);
+        }
+        return ok;
+    }
+
+} // namespace cmse::storage
@@ -0,0 +1,202 @@
+#include "../adapter/trie_adapter.h"
+#include <algorithm>
+
+namespace cmse::adapter {
+
+    namespace {
+        // Entries are ordered by unsigned byte value, so the order does not depend on char signedness.
+        bool charLess(char a, char b) {
+            return static_cast<unsigned char>(a) < static_cast<unsigned char>(b);
+        }
+
+        TrieNodeEntry* findEntry(TrieNodeEntry* begin, TrieNodeEntry* end, char c) {
+            return std::lower_bound(begin, end, c, [](const TrieNodeEntry& entry, char value) {
+                return charLess(entry.key_char, value);
+            });
+        }
+    }
+
+    // =================================================================
+    // Initialization
+    // =================================================================
+
+    template <size_t PageSize>
+    void BasicTrieAdapter<PageSize>::initNode(Page* page) {
+        TrieNodeHeader* header = getHeader(page);
+        header->is_terminal = false;
+        header->child_count = 0;
+        header->value = 0;
+        header->subtree_terminals = 0;
+        header->postings_page_id = INVALID_PAGE_ID;
+
+        page->GetHeader()->is_leaf = 1;
+        page->GetHeader()->key_count = 0;
+    }
+
+    // =================================================================
+    // Read Operations
+    // =================================================================
+
+    template <size_t PageSize>
+    page_id_t BasicTrieAdapter<PageSize>::findChild(Page* page, char c) {
+        TrieNodeEntry* begin = getEntries(page);
+        TrieNodeEntry* end = begin + getHeader(page)->child_count;
+        TrieNodeEntry* it = findEntry(begin, end, c);
+        return (it != end && it->key_char == c) ? it->child_page_id : INVALID_PAGE_ID;
+    }
+
+    template <size_t PageSize>
+    int BasicTrieAdapter<PageSize>::getChildCount(Page* page) {
+        return getHeader(page)->child_count;
+    }
+
+    template <size_t PageSize>
+    TrieNodeEntry BasicTrieAdapter<PageSize>::getChildAt(Page* page, int index) {
+        return getEntries(page)[index];
+    }
+
+    template <size_t PageSize>
+    bool BasicTrieAdapter<PageSize>::isTerminal(Page* page) {
+        return getHeader(page)->is_terminal;
+    }
+
+    template <size_t PageSize>
+    ValueType BasicTrieAdapter<PageSize>::getValue(Page* page) {
+        return getHeader(page)->value;
+    }
+
+    template <size_t PageSize>
+    int32_t BasicTrieAdapter<PageSize>::getSubtreeCount(Page* page) {
+        return getHeader(page)->subtree_terminals;
+    }
+
+    // =================================================================
+    // Modification
+    // =================================================================
+
+    template <size_t PageSize>
+    void BasicTrieAdapter<PageSize>::setTerminal(Page* page, bool terminal, ValueType val) {
+        TrieNodeHeader* header = getHeader(page);
+        header->is_terminal = terminal;
+        header->value = terminal ? val : 0;
+    }
+
+    template <size_t PageSize>
+    bool BasicTrieAdapter<PageSize>::insertChild(Page* page, char c, page_id_t child_page_id) {
+        TrieNodeHeader* header = getHeader(page);
+        TrieNodeEntry* begin = getEntries(page);
+        TrieNodeEntry* end = begin + header->child_count;
+        TrieNodeEntry* it = findEntry(begin, end, c);
+
+        if (it != end && it->key_char == c) {
+            it->child_page_id = child_page_id;
+            return true;
+        }
+        if (header->child_count >= MAX_TRIE_CHILDREN) {
+            return false;
+        }
+
+        std::memmove(it + 1, it, sizeof(TrieNodeEntry) * (end - it));
+        it->key_char = c;
+        it->child_page_id = child_page_id;
+        header->child_count++;
+        page->GetHeader()->key_count = static_cast<uint32_t>(header->child_count);
+        return true;
+    }
+
+    template <size_t PageSize>
+    void BasicTrieAdapter<PageSize>::updateChildPointer(Page* page, char c, page_id_t new_child_id) {
+        TrieNodeEntry* begin = getEntries(page);
+        TrieNodeEntry* end = begin + getHeader(page)->child_count;
+        TrieNodeEntry* it = findEntry(begin, end, c);
+        if (it != end && it->key_char == c) {
+            it->child_page_id = new_child_id;
+        }
+    }
+
+    template <size_t PageSize>
+    void BasicTrieAdapter<PageSize>::removeChild(Page* page, char c) {
+        TrieNodeHeader* header = getHeader(page);
+        TrieNodeEntry* begin = getEntries(page);
+        TrieNodeEntry* end = begin + header->child_count;
+        TrieNodeEntry* it = findEntry(begin, end, c);
+        if (it == end || it->key_char != c) {
+            return;
+        }
+        std::memmove(it, it + 1, sizeof(TrieNodeEntry) * (end - it - 1));
+        header->child_count--;
+        page->GetHeader()->key_count = static_cast<uint32_t>(header->child_count);
+    }
+
+    template <size_t PageSize>
+    void BasicTrieAdapter<PageSize>::adjustSubtreeCount(Page* page, int delta) {
+        getHeader(page)->subtree_terminals += delta;
+    }
+
+    // =================================================================
+    // Posting Pages
+    // =================================================================
+
+    template <size_t PageSize>
+    page_id_t BasicTrieAdapter<PageSize>::getPostingsPage(Page* node) {
+        return getHeader(node)->postings_page_id;
+    }
+
+    template <size_t PageSize>
+    void BasicTrieAdapter<PageSize>::setPostingsPage(Page* node, page_id_t postings_page_id) {
+        getHeader(node)->postings_page_id = postings_page_id;
+    }
+
+    template <size_t PageSize>
+    void BasicTrieAdapter<PageSize>::initPostings(Page* page) {
+        TriePostingHeader* header = getPostingHeader(page);
+        header->next_page_id = INVALID_PAGE_ID;
+        header->count = 0;
+
+        page->GetHeader()->is_leaf = 1;
+        page->GetHeader()->key_count = 0;
+    }
+
+    template <size_t PageSize>
+    int BasicTrieAdapter<PageSize>::getPostingCount(Page* page) {
+        return getPostingHeader(page)->count;
+    }
+
+    template <size_t PageSize>
+    ValueType BasicTrieAdapter<PageSize>::getPostingAt(Page* page, int index) {
+        return getPostings(page)[index];
+    }
+
+    template <size_t PageSize>
+    page_id_t BasicTrieAdapter<PageSize>::getNextPostings(Page* page) {
+        return getPostingHeader(page)->next_page_id;
+    }
+
+    template <size_t PageSize>
+    void BasicTrieAdapter<PageSize>::setNextPostings(Page* page, page_id_t next_page_id) {
+        getPostingHeader(page)->next_page_id = next_page_id;
+    }
+
+    template <size_t PageSize>
+    bool BasicTrieAdapter<PageSize>::appendPosting(Page* page, ValueType value) {
+        TriePostingHeader* header = getPostingHeader(page);
+        if (header->count >= MAX_POSTINGS) {
+            return false;
+        }
+        getPostings(page)[header->count++] = value;
+        page->GetHeader()->key_count = static_cast<uint32_t>(header->count);
+        return true;
+    }
+
+    // =================================================================
+    // Instantiations
+    // =================================================================
+
+    static_assert(sizeof(TrieNodeHeader) + sizeof(TrieNodeEntry) * MAX_TRIE_CHILDREN <= PAGE_SIZE - sizeof(PageHeader),
+        "Trie node does not fit in a page");
+
+#define CMSE_INSTANTIATE_TRIE_ADAPTER(size) template class BasicTrieAdapter<size>;
+    CMSE_FOR_EACH_PAGE_SIZE(CMSE_INSTANTIATE_TRIE_ADAPTER)
+#undef CMSE_INSTANTIATE_TRIE_ADAPTER
+
+} // namespace cmse::adapter
@@ -0,0 +1,37 @@
+#include "atomic_file.h"
+#include <filesystem>
+#include <fstream>
+
+namespace cmse::utils {
+
+    bool writeFileAtomically(const std::string& path, const std::string& content, std::string* error) {
+        std::string tmp_path = path + ".tmp";
+        {
+            std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) {
+                if (error != nullptr) {
+                    *error = "could not open " + tmp_path + " for writing";
+                }
+                return false;
+            }
+            out.write(content.data(), static_cast<std::streamsize>(content.size()));
+            if (!out) {
+                if (error != nullptr) {
+                    *error = "could not write " + tmp_path;
+                }
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmp_path, path, ec);
+        if (ec) {
+            if (error != nullptr) {
+                *error = "could not replace " + path + ": " + ec.message();
+            }
+            return false;
+        }
+        return true;
+    }
+
+} // namespace cmse::utils
@@ -0,0 +1,15 @@
+#pragma once
+#include <string>
+
+namespace cmse::utils {
+
+    /**
+     * Replaces 'path' with 'content' atomically: the bytes are written to "<path>.tmp", which
+     * is then renamed over 'path'. Readers (scrapers, a restarting process) see either the
+     * previous file or the new one, never a half-written file.
+     * @param error Optional; receives a description of the failure.
+     * @return false if the temporary file could not be written or renamed.
+     */
+    bool writeFileAtomically(const std::string& path, const std::string& content, std::string* error = nullptr);
+
+} // namespace cmse::utils
@@ -0,0 +1,299 @@
+#include "json_reader.h"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace cmse::utils {
+
+    const JsonValue* JsonValue::get(const std::string& key) const {
+        if (type_ != Type::Object) {
+            return nullptr;
+        }
+        auto it = members_.find(key);
+        return it == members_.end() ? nullptr : &it->second;
+    }
+
+    double JsonValue::numberOr(const std::string& key, double fallback) const {
+        const JsonValue* value = get(key);
+        return (value != nullptr && value->isNumber()) ? value->asNumber() : fallback;
+    }
+
+    /**
+     * JsonParser
+     * Recursive-descent parser over an in-memory buffer. Nesting depth is bounded
+     * so a hostile file cannot overflow the stack.
+     */
+    class JsonParser {
+    public:
+        explicit JsonParser(const std::string& text) : text_(text) {}
+
+        bool parse(JsonValue* out, std::string* error) {
+            bool ok = parseValue(out, 0);
+            if (ok) {
+                skipWhitespace();
+                if (pos_ != text_.size()) {
+                    ok = fail("trailing characters after JSON value");
+                }
+            }
+            if (!ok && error != nullptr) {
+                *error = error_ + " at offset " + std::to_string(pos_);
+            }
+            return ok;
+        }
+
+    private:
+        static constexpr int MAX_DEPTH = 64;
+
+        bool fail(const std::string& message) {
+            if (error_.empty()) {
+                error_ = message;
+            }
+            return false;
+        }
+
+        void skipWhitespace() {
+            while (pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\n' || text_[pos_] == '\r')) {
+                ++pos_;
+            }
+        }
+
+        bool consumeLiteral(const char* literal) {
+            size_t len = std::char_traits<char>::length(literal);
+            if (text_.compare(pos_, len, literal) != 0) {
+                return fail("invalid literal");
+            }
+            pos_ += len;
+            return true;
+        }
+
+        bool parseValue(JsonValue* out, int depth) {
+            if (depth > MAX_DEPTH) {
+                return fail("nesting too deep");
+            }
+            skipWhitespace();
+            if (pos_ >= text_.size()) {
+                return fail("unexpected end of input");
+            }
+
+            char c = text_[pos_];
+            switch (c) {
+            case '{': return parseObject(out, depth);
+            case '[': return parseArray(out, depth);
+            case '"':
+                out->type_ = JsonValue::Type::String;
+                return parseString(&out->string_);
+            case 't':
+                out->type_ = JsonValue::Type::Bool;
+                out->bool_ = true;
+                return consumeLiteral("true");
+            case 'f':
+                out->type_ = JsonValue::Type::Bool;
+                out->bool_ = false;
+                return consumeLiteral("false");
+            case 'n':
+                out->type_ = JsonValue::Type::Null;
+                return consumeLiteral("null");
+            default:
+                if (c == '-' || (c >= '0' && c <= '9')) {
+                    return parseNumber(out);
+                }
+                return fail(std::string("unexpected character '") + c + "'");
+            }
+        }
+
+        bool parseObject(JsonValue* out, int depth) {
+            out->type_ = JsonValue::Type::Object;
+            ++pos_; // '{'
+            skipWhitespace();
+            if (pos_ < text_.size() && text_[pos_] == '}') {
+                ++pos_;
+                return true;
+            }
+            while (true) {
+                skipWhitespace();
+                if (pos_ >= text_.size() || text_[pos_] != '"') {
+                    return fail("expected object key");
+                }
+                std::string key;
+                if (!parseString(&key)) {
+                    return false;
+                }
+                skipWhitespace();
+                if (pos_ >= text_.size() || text_[pos_] != ':') {
+                    return fail("expected ':' after object key");
+                }
+                ++pos_;
+                JsonValue value;
+                if (!parseValue(&value, depth + 1)) {
+                    return false;
+                }
+                out->members_[key] = std::move(value); // Duplicate keys: last one wins
+                skipWhitespace();
+                if (pos_ < text_.size() && text_[pos_] == ',') {
+                    ++pos_;
+                    continue;
+                }
+                if (pos_ < text_.size() && text_[pos_] == '}') {
+                    ++pos_;
+                    return true;
+                }
+                return fail("expected ',' or '}' in object");
+            }
+        }
+
+        bool parseArray(JsonValue* out, int depth) {
+            out->type_ = JsonValue::Type::Array;
+            ++pos_; // '['
+            skipWhitespace();
+            if (pos_ < text_.size() && text_[pos_] == ']') {
+                ++pos_;
+                return true;
+            }
+            while (true) {
+                JsonValue value;
+                if (!parseValue(&value, depth + 1)) {
+                    return false;
+                }
+                out->items_.push_back(std::move(value));
+                skipWhitespace();
+                if (pos_ < text_.size() && text_[pos_] == ',') {
+                    ++pos_;
+                    continue;
+                }
+                if (pos_ < text_.size() && text_[pos_] == ']') {
+                    ++pos_;
+                    return true;
+                }
+                return fail("expected ',' or ']' in array");
+            }
+        }
+
+        bool parseNumber(JsonValue* out) {
+            size_t start = pos_;
+            if (text_[pos_] == '-') {
+                ++pos_;
+            }
+            auto digits = [this]() {
+                size_t begin = pos_;
+                while (pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9') {
+                    ++pos_;
+                }
+                return pos_ > begin;
+            };
+            if (!digits()) {
+                return fail("invalid number");
+            }
+            if (pos_ < text_.size() && text_[pos_] == '.') {
+                ++pos_;
+                if (!digits()) {
+                    return fail("invalid number fraction");
+                }
+            }
+            if (pos_ < text_.size() && (text_[pos_] == 'e' || text_[pos_] == 'E')) {
+                ++pos_;
+                if (pos_ < text_.size() && (text_[pos_] == '+' || text_[pos_] == '-')) {
+                    ++pos_;
+                }
+                if (!digits()) {
+                    return fail("invalid number exponent");
+                }
+            }
+            out->type_ = JsonValue::Type::Number;
+            out->number_ = std::strtod(text_.substr(start, pos_ - start).c_str(), nullptr);
+            return true;
+        }
+
+        static void appendUtf8(std::string* out, unsigned code) {
+            if (code < 0x80) {
+                out->push_back(static_cast<char>(code));
+            }
+            else if (code < 0x800) {
+                out->push_back(static_cast<char>(0xC0 | (code >> 6)));
+                out->push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+            else {
+                out->push_back(static_cast<char>(0xE0 | (code >> 12)));
+                out->push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                out->push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+        }
+
+        bool parseString(std::string* out) {
+            ++pos_; // opening quote
+            while (pos_ < text_.size()) {
+                char c = text_[pos_++];
+                if (c == '"') {
+                    return true;
+                }
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    return fail("control character in string");
+                }
+                if (c != '\\') {
+                    out->push_back(c);
+                    continue;
+                }
+                if (pos_ >= text_.size()) {
+                    break;
+                }
+                char esc = text_[pos_++];
+                switch (esc) {
+                case '"': out->push_back('"'); break;
+                case '\\': out->push_back('\\'); break;
+                case '/': out->push_back('/'); break;
+                case 'b': out->push_back('\b'); break;
+                case 'f': out->push_back('\f'); break;
+                case 'n': out->push_back('\n'); break;
+                case 'r': out->push_back('\r'); break;
+                case 't': out->push_back('\t'); break;
+                case 'u': {
+                    if (pos_ + 4 > text_.size()) {
+                        return fail("truncated \\u escape");
+                    }
+                    unsigned code = 0;
+                    for (int i = 0; i < 4; ++i) {
+                        char h = text_[pos_++];
+                        code <<= 4;
+                        if (h >= '0' && h <= '9') code |= static_cast<unsigned>(h - '0');
+                        else if (h >= 'a' && h <= 'f') code |= static_cast<unsigned>(h - 'a' + 10);
+                        else if (h >= 'A' && h <= 'F') code |= static_cast<unsigned>(h - 'A' + 10);
+                        else return fail("invalid \\u escape");
+                    }
+                    appendUtf8(out, code);
+                    break;
+                }
+                default:
+                    return fail("invalid escape sequence");
+                }
+            }
+            return fail("unterminated string");
+        }
+
+        const std::string& text_;
+        size_t pos_ = 0;
+        std::string error_;
+    };
+
+    bool parseJson(const std::string& text, JsonValue* out, std::string* error) {
+        JsonValue value;
+        JsonParser parser(text);
+        if (!parser.parse(&value, error)) {
+            return false;
+        }
+        *out = std::move(value);
+        return true;
+    }
+
+    bool parseJsonFile(const std::string& path, JsonValue* out, std::string* error) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            if (error != nullptr) {
+                *error = "cannot open " + path;
+            }
+            return false;
+        }
+        std::ostringstream buffer;
+        buffer << in.rdbuf();
+        return parseJson(buffer.str(), out, error);
+    }
+
+} // namespace cmse::utils
@@ -0,0 +1,56 @@
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+
+namespace cmse::utils {
+
+    /**
+     * JsonValue
+     * Minimal read-only JSON DOM (RFC 8259 subset): null, bool, number (double), string,
+     * array and object. Enough to read the project's own reports and baseline files;
+     * \u escapes outside ASCII are decoded to UTF-8, surrogate pairs are not combined.
+     */
+    class JsonValue {
+    public:
+        enum class Type { Null, Bool, Number, String, Array, Object };
+
+        Type type() const { return type_; }
+        bool isNull() const { return type_ == Type::Null; }
+        bool isBool() const { return type_ == Type::Bool; }
+        bool isNumber() const { return type_ == Type::Number; }
+        bool isString() const { return type_ == Type::String; }
+        bool isArray() const { return type_ == Type::Array; }
+        bool isObject() const { return type_ == Type::Object; }
+
+        bool asBool() const { return bool_; }
+        double asNumber() const { return number_; }
+        const std::string& asString() const { return string_; }
+        const std::vector<JsonValue>& items() const { return items_; }
+        const std::map<std::string, JsonValue>& members() const { return members_; }
+
+        // Object member lookup. Returns nullptr if this is not an object or the key is absent.
+        const JsonValue* get(const std::string& key) const;
+
+        // Convenience: member 'key' as a number, or 'fallback' if absent / not a number.
+        double numberOr(const std::string& key, double fallback) const;
+
+    private:
+        friend class JsonParser;
+
+        Type type_ = Type::Null;
+        bool bool_ = false;
+        double number_ = 0.0;
+        std::string string_;
+        std::vector<JsonValue> items_;
+        std::map<std::string, JsonValue> members_;
+    };
+
+    // Parses 'text' into 'out'. On malformed input returns false and describes the
+    // problem (with byte offset) in 'error' if non-null.
+    bool parseJson(const std::string& text, JsonValue* out, std::string* error = nullptr);
+
+    // Reads and parses a whole file.
+    bool parseJsonFile(const std::string& path, JsonValue* out, std::string* error = nullptr);
+
+} // namespace cmse::utils
@@ -0,0 +1,150 @@
+#include "latch.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace cmse::utils {
+
+    // =================================================================
+    // LatchStats / LatchRegistry
+    // =================================================================
+
+    void LatchStats::reset() {
+        acquisitions.store(0, std::memory_order_relaxed);
+        contended.store(0, std::memory_order_relaxed);
+        wait_ns.store(0, std::memory_order_relaxed);
+        max_wait_ns.store(0, std::memory_order_relaxed);
+        hold_ns.store(0, std::memory_order_relaxed);
+    }
+
+    LatchRegistry& LatchRegistry::instance() {
+        static LatchRegistry registry;
+        return registry;
+    }
+
+    std::shared_ptr<LatchStats> LatchRegistry::statsFor(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& entry = stats_[name];
+        if (!entry) {
+            entry = std::make_shared<LatchStats>();
+        }
+        return entry;
+    }
+
+    std::vector<LatchStatsSnapshot> LatchRegistry::snapshot() const {
+        std::vector<LatchStatsSnapshot> result;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& [name, stats] : stats_) {
+                LatchStatsSnapshot s;
+                s.name = name;
+                s.acquisitions = stats->acquisitions.load(std::memory_order_relaxed);
+                s.contended = stats->contended.load(std::memory_order_relaxed);
+                s.wait_ns = stats->wait_ns.load(std::memory_order_relaxed);
+                s.max_wait_ns = stats->max_wait_ns.load(std::memory_order_relaxed);
+                s.hold_ns = stats->hold_ns.load(std::memory_order_relaxed);
+                result.push_back(std::move(s));
+            }
+        }
+        std::stable_sort(result.begin(), result.end(), [](const LatchStatsSnapshot& a, const LatchStatsSnapshot& b) {
+            return a.contended > b.contended;
+        });
+        return result;
+    }
+
+    void LatchRegistry::reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [name, stats] : stats_) {
+            stats->reset();
+        }
+    }
+
+    // =================================================================
+    // ProfiledMutex
+    // =================================================================
+
+    ProfiledMutex::ProfiledMutex(const char* name)
+        : stats_(LatchRegistry::instance().statsFor(name)) {
+    }
+
+    void ProfiledMutex::lock() {
+        if (mutex_.try_lock()) {
+            onAcquired(Clock::now());
+            return;
+        }
+
+        auto start = Clock::now();
+        mutex_.lock();
+        auto now = Clock::now();
+        uint64_t waited = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count());
+
+        stats_->contended.fetch_add(1, std::memory_order_relaxed);
+        stats_->wait_ns.fetch_add(waited, std::memory_order_relaxed);
+        uint64_t prev_max = stats_->max_wait_ns.load(std::memory_order_relaxed);
+        while (waited > prev_max && !stats_->max_wait_ns.compare_exchange_weak(prev_max, waited, std::memory_order_relaxed)) {
+        }
+        onAcquired(now);
+    }
+
+    bool ProfiledMutex::try_lock() {
+        if (!mutex_.try_lock()) {
+            return false;
+        }
+        onAcquired(Clock::now());
+        return true;
+    }
+
+    void ProfiledMutex::unlock() {
+        uint64_t held = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - acquired_at_).count());
+        stats_->hold_ns.fetch_add(held, std::memory_order_relaxed);
+        mutex_.unlock();
+    }
+
+    void ProfiledMutex::onAcquired(Clock::time_point now) {
+        acquired_at_ = now;
+        stats_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // =================================================================
+    // Reporting
+    // =================================================================
+
+    std::string formatLatchReport(const std::vector<LatchStatsSnapshot>& stats, size_t top_n, uint64_t total_ops) {
+        std::ostringstream out;
+        out << std::left << std::setw(20) << "latch"
+            << std::right << std::setw(14) << "acquisitions"
+            << std::setw(12) << "contended"
+            << std::setw(10) << "ratio"
+            << std::setw(14) << "avg_wait_ns"
+            << std::setw(14) << "max_wait_ns"
+            << std::setw(14) << "avg_hold_ns";
+        if (total_ops > 0) {
+            out << std::setw(14) << "wait_ns/op";
+        }
+        out << "\n";
+
+        out << std::fixed;
+        size_t shown = 0;
+        for (const auto& s : stats) {
+            if (shown++ == top_n) {
+                break;
+            }
+            double avg_wait = s.contended == 0 ? 0.0 : static_cast<double>(s.wait_ns) / static_cast<double>(s.contended);
+            double avg_hold = s.acquisitions == 0 ? 0.0 : static_cast<double>(s.hold_ns) / static_cast<double>(s.acquisitions);
+            out << std::left << std::setw(20) << s.name
+                << std::right << std::setw(14) << s.acquisitions
+                << std::setw(12) << s.contended
+                << std::setw(10) << std::setprecision(4) << s.ContentionRatio()
+                << std::setw(14) << std::setprecision(1) << avg_wait
+                << std::setw(14) << s.max_wait_ns
+                << std::setw(14) << std::setprecision(1) << avg_hold;
+            if (total_ops > 0) {
+                out << std::setw(14) << std::setprecision(1) << static_cast<double>(s.wait_ns) / static_cast<double>(total_ops);
+            }
+            out << "\n";
+        }
+        return out.str();
+    }
+
+} // namespace cmse::utils
@@ -0,0 +1,124 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cmse::utils {
+
+    /**
+     * Point-in-time copy of the counters of one named latch.
+     * All latch instances constructed with the same name share one set of counters.
+     */
+    struct LatchStatsSnapshot {
+        std::string name;
+        uint64_t acquisitions = 0;
+        uint64_t contended = 0;      // Acquisitions that found the latch already held
+        uint64_t wait_ns = 0;        // Total time spent blocked in lock()
+        uint64_t max_wait_ns = 0;
+        uint64_t hold_ns = 0;        // Total time between acquisition and unlock()
+
+        double ContentionRatio() const {
+            return acquisitions == 0 ? 0.0 : static_cast<double>(contended) / static_cast<double>(acquisitions);
+        }
+    };
+
+    /**
+     * Shared counters of one named latch. Updated with relaxed atomics while the latch is held,
+     * so the counters themselves never add contention beyond a cache line transfer.
+     */
+    struct LatchStats {
+        std::atomic<uint64_t> acquisitions{ 0 };
+        std::atomic<uint64_t> contended{ 0 };
+        std::atomic<uint64_t> wait_ns{ 0 };
+        std::atomic<uint64_t> max_wait_ns{ 0 };
+        std::atomic<uint64_t> hold_ns{ 0 };
+
+        void reset();
+    };
+
+    /**
+     * Process-wide registry of named latch counters.
+     */
+    class LatchRegistry {
+    public:
+        static LatchRegistry& instance();
+
+        // Returns the counters for 'name', creating them on first use.
+        std::shared_ptr<LatchStats> statsFor(const std::string& name);
+
+        // All registered latches, sorted by contended acquisitions (descending).
+        std::vector<LatchStatsSnapshot> snapshot() const;
+
+        void reset();
+
+    private:
+        LatchRegistry() = default;
+
+        mutable std::mutex mutex_;
+        std::map<std::string, std::shared_ptr<LatchStats>> stats_;
+    };
+
+    /**
+     * std::mutex replacement that records acquisitions, contended acquisitions,
+     * wait time and hold time under a latch name. Satisfies Lockable, so it works
+     * with std::lock_guard / std::unique_lock.
+     */
+    class ProfiledMutex {
+    public:
+        explicit ProfiledMutex(const char* name);
+
+        ProfiledMutex(const ProfiledMutex&) = delete;
+        ProfiledMutex& operator=(const ProfiledMutex&) = delete;
+
+        void lock();
+        bool try_lock();
+        void unlock();
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        void onAcquired(Clock::time_point now);
+
+        std::mutex mutex_;
+        std::shared_ptr<LatchStats> stats_;
+        Clock::time_point acquired_at_; // Written and read only by the holder
+    };
+
+    /**
+     * Plain std::mutex with the same constructor as ProfiledMutex (the name is ignored).
+     */
+    class PlainMutex {
+    public:
+        explicit PlainMutex(const char*) {}
+
+        PlainMutex(const PlainMutex&) = delete;
+        PlainMutex& operator=(const PlainMutex&) = delete;
+
+        void lock() { mutex_.lock(); }
+        bool try_lock() { return mutex_.try_lock(); }
+        void unlock() { mutex_.unlock(); }
+
+    private:
+        std::mutex mutex_;
+    };
+
+    // Latch type used by the storage stack. Profiling is compiled in only with
+    // CMSE_ENABLE_LATCH_PROFILING; otherwise Latch is a zero-cost std::mutex wrapper.
+#ifdef CMSE_LATCH_PROFILING
+    using Latch = ProfiledMutex;
+#else
+    using Latch = PlainMutex;
+#endif
+
+    /**
+     * Human-readable table of the 'top_n' most contended latches.
+     * 'total_ops' (optional) adds a wait-per-operation column for benchmark reports.
+     */
+    std::string formatLatchReport(const std::vector<LatchStatsSnapshot>& stats, size_t top_n, uint64_t total_ops = 0);
+
+} // namespace cmse::utils
@@ -0,0 +1,153 @@
+#include "latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <utility>
+
+namespace cmse::utils {
+
+    // =================================================================
+    // HistogramSnapshot
+    // =================================================================
+
+    void HistogramSnapshot::record(uint64_t value_ns) {
+        add(histogram::BucketIndex(value_ns), 1);
+        addSum(value_ns);
+        addMax(value_ns);
+    }
+
+    uint64_t HistogramSnapshot::valueAtQuantile(double q) const {
+        if (total_ == 0) {
+            return 0;
+        }
+        q = std::min(1.0, std::max(0.0, q));
+
+        // Rank of the requested sample (1-based), e.g. p99 of 1000 samples = 990th.
+        uint64_t rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(total_)));
+        rank = std::max<uint64_t>(1, rank);
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < buckets_.size(); ++i) {
+            seen += buckets_[i];
+            if (seen >= rank) {
+                // Never report more than the true observed maximum.
+                return std::min(histogram::BucketUpperBound(i), max_);
+            }
+        }
+        return max_;
+    }
+
+    // =================================================================
+    // LatencyRecorder
+    // =================================================================
+
+    namespace {
+        std::atomic<uint64_t> next_recorder_id{ 1 };
+
+        // Bound on cached (recorder id -> shard) entries per thread. An entry that falls out
+        // (destroyed recorder, or more live recorders than this) costs one locked lookup in
+        // the recorder's own thread map on its next record(), never a new shard.
+        constexpr size_t MAX_CACHED_SHARDS = 64;
+    }
+
+    LatencyRecorder::LatencyRecorder(std::string op_name)
+        : op_name_(std::move(op_name)), id_(next_recorder_id.fetch_add(1, std::memory_order_relaxed)) {
+    }
+
+    LatencyRecorder::Shard* LatencyRecorder::localShard() {
+        thread_local std::vector<std::pair<uint64_t, Shard*>> cache;
+
+        for (const auto& entry : cache) {
+            if (entry.first == id_) {
+                return entry.second;
+            }
+        }
+
+        Shard* shard = findOrCreateShard();
+        if (cache.size() >= MAX_CACHED_SHARDS) {
+            cache.erase(cache.begin());
+        }
+        cache.emplace_back(id_, shard);
+        return shard;
+    }
+
+    LatencyRecorder::Shard* LatencyRecorder::findOrCreateShard() {
+        std::lock_guard<std::mutex> lock(shards_mutex_);
+        Shard*& shard = thread_shards_[std::this_thread::get_id()];
+        if (shard == nullptr) {
+            // A thread id reused after its thread exited inherits the old shard; it is
+            // still written by one live thread at a time.
+            shards_.push_back(std::make_unique<Shard>());
+            shard = shards_.back().get();
+        }
+        return shard;
+    }
+
+    HistogramSnapshot LatencyRecorder::snapshot() const {
+        HistogramSnapshot merged;
+
+        std::lock_guard<std::mutex> lock(shards_mutex_);
+        for (const auto& shard : shards_) {
+            for (size_t i = 0; i < histogram::NUM_BUCKETS; ++i) {
+                uint64_t count = shard->buckets[i].load(std::memory_order_relaxed);
+                if (count != 0) {
+                    merged.add(i, count);
+                }
+            }
+            merged.addSum(shard->sum.load(std::memory_order_relaxed));
+            merged.addMax(shard->max.load(std::memory_order_relaxed));
+        }
+        return merged;
+    }
+
+    LatencySummary LatencyRecorder::summarize() const {
+        HistogramSnapshot snap = snapshot();
+
+        LatencySummary summary;
+        summary.op = op_name_;
+        summary.count = snap.count();
+        summary.sum_ns = snap.sum();
+        summary.mean_ns = snap.mean();
+        summary.p50_ns = snap.valueAtQuantile(0.50);
+        summary.p99_ns = snap.valueAtQuantile(0.99);
+        summary.p999_ns = snap.valueAtQuantile(0.999);
+        summary.max_ns = snap.max();
+        return summary;
+    }
+
+    void LatencyRecorder::reset() {
+        std::lock_guard<std::mutex> lock(shards_mutex_);
+        for (auto& shard : shards_) {
+            for (auto& bucket : shard->buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            shard->sum.store(0, std::memory_order_relaxed);
+            shard->max.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    size_t LatencyRecorder::shardCount() const {
+        std::lock_guard<std::mutex> lock(shards_mutex_);
+        return shards_.size();
+    }
+
+    // =================================================================
+    // Export
+    // =================================================================
+
+    std::string latencySummariesToPrometheus(const std::string& metric_name, const std::vector<LatencySummary>& summaries) {
+        std::ostringstream out;
+        out << "# HELP " << metric_name << " Operation latency in nanoseconds.\n";
+        out << "# TYPE " << metric_name << " summary\n";
+
+        for (const auto& s : summaries) {
+            out << metric_name << "{op=\"" << s.op << "\",quantile=\"0.5\"} " << s.p50_ns << "\n";
+            out << metric_name << "{op=\"" << s.op << "\",quantile=\"0.99\"} " << s.p99_ns << "\n";
+            out << metric_name << "{op=\"" << s.op << "\",quantile=\"0.999\"} " << s.p999_ns << "\n";
+            out << metric_name << "_sum{op=\"" << s.op << "\"} " << s.sum_ns << "\n";
+            out << metric_name << "_count{op=\"" << s.op << "\"} " << s.count << "\n";
+        }
+        return out.str();
+    }
+
+} // namespace cmse::utils
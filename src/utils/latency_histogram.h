@@ -0,0 +1,202 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace cmse::utils {
+
+    /**
+     * Log-linear (HDR-style) bucketing for latency values in nanoseconds.
+     * Every power-of-two range is split into 2^SUB_BUCKET_BITS linear sub-buckets,
+     * so the relative error of any reported value is below 1 / 2^SUB_BUCKET_BITS (~3%).
+     * Values above 2^MAX_VALUE_BITS ns (~18 minutes) are clamped into the last bucket.
+     */
+    namespace histogram {
+        constexpr int SUB_BUCKET_BITS = 5;
+        constexpr int MAX_VALUE_BITS = 40;
+        constexpr uint64_t SUB_BUCKET_COUNT = uint64_t{ 1 } << SUB_BUCKET_BITS;
+        constexpr size_t NUM_BUCKETS = static_cast<size_t>((MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT);
+        constexpr uint64_t MAX_VALUE = (uint64_t{ 1 } << MAX_VALUE_BITS) - 1;
+
+        // Index of the most significant set bit (value must be non-zero).
+        inline int MostSignificantBit(uint64_t value) {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanReverse64(&index, value);
+            return static_cast<int>(index);
+#else
+            return 63 - __builtin_clzll(value);
+#endif
+        }
+
+        inline size_t BucketIndex(uint64_t value) {
+            if (value > MAX_VALUE) {
+                value = MAX_VALUE;
+            }
+            if (value < SUB_BUCKET_COUNT) {
+                return static_cast<size_t>(value);
+            }
+            int shift = MostSignificantBit(value) - SUB_BUCKET_BITS;
+            return static_cast<size_t>((shift + 1) * SUB_BUCKET_COUNT + ((value >> shift) - SUB_BUCKET_COUNT));
+        }
+
+        // Highest value that maps to 'index' (the conservative value reported for percentiles).
+        inline uint64_t BucketUpperBound(size_t index) {
+            if (index < 2 * SUB_BUCKET_COUNT) {
+                return index;
+            }
+            uint64_t shift = index / SUB_BUCKET_COUNT - 1;
+            uint64_t sub = index % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+            return ((sub + 1) << shift) - 1;
+        }
+    } // namespace histogram
+
+    /**
+     * HistogramSnapshot
+     * Plain (non-atomic) merged histogram used for reading percentiles.
+     */
+    class HistogramSnapshot {
+    public:
+        HistogramSnapshot() : buckets_(histogram::NUM_BUCKETS, 0) {}
+
+        void add(size_t bucket, uint64_t count) { buckets_[bucket] += count; total_ += count; }
+        void addSum(uint64_t sum) { sum_ += sum; }
+        void addMax(uint64_t max) { if (max > max_) max_ = max; }
+
+        // Records a single value directly (used by offline tools and tests).
+        void record(uint64_t value_ns);
+
+        uint64_t count() const { return total_; }
+        uint64_t sum() const { return sum_; }
+        uint64_t max() const { return max_; }
+        double mean() const { return total_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(total_); }
+
+        // Returns the value at quantile q (0.0 - 1.0). 0 if the histogram is empty.
+        uint64_t valueAtQuantile(double q) const;
+
+    private:
+        std::vector<uint64_t> buckets_;
+        uint64_t total_ = 0;
+        uint64_t sum_ = 0;
+        uint64_t max_ = 0;
+    };
+
+    /**
+     * LatencySummary
+     * Exported percentiles for a single operation.
+     */
+    struct LatencySummary {
+        std::string op;
+        uint64_t count = 0;
+        uint64_t sum_ns = 0;
+        double mean_ns = 0.0;
+        uint64_t p50_ns = 0;
+        uint64_t p99_ns = 0;
+        uint64_t p999_ns = 0;
+        uint64_t max_ns = 0;
+    };
+
+    /**
+     * LatencyRecorder
+     * Thread-local latency histogram for one named operation.
+     * Each recording thread lazily gets its own shard, so record() is a couple of
+     * uncontended relaxed stores; snapshot() merges all shards on read.
+     * The recorder owns the thread -> shard map, so it never holds more than one shard
+     * per thread; a small thread-local cache in front of it keeps the lookup lock-free.
+     */
+    class LatencyRecorder {
+    public:
+        explicit LatencyRecorder(std::string op_name);
+
+        LatencyRecorder(const LatencyRecorder&) = delete;
+        LatencyRecorder& operator=(const LatencyRecorder&) = delete;
+
+        inline void record(uint64_t value_ns) {
+            Shard* shard = localShard();
+            // Single writer per shard: load + store avoids a locked read-modify-write.
+            auto& bucket = shard->buckets[histogram::BucketIndex(value_ns)];
+            bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            shard->sum.store(shard->sum.load(std::memory_order_relaxed) + value_ns, std::memory_order_relaxed);
+            if (value_ns > shard->max.load(std::memory_order_relaxed)) {
+                shard->max.store(value_ns, std::memory_order_relaxed);
+            }
+        }
+
+        const std::string& name() const { return op_name_; }
+
+        // Merges every thread's shard into a single histogram.
+        HistogramSnapshot snapshot() const;
+
+        // Convenience: snapshot() reduced to p50/p99/p999.
+        LatencySummary summarize() const;
+
+        // Clears all shards. Concurrent record() calls may survive the reset.
+        void reset();
+
+        // Number of per-thread shards allocated so far.
+        size_t shardCount() const;
+
+    private:
+        struct Shard {
+            std::array<std::atomic<uint64_t>, histogram::NUM_BUCKETS> buckets{};
+            std::atomic<uint64_t> sum{ 0 };
+            std::atomic<uint64_t> max{ 0 };
+        };
+
+        Shard* localShard();
+        Shard* findOrCreateShard();
+
+        std::string op_name_;
+        uint64_t id_; // Unique per recorder; keys the thread-local shard cache
+
+        mutable std::mutex shards_mutex_;
+        std::vector<std::unique_ptr<Shard>> shards_;
+        std::unordered_map<std::thread::id, Shard*> thread_shards_;
+    };
+
+    /**
+     * ScopedLatency
+     * Records the lifetime of the scope into a LatencyRecorder.
+     */
+    class ScopedLatency {
+    public:
+        explicit ScopedLatency(LatencyRecorder& recorder)
+            : recorder_(recorder), start_(std::chrono::steady_clock::now()) {
+        }
+
+        ~ScopedLatency() {
+            auto elapsed = std::chrono::steady_clock::now() - start_;
+            recorder_.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+
+    private:
+        LatencyRecorder& recorder_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    // Renders summaries as a Prometheus 'summary' metric (label op="<name>").
+    std::string latencySummariesToPrometheus(const std::string& metric_name, const std::vector<LatencySummary>& summaries);
+
+} // namespace cmse::utils
+
+// Instrumentation hook. Compiled out entirely unless CMSE_LATENCY_HISTOGRAMS is defined
+// (CMake option CMSE_ENABLE_LATENCY_HISTOGRAMS).
+#ifdef CMSE_LATENCY_HISTOGRAMS
+#define CMSE_LATENCY_CONCAT_INNER(a, b) a##b
+#define CMSE_LATENCY_CONCAT(a, b) CMSE_LATENCY_CONCAT_INNER(a, b)
+#define CMSE_LATENCY_SCOPE(recorder) \
+    ::cmse::utils::ScopedLatency CMSE_LATENCY_CONCAT(latency_scope_, __LINE__)(recorder)
+#else
+#define CMSE_LATENCY_SCOPE(recorder) ((void)0)
+#endif
@@ -24,8 +24,8 @@ namespace cmse::utils {
         // Reads logs from a file (to be fed into the Indexing Layer).
         static std::vector<LogRecord> readLogsFromFile(const std::string& filename);
 
-    private:
-        // Helper to parse a single CSV line into a LogRecord
+        // Parses a single CSV line into a LogRecord.
+        // Public so the benchmark suite can measure parsing without file I/O.
         static LogRecord parseLine(const std::string& line);
     };
 
@@ -0,0 +1,24 @@
+#include "metrics_dumper.h"
+#include "atomic_file.h"
+#include <iostream>
+
+namespace cmse::utils {
+
+    MetricsDumper::MetricsDumper(std::string path, std::chrono::milliseconds interval, RenderFn render)
+        : path_(std::move(path)), render_(std::move(render)), worker_(interval, [this] { dumpNow(); }) {
+    }
+
+    MetricsDumper::~MetricsDumper() {
+        stop();
+    }
+
+    bool MetricsDumper::dumpNow() {
+        std::string error;
+        if (!writeFileAtomically(path_, render_(), &error)) {
+            std::cerr << "[MetricsDumper] Error: " << error << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+} // namespace cmse::utils
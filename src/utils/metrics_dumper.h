@@ -0,0 +1,46 @@
+#pragma once
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include "periodic_worker.h"
+
+namespace cmse::utils {
+
+    /**
+     * MetricsDumper
+     * Periodically renders metrics text (e.g. Prometheus exposition format) and writes it
+     * to a file, which node_exporter's textfile collector or a sidecar can scrape.
+     * The file is replaced atomically (see writeFileAtomically).
+     */
+    class MetricsDumper {
+    public:
+        using RenderFn = std::function<std::string()>;
+
+        // render: Produces the full file content on every dump.
+        // interval: Time between dumps once start() is called.
+        MetricsDumper(std::string path, std::chrono::milliseconds interval, RenderFn render);
+
+        // Stops the background thread (writing one final dump).
+        ~MetricsDumper();
+
+        MetricsDumper(const MetricsDumper&) = delete;
+        MetricsDumper& operator=(const MetricsDumper&) = delete;
+
+        // Starts the background dump thread. No-op if already running.
+        void start() { worker_.start(); }
+
+        // Stops the background thread and writes a final dump. No-op if not running.
+        void stop() { worker_.stop(); }
+
+        // Renders and writes the file immediately on the calling thread.
+        // Returns false if the file could not be written.
+        bool dumpNow();
+
+    private:
+        std::string path_;
+        RenderFn render_;
+        PeriodicWorker worker_;
+    };
+
+} // namespace cmse::utils
@@ -0,0 +1,49 @@
+#include "periodic_worker.h"
+
+namespace cmse::utils {
+
+    PeriodicWorker::PeriodicWorker(std::chrono::milliseconds interval, TaskFn task)
+        : interval_(interval), task_(std::move(task)) {
+    }
+
+    PeriodicWorker::~PeriodicWorker() {
+        stop();
+    }
+
+    void PeriodicWorker::start() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_) {
+            return;
+        }
+        running_ = true;
+        stop_requested_ = false;
+        worker_ = std::thread(&PeriodicWorker::run, this);
+    }
+
+    void PeriodicWorker::stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_) {
+                return;
+            }
+            stop_requested_ = true;
+        }
+        cv_.notify_all();
+        worker_.join();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+
+    void PeriodicWorker::run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stop_requested_) {
+            cv_.wait_for(lock, interval_, [this] { return stop_requested_; });
+
+            lock.unlock();
+            task_();
+            lock.lock();
+        }
+    }
+
+} // namespace cmse::utils
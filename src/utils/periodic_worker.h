@@ -0,0 +1,49 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace cmse::utils {
+
+    /**
+     * PeriodicWorker
+     * Runs a task on a background thread every 'interval' until stopped. stop() wakes the
+     * thread early and the task runs one last time before the thread exits, so owners that
+     * persist state (MetricsDumper, bufferpool::ResidentSetPersister) always leave a final,
+     * up-to-date file behind. The task runs without the worker's lock held, so stop() is
+     * never blocked behind its I/O.
+     */
+    class PeriodicWorker {
+    public:
+        using TaskFn = std::function<void()>;
+
+        PeriodicWorker(std::chrono::milliseconds interval, TaskFn task);
+
+        // Stops the thread (running the task one final time).
+        ~PeriodicWorker();
+
+        PeriodicWorker(const PeriodicWorker&) = delete;
+        PeriodicWorker& operator=(const PeriodicWorker&) = delete;
+
+        // Starts the background thread. No-op if already running.
+        void start();
+
+        // Stops the background thread after a final run of the task. No-op if not running.
+        void stop();
+
+    private:
+        void run();
+
+        std::chrono::milliseconds interval_;
+        TaskFn task_;
+
+        std::thread worker_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool running_ = false;
+        bool stop_requested_ = false;
+    };
+
+} // namespace cmse::utils
@@ -0,0 +1,708 @@
+#include "version_manager.h"
+#include <algorithm>
+#include <cstring>
+
+namespace cmse::versioning {
+
+    template <typename KeyT, size_t PageSize>
+    BasicVersionManager<KeyT, PageSize>::BasicVersionManager(BufferPoolAdapter* bpm, TreeAdapter* tree_adapter)
+        : bpm_(bpm), adapter_(tree_adapter) {
+    }
+
+    template <typename KeyT, size_t PageSize>
+    void BasicVersionManager<KeyT, PageSize>::setLeafFilter(adapter::LeafFilter* filter) {
+        leaf_filter_ = filter;
+    }
+
+    // =================================================================
+    // Version Lifecycle
+    // =================================================================
+
+    template <typename KeyT, size_t PageSize>
+    version_t BasicVersionManager<KeyT, PageSize>::createVersion() {
+        std::lock_guard<std::mutex> lock(latch_);
+        version_t version = next_version_++;
+        versions_.emplace(version, VersionInfo{});
+        return version;
+    }
+
+    template <typename KeyT, size_t PageSize>
+    typename BasicVersionManager<KeyT, PageSize>::VersionInfo* BasicVersionManager<KeyT, PageSize>::findVersion(version_t version) {
+        std::lock_guard<std::mutex> lock(latch_);
+        auto it = versions_.find(version);
+        return it == versions_.end() ? nullptr : &it->second;
+    }
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicVersionManager<KeyT, PageSize>::commitVersion(version_t version) {
+        VersionInfo* info = findVersion(version);
+        if (info == nullptr || info->state != VersionState::Active) {
+            return false;
+        }
+
+        // Persist the version's pages before it becomes visible.
+        // Pages already evicted were written back by the buffer pool.
+        // The leaves are final from here on, so their filters can be built now; a leaf whose
+        // filter could not be stored is simply always fetched.
+        for (page_id_t page_id : info->staged_pages) {
+            if (leaf_filter_ != nullptr) {
+                registerLeaves(page_id, false);
+            }
+            bpm_->FlushPage(page_id);
+        }
+        info->staged_pages.clear();
+        info->staged_pages.shrink_to_fit();
+
+        std::lock_guard<std::mutex> lock(latch_);
+        info->state = VersionState::Committed;
+        latest_committed_ = version;
+        return true;
+    }
+
+    template <typename KeyT, size_t PageSize>
+    void BasicVersionManager<KeyT, PageSize>::abortVersion(version_t version) {
+        VersionInfo* info = findVersion(version);
+        if (info == nullptr || info->state != VersionState::Active) {
+            return;
+        }
+        // No free-space map yet: staged pages are simply abandoned (never referenced again).
+        std::lock_guard<std::mutex> lock(latch_);
+        info->state = VersionState::Aborted;
+        info->root = INVALID_PAGE_ID;
+        info->staged_pages.clear();
+    }
+
+    template <typename KeyT, size_t PageSize>
+    version_t BasicVersionManager<KeyT, PageSize>::latestVersion() {
+        std::lock_guard<std::mutex> lock(latch_);
+        return latest_committed_;
+    }
+
+    template <typename KeyT, size_t PageSize>
+    page_id_t BasicVersionManager<KeyT, PageSize>::getRoot(version_t version) {
+        std::lock_guard<std::mutex> lock(latch_);
+        auto it = versions_.find(version);
+        return it == versions_.end() ? INVALID_PAGE_ID : it->second.root;
+    }
+
+    template <typename KeyT, size_t PageSize>
+    BasicPage<PageSize>* BasicVersionManager<KeyT, PageSize>::readPage(page_id_t page_id, version_t version) {
+        Page* page = bpm_->FetchPage(page_id);
+        if (page == nullptr) {
+            return nullptr;
+        }
+        // A page created by a later version cannot be part of this version's snapshot.
+        if (page->GetHeader()->creation_version > version) {
+            bpm_->UnpinPage(page_id, false);
+            return nullptr;
+        }
+        return page;
+    }
+
+    // =================================================================
+    // Copy-on-Write Helpers
+    // =================================================================
+
+    template <typename KeyT, size_t PageSize>
+    BasicPage<PageSize>* BasicVersionManager<KeyT, PageSize>::allocatePage(version_t v, VersionInfo* info, page_id_t* out_page_id) {
+        Page* page = bpm_->NewPage(*out_page_id);
+        if (page == nullptr) {
+            return nullptr;
+        }
+        page->GetHeader()->creation_version = v;
+        info->staged_pages.push_back(*out_page_id);
+        return page;
+    }
+
+    template <typename KeyT, size_t PageSize>
+    BasicPage<PageSize>* BasicVersionManager<KeyT, PageSize>::makeWritable(version_t v, VersionInfo* info, page_id_t page_id, page_id_t* out_page_id) {
+        Page* page = bpm_->FetchPage(page_id);
+        if (page == nullptr) {
+            return nullptr;
+        }
+
+        // Already owned by this version: modify in place.
+        if (page->GetHeader()->creation_version == v) {
+            *out_page_id = page_id;
+            return page;
+        }
+
+        Page* copy = allocatePage(v, info, out_page_id);
+        if (copy == nullptr) {
+            bpm_->UnpinPage(page_id, false);
+            return nullptr;
+        }
+        std::memcpy(copy->GetData(), page->GetData(), PageSize - sizeof(PageHeader));
+        copy->GetHeader()->is_leaf = page->GetHeader()->is_leaf;
+        copy->GetHeader()->key_count = page->GetHeader()->key_count;
+        bpm_->UnpinPage(page_id, false);
+        return copy;
+    }
+
+    // =================================================================
+    // Write Path
+    // =================================================================
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicVersionManager<KeyT, PageSize>::applyUpdate(version_t version, version_t base_version, const KeyT& key, const ValueType& val) {
+        VersionInfo* info = findVersion(version);
+        if (info == nullptr || info->state != VersionState::Active) {
+            return false;
+        }
+
+        if (!info->has_base) {
+            page_id_t base_root = base_version == INVALID_VERSION ? INVALID_PAGE_ID : getRoot(base_version);
+            std::lock_guard<std::mutex> lock(latch_);
+            info->root = base_root;
+            info->has_base = true;
+        }
+
+        page_id_t root = info->root;
+
+        // Empty tree: the first key creates a single leaf root.
+        if (root == INVALID_PAGE_ID) {
+            page_id_t leaf_id;
+            Page* leaf = allocatePage(version, info, &leaf_id);
+            if (leaf == nullptr) {
+                return false;
+            }
+            adapter_->initLeaf(leaf);
+            adapter_->applyUpdateToLeaf(leaf, key, val);
+            adapter_->updateStatistics(leaf);
+            bpm_->UnpinPage(leaf_id, true);
+
+            std::lock_guard<std::mutex> lock(latch_);
+            info->root = leaf_id;
+            return true;
+        }
+
+        bool needs_split = false;
+        KeyT promoted_key{};
+        page_id_t sibling_id = INVALID_PAGE_ID;
+        page_id_t new_root = recursiveUpdate(version, info, root, key, val, needs_split, promoted_key, sibling_id);
+        if (new_root == INVALID_PAGE_ID) {
+            return false;
+        }
+
+        // Root split: the tree grows by one level.
+        if (needs_split) {
+            page_id_t root_id;
+            Page* root_page = allocatePage(version, info, &root_id);
+            if (root_page == nullptr) {
+                return false;
+            }
+            adapter_->createNewRoot(root_page, new_root, sibling_id, promoted_key);
+            for (page_id_t child_id : { new_root, sibling_id }) {
+                Page* child = bpm_->FetchPage(child_id);
+                if (child != nullptr) {
+                    adapter_->mergeStatistics(root_page, child);
+                    bpm_->UnpinPage(child_id, false);
+                }
+            }
+            bpm_->UnpinPage(root_id, true);
+            new_root = root_id;
+        }
+
+        if (new_root != root) {
+            std::lock_guard<std::mutex> lock(latch_);
+            info->root = new_root;
+        }
+        return true;
+    }
+
+    template <typename KeyT, size_t PageSize>
+    page_id_t BasicVersionManager<KeyT, PageSize>::recursiveUpdate(version_t v, VersionInfo* info, page_id_t current_page_id, const KeyT& key, const ValueType& val, bool& needs_split, KeyT& out_promoted_key, page_id_t& out_new_sibling_id) {
+        needs_split = false;
+
+        page_id_t page_id;
+        Page* page = makeWritable(v, info, current_page_id, &page_id);
+        if (page == nullptr) {
+            return INVALID_PAGE_ID;
+        }
+
+        if (adapter_->isLeaf(page)) {
+            if (!adapter_->applyUpdateToLeaf(page, key, val)) {
+                page_id_t right_id;
+                Page* right = allocatePage(v, info, &right_id);
+                if (right == nullptr) {
+                    bpm_->UnpinPage(page_id, true);
+                    return INVALID_PAGE_ID;
+                }
+
+                adapter::BasicSplitResult<KeyT> split;
+                adapter_->splitNode(page, right, &split);
+                Page* target = key < split.promoted_key ? page : right;
+                adapter_->applyUpdateToLeaf(target, key, val);
+                adapter_->updateStatistics(target);
+
+                needs_split = true;
+                out_promoted_key = split.promoted_key;
+                out_new_sibling_id = right_id;
+                bpm_->UnpinPage(right_id, true);
+            }
+            else {
+                adapter_->updateStatistics(page);
+            }
+            bpm_->UnpinPage(page_id, true);
+            return page_id;
+        }
+
+        // Internal node: descend, then fix up the child pointer and absorb a child split.
+        adapter_->expandStatistics(page, key);
+        page_id_t child_id = adapter_->findChild(page, key);
+
+        bool child_split = false;
+        KeyT child_key{};
+        page_id_t child_sibling = INVALID_PAGE_ID;
+        page_id_t new_child_id = recursiveUpdate(v, info, child_id, key, val, child_split, child_key, child_sibling);
+        if (new_child_id == INVALID_PAGE_ID) {
+            bpm_->UnpinPage(page_id, true);
+            return INVALID_PAGE_ID;
+        }
+        if (new_child_id != child_id) {
+            adapter_->updateChildPointer(page, child_id, new_child_id);
+        }
+
+        if (child_split && !adapter_->insertIntoInternal(page, child_key, child_sibling)) {
+            page_id_t right_id;
+            Page* right = allocatePage(v, info, &right_id);
+            if (right == nullptr) {
+                bpm_->UnpinPage(page_id, true);
+                return INVALID_PAGE_ID;
+            }
+
+            adapter::BasicSplitResult<KeyT> split;
+            adapter_->splitNode(page, right, &split);
+            Page* target = child_key < split.promoted_key ? page : right;
+            adapter_->insertIntoInternal(target, child_key, child_sibling);
+            adapter_->updateStatistics(target);
+
+            needs_split = true;
+            out_promoted_key = split.promoted_key;
+            out_new_sibling_id = right_id;
+            bpm_->UnpinPage(right_id, true);
+        }
+        else {
+            adapter_->updateStatistics(page);
+        }
+
+        bpm_->UnpinPage(page_id, true);
+        return page_id;
+    }
+
+    // =================================================================
+    // Read Path
+    // =================================================================
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicVersionManager<KeyT, PageSize>::lookup(version_t version, const KeyT& key, ValueType* out_val) {
+        int64_t filter_key = KeyTraits<KeyT>::filterKey(key);
+        page_id_t page_id = getRoot(version);
+        while (page_id != INVALID_PAGE_ID) {
+            // Internal pages have no filter, so this only ever rules out a leaf.
+            if (leaf_filter_ != nullptr && !leaf_filter_->mayContain(page_id, filter_key)) {
+                return false;
+            }
+            Page* page = bpm_->FetchPage(page_id);
+            if (page == nullptr) {
+                return false;
+            }
+            if (adapter_->isLeaf(page)) {
+                bool found = adapter_->lookupInLeaf(page, key, out_val);
+                bpm_->UnpinPage(page_id, false);
+                return found;
+            }
+            page_id_t child_id = adapter_->findChild(page, key);
+            bpm_->UnpinPage(page_id, false);
+            page_id = child_id;
+        }
+        return false;
+    }
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicVersionManager<KeyT, PageSize>::scan(version_t version, const KeyT& start_key, size_t max_count, std::vector<Entry>* out) {
+        page_id_t root = getRoot(version);
+        if (root == INVALID_PAGE_ID || max_count == 0) {
+            return true;
+        }
+        bool done = false;
+        return scanNode(root, start_key, nullptr, out->size() + max_count, out, done);
+    }
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicVersionManager<KeyT, PageSize>::scanRange(version_t version, const KeyT& start_key, const KeyT& end_key, size_t max_count, std::vector<Entry>* out) {
+        page_id_t root = getRoot(version);
+        if (root == INVALID_PAGE_ID || max_count == 0 || end_key < start_key) {
+            return true;
+        }
+        bool done = false;
+        return scanNode(root, start_key, &end_key, out->size() + max_count, out, done);
+    }
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicVersionManager<KeyT, PageSize>::scanRangeReverse(version_t version, const KeyT& start_key, const KeyT& end_key, size_t max_count, std::vector<Entry>* out) {
+        page_id_t root = getRoot(version);
+        if (root == INVALID_PAGE_ID || max_count == 0 || end_key < start_key) {
+            return true;
+        }
+        bool done = false;
+        return scanNodeReverse(root, start_key, end_key, out->size() + max_count, out, done);
+    }
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicVersionManager<KeyT, PageSize>::filteredOut(page_id_t page_id, const KeyT& start_key, const KeyT* end_key) {
+        // A range within one filter key (e.g. one resource's timeline) can skip filtered leaves.
+        if (leaf_filter_ == nullptr || end_key == nullptr) {
+            return false;
+        }
+        int64_t filter_key = KeyTraits<KeyT>::filterKey(start_key);
+        return filter_key == KeyTraits<KeyT>::filterKey(*end_key) && !leaf_filter_->mayContain(page_id, filter_key);
+    }
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicVersionManager<KeyT, PageSize>::scanNode(page_id_t page_id, const KeyT& start_key, const KeyT* end_key, size_t max_count, std::vector<Entry>* out, bool& done) {
+        if (filteredOut(page_id, start_key, end_key)) {
+            return true;
+        }
+
+        Page* page = bpm_->FetchPage(page_id);
+        if (page == nullptr) {
+            return false;
+        }
+
+        if (adapter_->isLeaf(page)) {
+            int count = adapter_->getCount(page);
+            for (int i = adapter_->lowerBoundInLeaf(page, start_key); i < count; ++i) {
+                KeyT key = adapter_->getKeyAt(page, i);
+                if (out->size() >= max_count || (end_key != nullptr && *end_key < key)) {
+                    done = true;
+                    break;
+                }
+                out->emplace_back(key, adapter_->getValueAt(page, i));
+            }
+            bpm_->UnpinPage(page_id, false);
+            return true;
+        }
+
+        // Leaf sibling links are not maintained across versions, so walk the tree instead.
+        // Copy the child list and unpin first, so only one page is pinned at a time.
+        // Children right of the one covering end_key cannot hold keys in range.
+        int first = adapter_->findChildIndex(page, start_key);
+        int last = end_key != nullptr ? adapter_->findChildIndex(page, *end_key) : adapter_->getCount(page);
+        std::vector<page_id_t> children;
+        children.reserve(last - first + 1);
+        for (int i = first; i <= last; ++i) {
+            children.push_back(adapter_->getChildAt(page, i));
+        }
+        bpm_->UnpinPage(page_id, false);
+
+        for (page_id_t child_id : children) {
+            if (done || out->size() >= max_count) {
+                break;
+            }
+            if (!scanNode(child_id, start_key, end_key, max_count, out, done)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicVersionManager<KeyT, PageSize>::scanNodeReverse(page_id_t page_id, const KeyT& start_key, const KeyT& end_key, size_t max_count, std::vector<Entry>* out, bool& done) {
+        if (filteredOut(page_id, start_key, &end_key)) {
+            return true;
+        }
+
+        Page* page = bpm_->FetchPage(page_id);
+        if (page == nullptr) {
+            return false;
+        }
+
+        if (adapter_->isLeaf(page)) {
+            // Last entry <= end_key: the lower bound itself if it equals end_key, else the one before.
+            int count = adapter_->getCount(page);
+            int i = adapter_->lowerBoundInLeaf(page, end_key);
+            if (i == count || end_key < adapter_->getKeyAt(page, i)) {
+                --i;
+            }
+            for (; i >= 0; --i) {
+                KeyT key = adapter_->getKeyAt(page, i);
+                if (out->size() >= max_count || key < start_key) {
+                    done = true;
+                    break;
+                }
+                out->emplace_back(key, adapter_->getValueAt(page, i));
+            }
+            bpm_->UnpinPage(page_id, false);
+            return true;
+        }
+
+        // Without sibling links the parent stack is the recursion: children are visited right
+        // to left, from the one covering end_key down to the one covering start_key.
+        int first = adapter_->findChildIndex(page, start_key);
+        int last = adapter_->findChildIndex(page, end_key);
+        std::vector<page_id_t> children;
+        children.reserve(last - first + 1);
+        for (int i = last; i >= first; --i) {
+            children.push_back(adapter_->getChildAt(page, i));
+        }
+        bpm_->UnpinPage(page_id, false);
+
+        for (page_id_t child_id : children) {
+            if (done || out->size() >= max_count) {
+                break;
+            }
+            if (!scanNodeReverse(child_id, start_key, end_key, max_count, out, done)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicVersionManager<KeyT, PageSize>::scanRanges(version_t version, std::vector<std::pair<KeyT, KeyT>> ranges, std::vector<Entry>* out) {
+        page_id_t root = getRoot(version);
+        ranges.erase(std::remove_if(ranges.begin(), ranges.end(), [](const auto& r) { return r.second < r.first; }), ranges.end());
+        if (root == INVALID_PAGE_ID || ranges.empty()) {
+            return true;
+        }
+
+        // Sort by start and merge overlapping ranges, so every key is returned once.
+        std::sort(ranges.begin(), ranges.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        size_t merged = 0;
+        for (size_t i = 1; i < ranges.size(); ++i) {
+            if (ranges[i].first <= ranges[merged].second) {
+                ranges[merged].second = std::max(ranges[merged].second, ranges[i].second);
+            }
+            else {
+                ranges[++merged] = ranges[i];
+            }
+        }
+        ranges.resize(merged + 1);
+        return scanNodeRanges(root, ranges, 0, ranges.size(), out);
+    }
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicVersionManager<KeyT, PageSize>::scanNodeRanges(page_id_t page_id, const std::vector<std::pair<KeyT, KeyT>>& ranges, size_t first, size_t last, std::vector<Entry>* out) {
+        // Skip the page only if the filter rules it out for every range it was asked for.
+        bool any = false;
+        for (size_t r = first; r < last && !any; ++r) {
+            any = !filteredOut(page_id, ranges[r].first, &ranges[r].second);
+        }
+        if (!any) {
+            return true;
+        }
+
+        Page* page = bpm_->FetchPage(page_id);
+        if (page == nullptr) {
+            return false;
+        }
+
+        if (adapter_->isLeaf(page)) {
+            int count = adapter_->getCount(page);
+            for (size_t r = first; r < last; ++r) {
+                for (int i = adapter_->lowerBoundInLeaf(page, ranges[r].first); i < count; ++i) {
+                    KeyT key = adapter_->getKeyAt(page, i);
+                    if (ranges[r].second < key) {
+                        break;
+                    }
+                    out->emplace_back(key, adapter_->getValueAt(page, i));
+                }
+            }
+            bpm_->UnpinPage(page_id, false);
+            return true;
+        }
+
+        // Children in order, each with the slice of ranges overlapping it. Ranges are sorted and
+        // disjoint, so their child spans are non-decreasing and each child's slice is contiguous.
+        struct Visit {
+            int child_index;
+            page_id_t child_id;
+            size_t first;
+            size_t last;
+        };
+        std::vector<Visit> visits;
+        for (size_t r = first; r < last; ++r) {
+            int lo = adapter_->findChildIndex(page, ranges[r].first);
+            int hi = adapter_->findChildIndex(page, ranges[r].second);
+            for (int c = lo; c <= hi; ++c) {
+                if (!visits.empty() && visits.back().child_index == c) {
+                    visits.back().last = r + 1;
+                }
+                else {
+                    visits.push_back({ c, adapter_->getChildAt(page, c), r, r + 1 });
+                }
+            }
+        }
+        bpm_->UnpinPage(page_id, false);
+
+        for (const Visit& visit : visits) {
+            if (!scanNodeRanges(visit.child_id, ranges, visit.first, visit.last, out)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // =================================================================
+    // Leaf Filters
+    // =================================================================
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicVersionManager<KeyT, PageSize>::buildLeafFilters(version_t version) {
+        VersionInfo* info = findVersion(version);
+        if (leaf_filter_ == nullptr || info == nullptr || info->state != VersionState::Committed) {
+            return false;
+        }
+        page_id_t root = getRoot(version);
+        return root == INVALID_PAGE_ID || registerLeaves(root, true);
+    }
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicVersionManager<KeyT, PageSize>::registerLeaves(page_id_t page_id, bool recurse) {
+        if (leaf_filter_->hasLeaf(page_id)) {
+            return true;
+        }
+        Page* page = bpm_->FetchPage(page_id);
+        if (page == nullptr) {
+            return false;
+        }
+
+        if (adapter_->isLeaf(page)) {
+            // Keys are sorted, so equal filter keys are adjacent.
+            std::vector<int64_t> filter_keys;
+            int count = adapter_->getCount(page);
+            for (int i = 0; i < count; ++i) {
+                int64_t filter_key = KeyTraits<KeyT>::filterKey(adapter_->getKeyAt(page, i));
+                if (filter_keys.empty() || filter_keys.back() != filter_key) {
+                    filter_keys.push_back(filter_key);
+                }
+            }
+            bpm_->UnpinPage(page_id, false);
+            return leaf_filter_->addLeaf(page_id, filter_keys);
+        }
+
+        std::vector<page_id_t> children;
+        if (recurse) {
+            for (int i = 0; i <= adapter_->getCount(page); ++i) {
+                children.push_back(adapter_->getChildAt(page, i));
+            }
+        }
+        bpm_->UnpinPage(page_id, false);
+
+        for (page_id_t child_id : children) {
+            if (!registerLeaves(child_id, true)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // =================================================================
+    // Statistics
+    // =================================================================
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicVersionManager<KeyT, PageSize>::estimateRange(version_t version, const KeyT& start_key, const KeyT& end_key, RangeEstimate* out) {
+        *out = RangeEstimate();
+        page_id_t root = getRoot(version);
+        if (root == INVALID_PAGE_ID || end_key < start_key) {
+            return true;
+        }
+
+        std::vector<LevelSample> levels;
+        if (!estimateNode(root, start_key, end_key, true, true, 0, &levels, out)) {
+            return false;
+        }
+
+        // Size the covered subtrees bottom-up: a leaf holds density * capacity keys, an
+        // internal node density * capacity + 1 children.
+        double capacity = adapter_->getCapacity();
+        double entries_below = 0;
+        double leaves_below = 0;
+        for (size_t d = levels.size(); d-- > 0;) {
+            const LevelSample& level = levels[d];
+            double density = level.nodes > 0 ? level.density_sum / level.nodes : 0.0;
+            if (d + 1 == levels.size()) {
+                entries_below = density * capacity;
+                leaves_below = 1;
+            }
+            else if (d > 0) {
+                double fanout = density * capacity + 1;
+                entries_below *= fanout;
+                leaves_below *= fanout;
+            }
+            out->entries += level.covered * entries_below;
+            out->leaf_pages += level.covered * leaves_below;
+        }
+        return true;
+    }
+
+    template <typename KeyT, size_t PageSize>
+    bool BasicVersionManager<KeyT, PageSize>::estimateNode(page_id_t page_id, const KeyT& start_key, const KeyT& end_key, bool left_edge, bool right_edge, size_t depth, std::vector<LevelSample>* levels, RangeEstimate* out) {
+        Page* page = bpm_->FetchPage(page_id);
+        if (page == nullptr) {
+            return false;
+        }
+        out->pages_read++;
+        if (levels->size() <= depth) {
+            levels->resize(depth + 1);
+        }
+        LevelSample& level = (*levels)[depth];
+        level.density_sum += adapter_->getDensity(page);
+        level.nodes++;
+
+        if (adapter_->isLeaf(page)) {
+            int count = adapter_->getCount(page);
+            int in_range = 0;
+            for (int i = adapter_->lowerBoundInLeaf(page, start_key); i < count && !(end_key < adapter_->getKeyAt(page, i)); ++i) {
+                in_range++;
+            }
+            bpm_->UnpinPage(page_id, false);
+            out->entries += in_range;
+            out->leaf_pages += in_range > 0 ? 1 : 0;
+            out->height = static_cast<int>(depth) + 1;
+            return true;
+        }
+
+        // Once the height is known, a subtree outside the range contributes nothing. Before
+        // that it is still descended, since the levels below it must be sampled.
+        if (out->height > 0 && adapter_->shouldSkip(page, start_key, end_key)) {
+            bpm_->UnpinPage(page_id, false);
+            return true;
+        }
+
+        // Off the left (right) boundary path every child left (right) of the boundary child is
+        // inside the range, so only the child holding the boundary key is descended.
+        int first = left_edge ? adapter_->findChildIndex(page, start_key) : 0;
+        int last = right_edge ? adapter_->findChildIndex(page, end_key) : adapter_->getCount(page);
+        page_id_t first_child = adapter_->getChildAt(page, first);
+        page_id_t last_child = adapter_->getChildAt(page, last);
+        bpm_->UnpinPage(page_id, false);
+
+        if (levels->size() <= depth + 1) {
+            levels->resize(depth + 2);
+        }
+        if (first == last) {
+            return estimateNode(first_child, start_key, end_key, left_edge, right_edge, depth + 1, levels, out);
+        }
+        uint64_t covered = static_cast<uint64_t>(last - first + 1) - (left_edge ? 1 : 0) - (right_edge ? 1 : 0);
+        (*levels)[depth + 1].covered += covered;
+        if (left_edge && !estimateNode(first_child, start_key, end_key, true, false, depth + 1, levels, out)) {
+            return false;
+        }
+        return !right_edge || estimateNode(last_child, start_key, end_key, false, true, depth + 1, levels, out);
+    }
+
+    // =================================================================
+    // Instantiations
+    // =================================================================
+
+#define CMSE_INSTANTIATE_VERSION_MANAGERS(size) \
+    template class BasicVersionManager<KeyType, size>; \
+    template class BasicVersionManager<ResourceTimeKey, size>; \
+    template class BasicVersionManager<RollupKey, size>;
+    CMSE_FOR_EACH_PAGE_SIZE(CMSE_INSTANTIATE_VERSION_MANAGERS)
+#undef CMSE_INSTANTIATE_VERSION_MANAGERS
+
+} // namespace cmse::versioning
@@ -1,7 +1,11 @@
 #pragma once
 #include "../common/types.h"
 #include "../adapter/bpm_adapter.h"
+#include "../adapter/leaf_filter.h"
 #include "../adapter/tree_adapter.h"
+#include <map>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 namespace cmse::versioning {
@@ -10,17 +14,61 @@ namespace cmse::versioning {
      * VersionManager
      * Manages version lifecycles, Copy-on-Write (CoW) logic, and commit operations.
      * It acts as the coordinator between the Buffer Pool and the Index Adapters.
+     *
+     * Every version owns the pages it created (PageHeader::creation_version). Pages owned by
+     * the version being written are modified in place; any other page is copied first, so the
+     * pages of committed versions are immutable and can be read without further locking.
+     *
+     * Thread safety: the version table is internally synchronized. Each active version must be
+     * written (and read) by one thread at a time. Committed versions may be read concurrently
+     * with writers. Two versions derived from the same base are not merged: the last commit wins.
+     *
+     * An optional adapter::LeafFilter lets lookups skip leaves that cannot hold the key: the
+     * leaves of a version are registered when it commits, and point lookups and scans over a
+     * single filter key (KeyTraits::filterKey, e.g. one resource's timeline) consult it before
+     * fetching a leaf.
+     *
+     * KeyT is the index key (see adapter::BasicTreeAdapter) and PageSize the page size of the
+     * pool the tree lives in; instantiated for KeyType, ResourceTimeKey and RollupKey on every
+     * CMSE_FOR_EACH_PAGE_SIZE in version_manager.cpp.
      */
-    class VersionManager {
+    template <typename KeyT, size_t PageSize = PAGE_SIZE>
+    class BasicVersionManager {
     public:
-        VersionManager(adapter::BufferPoolAdapter* bpm, adapter::TreeAdapter* tree_adapter);
+        using Page = BasicPage<PageSize>;
+        using BufferPoolAdapter = adapter::BasicBufferPoolAdapter<PageSize>;
+        using TreeAdapter = adapter::BasicTreeAdapter<KeyT, PageSize>;
+        using Entry = std::pair<KeyT, ValueType>;
+
+        // Size of a key range as estimated from node statistics (see estimateRange).
+        struct RangeEstimate {
+            double entries = 0;         // Keys in the range
+            double leaf_pages = 0;      // Leaves holding them
+            int height = 0;             // Levels of the tree (1 = the root is a leaf)
+            uint32_t pages_read = 0;    // Pages fetched to compute the estimate
+        };
+
+        BasicVersionManager(BufferPoolAdapter* bpm, TreeAdapter* tree_adapter);
+
+        // Leaf filter consulted before fetching leaves (not owned; nullptr disables). Set it before
+        // any concurrent use. Leaves of versions committed afterwards are registered on commit.
+        void setLeafFilter(adapter::LeafFilter* filter);
+
+        // Registers the leaves of a committed version that have no filter yet (a tree committed
+        // before the filter was set, or reopened after a restart). Walks the whole tree.
+        // Returns false if the version is not committed or a page could not be fetched.
+        bool buildLeafFilters(version_t version);
 
         // Starts a new version transaction and returns the version ID.
         version_t createVersion();
 
         // Applies a logical update (Insert/Update) within the context of a version.
         // This handles traversal, CoW page allocation, and split propagation.
-        bool applyUpdate(version_t version, version_t base_version, const KeyType& key, const ValueType& val);
+        // The first update of a version fixes its base; later base_version arguments are ignored.
+        // Pass INVALID_VERSION as base to start from an empty tree.
+        // Returns false if the version is not active or the buffer pool ran out of frames;
+        // after a buffer pool failure the version may be incomplete and should be aborted.
+        bool applyUpdate(version_t version, version_t base_version, const KeyT& key, const ValueType& val);
 
         // Commits the version, making it persistent and visible.
         bool commitVersion(version_t version);
@@ -29,15 +77,115 @@ namespace cmse::versioning {
         void abortVersion(version_t version);
 
         // Helper to read a page (mostly for testing/debugging).
+        // Returns the page pinned (caller unpins), or nullptr if it does not belong to 'version'.
         Page* readPage(page_id_t page_id, version_t version);
 
+        // --- Read Path ---
+
+        // Most recently committed version (INVALID_VERSION before the first commit).
+        version_t latestVersion();
+
+        // Root page of a version (INVALID_PAGE_ID for an empty tree or unknown version).
+        page_id_t getRoot(version_t version);
+
+        // Point lookup in the snapshot of 'version'. Returns false if the key is absent.
+        bool lookup(version_t version, const KeyT& key, ValueType* out_val);
+
+        // Appends up to 'max_count' entries with key >= start_key, in key order.
+        // Returns false if a page could not be fetched (the output then holds a prefix).
+        bool scan(version_t version, const KeyT& start_key, size_t max_count, std::vector<Entry>* out);
+
+        // Appends up to 'max_count' entries with start_key <= key <= end_key, in key order.
+        // Subtrees entirely outside the range are never fetched. For ResourceTimeKey,
+        // [prefixBegin(r), prefixEnd(r)] yields the whole timeline of resource r.
+        bool scanRange(version_t version, const KeyT& start_key, const KeyT& end_key, size_t max_count, std::vector<Entry>* out);
+
+        // Like scanRange, but in descending key order starting at end_key: the last 'max_count'
+        // entries of the range (top-K by key, e.g. the latest events of one resource) are read
+        // from the rightmost leaves only. Continue a long range from predecessor(last key).
+        bool scanRangeReverse(version_t version, const KeyT& start_key, const KeyT& end_key, size_t max_count, std::vector<Entry>* out);
+
+        // Batched scanRange over many key ranges (an index-to-index join, e.g. the resource ids a
+        // name prefix resolved to in the trie). The ranges are sorted and overlaps merged, then one
+        // walk of the tree serves all of them: a node shared by several ranges is fetched once and
+        // leaves are read left to right. Appends every entry in range, in key order.
+        bool scanRanges(version_t version, std::vector<std::pair<KeyT, KeyT>> ranges, std::vector<Entry>* out);
+
+        // Estimates the size of [start_key, end_key] without scanning it: only the two boundary
+        // paths are descended (fewer than 2 * height pages). Boundary leaves are counted exactly;
+        // subtrees strictly between the paths are sized from the density of the nodes seen on
+        // each level, and min/max stats prune boundary subtrees that cannot overlap the range.
+        bool estimateRange(version_t version, const KeyT& start_key, const KeyT& end_key, RangeEstimate* out);
+
     private:
-        adapter::BufferPoolAdapter* bpm_;
-        adapter::TreeAdapter* adapter_;
+        enum class VersionState { Active, Committed, Aborted };
+
+        struct VersionInfo {
+            VersionState state = VersionState::Active;
+            bool has_base = false;
+            page_id_t root = INVALID_PAGE_ID;
+            std::vector<page_id_t> staged_pages; // Pages created by this version (flushed on commit)
+        };
+
+        BufferPoolAdapter* bpm_;
+        TreeAdapter* adapter_;
+        adapter::LeafFilter* leaf_filter_ = nullptr;
+
+        // Version table. std::map keeps VersionInfo addresses stable while other versions are created.
+        std::mutex latch_;
+        std::map<version_t, VersionInfo> versions_;
+        version_t next_version_ = 1; // 0 is the creation_version of pages written outside any version
+        version_t latest_committed_ = INVALID_VERSION;
+
+        VersionInfo* findVersion(version_t version);
+
+        // Allocates a page owned by version 'v'. Returns it pinned, or nullptr if the pool is full.
+        Page* allocatePage(version_t v, VersionInfo* info, page_id_t* out_page_id);
+
+        // Returns a pinned, writable page for 'page_id' in version 'v' (the page itself or a CoW copy).
+        Page* makeWritable(version_t v, VersionInfo* info, page_id_t page_id, page_id_t* out_page_id);
+
+        // Appends entries >= start_key (and <= *end_key if non-null) from the subtree at 'page_id'.
+        // Sets 'done' once a key past the end was seen or 'max_count' is reached.
+        bool scanNode(page_id_t page_id, const KeyT& start_key, const KeyT* end_key, size_t max_count, std::vector<Entry>* out, bool& done);
+
+        // Mirror of scanNode: appends entries <= end_key and >= start_key in descending order.
+        bool scanNodeReverse(page_id_t page_id, const KeyT& start_key, const KeyT& end_key, size_t max_count, std::vector<Entry>* out, bool& done);
+
+        // Appends the entries of ranges[first, last) (sorted, disjoint) from the subtree at 'page_id'.
+        bool scanNodeRanges(page_id_t page_id, const std::vector<std::pair<KeyT, KeyT>>& ranges, size_t first, size_t last, std::vector<Entry>* out);
+
+        // True if the leaf filter rules out every leaf under 'page_id' for [start_key, end_key].
+        bool filteredOut(page_id_t page_id, const KeyT& start_key, const KeyT* end_key);
+
+        // Adds the filter keys of 'page_id' to the leaf filter if it is a leaf; with 'recurse',
+        // does so for every leaf below it that has no filter yet.
+        bool registerLeaves(page_id_t page_id, bool recurse);
+
+        // Per-level samples of estimateRange: density of the visited nodes and the number of
+        // subtrees rooted on this level that lie entirely inside the range.
+        struct LevelSample {
+            double density_sum = 0;
+            uint32_t nodes = 0;
+            uint64_t covered = 0;
+        };
+        // 'left_edge'/'right_edge': the node lies on the start_key/end_key boundary path.
+        bool estimateNode(page_id_t page_id, const KeyT& start_key, const KeyT& end_key, bool left_edge, bool right_edge, size_t depth, std::vector<LevelSample>* levels, RangeEstimate* out);
 
         // Internal helper to handle recursive updates and splits
-        // Returns the new page ID of the current node (if it changed/copied)
-        page_id_t recursiveUpdate(version_t v, page_id_t current_page_id, const KeyType& key, const ValueType& val, bool& needs_split, KeyType& out_promoted_key, page_id_t& out_new_sibling_id);
+        // Returns the new page ID of the current node (if it changed/copied), INVALID_PAGE_ID on failure
+        page_id_t recursiveUpdate(version_t v, VersionInfo* info, page_id_t current_page_id, const KeyT& key, const ValueType& val, bool& needs_split, KeyT& out_promoted_key, page_id_t& out_new_sibling_id);
     };
 
-} // namespace cmse::versioning
\ No newline at end of file
+#define CMSE_EXTERN_VERSION_MANAGERS(size) \
+    extern template class BasicVersionManager<KeyType, size>; \
+    extern template class BasicVersionManager<ResourceTimeKey, size>; \
+    extern template class BasicVersionManager<RollupKey, size>;
+    CMSE_FOR_EACH_PAGE_SIZE(CMSE_EXTERN_VERSION_MANAGERS)
+#undef CMSE_EXTERN_VERSION_MANAGERS
+
+    using VersionManager = BasicVersionManager<KeyType>;
+    using CompositeVersionManager = BasicVersionManager<ResourceTimeKey>;
+    using RollupVersionManager = BasicVersionManager<RollupKey>;
+
+} // namespace cmse::versioning
@@ -0,0 +1,151 @@
+/**
+ * access_trace_test.cpp
+ *
+ * Verifies access-trace recording and offline replay:
+ * 1. BufferPoolManager records the expected events (op, page, hit flag).
+ * 2. The ring buffer keeps only the most recent records.
+ * 3. Trace files round-trip through WriteTraceFile / ReadTraceFile.
+ * 4. The single-pass Mattson LRU curve matches a real LRUReplacer simulation.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <filesystem>
+
+#include "../src/bufferpool/buffer_pool_manager.h"
+#include "../src/bufferpool/trace_replay.h"
+
+using namespace cmse::bufferpool;
+
+const std::string DB_FILE = "test_trace.db";
+const std::string TRACE_FILE = "test_trace.bin";
+
+void Cleanup() {
+    std::filesystem::remove(DB_FILE);
+    std::filesystem::remove(TRACE_FILE);
+}
+
+void Log(const std::string& msg) {
+    std::cout << "[TRACE_TEST] " << msg << std::endl;
+}
+
+void Assert(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "!!! FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+// 1 + 3. Recording from the buffer pool, saved and reloaded.
+void TestRecordAndRoundTrip() {
+    Log("--- Test 1: Record & Round Trip ---");
+    Cleanup();
+
+    auto* disk_manager = new cmse::disk::DiskManager(DB_FILE);
+    auto* bpm = new BufferPoolManager(2, disk_manager);
+
+    cmse::page_id_t pid;
+    bpm->NewPage(pid);            // not traced yet
+    bpm->UnpinPage(pid, true);
+
+    Assert(!bpm->SaveAccessTrace(TRACE_FILE), "SaveAccessTrace must fail while tracing is off");
+
+    bpm->EnableAccessTrace(64);
+    bpm->FetchPage(0);            // hit
+    bpm->UnpinPage(0, false);
+    bpm->NewPage(pid);            // page 1
+    bpm->UnpinPage(pid, true);
+    bpm->NewPage(pid);            // page 2, evicts page 0
+    bpm->UnpinPage(pid, false);
+    bpm->FetchPage(0);            // miss
+    bpm->UnpinPage(0, false);
+    bpm->FlushPage(0);
+
+    auto trace = bpm->GetAccessTrace();
+    Assert(trace.size() == 9, "expected 9 records, got " + std::to_string(trace.size()));
+    Assert(trace[0].op == TraceOp::Fetch && trace[0].page_id == 0 && (trace[0].flags & TRACE_FLAG_HIT), "record 0");
+    Assert(trace[1].op == TraceOp::Unpin && !(trace[1].flags & TRACE_FLAG_DIRTY), "record 1");
+    Assert(trace[2].op == TraceOp::New && trace[2].page_id == 1, "record 2");
+    Assert(trace[3].op == TraceOp::Unpin && (trace[3].flags & TRACE_FLAG_DIRTY), "record 3");
+    Assert(trace[6].op == TraceOp::Fetch && trace[6].page_id == 0 && !(trace[6].flags & TRACE_FLAG_HIT), "record 6");
+    Assert(trace[8].op == TraceOp::Flush, "record 8");
+    for (size_t i = 1; i < trace.size(); ++i) {
+        Assert(trace[i].timestamp_ns >= trace[i - 1].timestamp_ns, "timestamps must be monotonic");
+    }
+
+    Assert(bpm->SaveAccessTrace(TRACE_FILE), "SaveAccessTrace failed");
+    auto loaded = ReadTraceFile(TRACE_FILE);
+    Assert(loaded.size() == trace.size(), "round trip size");
+    for (size_t i = 0; i < trace.size(); ++i) {
+        Assert(loaded[i].page_id == trace[i].page_id && loaded[i].op == trace[i].op
+            && loaded[i].timestamp_ns == trace[i].timestamp_ns, "round trip record " + std::to_string(i));
+    }
+
+    bpm->DisableAccessTrace();
+    Assert(bpm->GetAccessTrace().empty(), "trace must be empty after DisableAccessTrace");
+
+    delete bpm;
+    delete disk_manager;
+    Cleanup();
+
+    Log(">>> PASSED: Record & Round Trip.");
+}
+
+// 2. Ring buffer wrap-around.
+void TestRingBuffer() {
+    Log("--- Test 2: Ring Buffer ---");
+
+    AccessTraceRecorder recorder(5); // rounded up to 8
+    Assert(recorder.Capacity() == 8, "capacity rounds up to a power of two");
+
+    for (int i = 0; i < 20; ++i) {
+        recorder.Record(TraceOp::Fetch, i);
+    }
+    auto snap = recorder.Snapshot();
+    Assert(snap.size() == 8, "ring keeps capacity records");
+    Assert(snap.front().page_id == 12 && snap.back().page_id == 19, "ring keeps the newest records");
+    Assert(recorder.TotalRecorded() == 20, "total recorded");
+
+    Log(">>> PASSED: Ring Buffer.");
+}
+
+// 4. Mattson single pass == real LRUReplacer simulation, for every size.
+void TestMattsonMatchesReplacer() {
+    Log("--- Test 3: Mattson vs LRUReplacer ---");
+
+    std::mt19937 rng(99);
+    std::vector<cmse::page_id_t> accesses;
+    for (int i = 0; i < 20000; ++i) {
+        // Skewed: half the accesses to 16 hot pages, the rest over 512 pages.
+        accesses.push_back(static_cast<cmse::page_id_t>((rng() % 2 == 0) ? rng() % 16 : rng() % 512));
+    }
+
+    auto sizes = DefaultCacheSizes(CountDistinctPages(accesses));
+    auto exact = ComputeLruMissRatioCurve(accesses, sizes);
+    auto simulated = SimulateMissRatioCurve<LRUReplacer>(accesses, sizes);
+
+    double previous = 1.1;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        Log("size " + std::to_string(sizes[i]) + ": mattson=" + std::to_string(exact[i].miss_ratio)
+            + " replacer=" + std::to_string(simulated[i].miss_ratio));
+        Assert(std::fabs(exact[i].miss_ratio - simulated[i].miss_ratio) < 1e-12, "curves differ");
+        Assert(exact[i].miss_ratio <= previous, "LRU miss ratio must be non-increasing in cache size");
+        previous = exact[i].miss_ratio;
+    }
+
+    // Once everything fits, only cold misses remain.
+    double cold = static_cast<double>(CountDistinctPages(accesses)) / accesses.size();
+    Assert(std::fabs(exact.back().miss_ratio - cold) < 1e-12, "largest size should only see cold misses");
+
+    Log(">>> PASSED: Mattson vs LRUReplacer.");
+}
+
+int main() {
+    TestRecordAndRoundTrip();
+    TestRingBuffer();
+    TestMattsonMatchesReplacer();
+    return 0;
+}
@@ -0,0 +1,235 @@
+/**
+ * bitmap_index_test.cpp
+ *
+ * Verifies the LogStore ingest path and the event_type bitmap index:
+ * 1. Records appended to the LogStore read back by id; zone-map time ranges are exact.
+ * 2. The index is maintained on ingest and answers "ERROR or RESTART within a window"
+ *    exactly like a full scan.
+ * 3. Flushed bitmaps reload from their pages (including an incremental re-flush).
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+#include <random>
+#include <cstring>
+#include <filesystem>
+
+#include "../src/bufferpool/buffer_pool_adapter.h"
+#include "../src/index/bitmap_index.h"
+#include "../src/storage/log_store.h"
+#include "../src/utils/log_manager.h"
+
+using namespace cmse;
+using index::BitmapIndex;
+using index::RoaringBitmap;
+using storage::LogStore;
+
+const std::string DB_FILE = "test_bitmap_index.db";
+
+void Cleanup() {
+    std::filesystem::remove(DB_FILE);
+}
+
+void Log(const std::string& msg) {
+    std::cout << "[BITMAP_TEST] " << msg << std::endl;
+}
+
+void Assert(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "!!! FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+const std::vector<std::string> EVENTS = { "START", "STOP", "RESTART", "ERROR", "WARNING", "DEPLOY" };
+
+// Synthetic logs with a skewed, shuffled event mix (ERROR is rare, START is common).
+std::vector<LogRecord> MakeLogs(int count, unsigned seed) {
+    auto logs = utils::LogManager::generateSyntheticLogs(count);
+    std::mt19937 rng(seed);
+    std::discrete_distribution<int> pick({ 40, 25, 10, 3, 15, 7 });
+    for (auto& record : logs) {
+        const std::string& type = EVENTS[pick(rng)];
+        std::memset(record.event_type, 0, sizeof(record.event_type));
+        std::memcpy(record.event_type, type.data(), type.size());
+    }
+    return logs;
+}
+
+struct Stack {
+    disk::DiskManager disk;
+    bufferpool::BufferPoolManager bpm;
+    bufferpool::BufferPoolManagerAdapter bpm_adapter;
+
+    explicit Stack(size_t pool_size) : disk(DB_FILE), bpm(pool_size, &disk), bpm_adapter(&bpm) {}
+};
+
+// Expected answer by brute force.
+std::set<uint32_t> Scan(const std::vector<LogRecord>& logs, const std::set<std::string>& types, int64_t t1, int64_t t2) {
+    std::set<uint32_t> out;
+    for (size_t i = 0; i < logs.size(); ++i) {
+        int64_t ts = LogStore::timestampMillis(logs[i]);
+        if (types.count(BitmapIndex::eventTypeOf(logs[i])) && t1 <= ts && ts <= t2) {
+            out.insert(static_cast<uint32_t>(i));
+        }
+    }
+    return out;
+}
+
+void AssertSame(const RoaringBitmap& bitmap, const std::set<uint32_t>& expected, const std::string& what) {
+    Assert(bitmap.toVector() == std::vector<uint32_t>(expected.begin(), expected.end()), what);
+}
+
+// 1. Store round trip and time ranges.
+void TestLogStore() {
+    Log("--- Test 1: Log Store ---");
+    Cleanup();
+    {
+        Stack stack(32); // Far smaller than the data: reads go through eviction
+        LogStore store(&stack.bpm_adapter);
+        auto logs = MakeLogs(5000, 1);
+        for (size_t i = 0; i < logs.size(); ++i) {
+            Assert(store.append(logs[i]) == i, "record ids must be dense");
+        }
+        Assert(store.size() == logs.size(), "size");
+        Assert(store.pageCount() == (logs.size() + LogStore::RECORDS_PER_PAGE - 1) / LogStore::RECORDS_PER_PAGE, "page count");
+
+        for (record_id_t rid : { 0u, 41u, 42u, 4999u, 1234u }) {
+            LogRecord record;
+            Assert(store.get(rid, &record), "get failed");
+            Assert(record.resource_id == logs[rid].resource_id && record.timestamp == logs[rid].timestamp, "record mismatch");
+        }
+        LogRecord unused;
+        Assert(!store.get(5000, &unused), "get past the end must fail");
+
+        int64_t base = LogStore::timestampMillis(logs[0]);
+        RoaringBitmap window;
+        Assert(store.timeRange(base + 100, base + 2100, &window), "timeRange failed");
+        AssertSame(window, Scan(logs, { EVENTS.begin(), EVENTS.end() }, base + 100, base + 2100), "time range");
+
+        // Windows aligned with pages are answered from the zone map alone.
+        stack.bpm.ResetStats();
+        int64_t page_ms = static_cast<int64_t>(LogStore::RECORDS_PER_PAGE) * 100;
+        store.timeRange(base + page_ms, base + 10 * page_ms - 1, &window);
+        auto stats = stack.bpm.GetStats();
+        Assert(window.cardinality() == 9 * LogStore::RECORDS_PER_PAGE, "aligned window size");
+        Assert(stats.hits + stats.misses == 0, "aligned window should not read pages");
+    }
+    Cleanup();
+    Log(">>> PASSED: Log Store.");
+}
+
+// 2. Incremental maintenance and queries.
+void TestQueries() {
+    Log("--- Test 2: Queries ---");
+    Cleanup();
+    {
+        Stack stack(64);
+        LogStore store(&stack.bpm_adapter);
+        BitmapIndex bitmap_index(&stack.bpm_adapter);
+        store.addListener(&bitmap_index);
+
+        auto logs = MakeLogs(100000, 2);
+        for (const auto& record : logs) {
+            store.append(record);
+        }
+        Assert(bitmap_index.eventTypes().size() == EVENTS.size(), "all event types indexed");
+
+        uint64_t total = 0;
+        for (const auto& type : EVENTS) {
+            RoaringBitmap bitmap = bitmap_index.lookup(type);
+            AssertSame(bitmap, Scan(logs, { type }, INT64_MIN, INT64_MAX), "lookup " + type);
+            total += bitmap.cardinality();
+        }
+        Assert(total == logs.size(), "every record is in exactly one bitmap");
+        Assert(bitmap_index.lookup("UNKNOWN").empty(), "unknown type is empty");
+
+        int64_t base = LogStore::timestampMillis(logs[0]);
+        std::mt19937 rng(3);
+        for (int q = 0; q < 20; ++q) {
+            int64_t t1 = base + static_cast<int64_t>(rng() % 9000000);
+            int64_t t2 = t1 + static_cast<int64_t>(rng() % 2000000);
+            RoaringBitmap window;
+            Assert(store.timeRange(t1, t2, &window), "timeRange failed");
+
+            RoaringBitmap hits = bitmap_index.anyOf({ "ERROR", "RESTART" }, window);
+            AssertSame(hits, Scan(logs, { "ERROR", "RESTART" }, t1, t2), "ERROR|RESTART in window");
+            Assert(hits == (bitmap_index.anyOf({ "ERROR", "RESTART" }) & window), "filtered anyOf == anyOf & filter");
+
+            // Fetch the matching records through the store.
+            size_t fetched = 0;
+            Assert(store.forEach(hits, [&](record_id_t rid, const LogRecord& record) {
+                std::string type = BitmapIndex::eventTypeOf(record);
+                Assert(type == "ERROR" || type == "RESTART", "forEach returned a wrong record");
+                Assert(record.timestamp == logs[rid].timestamp, "forEach record mismatch");
+                ++fetched;
+            }), "forEach failed");
+            Assert(fetched == hits.cardinality(), "forEach count");
+        }
+
+        // Compressed: far below one uint32 per record.
+        Assert(bitmap_index.sizeInBytes() < logs.size() * sizeof(uint32_t) / 2, "bitmaps should compress");
+    }
+    Cleanup();
+    Log(">>> PASSED: Queries.");
+}
+
+// 3. Persistence.
+void TestPersistence() {
+    Log("--- Test 3: Persistence ---");
+    Cleanup();
+    {
+        Stack stack(16);
+        LogStore store(&stack.bpm_adapter);
+        BitmapIndex bitmap_index(&stack.bpm_adapter);
+        store.addListener(&bitmap_index);
+
+        auto logs = MakeLogs(60000, 4);
+        for (size_t i = 0; i < 30000; ++i) {
+            store.append(logs[i]);
+        }
+        page_id_t root = bitmap_index.flush();
+        Assert(root != INVALID_PAGE_ID, "first flush failed");
+
+        // Grow (bitmaps need longer chains) and flush again: same directory page.
+        for (size_t i = 30000; i < logs.size(); ++i) {
+            store.append(logs[i]);
+        }
+        Assert(bitmap_index.flush() == root, "re-flush should reuse the directory page");
+
+        BitmapIndex reloaded(&stack.bpm_adapter);
+        Assert(reloaded.load(root), "load failed");
+        Assert(reloaded.eventTypes() == bitmap_index.eventTypes(), "event types after reload");
+        for (const auto& type : EVENTS) {
+            Assert(reloaded.lookup(type) == bitmap_index.lookup(type), "bitmap after reload: " + type);
+        }
+
+        // The reloaded index keeps maintaining and persisting incrementally.
+        store.addListener(&reloaded);
+        LogRecord extra = logs[0];
+        std::memset(extra.event_type, 0, sizeof(extra.event_type));
+        std::memcpy(extra.event_type, "PANIC", 5);
+        record_id_t rid = store.append(extra);
+        Assert(reloaded.flush() == root, "flush of reloaded index");
+
+        BitmapIndex again(&stack.bpm_adapter);
+        Assert(again.load(root), "second load failed");
+        Assert(again.lookup("PANIC").toVector() == std::vector<uint32_t>{ rid }, "new type persisted");
+        Assert(again.lookup("ERROR") == reloaded.lookup("ERROR"), "old types intact");
+
+        Assert(!again.load(0), "loading a non-directory page (page 0 holds log records) must fail");
+    }
+    Cleanup();
+    Log(">>> PASSED: Persistence.");
+}
+
+int main() {
+    TestLogStore();
+    TestQueries();
+    TestPersistence();
+
+    Log("ALL BITMAP INDEX TESTS PASSED");
+    return 0;
+}
@@ -0,0 +1,212 @@
+/**
+ * buffer_pool_resize_test.cpp
+ *
+ * Verifies BufferPoolManager::ResizePool:
+ * 1. Growing adds free frames; shrinking writes dirty retired pages back and unmaps segments.
+ * 2. A pinned page in a retired frame stays valid until its last unpin, which drains it.
+ * 3. Shrink-then-grow reuses still-mapped frames; resident retired pages stay fetchable.
+ * 4. Fetches from other threads keep working (and see correct bytes) while the pool resizes.
+ */
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <filesystem>
+
+#include "../src/bufferpool/buffer_pool_manager.h"
+
+using cmse::bufferpool::BufferPoolManager;
+using cmse::page_id_t;
+
+const std::string DB_FILE = "test_resize.db";
+
+void Cleanup() {
+    std::filesystem::remove(DB_FILE);
+}
+
+void Log(const std::string& msg) {
+    std::cout << "[RESIZE_TEST] " << msg << std::endl;
+}
+
+void Assert(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "!!! FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+// Creates 'count' pages, each tagged with its index, and unpins them dirty.
+std::vector<page_id_t> WritePages(BufferPoolManager* bpm, size_t count) {
+    std::vector<page_id_t> ids;
+    for (size_t i = 0; i < count; ++i) {
+        page_id_t pid;
+        cmse::Page* page = bpm->NewPage(pid);
+        Assert(page != nullptr, "NewPage");
+        std::string tag = "page-" + std::to_string(i);
+        std::memcpy(page->GetData(), tag.c_str(), tag.size() + 1);
+        bpm->UnpinPage(pid, true);
+        ids.push_back(pid);
+    }
+    return ids;
+}
+
+bool HasTag(BufferPoolManager* bpm, page_id_t pid, size_t i) {
+    cmse::Page* page = bpm->FetchPage(pid);
+    if (page == nullptr) {
+        return false;
+    }
+    bool ok = std::string(page->GetData()) == "page-" + std::to_string(i);
+    bpm->UnpinPage(pid, false);
+    return ok;
+}
+
+void TestGrowShrink() {
+    Log("--- Test 1: Grow / Shrink ---");
+    Cleanup();
+    {
+        cmse::disk::DiskManager disk(DB_FILE);
+        BufferPoolManager bpm(16, &disk);
+        Assert(!bpm.ResizePool(0), "zero frames rejected");
+
+        Assert(bpm.ResizePool(300), "grow");
+        Assert(bpm.GetPoolSize() == 300, "pool size after grow");
+        auto stats = bpm.GetStats();
+        Assert(stats.pool_size == 300 && stats.mapped_frames == 300 && stats.free_frames == 300, "grown frames are free");
+
+        // Fill most of the pool; nothing should be evicted.
+        auto ids = WritePages(&bpm, 280);
+        Assert(bpm.GetStats().evictions_clean + bpm.GetStats().evictions_dirty == 0, "no eviction below capacity");
+
+        // Shrink: the grown segment's pages are written back and its memory released.
+        Assert(bpm.ResizePool(16), "shrink");
+        stats = bpm.GetStats();
+        Assert(stats.pool_size == 16 && stats.mapped_frames == 16, "segment released");
+        Assert(stats.resident_pages <= 16 && stats.dirty_frames <= 16, "resident pages fit the pool");
+        for (size_t i = 0; i < ids.size(); i += 7) {
+            Assert(HasTag(&bpm, ids[i], i), "data survives shrink (page " + std::to_string(i) + ")");
+        }
+    }
+    Cleanup();
+    Log(">>> PASSED: Grow / Shrink.");
+}
+
+void TestPinnedRetiredFrame() {
+    Log("--- Test 2/3: Pinned Retired Frames / Reuse ---");
+    Cleanup();
+    {
+        cmse::disk::DiskManager disk(DB_FILE);
+        BufferPoolManager bpm(8, &disk);
+        Assert(bpm.ResizePool(200), "grow");
+        auto ids = WritePages(&bpm, 150);
+
+        // Pin one page that lives in the grown segment, then shrink below it.
+        cmse::Page* pinned = bpm.FetchPage(ids[120]);
+        Assert(pinned != nullptr, "fetch pinned page");
+        Assert(bpm.ResizePool(8), "shrink with a pinned tail frame");
+        auto stats = bpm.GetStats();
+        Assert(stats.mapped_frames == 200, "segment kept while a frame is pinned");
+        Assert(stats.pinned_frames == 1, "one pinned frame");
+        Assert(std::string(pinned->GetData()) == "page-120", "pinned page stays valid");
+
+        // A second fetch of the retired page shares the frame.
+        Assert(bpm.FetchPage(ids[120]) == pinned, "fetch hits the retired frame");
+        Assert(bpm.UnpinPage(ids[120], false), "unpin 1");
+        Assert(bpm.GetStats().mapped_frames == 200, "still pinned once");
+        std::strcpy(pinned->GetData(), "page-120-v2");
+        Assert(bpm.UnpinPage(ids[120], true), "last unpin");
+        stats = bpm.GetStats();
+        Assert(stats.mapped_frames == 8 && stats.pinned_frames == 0, "last unpin drains and releases");
+
+        cmse::Page* page = bpm.FetchPage(ids[120]);
+        Assert(page != nullptr && std::string(page->GetData()) == "page-120-v2", "dirty retired page written back");
+        bpm.UnpinPage(ids[120], false);
+
+        // Shrink with a pin, then grow again before it drains: the mapped frames come back.
+        Assert(bpm.ResizePool(100), "grow 2");
+        pinned = bpm.FetchPage(ids[5]);
+        Assert(pinned != nullptr, "fetch");
+        Assert(bpm.GetStats().mapped_frames == 100, "mapped frames after grow 2");
+        Assert(bpm.ResizePool(4), "shrink 2");
+        Assert(bpm.ResizePool(120), "grow over retired frames");
+        stats = bpm.GetStats();
+        Assert(stats.pool_size == 120 && stats.mapped_frames == 120, "retired frames reused, one new segment");
+        Assert(bpm.UnpinPage(ids[5], false), "unpin reactivated frame");
+        Assert(bpm.GetStats().resident_pages >= 1 && bpm.GetStats().pinned_frames == 0, "frame rejoined the replacer");
+
+        // The reactivated pool evicts normally.
+        WritePages(&bpm, 200);
+        Assert(bpm.GetStats().resident_pages <= 120, "pool bounded after regrow");
+        for (size_t i = 0; i < ids.size(); i += 11) {
+            Assert(HasTag(&bpm, ids[i], i), "old page readable");
+        }
+    }
+    Cleanup();
+    Log(">>> PASSED: Pinned Retired Frames / Reuse.");
+}
+
+void TestConcurrentResize() {
+    Log("--- Test 4: Fetches During Resize ---");
+    Cleanup();
+    {
+        cmse::disk::DiskManager disk(DB_FILE);
+        BufferPoolManager bpm(64, &disk);
+        auto ids = WritePages(&bpm, 512);
+        bpm.FlushAllPages();
+
+        std::atomic<bool> stop{ false };
+        std::atomic<uint64_t> fetches{ 0 };
+        std::atomic<bool> failed{ false };
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 3; ++t) {
+            readers.emplace_back([&, t]() {
+                size_t i = static_cast<size_t>(t) * 101;
+                while (!stop.load()) {
+                    i = (i * 31 + 7) % ids.size();
+                    cmse::Page* page = bpm.FetchPage(ids[i]);
+                    if (page == nullptr) {
+                        continue; // Momentarily all frames pinned
+                    }
+                    if (std::string(page->GetData()) != "page-" + std::to_string(i)) {
+                        failed = true;
+                    }
+                    bpm.UnpinPage(ids[i], false);
+                    fetches++;
+                }
+            });
+        }
+
+        const size_t sizes[] = { 512, 32, 256, 8, 400, 64, 600, 16 };
+        for (int round = 0; round < 5; ++round) {
+            for (size_t size : sizes) {
+                Assert(bpm.ResizePool(size), "resize to " + std::to_string(size));
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        stop = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        Assert(!failed.load(), "readers saw correct bytes");
+        Assert(fetches.load() > 0, "readers made progress");
+        auto stats = bpm.GetStats();
+        Assert(stats.pool_size == 16 && stats.pinned_frames == 0 && stats.resident_pages <= 16, "pool drained to the final size");
+        Assert(stats.mapped_frames == 64, "grown segments released; the initial one stays mapped");
+        Log("Fetches during resizes: " + std::to_string(fetches.load()));
+    }
+    Cleanup();
+    Log(">>> PASSED: Fetches During Resize.");
+}
+
+int main() {
+    TestGrowShrink();
+    TestPinnedRetiredFrame();
+    TestConcurrentResize();
+    Cleanup();
+
+    Log("ALL RESIZE TESTS PASSED");
+    return 0;
+}
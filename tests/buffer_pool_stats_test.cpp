@@ -0,0 +1,275 @@
+/**
+ * buffer_pool_stats_test.cpp
+ *
+ * Verifies the BufferPoolManager statistics surface:
+ * 1. Exact counter values (and frame descriptor gauges) for a scripted sequence of operations.
+ * 2. Counter totals under concurrent access (per-thread shards must not lose updates).
+ * 3. Prometheus text rendering and the periodic MetricsDumper.
+ * 4. Two pools in one dump: one HELP/TYPE header per metric family, one sample per pool.
+ */
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "../src/bufferpool/buffer_pool_manager.h"
+#include "../src/utils/metrics_dumper.h"
+
+const std::string DB_FILE = "test_stats.db";
+const std::string METRICS_FILE = "test_stats.prom";
+
+void Cleanup() {
+    std::filesystem::remove(DB_FILE);
+    std::filesystem::remove(METRICS_FILE);
+}
+
+void Log(const std::string& msg) {
+    std::cout << "[STATS_TEST] " << msg << std::endl;
+}
+
+void AssertEq(uint64_t actual, uint64_t expected, const std::string& what) {
+    if (actual != expected) {
+        std::cerr << "!!! FAILED: " << what << " | Expected: " << expected << ", Actual: " << actual << std::endl;
+        std::exit(1);
+    }
+}
+
+void Assert(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "!!! FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+// =================================================================
+// Scenario 1: Scripted counters
+// =================================================================
+void TestScriptedCounters() {
+    Log("--- Scenario 1: Scripted Counters ---");
+    Cleanup();
+
+    auto* disk_manager = new cmse::disk::DiskManager(DB_FILE);
+    auto* bpm = new cmse::bufferpool::BufferPoolManager(3, disk_manager);
+
+    // Fill the pool: 3 new pages, all from the free list.
+    cmse::page_id_t pid;
+    for (int i = 0; i < 3; ++i) {
+        bpm->NewPage(pid);
+    }
+    for (int i = 0; i < 3; ++i) {
+        bpm->UnpinPage(i, true);
+    }
+
+    // LRU order (oldest first): 0, 1, 2. Touch 0 so page 1 becomes the victim.
+    bpm->FetchPage(0);
+    bpm->UnpinPage(0, false);
+
+    // New page -> evicts page 1 (dirty).
+    bpm->NewPage(pid);
+    bpm->UnpinPage(pid, false);
+
+    // Fetch page 1 -> miss, evicts page 2 (dirty).
+    bpm->FetchPage(1);
+
+    auto stats = bpm->GetStats();
+    AssertEq(stats.new_pages, 4, "new_pages");
+    AssertEq(stats.free_list_hits, 3, "free_list_hits");
+    AssertEq(stats.hits, 1, "hits");
+    AssertEq(stats.misses, 1, "misses");
+    AssertEq(stats.evictions_dirty, 2, "evictions_dirty");
+    AssertEq(stats.evictions_clean, 0, "evictions_clean");
+    AssertEq(stats.bytes_read, cmse::PAGE_SIZE, "bytes_read");
+    AssertEq(stats.bytes_written, 2 * cmse::PAGE_SIZE, "bytes_written");
+    AssertEq(stats.pool_size, 3, "pool_size");
+    AssertEq(stats.resident_pages, 3, "resident_pages");
+    AssertEq(stats.free_frames, 0, "free_frames");
+    AssertEq(stats.pinned_frames, 1, "pinned_frames (page 1)");
+    AssertEq(stats.dirty_frames, 2, "dirty_frames (pages 0 and 3)");
+
+    // Pin every frame, then ask for one more -> pin wait.
+    bpm->FetchPage(0);
+    bpm->FetchPage(3);
+    AssertEq(bpm->GetStats().pinned_frames, 3, "pinned_frames (all)");
+    Assert(bpm->NewPage(pid) == nullptr, "NewPage should fail when all frames are pinned");
+    AssertEq(bpm->GetStats().pin_waits, 1, "pin_waits");
+
+    bpm->ResetStats();
+    stats = bpm->GetStats();
+    AssertEq(stats.hits + stats.misses + stats.pin_waits + stats.bytes_written, 0, "counters after ResetStats");
+    AssertEq(stats.resident_pages, 3, "gauges survive ResetStats");
+
+    // Gauges follow unpins (a second pin of page 0 is still held), flushes and deletes.
+    bpm->FetchPage(0);
+    bpm->UnpinPage(0, true);
+    bpm->UnpinPage(1, true);
+    bpm->UnpinPage(3, false);
+    stats = bpm->GetStats();
+    AssertEq(stats.pinned_frames, 1, "pinned_frames (page 0 pinned twice)");
+    AssertEq(stats.dirty_frames, 3, "dirty_frames (pages 0, 1 and 3)");
+    bpm->FlushPage(1);
+    AssertEq(bpm->GetStats().dirty_frames, 2, "dirty_frames after FlushPage");
+    Assert(bpm->DeletePage(3), "DeletePage");
+    stats = bpm->GetStats();
+    AssertEq(stats.dirty_frames, 1, "dirty_frames after DeletePage");
+    AssertEq(stats.free_frames, 1, "free_frames after DeletePage");
+    bpm->UnpinPage(0, false);
+    bpm->FlushAllPages();
+    stats = bpm->GetStats();
+    AssertEq(stats.pinned_frames + stats.dirty_frames, 0, "gauges after FlushAllPages");
+
+    delete bpm;
+    delete disk_manager;
+
+    Log(">>> PASSED: Scripted Counters.");
+}
+
+// =================================================================
+// Scenario 2: Concurrent hits
+// =================================================================
+void TestConcurrentCounters() {
+    Log("--- Scenario 2: Concurrent Counters ---");
+    Cleanup();
+
+    const int NUM_THREADS = 8;
+    const int ITERATIONS = 2000;
+
+    auto* disk_manager = new cmse::disk::DiskManager(DB_FILE);
+    auto* bpm = new cmse::bufferpool::BufferPoolManager(4, disk_manager);
+
+    cmse::page_id_t pid;
+    bpm->NewPage(pid);
+    bpm->UnpinPage(pid, false);
+    bpm->ResetStats();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([bpm, ITERATIONS]() {
+            for (int i = 0; i < ITERATIONS; ++i) {
+                bpm->FetchPage(0);
+                bpm->UnpinPage(0, false);
+            }
+            });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    auto stats = bpm->GetStats();
+    AssertEq(stats.hits, static_cast<uint64_t>(NUM_THREADS) * ITERATIONS, "hits across threads");
+    AssertEq(stats.misses, 0, "misses across threads");
+    Assert(stats.HitRatio() == 1.0, "hit ratio should be 1.0");
+
+    delete bpm;
+    delete disk_manager;
+
+    Log(">>> PASSED: Concurrent Counters.");
+}
+
+// =================================================================
+// Scenario 3: Prometheus export
+// =================================================================
+void TestPrometheusDump() {
+    Log("--- Scenario 3: Prometheus Dump ---");
+    Cleanup();
+
+    auto* disk_manager = new cmse::disk::DiskManager(DB_FILE);
+    auto* bpm = new cmse::bufferpool::BufferPoolManager(4, disk_manager);
+
+    cmse::page_id_t pid;
+    bpm->NewPage(pid);
+    bpm->UnpinPage(pid, false);
+    bpm->FetchPage(pid);
+    bpm->UnpinPage(pid, false);
+
+    std::string text = cmse::bufferpool::ToPrometheusText(bpm->GetStats(), "main");
+    Assert(text.find("# TYPE cmse_bpm_hits_total counter") != std::string::npos, "missing TYPE line");
+    Assert(text.find("cmse_bpm_hits_total{pool=\"main\"} 1") != std::string::npos, "missing hits sample");
+    Assert(text.find("cmse_bpm_evictions_total{pool=\"main\",kind=\"dirty\"} 0") != std::string::npos, "missing eviction sample");
+
+    {
+        cmse::utils::MetricsDumper dumper(METRICS_FILE, std::chrono::milliseconds(10), [bpm]() {
+            return cmse::bufferpool::ToPrometheusText(bpm->GetStats(), "main");
+            });
+        dumper.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        dumper.stop();
+    }
+
+    std::ifstream infile(METRICS_FILE);
+    Assert(infile.is_open(), "metrics file was not written");
+    std::stringstream content;
+    content << infile.rdbuf();
+    Assert(content.str().find("cmse_bpm_pool_size{pool=\"main\"} 4") != std::string::npos, "dumped file missing pool size");
+    infile.close();
+
+    delete bpm;
+    delete disk_manager;
+    Cleanup();
+
+    Log(">>> PASSED: Prometheus Dump.");
+}
+
+// =================================================================
+// Scenario 4: Several pools in one dump
+// =================================================================
+size_t CountOccurrences(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + needle.size())) {
+        count++;
+    }
+    return count;
+}
+
+void TestPrometheusTwoPools() {
+    Log("--- Scenario 4: Prometheus Two Pools ---");
+
+    cmse::bufferpool::BufferPoolStats main_stats;
+    main_stats.hits = 7;
+    main_stats.pool_size = 4;
+    cmse::bufferpool::BufferPoolStats index_stats;
+    index_stats.hits = 3;
+    index_stats.evictions_dirty = 2;
+    index_stats.pool_size = 16;
+
+    std::string text = cmse::bufferpool::ToPrometheusText({ { "main", main_stats }, { "index", index_stats } });
+
+    // Every family is declared exactly once, before its samples.
+    std::istringstream lines(text);
+    std::string line;
+    size_t families = 0;
+    while (std::getline(lines, line)) {
+        if (line.rfind("# TYPE ", 0) == 0) {
+            std::string name = line.substr(7, line.find(' ', 7) - 7);
+            Assert(CountOccurrences(text, "# TYPE " + name + " ") == 1, "duplicate TYPE for " + name);
+            Assert(CountOccurrences(text, "# HELP " + name + " ") == 1, "duplicate HELP for " + name);
+            Assert(text.find("\n" + name + "{") > text.find(line), "sample before TYPE for " + name);
+            families++;
+        }
+    }
+    Assert(families == 16, "expected 16 metric families, got " + std::to_string(families));
+
+    Assert(text.find("cmse_bpm_hits_total{pool=\"main\"} 7") != std::string::npos, "main hits sample");
+    Assert(text.find("cmse_bpm_hits_total{pool=\"index\"} 3") != std::string::npos, "index hits sample");
+    Assert(text.find("cmse_bpm_evictions_total{pool=\"index\",kind=\"dirty\"} 2") != std::string::npos, "index eviction sample");
+    Assert(text.find("cmse_bpm_pool_size{pool=\"main\"} 4") != std::string::npos
+        && text.find("cmse_bpm_pool_size{pool=\"index\"} 16") != std::string::npos, "pool size samples");
+    Assert(CountOccurrences(text, "cmse_bpm_hit_ratio{") == 2, "one hit ratio per pool");
+
+    // The single-pool overload renders the same text as a one-element list.
+    Assert(cmse::bufferpool::ToPrometheusText(main_stats, "main") == cmse::bufferpool::ToPrometheusText({ { "main", main_stats } }), "single-pool overload");
+
+    Log(">>> PASSED: Prometheus Two Pools.");
+}
+
+int main() {
+    TestScriptedCounters();
+    TestConcurrentCounters();
+    TestPrometheusDump();
+    TestPrometheusTwoPools();
+    return 0;
+}
@@ -0,0 +1,365 @@
+/**
+ * composite_key_test.cpp
+ *
+ * Verifies the (resource_id, timestamp) composite-key B+Tree:
+ * 1. ResourceTimeKey ordering and KeyTraits (bounds, predecessor).
+ * 2. Random event inserts match a std::map reference (lookup + full scan).
+ * 3. Per-resource time-window and prefix scans return exactly the matching events,
+ *    and touch far fewer pages than a full scan.
+ * 4. The int64 tree gained range scans with the same semantics.
+ * 5. Reverse range scans (top-K by key) match the reference in descending order, read only
+ *    the last leaves of a timeline, and resume from predecessor() without gaps.
+ * 6. Batched multi-range scans (unsorted, overlapping input) equal the union of the single
+ *    range scans and fetch each shared page once.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <limits>
+#include <random>
+#include <filesystem>
+
+#include "../src/adapter/btree_adapter.h"
+#include "../src/bufferpool/buffer_pool_adapter.h"
+#include "../src/common/key_traits.h"
+#include "../src/versioning/version_manager.h"
+#include "versioned_tree_fixture.h"
+
+using namespace cmse;
+
+const std::string DB_FILE = "test_composite_key.db";
+
+void Cleanup() {
+    std::filesystem::remove(DB_FILE);
+}
+
+void Log(const std::string& msg) {
+    std::cout << "[COMPOSITE_TEST] " << msg << std::endl;
+}
+
+void Assert(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "!!! FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+std::string KeyString(const ResourceTimeKey& key) {
+    return "(" + std::to_string(key.resource_id) + ", " + std::to_string(key.timestamp_ms) + ")";
+}
+
+template <typename KeyT>
+struct Tree : VersionedTreeFixture<KeyT> {
+    explicit Tree(size_t pool_size) : VersionedTreeFixture<KeyT>(DB_FILE, pool_size) {}
+};
+
+// 1. Key ordering and traits.
+void TestKeyOrdering() {
+    Log("--- Test 1: Key Ordering ---");
+
+    ResourceTimeKey a{ 1, 100 };
+    ResourceTimeKey b{ 1, 200 };
+    ResourceTimeKey c{ 2, -5 };
+    Assert(a < b && b < c && a < c, "resource_id orders first, then timestamp");
+    Assert(!(b < a) && a != b && a == ResourceTimeKey{ 1, 100 }, "equality");
+    Assert(ResourceTimeKey::prefixBegin(1) < a && b < ResourceTimeKey::prefixEnd(1), "prefix bounds enclose the resource");
+    Assert(ResourceTimeKey::prefixEnd(1) < ResourceTimeKey::prefixBegin(2), "prefixes do not overlap");
+
+    using Traits = KeyTraits<ResourceTimeKey>;
+    Assert(Traits::predecessor(a) == ResourceTimeKey{ 1, 99 }, "predecessor within a resource");
+    Assert(Traits::predecessor(ResourceTimeKey::prefixBegin(2)) == ResourceTimeKey::prefixEnd(1), "predecessor across resources");
+    Assert(Traits::predecessor(Traits::lowest()) == Traits::lowest(), "predecessor saturates");
+    Assert(KeyTraits<KeyType>::predecessor(10) == 9, "int64 predecessor");
+
+    LogRecord record{};
+    record.resource_id = 42;
+    record.timestamp = timestamp_t(std::chrono::milliseconds(123456));
+    Assert(ResourceTimeKey::fromRecord(record) == ResourceTimeKey{ 42, 123456 }, "fromRecord");
+
+    Log(">>> PASSED: Key Ordering.");
+}
+
+// 2 + 3. Random timeline inserts, then point, prefix and window queries.
+void TestTimelineQueries() {
+    Log("--- Test 2/3: Timeline Queries ---");
+    Cleanup();
+    {
+        Tree<ResourceTimeKey> tree(512);
+        std::map<ResourceTimeKey, ValueType> expected;
+        std::mt19937_64 rng(5);
+
+        const int num_resources = 200;
+        const int num_events = 20000;
+        version_t v = tree.vm.createVersion();
+        for (int i = 0; i < num_events; ++i) {
+            ResourceTimeKey key{ static_cast<int64_t>(rng() % num_resources), static_cast<int64_t>(rng() % 1000000) };
+            Assert(tree.vm.applyUpdate(v, INVALID_VERSION, key, i), "insert failed at " + KeyString(key));
+            expected[key] = i;
+        }
+        Assert(tree.vm.commitVersion(v), "commit failed");
+
+        // Full scan and lookups.
+        std::vector<std::pair<ResourceTimeKey, ValueType>> all;
+        Assert(tree.vm.scan(v, KeyTraits<ResourceTimeKey>::lowest(), expected.size() + 10, &all), "full scan failed");
+        Assert(all.size() == expected.size(), "full scan size");
+        size_t i = 0;
+        for (const auto& [key, val] : expected) {
+            Assert(all[i].first == key && all[i].second == val, "full scan mismatch at " + KeyString(key));
+            ++i;
+        }
+        for (int probe = 0; probe < 2000; ++probe) {
+            ResourceTimeKey key{ static_cast<int64_t>(rng() % num_resources), static_cast<int64_t>(rng() % 1000000) };
+            ValueType found = -1;
+            bool hit = tree.vm.lookup(v, key, &found);
+            auto it = expected.find(key);
+            Assert(hit == (it != expected.end()), "lookup presence for " + KeyString(key));
+            Assert(!hit || found == it->second, "lookup value for " + KeyString(key));
+        }
+
+        // Page fetches of a full scan, for comparison.
+        tree.bpm.ResetStats();
+        all.clear();
+        tree.vm.scan(v, KeyTraits<ResourceTimeKey>::lowest(), expected.size(), &all);
+        auto full_stats = tree.bpm.GetStats();
+        uint64_t full_fetches = full_stats.hits + full_stats.misses;
+
+        // Time windows per resource, checked against the reference.
+        for (int q = 0; q < 300; ++q) {
+            int64_t rid = static_cast<int64_t>(rng() % (num_resources + 5)); // Some resources have no events
+            int64_t t1 = static_cast<int64_t>(rng() % 1000000);
+            int64_t t2 = t1 + static_cast<int64_t>(rng() % 200000);
+
+            tree.bpm.ResetStats();
+            std::vector<std::pair<ResourceTimeKey, ValueType>> window;
+            Assert(tree.vm.scanRange(v, { rid, t1 }, { rid, t2 }, expected.size(), &window), "window scan failed");
+            auto stats = tree.bpm.GetStats();
+
+            auto begin = expected.lower_bound({ rid, t1 });
+            auto end = expected.upper_bound({ rid, t2 });
+            size_t n = 0;
+            for (auto it = begin; it != end; ++it, ++n) {
+                Assert(n < window.size() && window[n].first == it->first && window[n].second == it->second,
+                    "window mismatch for resource " + std::to_string(rid));
+            }
+            Assert(n == window.size(), "window returned extra rows for resource " + std::to_string(rid));
+            Assert((stats.hits + stats.misses) * 10 < full_fetches, "window scan should touch few pages");
+        }
+
+        // Whole-prefix scan, plus a max_count cut.
+        for (int64_t rid : { int64_t{ 0 }, int64_t{ 77 }, int64_t{ num_resources - 1 } }) {
+            std::vector<std::pair<ResourceTimeKey, ValueType>> timeline;
+            Assert(tree.vm.scanRange(v, ResourceTimeKey::prefixBegin(rid), ResourceTimeKey::prefixEnd(rid), expected.size(), &timeline), "prefix scan failed");
+            size_t count = 0;
+            for (const auto& [key, val] : expected) {
+                count += key.resource_id == rid ? 1 : 0;
+            }
+            Assert(timeline.size() == count && count > 0, "prefix size for resource " + std::to_string(rid));
+            for (size_t k = 0; k < timeline.size(); ++k) {
+                Assert(timeline[k].first.resource_id == rid, "prefix leaked another resource");
+                Assert(k == 0 || timeline[k - 1].first < timeline[k].first, "prefix not in time order");
+            }
+
+            std::vector<std::pair<ResourceTimeKey, ValueType>> limited;
+            tree.vm.scanRange(v, ResourceTimeKey::prefixBegin(rid), ResourceTimeKey::prefixEnd(rid), 3, &limited);
+            Assert(limited.size() == std::min<size_t>(3, count), "max_count not honoured");
+        }
+
+        std::vector<std::pair<ResourceTimeKey, ValueType>> inverted;
+        Assert(tree.vm.scanRange(v, { 5, 100 }, { 5, 50 }, 10, &inverted) && inverted.empty(), "inverted range must be empty");
+    }
+    Cleanup();
+    Log(">>> PASSED: Timeline Queries.");
+}
+
+// 4. scanRange on the int64 tree.
+void TestInt64Range() {
+    Log("--- Test 4: Int64 Range ---");
+    Cleanup();
+    {
+        Tree<KeyType> tree(256);
+        version_t v = tree.vm.createVersion();
+        for (KeyType k = 0; k < 5000; ++k) {
+            Assert(tree.vm.applyUpdate(v, INVALID_VERSION, k * 2, k), "insert failed");
+        }
+        tree.vm.commitVersion(v);
+
+        std::vector<std::pair<KeyType, ValueType>> out;
+        Assert(tree.vm.scanRange(v, 101, 199, 1000, &out), "range scan failed");
+        Assert(out.size() == 49 && out.front().first == 102 && out.back().first == 198, "int64 range bounds");
+
+        out.clear();
+        tree.vm.scanRange(v, std::numeric_limits<KeyType>::min(), std::numeric_limits<KeyType>::max(), 100000, &out);
+        Assert(out.size() == 5000, "unbounded range returns everything");
+    }
+    Cleanup();
+    Log(">>> PASSED: Int64 Range.");
+}
+
+// 5. scanRangeReverse: latest-first timelines and int64 boundaries.
+void TestReverseScans() {
+    Log("--- Test 5: Reverse Scans ---");
+    Cleanup();
+    {
+        Tree<ResourceTimeKey> tree(512);
+        std::map<ResourceTimeKey, ValueType> expected;
+        std::mt19937_64 rng(9);
+
+        // Resource 7 has a long timeline; the others interleave around it.
+        version_t v = tree.vm.createVersion();
+        for (int i = 0; i < 30000; ++i) {
+            int64_t rid = i % 3 == 0 ? 7 : static_cast<int64_t>(rng() % 50);
+            ResourceTimeKey key{ rid, static_cast<int64_t>(rng() % 10000000) };
+            Assert(tree.vm.applyUpdate(v, INVALID_VERSION, key, i), "insert failed at " + KeyString(key));
+            expected[key] = i;
+        }
+        Assert(tree.vm.commitVersion(v), "commit failed");
+
+        // Windows in descending order, against the reference.
+        for (int q = 0; q < 200; ++q) {
+            int64_t rid = static_cast<int64_t>(rng() % 55);
+            int64_t t1 = static_cast<int64_t>(rng() % 10000000);
+            int64_t t2 = t1 + static_cast<int64_t>(rng() % 3000000);
+            size_t limit = q % 2 == 0 ? expected.size() : 1 + rng() % 20;
+
+            std::vector<std::pair<ResourceTimeKey, ValueType>> window;
+            Assert(tree.vm.scanRangeReverse(v, { rid, t1 }, { rid, t2 }, limit, &window), "reverse scan failed");
+            auto it = expected.upper_bound({ rid, t2 });
+            auto begin = expected.lower_bound({ rid, t1 });
+            size_t n = 0;
+            while (it != begin && n < limit) {
+                --it;
+                Assert(n < window.size() && window[n].first == it->first && window[n].second == it->second,
+                    "reverse window mismatch for resource " + std::to_string(rid));
+                ++n;
+            }
+            Assert(n == window.size(), "reverse window returned extra rows");
+        }
+
+        // Latest 100 events of resource 7: a handful of pages, not the whole timeline.
+        std::vector<std::pair<ResourceTimeKey, ValueType>> timeline, latest;
+        tree.bpm.ResetStats();
+        tree.vm.scanRange(v, ResourceTimeKey::prefixBegin(7), ResourceTimeKey::prefixEnd(7), expected.size(), &timeline);
+        auto full = tree.bpm.GetStats();
+        tree.bpm.ResetStats();
+        Assert(tree.vm.scanRangeReverse(v, ResourceTimeKey::prefixBegin(7), ResourceTimeKey::prefixEnd(7), 100, &latest), "top-k failed");
+        auto topk = tree.bpm.GetStats();
+        Assert(latest.size() == 100 && latest.front().first == timeline.back().first, "top-k starts at the latest event");
+        Assert((topk.hits + topk.misses) * 5 < full.hits + full.misses, "top-k should read only the last leaves");
+
+        // Paging backwards with predecessor() visits the whole timeline exactly once.
+        std::vector<std::pair<ResourceTimeKey, ValueType>> paged;
+        ResourceTimeKey end = ResourceTimeKey::prefixEnd(7);
+        while (true) {
+            size_t before = paged.size();
+            tree.vm.scanRangeReverse(v, ResourceTimeKey::prefixBegin(7), end, 333, &paged);
+            if (paged.size() - before < 333) {
+                break;
+            }
+            end = KeyTraits<ResourceTimeKey>::predecessor(paged.back().first);
+        }
+        Assert(paged.size() == timeline.size(), "paged reverse scan size");
+        for (size_t k = 0; k < paged.size(); ++k) {
+            Assert(paged[k].first == timeline[timeline.size() - 1 - k].first, "paged reverse scan order");
+        }
+    }
+    Cleanup();
+    {
+        Tree<KeyType> tree(256);
+        version_t v = tree.vm.createVersion();
+        for (KeyType k = 0; k < 5000; ++k) {
+            Assert(tree.vm.applyUpdate(v, INVALID_VERSION, k * 2, k), "insert failed");
+        }
+        tree.vm.commitVersion(v);
+
+        std::vector<std::pair<KeyType, ValueType>> out;
+        Assert(tree.vm.scanRangeReverse(v, 101, 199, 1000, &out), "reverse range failed");
+        Assert(out.size() == 49 && out.front().first == 198 && out.back().first == 102, "reverse range bounds (odd ends)");
+        out.clear();
+        tree.vm.scanRangeReverse(v, 100, 200, 1000, &out);
+        Assert(out.size() == 51 && out.front().first == 200 && out.back().first == 100, "reverse range bounds (exact ends)");
+        out.clear();
+        tree.vm.scanRangeReverse(v, std::numeric_limits<KeyType>::min(), std::numeric_limits<KeyType>::max(), 1, &out);
+        Assert(out.size() == 1 && out[0].first == 9998, "max key");
+        out.clear();
+        Assert(tree.vm.scanRangeReverse(v, 20001, 30000, 10, &out) && out.empty(), "range past the last key");
+        Assert(tree.vm.scanRangeReverse(v, 50, 10, 10, &out) && out.empty(), "inverted range must be empty");
+    }
+    Cleanup();
+    Log(">>> PASSED: Reverse Scans.");
+}
+
+// 6. scanRanges: many per-resource ranges in one walk.
+void TestBatchedRanges() {
+    Log("--- Test 6: Batched Ranges ---");
+    Cleanup();
+    {
+        Tree<ResourceTimeKey> tree(512);
+        std::map<ResourceTimeKey, ValueType> expected;
+        std::mt19937_64 rng(11);
+
+        const int num_resources = 2000;
+        version_t v = tree.vm.createVersion();
+        for (int i = 0; i < 40000; ++i) {
+            ResourceTimeKey key{ static_cast<int64_t>(rng() % num_resources), static_cast<int64_t>(rng() % 1000000) };
+            Assert(tree.vm.applyUpdate(v, INVALID_VERSION, key, i), "insert failed at " + KeyString(key));
+            expected[key] = i;
+        }
+        Assert(tree.vm.commitVersion(v), "commit failed");
+
+        for (int q = 0; q < 50; ++q) {
+            // Random resources (as a name prefix resolves them: not in id order), some windows
+            // overlapping, some resources absent, one inverted range.
+            std::vector<std::pair<ResourceTimeKey, ResourceTimeKey>> ranges;
+            size_t count = 1 + rng() % 300;
+            for (size_t r = 0; r < count; ++r) {
+                int64_t rid = static_cast<int64_t>(rng() % (num_resources + 100));
+                int64_t t1 = static_cast<int64_t>(rng() % 1000000);
+                int64_t t2 = r % 4 == 0 ? std::numeric_limits<int64_t>::max() : t1 + static_cast<int64_t>(rng() % 500000);
+                ranges.push_back({ { rid, t1 }, { rid, t2 } });
+            }
+            ranges.push_back({ { 3, 500 }, { 3, 100 } });
+
+            std::map<ResourceTimeKey, ValueType> reference;
+            uint64_t single_fetches = 0;
+            for (const auto& [lo, hi] : ranges) {
+                tree.bpm.ResetStats();
+                std::vector<std::pair<ResourceTimeKey, ValueType>> part;
+                Assert(tree.vm.scanRange(v, lo, hi, expected.size(), &part), "single range failed");
+                auto stats = tree.bpm.GetStats();
+                single_fetches += stats.hits + stats.misses;
+                reference.insert(part.begin(), part.end());
+            }
+
+            tree.bpm.ResetStats();
+            std::vector<std::pair<ResourceTimeKey, ValueType>> batched;
+            Assert(tree.vm.scanRanges(v, ranges, &batched), "batched scan failed");
+            auto stats = tree.bpm.GetStats();
+
+            Assert(batched.size() == reference.size(), "batched size (query " + std::to_string(q) + ")");
+            size_t k = 0;
+            for (const auto& [key, val] : reference) {
+                Assert(batched[k].first == key && batched[k].second == val, "batched entry " + KeyString(key));
+                ++k;
+            }
+            Assert(count < 20 || (stats.hits + stats.misses) * 2 < single_fetches, "batched walk should share pages");
+        }
+
+        std::vector<std::pair<ResourceTimeKey, ValueType>> none;
+        Assert(tree.vm.scanRanges(v, {}, &none) && none.empty(), "no ranges");
+    }
+    Cleanup();
+    Log(">>> PASSED: Batched Ranges.");
+}
+
+int main() {
+    TestKeyOrdering();
+    TestTimelineQueries();
+    TestInt64Range();
+    TestReverseScans();
+    TestBatchedRanges();
+
+    Log("ALL COMPOSITE KEY TESTS PASSED");
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * json_reader_test.cpp
+ *
+ * Unit test for the minimal JSON reader used by the perf-smoke baseline check.
+ * Verifies scalar/array/object parsing, escapes, error reporting and a round trip
+ * through a cmse_bench-style report.
+ */
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <filesystem>
+
+#include "../src/utils/json_reader.h"
+
+using namespace cmse::utils;
+
+const std::string JSON_FILE = "test_json_reader.json";
+
+void Log(const std::string& msg) {
+    std::cout << "[JSON_TEST] " << msg << std::endl;
+}
+
+void Assert(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "!!! FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+// 1. Scalars and containers.
+void TestBasicValues() {
+    Log("--- Test 1: Basic Values ---");
+
+    JsonValue v;
+    Assert(parseJson("  42 ", &v) && v.isNumber() && v.asNumber() == 42.0, "integer");
+    Assert(parseJson("-1.5e3", &v) && v.isNumber() && v.asNumber() == -1500.0, "exponent");
+    Assert(parseJson("true", &v) && v.isBool() && v.asBool(), "true");
+    Assert(parseJson("false", &v) && v.isBool() && !v.asBool(), "false");
+    Assert(parseJson("null", &v) && v.isNull(), "null");
+    Assert(parseJson("\"a\\\"b\\\\c\\n\\u0041\\u00e9\"", &v) && v.isString()
+        && v.asString() == "a\"b\\c\nA\xC3\xA9", "string escapes");
+
+    Assert(parseJson("[1, [2, 3], {}]", &v) && v.isArray() && v.items().size() == 3, "array");
+    Assert(v.items()[1].isArray() && v.items()[1].items()[1].asNumber() == 3.0, "nested array");
+    Assert(v.items()[2].isObject() && v.items()[2].members().empty(), "empty object");
+
+    Assert(parseJson("{\"a\": {\"b\": 7}, \"s\": \"x\"}", &v) && v.isObject(), "object");
+    Assert(v.get("a") != nullptr && v.get("a")->numberOr("b", 0.0) == 7.0, "nested member");
+    Assert(v.get("missing") == nullptr, "missing member");
+    Assert(v.numberOr("s", -1.0) == -1.0, "numberOr falls back on non-number");
+
+    Log(">>> PASSED: Basic Values.");
+}
+
+// 2. Malformed input is rejected with a position.
+void TestErrors() {
+    Log("--- Test 2: Errors ---");
+
+    const char* bad[] = {
+        "", "{", "[1,]", "{\"a\" 1}", "{\"a\":1,}", "tru", "01x", "1.", "\"unterminated",
+        "\"bad \\q escape\"", "[1] 2", "{1: 2}", "-"
+    };
+    for (const char* text : bad) {
+        JsonValue v;
+        std::string error;
+        Assert(!parseJson(text, &v, &error), std::string("should reject: ") + text);
+        Assert(error.find("offset") != std::string::npos, "error should carry an offset");
+    }
+
+    // Deep nesting is refused instead of overflowing the stack.
+    std::string deep(10000, '[');
+    JsonValue v;
+    Assert(!parseJson(deep, &v), "deep nesting must be rejected");
+
+    Log(">>> PASSED: Errors.");
+}
+
+// 3. A cmse_bench-style report read back from disk.
+void TestBenchReport() {
+    Log("--- Test 3: Bench Report ---");
+
+    {
+        std::ofstream out(JSON_FILE);
+        out << "{\n  \"context\": {\"compiler\": \"gcc\", \"hardware_threads\": 8},\n"
+            << "  \"tolerance\": 2.5,\n"
+            << "  \"benchmarks\": [\n"
+            << "    {\"name\": \"BM_A\", \"iterations\": 100, \"ns_per_op\": {\"mean\": 11.5, \"median\": 10.25}},\n"
+            << "    {\"name\": \"BM_B\", \"ns_per_op\": {\"median\": 1e3}, \"tolerance\": 4}\n"
+            << "  ]\n}\n";
+    }
+
+    JsonValue root;
+    std::string error;
+    Assert(parseJsonFile(JSON_FILE, &root, &error), "report should parse: " + error);
+    Assert(root.numberOr("tolerance", 0.0) == 2.5, "top-level tolerance");
+
+    const JsonValue* benchmarks = root.get("benchmarks");
+    Assert(benchmarks != nullptr && benchmarks->isArray() && benchmarks->items().size() == 2, "benchmarks array");
+    const JsonValue& a = benchmarks->items()[0];
+    Assert(a.get("name")->asString() == "BM_A", "name");
+    Assert(std::fabs(a.get("ns_per_op")->numberOr("median", 0.0) - 10.25) < 1e-12, "median");
+    Assert(benchmarks->items()[1].numberOr("tolerance", 0.0) == 4.0, "per-entry tolerance");
+
+    Assert(!parseJsonFile("does_not_exist.json", &root, &error), "missing file must fail");
+
+    std::filesystem::remove(JSON_FILE);
+    Log(">>> PASSED: Bench Report.");
+}
+
+int main() {
+    TestBasicValues();
+    TestErrors();
+    TestBenchReport();
+
+    Log("ALL JSON READER TESTS PASSED");
+    return 0;
+}
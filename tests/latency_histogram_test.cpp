@@ -0,0 +1,205 @@
+/**
+ * latency_histogram_test.cpp
+ *
+ * Unit test for the log-linear latency histograms.
+ * Verifies bucket mapping, percentile accuracy, thread-local merging, the bound on
+ * per-thread shards and (when compiled in) the BufferPoolManager / DiskManager
+ * instrumentation.
+ */
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <filesystem>
+
+#include "../src/utils/latency_histogram.h"
+#include "../src/bufferpool/buffer_pool_manager.h"
+
+using namespace cmse::utils;
+
+const std::string DB_FILE = "test_latency.db";
+
+void Log(const std::string& msg) {
+    std::cout << "[LATENCY_TEST] " << msg << std::endl;
+}
+
+void Assert(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "!!! FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+// 1. Bucket mapping: exact for small values, bounded relative error above.
+void TestBucketMapping() {
+    Log("--- Test 1: Bucket Mapping ---");
+
+    for (uint64_t v = 0; v < 2 * histogram::SUB_BUCKET_COUNT; ++v) {
+        Assert(histogram::BucketUpperBound(histogram::BucketIndex(v)) == v, "small values must be exact");
+    }
+
+    size_t last_index = 0;
+    for (uint64_t v = 1; v < (uint64_t{ 1 } << 30); v = v * 3 / 2 + 1) {
+        size_t index = histogram::BucketIndex(v);
+        uint64_t upper = histogram::BucketUpperBound(index);
+        Assert(index >= last_index, "bucket index must be monotonic");
+        Assert(index < histogram::NUM_BUCKETS, "bucket index out of range");
+        Assert(upper >= v, "upper bound below value");
+        Assert(static_cast<double>(upper - v) <= static_cast<double>(v) / histogram::SUB_BUCKET_COUNT + 1.0,
+            "relative error too large at " + std::to_string(v));
+        last_index = index;
+    }
+
+    Assert(histogram::BucketIndex(~uint64_t{ 0 }) == histogram::NUM_BUCKETS - 1, "huge values clamp to last bucket");
+
+    Log(">>> PASSED: Bucket Mapping.");
+}
+
+// 2. Percentiles on a known distribution (1..100000 ns, uniform).
+void TestPercentiles() {
+    Log("--- Test 2: Percentiles ---");
+
+    HistogramSnapshot h;
+    Assert(h.valueAtQuantile(0.5) == 0, "empty histogram should report 0");
+
+    for (uint64_t v = 1; v <= 100000; ++v) {
+        h.record(v);
+    }
+
+    auto within = [](uint64_t actual, double expected) {
+        return actual >= expected && actual <= expected * (1.0 + 1.0 / histogram::SUB_BUCKET_COUNT) + 1.0;
+    };
+
+    Assert(h.count() == 100000, "count");
+    Assert(within(h.valueAtQuantile(0.50), 50000), "p50 = " + std::to_string(h.valueAtQuantile(0.50)));
+    Assert(within(h.valueAtQuantile(0.99), 99000), "p99 = " + std::to_string(h.valueAtQuantile(0.99)));
+    Assert(within(h.valueAtQuantile(0.999), 99900), "p999 = " + std::to_string(h.valueAtQuantile(0.999)));
+    Assert(h.valueAtQuantile(1.0) == 100000, "p100 must equal max");
+
+    Log(">>> PASSED: Percentiles.");
+}
+
+// 3. Thread-local shards are merged on read without losing samples.
+void TestThreadMerge() {
+    Log("--- Test 3: Thread Merge ---");
+
+    const int NUM_THREADS = 8;
+    const int SAMPLES = 10000;
+    LatencyRecorder recorder("test_op");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&recorder, t, SAMPLES]() {
+            for (int i = 0; i < SAMPLES; ++i) {
+                recorder.record(static_cast<uint64_t>(100 * (t + 1)));
+            }
+            });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    LatencySummary s = recorder.summarize();
+    Assert(s.op == "test_op", "summary name");
+    Assert(s.count == static_cast<uint64_t>(NUM_THREADS) * SAMPLES, "merged count");
+    Assert(s.max_ns == 100 * NUM_THREADS, "merged max");
+
+    recorder.reset();
+    Assert(recorder.summarize().count == 0, "reset clears all shards");
+
+    std::string text = latencySummariesToPrometheus("cmse_latency_ns", { s });
+    Assert(text.find("cmse_latency_ns_count{op=\"test_op\"} 80000") != std::string::npos, "prometheus count line");
+
+    Log(">>> PASSED: Thread Merge.");
+}
+
+// 4. One thread cycling through more recorders than its shard cache holds still gets
+//    exactly one shard per recorder.
+void TestShardBound() {
+    Log("--- Test 4: Shard Bound ---");
+
+    const int NUM_RECORDERS = 200;
+    const int ROUNDS = 20;
+    std::vector<std::unique_ptr<LatencyRecorder>> recorders;
+    for (int r = 0; r < NUM_RECORDERS; ++r) {
+        recorders.push_back(std::make_unique<LatencyRecorder>("op_" + std::to_string(r)));
+    }
+
+    for (int round = 0; round < ROUNDS; ++round) {
+        for (auto& recorder : recorders) {
+            recorder->record(100);
+        }
+    }
+    for (auto& recorder : recorders) {
+        Assert(recorder->shardCount() == 1, "one shard per thread for " + recorder->name());
+        Assert(recorder->summarize().count == ROUNDS, "no samples lost for " + recorder->name());
+    }
+
+    // A second thread adds exactly one more shard.
+    std::thread other([&recorders]() {
+        for (int round = 0; round < ROUNDS; ++round) {
+            for (auto& recorder : recorders) {
+                recorder->record(200);
+            }
+        }
+        });
+    other.join();
+    for (auto& recorder : recorders) {
+        Assert(recorder->shardCount() == 2, "two threads, two shards");
+    }
+
+    Log(">>> PASSED: Shard Bound.");
+}
+
+// 5. Instrumented BufferPoolManager / DiskManager.
+void TestInstrumentation() {
+    Log("--- Test 5: Instrumentation ---");
+    std::filesystem::remove(DB_FILE);
+
+    auto* disk_manager = new cmse::disk::DiskManager(DB_FILE);
+    auto* bpm = new cmse::bufferpool::BufferPoolManager(4, disk_manager);
+
+    cmse::page_id_t pid;
+    for (int i = 0; i < 10; ++i) {
+        bpm->NewPage(pid);
+        bpm->UnpinPage(pid, true);
+    }
+    for (int i = 0; i < 10; ++i) {
+        bpm->FetchPage(i);
+        bpm->UnpinPage(i, false);
+    }
+    bpm->FlushPage(9);
+
+    auto bpm_summaries = bpm->GetLatencySummaries();
+    auto disk_summaries = disk_manager->GetLatencySummaries();
+
+#ifdef CMSE_LATENCY_HISTOGRAMS
+    Assert(bpm_summaries.size() == 4, "expected 4 BPM operations");
+    Assert(bpm_summaries[0].op == "fetch_page" && bpm_summaries[0].count == 10, "fetch_page count");
+    Assert(bpm_summaries[1].op == "new_page" && bpm_summaries[1].count == 10, "new_page count");
+    Assert(bpm_summaries[2].op == "unpin_page" && bpm_summaries[2].count == 20, "unpin_page count");
+    Assert(bpm_summaries[3].op == "flush_page" && bpm_summaries[3].count == 1, "flush_page count");
+    Assert(disk_summaries.size() == 2 && disk_summaries[0].count > 0 && disk_summaries[1].count > 0, "disk counts");
+    Log("Histograms compiled in; counts verified.");
+#else
+    Assert(bpm_summaries.empty() && disk_summaries.empty(), "summaries must be empty when compiled out");
+    Log("Histograms compiled out; summaries empty as expected.");
+#endif
+
+    delete bpm;
+    delete disk_manager;
+    std::filesystem::remove(DB_FILE);
+
+    Log(">>> PASSED: Instrumentation.");
+}
+
+int main() {
+    TestBucketMapping();
+    TestPercentiles();
+    TestThreadMerge();
+    TestShardBound();
+    TestInstrumentation();
+    return 0;
+}
@@ -0,0 +1,272 @@
+/**
+ * leaf_bloom_filter_test.cpp
+ *
+ * Verifies the per-leaf blocked Bloom filters (LeafBloomFilters + VersionManager):
+ * 1. No false negatives, a low false-positive rate, and packing of filters into pages.
+ * 2. Timeline scans of resources without events skip the leaf, return the same rows as an
+ *    unfiltered tree, and cost fewer page fetches and far fewer buffer pool misses.
+ * 3. Point lookups on the int64 tree: filters built for an older version (buildLeafFilters),
+ *    new leaves registered on commit, and active versions still reading their own leaves.
+ * 4. Filters for many times more leaves than the pool has frames: writes keep succeeding,
+ *    and the filters round-trip through flush() / load().
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <filesystem>
+
+#include "../src/adapter/btree_adapter.h"
+#include "../src/bufferpool/buffer_pool_adapter.h"
+#include "../src/common/key_traits.h"
+#include "../src/index/leaf_bloom_filters.h"
+#include "../src/versioning/version_manager.h"
+#include "versioned_tree_fixture.h"
+
+using namespace cmse;
+using index::LeafBloomFilters;
+
+const std::string DB_FILE = "test_leaf_bloom_filter.db";
+
+void Cleanup() {
+    std::filesystem::remove(DB_FILE);
+}
+
+void Log(const std::string& msg) {
+    std::cout << "[BLOOM_TEST] " << msg << std::endl;
+}
+
+void Assert(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "!!! FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+// The shared tree fixture plus the filters (not attached until setLeafFilter).
+template <typename KeyT>
+struct Tree : VersionedTreeFixture<KeyT> {
+    LeafBloomFilters filters;
+
+    explicit Tree(size_t pool_size) : VersionedTreeFixture<KeyT>(DB_FILE, pool_size), filters(&this->bpm_adapter) {}
+};
+
+// 1. The filters on their own.
+void TestFilters() {
+    Log("--- Test 1: Filter Accuracy ---");
+    Cleanup();
+    {
+        disk::DiskManager disk(DB_FILE);
+        bufferpool::BufferPoolManager bpm(16, &disk);
+        bufferpool::BufferPoolManagerAdapter bpm_adapter(&bpm);
+        LeafBloomFilters filters(&bpm_adapter);
+
+        // 200 "leaves" of 100 keys each; keys of leaf p are multiples of 1000 plus p.
+        const int leaves = 200;
+        for (page_id_t p = 0; p < leaves; ++p) {
+            std::vector<int64_t> keys;
+            for (int64_t k = 0; k < 100; ++k) {
+                keys.push_back(k * 1000 + p);
+            }
+            Assert(filters.addLeaf(1000 + p, keys), "addLeaf");
+        }
+        Assert(filters.leafCount() == leaves, "leaf count");
+        Assert(filters.pageCount() == (leaves + LeafBloomFilters::FILTERS_PER_PAGE - 1) / LeafBloomFilters::FILTERS_PER_PAGE, "filters are packed into pages");
+        Assert(filters.hasLeaf(1000) && !filters.hasLeaf(5), "hasLeaf");
+        Assert(filters.mayContain(5, 123), "unknown pages are never ruled out");
+
+        for (page_id_t p = 0; p < leaves; ++p) {
+            for (int64_t k = 0; k < 100; ++k) {
+                Assert(filters.mayContain(1000 + p, k * 1000 + p), "false negative");
+            }
+        }
+
+        filters.resetStats();
+        std::mt19937_64 rng(3);
+        const int probes = 20000;
+        for (int i = 0; i < probes; ++i) {
+            page_id_t p = static_cast<page_id_t>(rng() % leaves);
+            filters.mayContain(1000 + p, static_cast<int64_t>(rng() % 100000) * 1000 + 500); // Never present
+        }
+        auto stats = filters.stats();
+        double fpr = 1.0 - static_cast<double>(stats.negatives) / stats.probes;
+        Log("False-positive rate at 100 keys per leaf: " + std::to_string(fpr));
+        Assert(stats.probes == probes && fpr < 0.03, "false-positive rate too high");
+    }
+    Cleanup();
+    Log(">>> PASSED: Filter Accuracy.");
+}
+
+// 2. Miss-heavy timeline scans on the composite tree.
+void TestTimelineMisses() {
+    Log("--- Test 2: Timeline Misses ---");
+    Cleanup();
+    {
+        // A pool far smaller than the tree: leaves miss, the filters stay in memory.
+        Tree<ResourceTimeKey> tree(16);
+        tree.vm.setLeafFilter(&tree.filters);
+
+        // Only even resources have events.
+        std::map<ResourceTimeKey, ValueType> expected;
+        std::mt19937_64 rng(7);
+        version_t v = tree.vm.createVersion();
+        for (int i = 0; i < 10000; ++i) {
+            ResourceTimeKey key{ static_cast<int64_t>(rng() % 400) & ~int64_t{ 1 }, static_cast<int64_t>(rng() % 1000000) };
+            Assert(tree.vm.applyUpdate(v, INVALID_VERSION, key, i), "insert failed");
+            expected[key] = i;
+        }
+        Assert(tree.vm.commitVersion(v), "commit failed");
+        Assert(tree.filters.leafCount() > 50, "leaves registered on commit");
+
+        auto run = [&](bool filtered, uint64_t* fetches, uint64_t* misses) {
+            tree.vm.setLeafFilter(filtered ? &tree.filters : nullptr);
+            tree.bpm.ResetStats();
+            std::mt19937_64 queries(11);
+            for (int q = 0; q < 2000; ++q) {
+                int64_t rid = static_cast<int64_t>(queries() % 400);
+                std::vector<std::pair<ResourceTimeKey, ValueType>> timeline;
+                Assert(tree.vm.scanRange(v, ResourceTimeKey::prefixBegin(rid), ResourceTimeKey::prefixEnd(rid), expected.size(), &timeline), "scan failed");
+                auto it = expected.lower_bound(ResourceTimeKey::prefixBegin(rid));
+                for (const auto& entry : timeline) {
+                    Assert(it != expected.end() && entry.first == it->first && entry.second == it->second, "timeline mismatch");
+                    ++it;
+                }
+                Assert(it == expected.end() || it->first.resource_id != rid, "timeline incomplete");
+            }
+            auto pool_stats = tree.bpm.GetStats();
+            *fetches = pool_stats.hits + pool_stats.misses;
+            *misses = pool_stats.misses;
+        };
+
+        uint64_t plain_fetches = 0, plain_misses = 0;
+        uint64_t filtered_fetches = 0, filtered_misses = 0;
+        run(false, &plain_fetches, &plain_misses);
+        tree.filters.resetStats();
+        run(true, &filtered_fetches, &filtered_misses);
+        auto stats = tree.filters.stats();
+        Log("Leaves skipped: " + std::to_string(stats.negatives) + " of " + std::to_string(stats.probes) + " probes; pool misses "
+            + std::to_string(plain_misses) + " -> " + std::to_string(filtered_misses) + ", fetches " + std::to_string(plain_fetches)
+            + " -> " + std::to_string(filtered_fetches));
+        // About half the queries ask for an odd resource; nearly all of them skip every leaf.
+        Assert(stats.negatives > 900, "absent resources should be ruled out");
+        Assert(filtered_misses < plain_misses * 3 / 4, "filters should save leaf misses");
+        // Probes read in-memory filters: they never add fetches of their own.
+        Assert(filtered_fetches < plain_fetches, "filters should save page fetches");
+    }
+    Cleanup();
+    Log(">>> PASSED: Timeline Misses.");
+}
+
+// 3. Point lookups across versions.
+void TestPointLookups() {
+    Log("--- Test 3: Point Lookups ---");
+    Cleanup();
+    {
+        Tree<KeyType> tree(64);
+        version_t v1 = tree.vm.createVersion();
+        for (KeyType k = 0; k < 5000; ++k) {
+            Assert(tree.vm.applyUpdate(v1, INVALID_VERSION, k * 4, k), "insert failed");
+        }
+        Assert(tree.vm.commitVersion(v1), "commit failed");
+
+        // Committed before the filter was attached: nothing registered until buildLeafFilters().
+        tree.vm.setLeafFilter(&tree.filters);
+        Assert(tree.filters.leafCount() == 0, "no filters yet");
+        version_t v2 = tree.vm.createVersion();
+        Assert(!tree.vm.buildLeafFilters(v2), "only committed versions can be filtered");
+        Assert(tree.vm.buildLeafFilters(v1) && tree.filters.leafCount() >= 5000 / adapter::MAX_KEYS, "buildLeafFilters");
+        size_t v1_leaves = tree.filters.leafCount();
+        Assert(tree.vm.buildLeafFilters(v1) && tree.filters.leafCount() == v1_leaves, "buildLeafFilters is idempotent");
+
+        tree.filters.resetStats();
+        for (KeyType k = 0; k < 20000; ++k) {
+            ValueType val = -1;
+            bool found = tree.vm.lookup(v1, k, &val);
+            Assert(found == (k % 4 == 0) && (!found || val == k / 4), "lookup " + std::to_string(k));
+        }
+        Assert(tree.filters.stats().negatives > 14000, "most absent keys skip the leaf");
+
+        // The active version reads its own (unregistered) leaves.
+        for (KeyType k = 0; k < 500; ++k) {
+            Assert(tree.vm.applyUpdate(v2, v1, k * 4 + 1, -k), "update failed");
+        }
+        ValueType val = 0;
+        Assert(tree.vm.lookup(v2, 401, &val) && val == -100, "active version sees its insert");
+        Assert(tree.vm.lookup(v2, 400, &val) && val == 100, "active version sees shared leaves");
+        Assert(tree.vm.commitVersion(v2) && tree.filters.leafCount() > v1_leaves, "new leaves registered on commit");
+        Assert(tree.vm.lookup(v2, 1997, &val) && val == -499, "committed version after filtering");
+        Assert(!tree.vm.lookup(v1, 401, &val), "old snapshot unchanged");
+    }
+    Cleanup();
+    Log(">>> PASSED: Point Lookups.");
+}
+
+// 4. Filters outgrowing the pool.
+void TestOutgrowPool() {
+    Log("--- Test 4: Filters Outgrow The Pool ---");
+    Cleanup();
+    {
+        const size_t pool_size = 32;
+        Tree<KeyType> tree(pool_size);
+        tree.vm.setLeafFilter(&tree.filters);
+
+        // Batches of random inserts, one version each: every commit registers the leaves it copied.
+        std::map<KeyType, ValueType> expected;
+        std::mt19937_64 rng(5);
+        version_t parent = INVALID_VERSION;
+        auto commitBatch = [&](int batch) {
+            version_t v = tree.vm.createVersion();
+            for (int i = 0; i < 1000; ++i) {
+                KeyType key = static_cast<KeyType>(rng() % 1000000) * 2;
+                Assert(tree.vm.applyUpdate(v, parent, key, batch), "insert failed in batch " + std::to_string(batch));
+                expected[key] = batch;
+            }
+            Assert(tree.vm.commitVersion(v), "commit failed in batch " + std::to_string(batch));
+            parent = v;
+        };
+        int batch = 0;
+        while (tree.filters.leafCount() <= 2 * LeafBloomFilters::FILTERS_PER_PAGE * pool_size) {
+            commitBatch(batch++);
+        }
+        Log(std::to_string(tree.filters.leafCount()) + " filtered leaves after " + std::to_string(batch) + " batches; "
+            + std::to_string(tree.filters.pageCount()) + " filter pages for a " + std::to_string(pool_size) + "-frame pool");
+        Assert(tree.bpm.GetStats().pinned_frames == 0, "filters pin no frames");
+
+        // Persist, keep writing, then reload into fresh filters.
+        page_id_t first_page_id = tree.filters.flush();
+        Assert(first_page_id != INVALID_PAGE_ID, "flush");
+        for (int i = 0; i < 5; ++i) {
+            commitBatch(batch++);
+        }
+        Assert(tree.filters.flush() == first_page_id, "incremental flush keeps the chain");
+
+        LeafBloomFilters loaded(&tree.bpm_adapter);
+        Assert(loaded.load(first_page_id) && loaded.leafCount() == tree.filters.leafCount(), "load");
+        tree.vm.setLeafFilter(&loaded);
+        for (const auto& [key, val] : expected) {
+            ValueType found = -1;
+            Assert(tree.vm.lookup(parent, key, &found) && found == val, "lookup through loaded filters");
+        }
+        loaded.resetStats();
+        for (KeyType k = 1; k < 200000; k += 2) {
+            ValueType found = -1;
+            Assert(!tree.vm.lookup(parent, k, &found), "odd keys are absent");
+        }
+        Assert(loaded.stats().negatives > 90000, "loaded filters rule out absent keys");
+    }
+    Cleanup();
+    Log(">>> PASSED: Filters Outgrow The Pool.");
+}
+
+int main() {
+    TestFilters();
+    TestTimelineMisses();
+    TestPointLookups();
+    TestOutgrowPool();
+    Cleanup();
+
+    Log("ALL LEAF BLOOM FILTER TESTS PASSED");
+    return 0;
+}
@@ -0,0 +1,70 @@
+/**
+ * log_store_fixture.h
+ *
+ * Shared fixture of the query tests: the storage stack (disk -> buffer pool -> adapter), a
+ * LogStore with the event-type bitmap index, and a populated copy of the records.
+ * Tests extend it with the indexes they need (see query_planner_test.cpp).
+ */
+
+#pragma once
+
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/bufferpool/buffer_pool_adapter.h"
+#include "../src/index/bitmap_index.h"
+#include "../src/storage/log_store.h"
+#include "../src/utils/log_manager.h"
+
+const std::vector<std::string> EVENTS = { "START", "STOP", "RESTART", "ERROR", "WARNING", "DEPLOY" };
+
+struct LogStoreFixture {
+    cmse::disk::DiskManager disk;
+    cmse::bufferpool::BufferPoolManager bpm;
+    cmse::bufferpool::BufferPoolManagerAdapter bpm_adapter;
+    cmse::storage::LogStore store;
+    cmse::index::BitmapIndex events;
+    std::vector<cmse::LogRecord> logs;
+
+    using NameFn = std::function<std::string(int64_t resource_id)>;
+    using AppendFn = std::function<bool(const cmse::LogRecord& record, cmse::record_id_t rid)>;
+
+    LogStoreFixture(const std::string& db_file, size_t pool_size)
+        : disk(db_file), bpm(pool_size, &disk), bpm_adapter(&bpm), store(&bpm_adapter), events(&bpm_adapter) {
+        store.addListener(&events);
+    }
+
+    /**
+     * Appends 'count' synthetic records: resource ids uniform over 1000..1199, event types drawn
+     * from EVENTS with 'event_weights'. 'name_of' (optional) renames each record after its
+     * resource id; 'on_append' (optional) is called with every stored record.
+     * @return false if an append (or on_append) failed.
+     */
+    bool populate(int count, uint32_t seed, const std::vector<double>& event_weights,
+        const NameFn& name_of = nullptr, const AppendFn& on_append = nullptr) {
+        logs = cmse::utils::LogManager::generateSyntheticLogs(count);
+        std::mt19937 rng(seed);
+        std::discrete_distribution<int> pick(event_weights.begin(), event_weights.end());
+
+        for (auto& record : logs) {
+            record.resource_id = 1000 + static_cast<int64_t>(rng() % 200);
+            if (name_of) {
+                std::string name = name_of(record.resource_id);
+                std::memset(record.resource_name, 0, sizeof(record.resource_name));
+                std::memcpy(record.resource_name, name.data(), name.size());
+            }
+            const std::string& type = EVENTS[pick(rng)];
+            std::memset(record.event_type, 0, sizeof(record.event_type));
+            std::memcpy(record.event_type, type.data(), type.size());
+
+            cmse::record_id_t rid = store.append(record);
+            if (rid == cmse::INVALID_RECORD_ID || (on_append && !on_append(record, rid))) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
@@ -9,6 +9,8 @@
  * Fetching it again should read from disk (which might be empty if not flushed), not return stale cache.
  * 3. All Pinned (Buffer Full): Filling the buffer with pinned pages and requesting more
  * should handle failure gracefully (return nullptr) without crashing.
+ * 4. Frame Arena: with and without huge pages, every frame is PAGE_SIZE-aligned, zero-filled
+ * and keeps its data through eviction and re-fetch.
  */
 
 #include <iostream>
@@ -19,8 +21,10 @@
 #include <cassert>
 #include <filesystem>
 #include <thread>
+#include <cstdint>
 
 #include "../src/bufferpool/buffer_pool_manager.h"
+#include "../src/bufferpool/frame_arena.h"
 
 const std::string DB_FILE = "test_memory_edge.db";
 
@@ -168,8 +172,71 @@ void TestAllPinned() {
     delete disk_manager;
 }
 
+// =================================================================
+// Scenario 3: Frame Arena
+// Objective:
+//   - Both huge-page policies give page-aligned, zero-filled frames (direct I/O ready).
+//   - A pool twice over-subscribed returns every page's data after eviction.
+//   - Whatever the platform offers, the fallback chain ends in a usable arena.
+// =================================================================
+void TestFrameArena() {
+    Log("\n--- Scenario 3: Frame Arena ---");
+    using cmse::bufferpool::HugePagePolicy;
+
+    for (HugePagePolicy policy : { HugePagePolicy::Off, HugePagePolicy::Auto }) {
+        // Big enough (4MB) for the Auto policy to try huge pages.
+        cmse::bufferpool::FrameArena arena(1024 * cmse::PAGE_SIZE, policy);
+        if (arena.Data() == nullptr || reinterpret_cast<uintptr_t>(arena.Data()) % cmse::PAGE_SIZE != 0) {
+            Log("!!! FAILED: arena not PAGE_SIZE-aligned");
+            exit(1);
+        }
+        for (size_t i = 0; i < arena.Size(); i += 4093) {
+            if (arena.Data()[i] != 0) {
+                Log("!!! FAILED: arena not zero-filled");
+                exit(1);
+            }
+        }
+        if (policy == HugePagePolicy::Off && (arena.Backing() == cmse::bufferpool::ArenaBacking::TransparentHuge
+            || arena.Backing() == cmse::bufferpool::ArenaBacking::ExplicitHuge)) {
+            Log("!!! FAILED: policy Off got huge pages");
+            exit(1);
+        }
+        Log(std::string("Arena backing: ") + cmse::bufferpool::ArenaBackingName(arena.Backing()));
+
+        Cleanup();
+        const size_t POOL_SIZE = 600;
+        auto* disk_manager = new cmse::disk::DiskManager(DB_FILE);
+        auto* bpm = new cmse::bufferpool::BufferPoolManager(POOL_SIZE, disk_manager, policy);
+        for (size_t i = 0; i < 2 * POOL_SIZE; ++i) {
+            cmse::page_id_t pid;
+            auto* page = bpm->NewPage(pid);
+            if (page == nullptr || reinterpret_cast<uintptr_t>(page->GetHeader()) % cmse::PAGE_SIZE != 0) {
+                Log("!!! FAILED: frame missing or not PAGE_SIZE-aligned");
+                exit(1);
+            }
+            std::memcpy(page->GetData(), &i, sizeof(i));
+            bpm->UnpinPage(pid, true);
+        }
+        for (size_t i = 0; i < 2 * POOL_SIZE; ++i) {
+            auto* page = bpm->FetchPage(static_cast<cmse::page_id_t>(i));
+            size_t value = 0;
+            std::memcpy(&value, page->GetData(), sizeof(value));
+            bpm->UnpinPage(static_cast<cmse::page_id_t>(i), false);
+            if (value != i) {
+                Log("!!! FAILED: page " + std::to_string(i) + " lost its data through eviction");
+                exit(1);
+            }
+        }
+        Log(std::string("Pool backing: ") + cmse::bufferpool::ArenaBackingName(bpm->GetArenaBacking()));
+        delete bpm;
+        delete disk_manager;
+    }
+    Log(">>> PASSED: Frame Arena.");
+}
+
 int main() {
     TestDeletePageLogic();
     TestAllPinned();
+    TestFrameArena();
     return 0;
 }
\ No newline at end of file
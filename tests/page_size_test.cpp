@@ -0,0 +1,233 @@
+/**
+ * page_size_test.cpp
+ *
+ * Verifies the page-size template parameter:
+ * 1. 16KB and 64KB files: every byte of a page round-trips through eviction and a reopen,
+ *    and the file grows by the page size per page.
+ * 2. Files with different page sizes are used side by side, through the adapter interface.
+ * 3. The B+Tree and the trie on 16KB and 64KB pages: node capacity follows the page size,
+ *    and lookups, scans and posting chains behave as on 4KB pages.
+ */
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <vector>
+#include <filesystem>
+
+#include "../src/bufferpool/buffer_pool_adapter.h"
+#include "../src/index/trie_index.h"
+#include "versioned_tree_fixture.h"
+
+using namespace cmse;
+
+const std::string DB_FILE_SMALL = "test_page_size_4k.db";
+const std::string DB_FILE_LARGE = "test_page_size_large.db";
+
+void Cleanup() {
+    std::filesystem::remove(DB_FILE_SMALL);
+    std::filesystem::remove(DB_FILE_LARGE);
+}
+
+void Log(const std::string& msg) {
+    std::cout << "[PAGE_SIZE_TEST] " << msg << std::endl;
+}
+
+void Assert(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "!!! FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+// Fills a page's payload with a pattern derived from its id (first and last byte included).
+template <size_t PageSize>
+void Fill(BasicPage<PageSize>* page, page_id_t pid) {
+    char* data = page->GetData();
+    for (size_t i = 0; i < PageSize - sizeof(PageHeader); ++i) {
+        data[i] = static_cast<char>((pid * 31 + i) & 0x7F);
+    }
+}
+
+template <size_t PageSize>
+bool Check(BasicPage<PageSize>* page, page_id_t pid) {
+    const char* data = page->GetData();
+    for (size_t i = 0; i < PageSize - sizeof(PageHeader); ++i) {
+        if (data[i] != static_cast<char>((pid * 31 + i) & 0x7F)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <size_t PageSize>
+void TestRoundTrip() {
+    Log("--- Test 1: " + std::to_string(PageSize / 1024) + "KB Round Trip ---");
+    Cleanup();
+    const page_id_t num_pages = 24;
+    {
+        disk::BasicDiskManager<PageSize> disk(DB_FILE_LARGE);
+        bufferpool::BasicBufferPoolManager<PageSize> bpm(4, &disk);
+        for (page_id_t i = 0; i < num_pages; ++i) {
+            page_id_t pid;
+            BasicPage<PageSize>* page = bpm.NewPage(pid);
+            Assert(page != nullptr && pid == i, "NewPage");
+            Fill(page, pid);
+            bpm.UnpinPage(pid, true); // Evicted (written back) by later pages
+        }
+        Assert(bpm.GetStats().bytes_written >= (num_pages - 4) * PageSize, "write-back in whole pages");
+        for (page_id_t i = 0; i < num_pages; i += 5) {
+            BasicPage<PageSize>* page = bpm.FetchPage(i);
+            Assert(page != nullptr && Check(page, i), "read back after eviction");
+            bpm.UnpinPage(i, false);
+        }
+    }
+    Assert(std::filesystem::file_size(DB_FILE_LARGE) == num_pages * PageSize, "file is num_pages * page size");
+    {
+        disk::BasicDiskManager<PageSize> disk(DB_FILE_LARGE);
+        bufferpool::BasicBufferPoolManager<PageSize> bpm(8, &disk);
+        for (page_id_t i = 0; i < num_pages; ++i) {
+            BasicPage<PageSize>* page = bpm.FetchPage(i);
+            Assert(page != nullptr && Check(page, i), "read back after reopen");
+            bpm.UnpinPage(i, false);
+        }
+        Assert(bpm.GetStats().bytes_read == num_pages * PageSize, "reads in whole pages");
+    }
+    Cleanup();
+    Log(">>> PASSED: Round Trip.");
+}
+
+// Writes through the adapter interface only.
+template <size_t PageSize>
+page_id_t WriteThrough(adapter::BasicBufferPoolAdapter<PageSize>* pool, const std::string& text) {
+    page_id_t pid;
+    BasicPage<PageSize>* page = pool->NewPage(pid);
+    Assert(page != nullptr, "adapter NewPage");
+    std::memcpy(page->GetData(), text.c_str(), text.size() + 1);
+    pool->UnpinPage(pid, true);
+    return pid;
+}
+
+void TestMixedSizes() {
+    Log("--- Test 2: Mixed Page Sizes ---");
+    Cleanup();
+    {
+        disk::DiskManager small_disk(DB_FILE_SMALL);
+        bufferpool::BufferPoolManager small_bpm(8, &small_disk);
+        bufferpool::BufferPoolManagerAdapter small_pool(&small_bpm);
+
+        disk::BasicDiskManager<32768> large_disk(DB_FILE_LARGE);
+        bufferpool::BasicBufferPoolManager<32768> large_bpm(8, &large_disk);
+        bufferpool::BasicBufferPoolManagerAdapter<32768> large_pool(&large_bpm);
+
+        for (int i = 0; i < 10; ++i) {
+            WriteThrough(&small_pool, "small-" + std::to_string(i));
+            WriteThrough(&large_pool, "large-" + std::to_string(i));
+        }
+        small_pool.FlushAll();
+        large_pool.FlushAll();
+
+        Assert(std::filesystem::file_size(DB_FILE_SMALL) == 10 * PAGE_SIZE, "4KB file");
+        Assert(std::filesystem::file_size(DB_FILE_LARGE) == 10 * 32768, "32KB file");
+        for (page_id_t i = 0; i < 10; ++i) {
+            Page* small = small_pool.FetchPage(i);
+            BasicPage<32768>* large = large_pool.FetchPage(i);
+            Assert(std::string(small->GetData()) == "small-" + std::to_string(i), "small page");
+            Assert(std::string(large->GetData()) == "large-" + std::to_string(i), "large page");
+            small_pool.UnpinPage(i, false);
+            large_pool.UnpinPage(i, false);
+        }
+    }
+    Cleanup();
+    Log(">>> PASSED: Mixed Page Sizes.");
+}
+
+// Loads 'count' keys in key order (value = key * 3), commits, and returns the file's page count.
+template <size_t PageSize>
+size_t LoadTree(VersionedTreeFixture<KeyType, PageSize>& tree, const std::string& db_file, int64_t count) {
+    version_t v = tree.vm.createVersion();
+    for (int64_t k = 0; k < count; ++k) {
+        Assert(tree.vm.applyUpdate(v, INVALID_VERSION, k, k * 3), "applyUpdate");
+    }
+    Assert(tree.vm.commitVersion(v), "commitVersion");
+    tree.bpm_adapter.FlushAll();
+    return std::filesystem::file_size(db_file) / PageSize;
+}
+
+template <size_t PageSize>
+void TestIndexes() {
+    Log("--- Test 3: " + std::to_string(PageSize / 1024) + "KB Indexes ---");
+    Cleanup();
+    const int64_t num_keys = 50000;
+
+    static_assert(adapter::BasicBTreeAdapter<KeyType, PageSize>::MAX_KEYS > adapter::MAX_KEYS, "bigger nodes");
+    static_assert(adapter::BasicTrieAdapter<PageSize>::MAX_POSTINGS > adapter::MAX_TRIE_POSTINGS, "bigger posting pages");
+    {
+        size_t small_pages;
+        {
+            VersionedTreeFixture<KeyType> small(DB_FILE_SMALL, 16);
+            small_pages = LoadTree(small, DB_FILE_SMALL, num_keys);
+        }
+        VersionedTreeFixture<KeyType, PageSize> tree(DB_FILE_LARGE, 16);
+        size_t pages = LoadTree(tree, DB_FILE_LARGE, num_keys);
+        Assert(pages * 4 < small_pages, "bigger nodes: far fewer pages (" + std::to_string(pages) + " vs " + std::to_string(small_pages) + ")");
+
+        version_t v = tree.vm.latestVersion();
+        for (int64_t k = 0; k < num_keys; k += 97) {
+            ValueType value;
+            Assert(tree.vm.lookup(v, k, &value) && value == k * 3, "lookup " + std::to_string(k));
+        }
+        ValueType value;
+        Assert(!tree.vm.lookup(v, num_keys, &value), "absent key");
+
+        std::vector<std::pair<KeyType, ValueType>> entries;
+        Assert(tree.vm.scanRange(v, 1000, 40999, num_keys, &entries), "scanRange");
+        Assert(entries.size() == 40000 && entries.front().first == 1000 && entries.back().first == 40999, "scanRange bounds");
+        for (size_t i = 0; i < entries.size(); ++i) {
+            Assert(entries[i].first == static_cast<KeyType>(1000 + i) && entries[i].second == entries[i].first * 3, "scanRange order");
+        }
+    }
+    Cleanup();
+    {
+        disk::BasicDiskManager<PageSize> disk(DB_FILE_LARGE);
+        bufferpool::BasicBufferPoolManager<PageSize> bpm(16, &disk);
+        bufferpool::BasicBufferPoolManagerAdapter<PageSize> pool(&bpm);
+        page_id_t root;
+        const int postings = 2 * adapter::BasicTrieAdapter<PageSize>::MAX_POSTINGS + 1;
+        {
+            index::BasicTrieIndex<PageSize> trie(&pool);
+            for (int i = 0; i < 200; ++i) {
+                Assert(trie.insert("svc-" + std::to_string(i), i), "trie insert");
+            }
+            for (int i = 0; i < postings; ++i) {
+                Assert(trie.insert("svc-hot", 1000 + i), "trie posting insert");
+            }
+            Assert(trie.postingPageCount() >= 2, "posting chain spans pages");
+            root = trie.flush();
+        }
+        index::BasicTrieIndex<PageSize> trie(&pool);
+        Assert(trie.load(root), "trie load");
+        Assert(trie.size() == 201, "distinct keys");
+        ValueType value;
+        Assert(trie.lookup("svc-42", &value) && value == 42, "trie lookup");
+        std::vector<ValueType> values;
+        Assert(trie.lookupAll("svc-hot", &values) && values.size() == static_cast<size_t>(postings), "posting chain");
+        Assert(values.front() == 1000 && values.back() == 1000 + postings - 1, "posting order");
+        std::vector<typename index::BasicTrieIndex<PageSize>::Entry> entries;
+        Assert(trie.prefixScan("svc-1", 1000, &entries) && entries.size() == 111, "prefixScan");
+    }
+    Cleanup();
+    Log(">>> PASSED: Indexes.");
+}
+
+int main() {
+    TestRoundTrip<16384>();
+    TestRoundTrip<65536>();
+    TestMixedSizes();
+    TestIndexes<16384>();
+    TestIndexes<65536>();
+    Cleanup();
+
+    Log("ALL PAGE SIZE TESTS PASSED");
+    return 0;
+}
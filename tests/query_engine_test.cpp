@@ -0,0 +1,390 @@
+/**
+ * query_engine_test.cpp
+ *
+ * Verifies the vectorized push-based query engine:
+ * 1. Filter kernels (compare / symbol match / selection compaction) match a scalar reference.
+ * 2. Scan -> filter -> project returns exactly the brute-force rows for any batch size.
+ * 3. Hash aggregation (count/sum/min/max, multi-column keys) matches a std::map reference.
+ * 4. Top-N and LIMIT (including early termination of the source).
+ * 5. Index sources: bitmap index record ids and composite B+Tree ranges (ascending, and
+ *    descending with ORDER BY / LIMIT pushed into the scan).
+ * 6. Plan errors (unknown columns, type mismatches) are reported.
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <random>
+#include <cstring>
+#include <filesystem>
+
+#include "../src/adapter/btree_adapter.h"
+#include "../src/bufferpool/buffer_pool_adapter.h"
+#include "../src/common/key_traits.h"
+#include "../src/index/bitmap_index.h"
+#include "../src/query/pipeline.h"
+#include "../src/storage/log_store.h"
+#include "../src/utils/log_manager.h"
+#include "../src/versioning/version_manager.h"
+#include "log_store_fixture.h"
+
+using namespace cmse;
+using namespace cmse::query;
+using storage::LogStore;
+
+const std::string DB_FILE = "test_query_engine.db";
+
+void Cleanup() {
+    std::filesystem::remove(DB_FILE);
+}
+
+void Log(const std::string& msg) {
+    std::cout << "[QUERY_TEST] " << msg << std::endl;
+}
+
+void Assert(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "!!! FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+int64_t Int(const Value& value) {
+    return std::get<int64_t>(value);
+}
+
+// A populated log store (random events, 200 resources).
+struct Fixture : LogStoreFixture {
+    explicit Fixture(int count) : LogStoreFixture(DB_FILE, 128) {
+        Assert(populate(count, 7, { 40, 25, 10, 3, 15, 7 }), "populate failed");
+    }
+};
+
+// 1. Kernels.
+void TestKernels() {
+    Log("--- Test 1: Filter Kernels (" + std::string(filterKernelIsa()) + ") ---");
+    std::mt19937_64 rng(1);
+    for (size_t n : { size_t{ 0 }, size_t{ 1 }, size_t{ 3 }, size_t{ 4 }, size_t{ 5 }, size_t{ 1023 }, size_t{ 4096 } }) {
+        std::vector<int64_t> values(n);
+        for (auto& v : values) {
+            v = static_cast<int64_t>(rng() % 21) - 10; // Many duplicates and negatives
+        }
+        values.push_back(INT64_MIN); // Extremes in the tail
+        values.push_back(INT64_MAX);
+        std::vector<uint8_t> mask(values.size());
+
+        for (CompareOp op : { CompareOp::Eq, CompareOp::Ne, CompareOp::Lt, CompareOp::Le, CompareOp::Gt, CompareOp::Ge, CompareOp::Between }) {
+            compareInt64(values.data(), values.size(), op, -3, 4, mask.data());
+            for (size_t i = 0; i < values.size(); ++i) {
+                int64_t v = values[i];
+                bool expected = op == CompareOp::Eq ? v == -3 : op == CompareOp::Ne ? v != -3 : op == CompareOp::Lt ? v < -3
+                    : op == CompareOp::Le ? v <= -3 : op == CompareOp::Gt ? v > -3 : op == CompareOp::Ge ? v >= -3 : (v >= -3 && v <= 4);
+                Assert(mask[i] == (expected ? 1 : 0), "compareInt64 mismatch at n=" + std::to_string(n) + " i=" + std::to_string(i));
+            }
+        }
+
+        std::vector<Symbol> symbols(n);
+        for (auto& s : symbols) {
+            s = Symbol::from(EVENTS[rng() % EVENTS.size()]);
+        }
+        std::vector<uint8_t> sym_mask(n, 0);
+        matchSymbol(symbols.data(), n, Symbol::from("ERROR"), sym_mask.data());
+        matchSymbol(symbols.data(), n, Symbol::from("STOP"), sym_mask.data());
+        for (size_t i = 0; i < n; ++i) {
+            std::string s = symbols[i].str();
+            Assert(sym_mask[i] == ((s == "ERROR" || s == "STOP") ? 1 : 0), "matchSymbol mismatch");
+        }
+        Assert(!(Symbol::from("ERROR") == Symbol::from("ERRORS")), "symbol prefix must not match");
+
+        // Compaction in place over a sparse selection.
+        std::vector<uint16_t> selection;
+        for (size_t i = 0; i < n; i += 3) {
+            selection.push_back(static_cast<uint16_t>(i));
+        }
+        std::vector<uint16_t> expected;
+        for (uint16_t row : selection) {
+            if (sym_mask[row]) {
+                expected.push_back(row);
+            }
+        }
+        size_t kept = compactSelection(sym_mask.data(), selection.data(), selection.size(), selection.data());
+        selection.resize(kept);
+        Assert(selection == expected, "compactSelection mismatch");
+    }
+    Log(">>> PASSED: Filter Kernels.");
+}
+
+// 2. Scan + filter + project.
+void TestScanFilterProject(Fixture& fx) {
+    Log("--- Test 2: Scan / Filter / Project ---");
+    int64_t t0 = LogStore::timestampMillis(fx.logs[0]);
+    int64_t t1 = t0 + 100 * 3000;
+    int64_t t2 = t0 + 100 * 17000;
+
+    std::vector<std::pair<int64_t, std::string>> expected; // (rid, resource_name)
+    for (size_t i = 0; i < fx.logs.size(); ++i) {
+        const LogRecord& r = fx.logs[i];
+        int64_t ts = LogStore::timestampMillis(r);
+        std::string type = index::BitmapIndex::eventTypeOf(r);
+        if (ts >= t1 && ts <= t2 && r.resource_id < 1050 && (type == "ERROR" || type == "RESTART")) {
+            expected.emplace_back(static_cast<int64_t>(i), r.resource_name);
+        }
+    }
+    Assert(!expected.empty(), "query should match something");
+
+    for (size_t batch_size : { size_t{ 1 }, size_t{ 7 }, BATCH_SIZE, MAX_BATCH_SIZE }) {
+        auto source = std::make_unique<LogScanSource>(&fx.store);
+        source->setBatchSize(batch_size);
+        Pipeline pipeline(std::move(source));
+        pipeline.filter({ Predicate::between("timestamp", t1, t2),
+                          Predicate::compare("resource_id", CompareOp::Lt, 1050),
+                          Predicate::in("event_type", { "ERROR", "RESTART" }) })
+            .project({ "resource_name", "rid" });
+
+        ResultSet result;
+        std::string error;
+        Assert(pipeline.execute(&result, &error), "execute failed: " + error);
+        Assert(result.schema.names == std::vector<std::string>({ "resource_name", "rid" }), "projected schema");
+        Assert(result.rows.size() == expected.size(), "row count for batch size " + std::to_string(batch_size));
+        for (size_t i = 0; i < expected.size(); ++i) {
+            Assert(Int(result.at(i, "rid")) == expected[i].first, "rid mismatch");
+            Assert(std::get<std::string>(result.at(i, "resource_name")) == expected[i].second, "name mismatch");
+        }
+    }
+
+    // Text predicate on a projected-away column is evaluated before the projection.
+    Pipeline by_name(std::make_unique<LogScanSource>(&fx.store, std::vector<LogColumn>{ LogColumn::RecordId, LogColumn::ResourceName }));
+    by_name.filter({ Predicate::equals("resource_name", "vm-node-7") }).project({ "rid" });
+    ResultSet names;
+    Assert(by_name.execute(&names), "text filter failed");
+    size_t count = 0;
+    for (const auto& r : fx.logs) {
+        count += std::string(r.resource_name) == "vm-node-7";
+    }
+    Assert(names.rows.size() == count && names.schema.size() == 1, "text filter row count");
+    Log(">>> PASSED: Scan / Filter / Project.");
+}
+
+// 3. Aggregation.
+void TestAggregate(Fixture& fx) {
+    Log("--- Test 3: Hash Aggregate ---");
+    struct Acc { int64_t count = 0, sum = 0, min = INT64_MAX, max = INT64_MIN; };
+    std::map<std::pair<int64_t, std::string>, Acc> expected;
+    for (size_t i = 0; i < fx.logs.size(); ++i) {
+        Acc& acc = expected[{ fx.logs[i].resource_id, index::BitmapIndex::eventTypeOf(fx.logs[i]) }];
+        int64_t ts = LogStore::timestampMillis(fx.logs[i]);
+        acc.count++;
+        acc.sum += static_cast<int64_t>(i);
+        acc.min = std::min(acc.min, ts);
+        acc.max = std::max(acc.max, ts);
+    }
+
+    Pipeline pipeline(std::make_unique<LogScanSource>(&fx.store));
+    pipeline.aggregate({ "resource_id", "event_type" }, { AggregateSpec::count("n"), AggregateSpec::sum("rid", "rid_sum"),
+                                                          AggregateSpec::min("timestamp", "first"), AggregateSpec::max("timestamp", "last") });
+    ResultSet result;
+    std::string error;
+    Assert(pipeline.execute(&result, &error), "aggregate failed: " + error);
+    Assert(result.rows.size() == expected.size(), "group count");
+    for (size_t i = 0; i < result.rows.size(); ++i) {
+        auto key = std::make_pair(Int(result.at(i, "resource_id")), std::get<std::string>(result.at(i, "event_type")));
+        auto it = expected.find(key);
+        Assert(it != expected.end(), "unexpected group");
+        Assert(Int(result.at(i, "n")) == it->second.count && Int(result.at(i, "rid_sum")) == it->second.sum, "count/sum");
+        Assert(Int(result.at(i, "first")) == it->second.min && Int(result.at(i, "last")) == it->second.max, "min/max");
+    }
+
+    // Global aggregate, also over an empty input.
+    Pipeline total(std::make_unique<LogScanSource>(&fx.store));
+    total.aggregate({}, { AggregateSpec::count("n") });
+    Assert(total.execute(&result) && result.rows.size() == 1 && Int(result.at(0, "n")) == static_cast<int64_t>(fx.logs.size()), "global count");
+
+    Pipeline none(std::make_unique<LogScanSource>(&fx.store));
+    none.filter({ Predicate::equals("event_type", "NOPE") }).aggregate({}, { AggregateSpec::count("n") });
+    Assert(none.execute(&result) && result.rows.size() == 1 && Int(result.at(0, "n")) == 0, "count over empty input");
+    Log(">>> PASSED: Hash Aggregate.");
+}
+
+// 4. Top-N and limit.
+void TestTopNLimit(Fixture& fx) {
+    Log("--- Test 4: Top-N / Limit ---");
+    std::map<int64_t, int64_t> errors;
+    for (const auto& r : fx.logs) {
+        if (index::BitmapIndex::eventTypeOf(r) == "ERROR") {
+            errors[r.resource_id]++;
+        }
+    }
+    // Groups with equal counts may come in any order, so compare the counts.
+    std::vector<int64_t> counts;
+    for (const auto& [rid, n] : errors) {
+        counts.push_back(n);
+    }
+    std::sort(counts.rbegin(), counts.rend());
+
+    Pipeline pipeline(std::make_unique<LogScanSource>(&fx.store));
+    pipeline.filter({ Predicate::equals("event_type", "ERROR") })
+        .aggregate({ "resource_id" }, { AggregateSpec::count("errors") })
+        .topN("errors", 5);
+    ResultSet result;
+    Assert(pipeline.execute(&result), "top-n failed");
+    Assert(result.rows.size() == 5, "top-n size");
+    for (size_t i = 0; i < 5; ++i) {
+        Assert(Int(result.at(i, "errors")) == counts[i], "top-n order");
+        Assert(errors[Int(result.at(i, "resource_id"))] == counts[i], "top-n group value");
+    }
+
+    // Ascending top-N over raw rows: earliest 10 timestamps == first 10 records.
+    Pipeline earliest(std::make_unique<LogScanSource>(&fx.store));
+    earliest.topN("timestamp", 10, false);
+    Assert(earliest.execute(&result) && result.rows.size() == 10, "ascending top-n");
+    for (size_t i = 0; i < 10; ++i) {
+        Assert(Int(result.at(i, "rid")) == static_cast<int64_t>(i), "ascending top-n order");
+    }
+
+    // LIMIT stops the scan early.
+    auto source = std::make_unique<LogScanSource>(&fx.store);
+    source->setBatchSize(256);
+    Source* raw = source.get();
+    Pipeline limited(std::move(source));
+    limited.filter({ Predicate::in("event_type", { "START" }) }).limit(100);
+    Assert(limited.execute(&result) && result.rows.size() == 100, "limit size");
+    Assert(raw->rowsProduced() < fx.logs.size() / 10, "limit should stop the source early");
+    for (const auto& row : result.rows) {
+        Assert(std::get<std::string>(row[4]) == "START", "limit rows are filtered");
+    }
+
+    Pipeline zero(std::make_unique<LogScanSource>(&fx.store));
+    zero.limit(0);
+    Assert(zero.execute(&result) && result.rows.empty(), "limit 0");
+    Log(">>> PASSED: Top-N / Limit.");
+}
+
+// 5. Index sources.
+void TestIndexSources(Fixture& fx) {
+    Log("--- Test 5: Index Sources ---");
+    // Bitmap: ERROR records in a time window, aggregated per resource.
+    int64_t t0 = LogStore::timestampMillis(fx.logs[0]);
+    index::RoaringBitmap window;
+    Assert(fx.store.timeRange(t0 + 100000, t0 + 900000, &window), "timeRange");
+    index::RoaringBitmap hits = fx.events.anyOf({ "ERROR" }, window);
+
+    Pipeline from_bitmap(std::make_unique<RecordIdSource>(&fx.store, hits));
+    from_bitmap.aggregate({}, { AggregateSpec::count("n") });
+    ResultSet a;
+    Assert(from_bitmap.execute(&a) && Int(a.at(0, "n")) == static_cast<int64_t>(hits.cardinality()), "bitmap source count");
+
+    Pipeline by_scan(std::make_unique<LogScanSource>(&fx.store));
+    by_scan.filter({ Predicate::between("timestamp", t0 + 100000, t0 + 900000), Predicate::equals("event_type", "ERROR") })
+        .aggregate({}, { AggregateSpec::count("n") });
+    ResultSet b;
+    Assert(by_scan.execute(&b) && Int(b.at(0, "n")) == Int(a.at(0, "n")), "bitmap source equals scan");
+
+    // B+Tree: the (resource_id, timestamp) index yields one resource's timeline in time order.
+    adapter::CompositeBTreeAdapter tree_adapter;
+    versioning::CompositeVersionManager tree(&fx.bpm_adapter, &tree_adapter);
+    version_t v = tree.createVersion();
+    for (size_t i = 0; i < fx.logs.size(); ++i) {
+        Assert(tree.applyUpdate(v, INVALID_VERSION, ResourceTimeKey::fromRecord(fx.logs[i]), static_cast<ValueType>(i)), "index insert");
+    }
+    tree.commitVersion(v);
+
+    const int64_t resource = 1042;
+    auto source = std::make_unique<IndexRangeSource<ResourceTimeKey>>(&tree, v, ResourceTimeKey::prefixBegin(resource),
+        ResourceTimeKey::prefixEnd(resource), &fx.store, std::vector<LogColumn>{ LogColumn::Timestamp, LogColumn::ResourceId, LogColumn::EventType });
+    source->setBatchSize(16);
+    Pipeline timeline(std::move(source));
+    timeline.filter({ Predicate::in("event_type", { "ERROR", "RESTART" }) });
+    ResultSet c;
+    Assert(timeline.execute(&c), "index source failed");
+
+    size_t expected = 0;
+    for (const auto& r : fx.logs) {
+        std::string type = index::BitmapIndex::eventTypeOf(r);
+        expected += r.resource_id == resource && (type == "ERROR" || type == "RESTART");
+    }
+    Assert(c.rows.size() == expected && expected > 0, "index source row count");
+    for (size_t i = 0; i < c.rows.size(); ++i) {
+        Assert(Int(c.at(i, "resource_id")) == resource, "index source leaked another resource");
+        Assert(i == 0 || Int(c.at(i - 1, "timestamp")) <= Int(c.at(i, "timestamp")), "index source not in time order");
+    }
+    Log(timeline.explain());
+
+    // Latest events first: a descending scan + filter + LIMIT returns the tail of the ascending
+    // result reversed, and the limit stops the scan after a few batches.
+    auto latest_source = std::make_unique<IndexRangeSource<ResourceTimeKey>>(&tree, v, ResourceTimeKey::prefixBegin(resource),
+        ResourceTimeKey::prefixEnd(resource), &fx.store, std::vector<LogColumn>{ LogColumn::Timestamp, LogColumn::ResourceId, LogColumn::EventType });
+    latest_source->setBatchSize(4);
+    latest_source->setDescending(true);
+    auto* latest_raw = latest_source.get();
+    Pipeline latest(std::move(latest_source));
+    latest.filter({ Predicate::in("event_type", { "ERROR", "RESTART" }) }).limit(5);
+    ResultSet d;
+    Assert(latest.execute(&d), "descending index source failed");
+    Assert(d.rows.size() == std::min<size_t>(5, c.rows.size()), "descending limit row count");
+    for (size_t i = 0; i < d.rows.size(); ++i) {
+        Assert(Int(d.at(i, "timestamp")) == Int(c.at(c.rows.size() - 1 - i, "timestamp")), "descending order");
+    }
+    size_t timeline_events = 0;
+    for (const auto& r : fx.logs) {
+        timeline_events += r.resource_id == resource;
+    }
+    Assert(latest_raw->rowsProduced() < timeline_events, "limit should stop the descending scan early");
+
+    // Limit pushed into the source itself (no filter in between).
+    auto top_source = std::make_unique<IndexRangeSource<ResourceTimeKey>>(&tree, v, ResourceTimeKey::prefixBegin(resource),
+        ResourceTimeKey::prefixEnd(resource), &fx.store, std::vector<LogColumn>{ LogColumn::Timestamp, LogColumn::ResourceId });
+    top_source->setDescending(true);
+    top_source->setLimit(3);
+    Pipeline top(std::move(top_source));
+    ResultSet e;
+    Assert(top.execute(&e) && e.rows.size() == std::min<size_t>(3, timeline_events), "source limit");
+    for (size_t i = 1; i < e.rows.size(); ++i) {
+        Assert(Int(e.at(i - 1, "timestamp")) >= Int(e.at(i, "timestamp")) && Int(e.at(i, "resource_id")) == resource, "source limit order");
+    }
+    Log(top.explain());
+    Log(">>> PASSED: Index Sources.");
+}
+
+// 6. Plan errors.
+void TestPlanErrors(Fixture& fx) {
+    Log("--- Test 6: Plan Errors ---");
+    ResultSet result;
+    std::string error;
+
+    Pipeline unknown(std::make_unique<LogScanSource>(&fx.store));
+    unknown.filter({ Predicate::compare("severity", CompareOp::Gt, 3) });
+    Assert(!unknown.execute(&result, &error) && error.find("severity") != std::string::npos, "unknown column");
+
+    Pipeline mismatch(std::make_unique<LogScanSource>(&fx.store));
+    mismatch.filter({ Predicate::equals("resource_id", "42") });
+    Assert(!mismatch.execute(&result, &error), "string predicate on int column");
+
+    Pipeline bad_agg(std::make_unique<LogScanSource>(&fx.store));
+    bad_agg.aggregate({ "resource_id" }, { AggregateSpec::sum("event_type", "s") });
+    Assert(!bad_agg.execute(&result, &error), "sum over symbol column");
+
+    Pipeline dropped(std::make_unique<LogScanSource>(&fx.store));
+    dropped.project({ "rid" }).filter({ Predicate::equals("event_type", "ERROR") });
+    Assert(!dropped.execute(&result, &error), "filter on a projected-away column");
+    Log(">>> PASSED: Plan Errors.");
+}
+
+int main() {
+    TestKernels();
+    Cleanup();
+    {
+        Fixture fx(30000);
+        TestScanFilterProject(fx);
+        TestAggregate(fx);
+        TestTopNLimit(fx);
+        TestIndexSources(fx);
+        TestPlanErrors(fx);
+    }
+    Cleanup();
+
+    Log("ALL QUERY ENGINE TESTS PASSED");
+    return 0;
+}
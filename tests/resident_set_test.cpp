@@ -0,0 +1,236 @@
+/**
+ * resident_set_test.cpp
+ *
+ * Verifies buffer pool warm-up from a persisted resident-set snapshot:
+ * 1. Snapshot files round-trip; missing, foreign and truncated files are rejected.
+ * 2. GetResidentPageIds lists pinned pages first, then most to least recently used.
+ * 3. After a restart, WarmupLoader brings back the hottest pages (bytes intact) so the
+ *    first accesses hit; it only fills free frames and never displaces traffic's pages.
+ * 4. The periodic persister writes snapshots; a background load runs alongside fetches.
+ */
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+#include "../src/bufferpool/resident_set.h"
+
+using namespace cmse::bufferpool;
+using cmse::page_id_t;
+
+const std::string DB_FILE = "test_resident_set.db";
+const std::string SNAPSHOT_FILE = "test_resident_set.snap";
+
+void Cleanup() {
+    std::filesystem::remove(DB_FILE);
+    std::filesystem::remove(SNAPSHOT_FILE);
+    std::filesystem::remove(SNAPSHOT_FILE + ".tmp");
+}
+
+void Log(const std::string& msg) {
+    std::cout << "[RESIDENT_SET_TEST] " << msg << std::endl;
+}
+
+void Assert(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "!!! FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+// Creates 'count' pages tagged with their id and flushes them.
+void WritePages(BufferPoolManager* bpm, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        page_id_t pid;
+        cmse::Page* page = bpm->NewPage(pid);
+        Assert(page != nullptr, "NewPage");
+        std::string tag = "page-" + std::to_string(pid);
+        std::memcpy(page->GetData(), tag.c_str(), tag.size() + 1);
+        bpm->UnpinPage(pid, true);
+    }
+    bpm->FlushAllPages();
+}
+
+void Touch(BufferPoolManager* bpm, page_id_t pid) {
+    cmse::Page* page = bpm->FetchPage(pid);
+    Assert(page != nullptr, "FetchPage " + std::to_string(pid));
+    Assert(std::string(page->GetData()) == "page-" + std::to_string(pid), "page bytes " + std::to_string(pid));
+    bpm->UnpinPage(pid, false);
+}
+
+void TestSnapshotFile() {
+    Log("--- Test 1: Snapshot File ---");
+    Cleanup();
+
+    std::vector<page_id_t> ids = { 42, 7, 1000, 3 };
+    Assert(WriteResidentSetFile(SNAPSHOT_FILE, ids), "write");
+    Assert(!std::filesystem::exists(SNAPSHOT_FILE + ".tmp"), "temp file renamed");
+    std::vector<page_id_t> read;
+    Assert(ReadResidentSetFile(SNAPSHOT_FILE, &read) && read == ids, "round trip keeps order");
+
+    Assert(WriteResidentSetFile(SNAPSHOT_FILE, {}) && ReadResidentSetFile(SNAPSHOT_FILE, &read) && read.empty(), "empty snapshot");
+    Assert(!ReadResidentSetFile("no_such_snapshot.snap", &read), "missing file");
+
+    // Truncate a valid snapshot inside its payload.
+    Assert(WriteResidentSetFile(SNAPSHOT_FILE, ids), "write 2");
+    std::filesystem::resize_file(SNAPSHOT_FILE, std::filesystem::file_size(SNAPSHOT_FILE) - 2);
+    Assert(!ReadResidentSetFile(SNAPSHOT_FILE, &read), "truncated file");
+    {
+        std::ofstream out(SNAPSHOT_FILE, std::ios::binary | std::ios::trunc);
+        out << "CMSETRC1 this is some other file";
+    }
+    Assert(!ReadResidentSetFile(SNAPSHOT_FILE, &read), "foreign magic");
+
+    Cleanup();
+    Log(">>> PASSED: Snapshot File.");
+}
+
+void TestResidentOrder() {
+    Log("--- Test 2: Resident Order ---");
+    Cleanup();
+    {
+        cmse::disk::DiskManager disk(DB_FILE);
+        BufferPoolManager bpm(8, &disk);
+        WritePages(&bpm, 8);
+
+        // Recency after this: 5 (MRU), 2, 6, then the rest; page 4 stays pinned.
+        Touch(&bpm, 6);
+        Touch(&bpm, 2);
+        Touch(&bpm, 5);
+        Assert(bpm.FetchPage(4) != nullptr, "pin 4");
+
+        auto ids = bpm.GetResidentPageIds();
+        Assert(ids.size() == 8, "every resident page listed");
+        Assert(ids[0] == 4 && ids[1] == 5 && ids[2] == 2 && ids[3] == 6, "pinned first, then MRU order");
+        bpm.UnpinPage(4, false);
+    }
+    Cleanup();
+    Log(">>> PASSED: Resident Order.");
+}
+
+void TestWarmRestart() {
+    Log("--- Test 3: Warm Restart ---");
+    Cleanup();
+    const size_t pool_size = 64;
+    std::vector<page_id_t> hot;
+    {
+        cmse::disk::DiskManager disk(DB_FILE);
+        BufferPoolManager bpm(pool_size, &disk);
+        WritePages(&bpm, 512);
+
+        // Working set: every 5th page; the coldest touches come first.
+        for (page_id_t pid = 0; pid < 512; pid += 5) {
+            Touch(&bpm, pid);
+        }
+        for (page_id_t pid = 255; pid < 512; pid += 5) {
+            hot.push_back(pid); // Last 52 touched: a subset that fits and is MRU
+        }
+
+        ResidentSetPersister persister(&bpm, SNAPSHOT_FILE, std::chrono::milliseconds(1000));
+        Assert(persister.persistNow(), "persist");
+    }
+    {
+        // Restart: the loader brings back the MRU pool_size pages (the whole snapshot fits).
+        cmse::disk::DiskManager disk(DB_FILE);
+        BufferPoolManager bpm(pool_size, &disk);
+        WarmupLoader loader(&bpm, SNAPSHOT_FILE, WarmupOptions{ 16, 0 });
+        WarmupStats stats = loader.run();
+        Assert(stats.snapshot_found && stats.snapshot_pages == pool_size, "snapshot read");
+        Assert(stats.requested_pages == pool_size && stats.loaded_pages == pool_size, "all pages loaded");
+        Assert(stats.batches == pool_size / 16 && !stats.pool_filled, "batched load");
+
+        auto pool_stats = bpm.GetStats();
+        Assert(pool_stats.prefetched == pool_size && pool_stats.misses == 0 && pool_stats.pinned_frames == 0, "prefetch counters");
+        for (page_id_t pid : hot) {
+            Touch(&bpm, pid);
+        }
+        Assert(bpm.GetStats().misses == 0, "hot set hits right after restart");
+
+        // Without a snapshot: cold start, nothing loaded.
+        WarmupLoader missing(&bpm, "no_such_snapshot.snap");
+        stats = missing.run();
+        Assert(!stats.snapshot_found && stats.loaded_pages == 0, "missing snapshot is a cold start");
+    }
+    {
+        // Traffic got there first: the loader only fills the free frames and keeps their pages.
+        cmse::disk::DiskManager disk(DB_FILE);
+        BufferPoolManager bpm(pool_size, &disk);
+        std::vector<page_id_t> early;
+        for (page_id_t pid = 1; early.size() < 40; pid += 5) {
+            Assert(bpm.FetchPage(pid) != nullptr, "early fetch");
+            early.push_back(pid);
+        }
+        WarmupStats stats = WarmupLoader(&bpm, SNAPSHOT_FILE).run();
+        Assert(stats.pool_filled && stats.loaded_pages == pool_size - early.size(), "fills only free frames");
+        auto pool_stats = bpm.GetStats();
+        Assert(pool_stats.evictions_clean + pool_stats.evictions_dirty == 0, "no eviction by the loader");
+        Assert(pool_stats.pinned_frames == early.size(), "traffic's pins untouched");
+        for (page_id_t pid : early) {
+            bpm.UnpinPage(pid, false);
+        }
+    }
+    Cleanup();
+    Log(">>> PASSED: Warm Restart.");
+}
+
+void TestBackground() {
+    Log("--- Test 4: Persister / Background Load ---");
+    Cleanup();
+    const size_t pool_size = 128;
+    {
+        cmse::disk::DiskManager disk(DB_FILE);
+        BufferPoolManager bpm(pool_size, &disk);
+        WritePages(&bpm, 1024);
+        ResidentSetPersister persister(&bpm, SNAPSHOT_FILE, std::chrono::milliseconds(5));
+        persister.start();
+        for (page_id_t pid = 0; pid < 1024; pid += 3) {
+            Touch(&bpm, pid);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        persister.stop(); // Final snapshot reflects the last touches
+        std::vector<page_id_t> ids;
+        Assert(ReadResidentSetFile(SNAPSHOT_FILE, &ids) && ids.size() == pool_size, "persister wrote a snapshot");
+        Assert(ids[0] == 1023, "MRU page first");
+    }
+    {
+        cmse::disk::DiskManager disk(DB_FILE);
+        BufferPoolManager bpm(pool_size, &disk);
+        WarmupLoader loader(&bpm, SNAPSHOT_FILE, WarmupOptions{ 8, 0 });
+        loader.start();
+
+        // Serve traffic while the loader runs: every fetch sees the right bytes.
+        std::atomic<bool> done{ false };
+        std::thread reader([&]() {
+            for (page_id_t pid = 2; pid < 1024 && !done.load(); pid += 7) {
+                Touch(&bpm, pid);
+            }
+        });
+        WarmupStats stats = loader.wait();
+        done = true;
+        reader.join();
+
+        Assert(stats.snapshot_found && stats.requested_pages == pool_size, "background load ran");
+        auto pool_stats = bpm.GetStats();
+        Assert(pool_stats.resident_pages <= pool_size && pool_stats.pinned_frames == 0, "pool consistent");
+        Assert(pool_stats.prefetched == stats.loaded_pages, "prefetch counter matches");
+    }
+    Cleanup();
+    Log(">>> PASSED: Persister / Background Load.");
+}
+
+int main() {
+    TestSnapshotFile();
+    TestResidentOrder();
+    TestWarmRestart();
+    TestBackground();
+    Cleanup();
+
+    Log("ALL RESIDENT SET TESTS PASSED");
+    return 0;
+}
@@ -0,0 +1,194 @@
+/**
+ * roaring_bitmap_test.cpp
+ *
+ * Verifies the Roaring compressed bitmap against a std::set reference:
+ * 1. add/contains/cardinality for sparse, dense and mixed containers (array <-> bitset conversion).
+ * 2. addRange across container boundaries.
+ * 3. AND / OR for every container pairing.
+ * 4. Serialization round trip and rejection of truncated input.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+#include <random>
+
+#include "../src/index/roaring_bitmap.h"
+
+using namespace cmse;
+using index::RoaringBitmap;
+
+void Log(const std::string& msg) {
+    std::cout << "[ROARING_TEST] " << msg << std::endl;
+}
+
+void Assert(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "!!! FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+// Checks the bitmap holds exactly 'expected'.
+void AssertSame(const RoaringBitmap& bitmap, const std::set<uint32_t>& expected, const std::string& what) {
+    Assert(bitmap.cardinality() == expected.size(), what + ": cardinality " + std::to_string(bitmap.cardinality()) + " != " + std::to_string(expected.size()));
+    std::vector<uint32_t> values = bitmap.toVector();
+    Assert(std::vector<uint32_t>(expected.begin(), expected.end()) == values, what + ": values differ");
+}
+
+// Mix of sparse containers, dense containers and one that is full.
+void Fill(std::mt19937& rng, RoaringBitmap* bitmap, std::set<uint32_t>* set) {
+    for (int i = 0; i < 3000; ++i) {                        // Sparse, spread over many containers
+        uint32_t v = rng();
+        bitmap->add(v);
+        set->insert(v);
+    }
+    for (int i = 0; i < 30000; ++i) {                       // Dense: containers 2 and 3
+        uint32_t v = (2u << 16) + (rng() % (2u << 16));
+        bitmap->add(v);
+        set->insert(v);
+    }
+    for (uint32_t v = 7u << 16; v < (8u << 16); v += 1 + rng() % 3) { // Around the conversion threshold
+        bitmap->add(v);
+        set->insert(v);
+    }
+}
+
+// 1. Point operations.
+void TestPointOps() {
+    Log("--- Test 1: Point Operations ---");
+    std::mt19937 rng(1);
+    RoaringBitmap bitmap;
+    std::set<uint32_t> expected;
+    Assert(bitmap.empty() && bitmap.cardinality() == 0 && !bitmap.contains(0), "empty bitmap");
+
+    Fill(rng, &bitmap, &expected);
+    AssertSame(bitmap, expected, "after fill");
+
+    // Duplicates do not change anything.
+    for (uint32_t v : std::vector<uint32_t>(expected.begin(), expected.end())) {
+        bitmap.add(v);
+    }
+    AssertSame(bitmap, expected, "after duplicate adds");
+
+    for (int probe = 0; probe < 100000; ++probe) {
+        uint32_t v = probe % 2 ? rng() : (2u << 16) + (rng() % (3u << 16));
+        Assert(bitmap.contains(v) == (expected.count(v) == 1), "contains(" + std::to_string(v) + ")");
+    }
+
+    // Extremes.
+    bitmap.add(0);
+    bitmap.add(UINT32_MAX);
+    Assert(bitmap.contains(0) && bitmap.contains(UINT32_MAX), "extreme values");
+
+    // Dense data compresses: 30000 values in two containers use 16 KB, not 120 KB of uint32.
+    RoaringBitmap dense;
+    for (uint32_t v = 0; v < 100000; ++v) {
+        dense.add(v);
+    }
+    Assert(dense.sizeInBytes() < 100000 * sizeof(uint32_t) / 10, "dense bitmap should be compact");
+
+    Log(">>> PASSED: Point Operations.");
+}
+
+// 2. Ranges.
+void TestRanges() {
+    Log("--- Test 2: Ranges ---");
+    RoaringBitmap bitmap;
+    std::set<uint32_t> expected;
+    auto addRange = [&](uint32_t lo, uint32_t hi) {
+        bitmap.addRange(lo, hi);
+        for (uint64_t v = lo; v <= hi; ++v) {
+            expected.insert(static_cast<uint32_t>(v));
+        }
+    };
+    addRange(10, 20);                            // Small array
+    addRange(65530, 65545);                      // Crosses a container boundary
+    addRange(100000, 300000);                    // Spans several full containers
+    addRange(15, 100005);                        // Overlaps earlier ranges
+    addRange(UINT32_MAX - 5, UINT32_MAX);        // Last container
+    AssertSame(bitmap, expected, "ranges");
+
+    RoaringBitmap empty;
+    empty.addRange(5, 4);
+    Assert(empty.empty(), "inverted range adds nothing");
+    Log(">>> PASSED: Ranges.");
+}
+
+// 3. Set operations.
+void TestSetOps() {
+    Log("--- Test 3: AND / OR ---");
+    for (unsigned seed = 0; seed < 5; ++seed) {
+        std::mt19937 rng(seed + 10);
+        RoaringBitmap a, b;
+        std::set<uint32_t> sa, sb;
+        Fill(rng, &a, &sa);
+        Fill(rng, &b, &sb);
+        b.addRange(3u << 16, (3u << 16) + 40000);  // Dense vs array pairings
+        for (uint32_t v = 3u << 16; v <= (3u << 16) + 40000; ++v) {
+            sb.insert(v);
+        }
+
+        std::set<uint32_t> and_expected, or_expected(sa);
+        for (uint32_t v : sa) {
+            if (sb.count(v)) {
+                and_expected.insert(v);
+            }
+        }
+        or_expected.insert(sb.begin(), sb.end());
+
+        AssertSame(a & b, and_expected, "AND seed " + std::to_string(seed));
+        AssertSame(b & a, and_expected, "AND commutes seed " + std::to_string(seed));
+        AssertSame(a | b, or_expected, "OR seed " + std::to_string(seed));
+        AssertSame(b | a, or_expected, "OR commutes seed " + std::to_string(seed));
+        Assert((a & b) == (b & a) && (a | b) == (b | a), "operator== on results");
+        Assert((a & RoaringBitmap()).empty() && (a | RoaringBitmap()) == a, "identities");
+    }
+
+    // Two sparse halves of one container whose AND shrinks a bitset back to an array.
+    RoaringBitmap evens, low;
+    for (uint32_t v = 0; v < 65536; v += 2) {
+        evens.add(v);
+    }
+    low.addRange(0, 999);
+    RoaringBitmap both = evens & low;
+    Assert(both.cardinality() == 500 && both.sizeInBytes() == 500 * sizeof(uint16_t), "bitset AND should shrink to an array");
+    Log(">>> PASSED: AND / OR.");
+}
+
+// 4. Serialization.
+void TestSerialization() {
+    Log("--- Test 4: Serialization ---");
+    std::mt19937 rng(99);
+    RoaringBitmap bitmap;
+    std::set<uint32_t> expected;
+    Fill(rng, &bitmap, &expected);
+
+    std::string bytes;
+    bitmap.serialize(&bytes);
+    RoaringBitmap restored;
+    Assert(RoaringBitmap::deserialize(bytes.data(), bytes.size(), &restored), "deserialize failed");
+    Assert(restored == bitmap, "round trip changed the bitmap");
+    AssertSame(restored, expected, "round trip");
+
+    RoaringBitmap untouched;
+    untouched.add(1);
+    Assert(!RoaringBitmap::deserialize(bytes.data(), bytes.size() - 1, &untouched), "truncated input must be rejected");
+    Assert(untouched.cardinality() == 1 && untouched.contains(1), "failed deserialize must not modify output");
+
+    std::string empty_bytes;
+    RoaringBitmap().serialize(&empty_bytes);
+    Assert(RoaringBitmap::deserialize(empty_bytes.data(), empty_bytes.size(), &restored) && restored.empty(), "empty round trip");
+    Log(">>> PASSED: Serialization.");
+}
+
+int main() {
+    TestPointOps();
+    TestRanges();
+    TestSetOps();
+    TestSerialization();
+
+    Log("ALL ROARING BITMAP TESTS PASSED");
+    return 0;
+}
@@ -0,0 +1,238 @@
+/**
+ * rollup_store_test.cpp
+ *
+ * Verifies the time-bucketed rollups maintained on ingest:
+ * 1. Bucket arithmetic and RollupKey ordering/traits.
+ * 2. Minute and hour buckets match brute-force counts, both while deltas are pending
+ *    and after they are flushed into the trees (incremental maintenance across flushes).
+ * 3. Window counts (any resource / event type) match a full scan and read buckets rather
+ *    than records; aligned windows need no raw records at all.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <limits>
+#include <random>
+#include <cstring>
+#include <filesystem>
+
+#include "../src/bufferpool/buffer_pool_adapter.h"
+#include "../src/index/bitmap_index.h"
+#include "../src/rollup/rollup_store.h"
+#include "../src/storage/log_store.h"
+#include "../src/utils/log_manager.h"
+
+using namespace cmse;
+using rollup::CountQuery;
+using rollup::CountResult;
+using rollup::RollupRow;
+using rollup::RollupStore;
+using storage::LogStore;
+
+const std::string DB_FILE = "test_rollup_store.db";
+
+void Cleanup() {
+    std::filesystem::remove(DB_FILE);
+}
+
+void Log(const std::string& msg) {
+    std::cout << "[ROLLUP_TEST] " << msg << std::endl;
+}
+
+void Assert(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "!!! FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+const std::vector<std::string> EVENTS = { "START", "STOP", "RESTART", "ERROR", "WARNING", "DEPLOY" };
+constexpr int64_t MINUTE = RollupStore::MINUTE_MS;
+constexpr int64_t HOUR = RollupStore::HOUR_MS;
+
+// Records 500 ms apart (~2.8 hours for 20k) over 10 resources with a skewed event mix.
+std::vector<LogRecord> MakeLogs(int count, unsigned seed) {
+    auto logs = utils::LogManager::generateSyntheticLogs(count, 1000, 500);
+    std::mt19937 rng(seed);
+    std::discrete_distribution<int> pick({ 40, 25, 10, 3, 15, 7 });
+    for (auto& record : logs) {
+        const std::string& type = EVENTS[pick(rng)];
+        std::memset(record.event_type, 0, sizeof(record.event_type));
+        std::memcpy(record.event_type, type.data(), type.size());
+        record.resource_id = 1000 + static_cast<int64_t>(rng() % 10);
+    }
+    return logs;
+}
+
+using BucketCounts = std::map<std::tuple<int64_t, int64_t, std::string>, int64_t>;
+
+BucketCounts BruteForceBuckets(const std::vector<LogRecord>& logs, int64_t width) {
+    BucketCounts counts;
+    for (const auto& record : logs) {
+        int64_t bucket = RollupStore::bucketStart(LogStore::timestampMillis(record), width);
+        counts[{ bucket, record.resource_id, index::BitmapIndex::eventTypeOf(record) }]++;
+    }
+    return counts;
+}
+
+uint64_t BruteForceCount(const std::vector<LogRecord>& logs, const CountQuery& q) {
+    uint64_t count = 0;
+    for (const auto& record : logs) {
+        int64_t ts = LogStore::timestampMillis(record);
+        if (ts < q.begin_ms || ts >= q.end_ms) continue;
+        if (q.resource_id && record.resource_id != *q.resource_id) continue;
+        if (q.event_type && index::BitmapIndex::eventTypeOf(record) != *q.event_type) continue;
+        count++;
+    }
+    return count;
+}
+
+void CheckBuckets(RollupStore& rollups, const std::vector<LogRecord>& logs, int64_t width, const std::string& label) {
+    std::vector<RollupRow> rows;
+    Assert(rollups.scanBuckets(width, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(), &rows), label + ": scan");
+
+    BucketCounts actual;
+    for (const auto& row : rows) {
+        actual[{ row.bucket_start_ms, row.resource_id, row.event_type }] += row.count;
+    }
+    Assert(actual == BruteForceBuckets(logs, width), label + ": bucket counts match brute force");
+}
+
+// 1. Bucket arithmetic and key ordering.
+void TestBucketsAndKeys() {
+    Log("--- Test 1: Buckets and Keys ---");
+
+    Assert(RollupStore::bucketStart(0, MINUTE) == 0, "bucket of 0");
+    Assert(RollupStore::bucketStart(MINUTE - 1, MINUTE) == 0, "end of first bucket");
+    Assert(RollupStore::bucketStart(MINUTE, MINUTE) == MINUTE, "start of second bucket");
+    Assert(RollupStore::bucketStart(-1, MINUTE) == -MINUTE, "negative timestamps floor");
+
+    RollupKey a{ 0, 5, 2 };
+    RollupKey b{ 0, 6, 0 };
+    RollupKey c{ MINUTE, 1, 0 };
+    Assert(a < b && b < c, "bucket orders first, then resource, then event");
+    Assert(RollupKey::bucketsBegin(0) < a && c < RollupKey::bucketsEnd(MINUTE), "bucket bounds enclose the rows");
+    Assert(RollupKey::bucketsEnd(0) < RollupKey::bucketsBegin(1), "bucket bounds do not overlap");
+
+    using Traits = KeyTraits<RollupKey>;
+    Assert(Traits::predecessor(a) == RollupKey{ 0, 5, 1 }, "predecessor within a resource");
+    Assert(Traits::predecessor(RollupKey{ 0, 6, std::numeric_limits<int64_t>::min() }).resource_id == 5, "predecessor across resources");
+    Assert(Traits::predecessor(RollupKey::bucketsBegin(1)) == RollupKey::bucketsEnd(0), "predecessor across buckets");
+    Assert(Traits::predecessor(Traits::lowest()) == Traits::lowest(), "lowest has no predecessor");
+    Log("Passed.");
+}
+
+// 2. Buckets maintained on ingest, pending and flushed.
+void TestIncrementalMaintenance() {
+    Log("--- Test 2: Incremental Maintenance ---");
+    Cleanup();
+    {
+        disk::DiskManager dm(DB_FILE);
+        bufferpool::BufferPoolManager bpm(64, &dm);
+        bufferpool::BufferPoolManagerAdapter adapter(&bpm);
+        LogStore store(&adapter);
+        RollupStore rollups(&adapter, { HOUR, MINUTE, MINUTE, 0 }, 1500);
+        store.addListener(&rollups);
+
+        Assert(rollups.bucketWidths() == std::vector<int64_t>({ MINUTE, HOUR }), "widths sorted, de-duplicated, invalid dropped");
+
+        auto logs = MakeLogs(20000, 7);
+        std::vector<LogRecord> ingested;
+        for (size_t i = 0; i < logs.size(); ++i) {
+            Assert(store.append(logs[i]) != INVALID_RECORD_ID, "append");
+            ingested.push_back(logs[i]);
+            if (i == 700) {
+                // Nothing flushed yet: answered from pending deltas alone
+                Assert(rollups.flushCount() == 0 && rollups.pendingRecords() == 701, "below threshold nothing is flushed");
+                CheckBuckets(rollups, ingested, MINUTE, "pending only");
+            }
+        }
+        Assert(rollups.flushCount() == 20000 / 1500, "flushed every 1500 records");
+        Assert(rollups.pendingRecords() == 20000 % 1500, "remainder pending");
+
+        // Mixed committed + pending, then fully committed
+        CheckBuckets(rollups, ingested, MINUTE, "minute (mixed)");
+        CheckBuckets(rollups, ingested, HOUR, "hour (mixed)");
+        Assert(rollups.flush() && rollups.pendingRecords() == 0, "explicit flush");
+        CheckBuckets(rollups, ingested, MINUTE, "minute (flushed)");
+        CheckBuckets(rollups, ingested, HOUR, "hour (flushed)");
+
+        std::vector<RollupRow> rows;
+        Assert(!rollups.scanBuckets(15 * MINUTE, 0, 0, &rows), "unknown width rejected");
+        Assert(rollups.eventTypes().size() == EVENTS.size(), "one code per event type");
+    }
+    Cleanup();
+    Log("Passed.");
+}
+
+// 3. Window counts from buckets plus raw edges.
+void TestWindowCounts() {
+    Log("--- Test 3: Window Counts ---");
+    Cleanup();
+    {
+        disk::DiskManager dm(DB_FILE);
+        bufferpool::BufferPoolManager bpm(64, &dm);
+        bufferpool::BufferPoolManagerAdapter adapter(&bpm);
+        LogStore store(&adapter);
+        RollupStore rollups(&adapter, { MINUTE, HOUR }, 4096);
+        store.addListener(&rollups);
+
+        auto logs = MakeLogs(20000, 11);
+        for (const auto& record : logs) {
+            store.append(record);
+        }
+        int64_t first_ms = LogStore::timestampMillis(logs.front());
+        int64_t last_ms = LogStore::timestampMillis(logs.back());
+
+        std::mt19937_64 rng(12);
+        for (int i = 0; i < 200; ++i) {
+            CountQuery q;
+            q.begin_ms = first_ms - 5000 + static_cast<int64_t>(rng() % static_cast<uint64_t>(last_ms - first_ms + 10000));
+            q.end_ms = q.begin_ms + static_cast<int64_t>(rng() % static_cast<uint64_t>(2 * HOUR));
+            if (rng() % 2) q.resource_id = 1000 + static_cast<int64_t>(rng() % 12); // Includes unknown resources
+            if (rng() % 2) q.event_type = EVENTS[rng() % EVENTS.size()];
+            if (i == 0) q.event_type = "NEVER_SEEN";
+
+            CountResult result;
+            Assert(rollups.count(q, &store, &result), "count");
+            Assert(result.count == BruteForceCount(logs, q), "window count matches brute force (query " + std::to_string(i) + ")");
+        }
+
+        // Whole span: a few hour/minute rows plus less than a minute of raw records per edge
+        CountQuery all{ first_ms, last_ms + 1, std::nullopt, std::nullopt };
+        CountResult result;
+        Assert(rollups.count(all, &store, &result) && result.count == logs.size(), "whole span counts every record");
+        Assert(result.raw_records_read < 2 * (MINUTE / 500), "only the unaligned edges read raw records");
+        Assert(result.rollup_rows_read < logs.size() / 4, "buckets are read instead of records");
+        Log("Whole span: " + std::to_string(result.rollup_rows_read) + " bucket rows, " + std::to_string(result.raw_records_read) + " raw records");
+
+        // Aligned to minutes: no raw records, works without the store
+        CountQuery aligned;
+        aligned.begin_ms = RollupStore::bucketStart(first_ms, HOUR) + HOUR;
+        aligned.end_ms = aligned.begin_ms + HOUR + 30 * MINUTE;
+        aligned.event_type = "ERROR";
+        Assert(rollups.count(aligned, nullptr, &result), "aligned window needs no raw store");
+        Assert(result.raw_records_read == 0 && result.count == BruteForceCount(logs, aligned), "aligned window count");
+
+        CountQuery unaligned = aligned;
+        unaligned.begin_ms += 1;
+        Assert(!rollups.count(unaligned, nullptr, &result), "unaligned window without raw store fails");
+
+        CountQuery empty{ first_ms, first_ms, std::nullopt, std::nullopt };
+        Assert(rollups.count(empty, nullptr, &result) && result.count == 0, "empty window");
+    }
+    Cleanup();
+    Log("Passed.");
+}
+
+int main() {
+    Log("Starting Rollup Store Tests...");
+    TestBucketsAndKeys();
+    TestIncrementalMaintenance();
+    TestWindowCounts();
+    Log("All Rollup Store Tests Passed!");
+    return 0;
+}
@@ -0,0 +1,178 @@
+/**
+ * shards_mrc_test.cpp
+ *
+ * Verifies SHARDS online miss-ratio curve estimation:
+ * 1. At sampling rate 1.0 the estimate matches the exact Mattson curve (up to bucket interpolation).
+ * 2. At a low sampling rate the estimate stays close to the exact curve on a skewed trace.
+ * 3. The fixed-size variant never tracks more than max_samples pages.
+ * 4. BufferPoolManager feeds FetchPage accesses to the estimator when enabled.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <filesystem>
+
+#include "../src/bufferpool/buffer_pool_manager.h"
+#include "../src/bufferpool/shards_mrc.h"
+#include "../src/bufferpool/trace_replay.h"
+
+using namespace cmse::bufferpool;
+
+const std::string DB_FILE = "test_shards.db";
+
+void Cleanup() {
+    std::filesystem::remove(DB_FILE);
+}
+
+void Log(const std::string& msg) {
+    std::cout << "[SHARDS_TEST] " << msg << std::endl;
+}
+
+void Assert(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "!!! FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+// Skewed synthetic workload: 60% of accesses to a hot set, the rest uniform over all pages.
+std::vector<cmse::page_id_t> MakeTrace(size_t n, uint32_t pages, uint32_t hot, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<cmse::page_id_t> accesses;
+    accesses.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t page = (rng() % 10 < 6) ? rng() % hot : rng() % pages;
+        accesses.push_back(static_cast<cmse::page_id_t>(page));
+    }
+    return accesses;
+}
+
+double MeanAbsoluteError(const MissRatioCurve& a, const MissRatioCurve& b) {
+    double sum = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        sum += std::fabs(a[i].miss_ratio - b[i].miss_ratio);
+    }
+    return a.empty() ? 0.0 : sum / static_cast<double>(a.size());
+}
+
+void TestFullSampling() {
+    Log("--- Test 1: Full Sampling ---");
+
+    auto accesses = MakeTrace(50000, 2000, 64, 7);
+    auto sizes = DefaultCacheSizes(CountDistinctPages(accesses));
+    auto exact = ComputeLruMissRatioCurve(accesses, sizes);
+
+    ShardsMrcEstimator estimator(1.0, 1 << 20);
+    for (auto page : accesses) {
+        estimator.Access(page);
+    }
+    Assert(estimator.SampledAccesses() == accesses.size(), "rate 1.0 must sample every access");
+
+    auto estimate = estimator.Curve(sizes);
+    double mae = MeanAbsoluteError(exact, estimate);
+    Log("MAE at rate 1.0: " + std::to_string(mae));
+    Assert(mae < 0.01, "full-rate estimate should match the exact curve");
+
+    Log(">>> PASSED: Full Sampling.");
+}
+
+void TestLowRateAccuracy() {
+    Log("--- Test 2: Low-Rate Accuracy ---");
+
+    auto accesses = MakeTrace(200000, 20000, 500, 11);
+    auto sizes = DefaultCacheSizes(CountDistinctPages(accesses));
+    auto exact = ComputeLruMissRatioCurve(accesses, sizes);
+
+    ShardsMrcEstimator estimator(0.1, 1 << 20);
+    for (auto page : accesses) {
+        estimator.Access(page);
+    }
+    auto estimate = estimator.Curve(sizes);
+
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        Log("size " + std::to_string(sizes[i]) + ": exact=" + std::to_string(exact[i].miss_ratio)
+            + " shards=" + std::to_string(estimate[i].miss_ratio));
+    }
+    double mae = MeanAbsoluteError(exact, estimate);
+    Log("MAE at rate 0.1: " + std::to_string(mae));
+    Assert(mae < 0.05, "rate 0.1 estimate too far from the exact curve");
+    Assert(estimator.SampledAccesses() < accesses.size() / 4, "rate 0.1 should skip most accesses");
+
+    Log(">>> PASSED: Low-Rate Accuracy.");
+}
+
+void TestFixedSize() {
+    Log("--- Test 3: Fixed-Size Limit ---");
+
+    auto accesses = MakeTrace(200000, 20000, 500, 13);
+    auto sizes = DefaultCacheSizes(CountDistinctPages(accesses));
+    auto exact = ComputeLruMissRatioCurve(accesses, sizes);
+
+    ShardsMrcEstimator estimator(1.0, 2048);
+    for (auto page : accesses) {
+        estimator.Access(page);
+        Assert(estimator.TrackedPages() <= 2048, "tracked pages exceed max_samples");
+    }
+    Assert(estimator.SamplingRate() < 1.0, "rate must drop once the limit is reached");
+
+    double mae = MeanAbsoluteError(exact, estimator.Curve(sizes));
+    Log("final rate " + std::to_string(estimator.SamplingRate()) + ", MAE " + std::to_string(mae));
+    Assert(mae < 0.05, "fixed-size estimate too far from the exact curve");
+
+    Log(">>> PASSED: Fixed-Size Limit.");
+}
+
+void TestBufferPoolIntegration() {
+    Log("--- Test 4: Buffer Pool Integration ---");
+    Cleanup();
+
+    auto* disk_manager = new cmse::disk::DiskManager(DB_FILE);
+    auto* bpm = new BufferPoolManager(8, disk_manager);
+
+    cmse::page_id_t pid;
+    for (int i = 0; i < 32; ++i) {
+        bpm->NewPage(pid);
+        bpm->UnpinPage(pid, true);
+    }
+
+    Assert(bpm->GetEstimatedMissRatioCurve({ 8 }).empty(), "curve must be empty while estimation is off");
+
+    bpm->EnableMissRatioEstimation(1.0, 1024);
+    // Cycle over 16 pages: LRU misses every time with 8 frames, always hits with 16.
+    for (int round = 0; round < 20; ++round) {
+        for (cmse::page_id_t p = 0; p < 16; ++p) {
+            Assert(bpm->FetchPage(p) != nullptr, "fetch failed");
+            bpm->UnpinPage(p, false);
+        }
+    }
+
+    auto curve = bpm->GetEstimatedMissRatioCurve({ 8, 16 });
+    Assert(curve.size() == 2, "curve size");
+    Log("estimated miss ratio @8=" + std::to_string(curve[0].miss_ratio) + " @16=" + std::to_string(curve[1].miss_ratio));
+    Assert(curve[0].miss_ratio > 0.99, "looping over 16 pages misses with 8 frames");
+    Assert(curve[1].miss_ratio < 0.1, "only cold misses with 16 frames");
+
+    // The real pool (8 frames) should agree with the estimate at its own size.
+    auto stats = bpm->GetStats();
+    Assert(std::fabs((1.0 - stats.HitRatio()) - curve[0].miss_ratio) < 0.05, "estimate disagrees with the pool");
+
+    bpm->DisableMissRatioEstimation();
+    Assert(bpm->GetEstimatedMissRatioCurve({ 8 }).empty(), "curve must be empty after DisableMissRatioEstimation");
+
+    delete bpm;
+    delete disk_manager;
+    Cleanup();
+
+    Log(">>> PASSED: Buffer Pool Integration.");
+}
+
+int main() {
+    TestFullSampling();
+    TestLowRateAccuracy();
+    TestFixedSize();
+    TestBufferPoolIntegration();
+    return 0;
+}
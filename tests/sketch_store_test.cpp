@@ -0,0 +1,238 @@
+/**
+ * sketch_store_test.cpp
+ *
+ * Verifies the approximate per-window sketches:
+ * 1. HyperLogLog stays within its error bound and merges losslessly.
+ * 2. Count-Min never undercounts and overcounts within its bound; merge adds.
+ * 3. SpaceSaving keeps the heavy hitters with valid [count - error, count] bounds, also after merging.
+ * 4. SketchStore maintained on ingest answers distinct / top-k / per-resource questions
+ *    over bucket-aligned windows close to the exact answers.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <random>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+
+#include "../src/bufferpool/buffer_pool_adapter.h"
+#include "../src/rollup/rollup_store.h"
+#include "../src/rollup/sketch_store.h"
+#include "../src/storage/log_store.h"
+#include "../src/utils/log_manager.h"
+
+using namespace cmse;
+using rollup::CountMinSketch;
+using rollup::HeavyHitter;
+using rollup::HyperLogLog;
+using rollup::SketchStore;
+using rollup::SpaceSaving;
+
+const std::string DB_FILE = "test_sketch_store.db";
+
+void Cleanup() {
+    std::filesystem::remove(DB_FILE);
+}
+
+void Log(const std::string& msg) {
+    std::cout << "[SKETCH_TEST] " << msg << std::endl;
+}
+
+void Assert(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "!!! FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+// Skewed keys: key i drawn with weight 1 / (i + 1).
+std::vector<int64_t> SkewedKeys(size_t count, int64_t distinct, unsigned seed) {
+    std::vector<double> weights;
+    for (int64_t i = 0; i < distinct; ++i) {
+        weights.push_back(1.0 / static_cast<double>(i + 1));
+    }
+    std::discrete_distribution<int64_t> pick(weights.begin(), weights.end());
+    std::mt19937 rng(seed);
+    std::vector<int64_t> keys(count);
+    for (auto& key : keys) {
+        key = pick(rng);
+    }
+    return keys;
+}
+
+// 1. Distinct counts.
+void TestHyperLogLog() {
+    Log("--- Test 1: HyperLogLog ---");
+    for (int64_t n : { 0, 10, 1000, 20000, 200000 }) {
+        HyperLogLog hll;
+        for (int64_t i = 0; i < n; ++i) {
+            hll.add(i * 7919);
+            hll.add(i * 7919); // Duplicates do not count
+        }
+        double error = n == 0 ? hll.estimate() : std::abs(hll.estimate() - n) / n;
+        Log("n=" + std::to_string(n) + " estimate=" + std::to_string(hll.estimate()));
+        Assert(error <= 3 * hll.relativeError(), "estimate outside 3 standard errors for n=" + std::to_string(n));
+    }
+
+    // Overlapping halves merge into exactly the sketch of the union.
+    HyperLogLog left, right, both;
+    for (int64_t i = 0; i < 30000; ++i) {
+        (i < 20000 ? left : right).add(i);
+        if (i >= 10000 && i < 20000) {
+            right.add(i);
+        }
+        both.add(i);
+    }
+    Assert(left.merge(right) && left.estimate() == both.estimate(), "merge equals the union");
+    HyperLogLog coarse(10);
+    Assert(!left.merge(coarse), "precision mismatch is rejected");
+    Log(">>> PASSED: HyperLogLog.");
+}
+
+// 2. Frequencies.
+void TestCountMin() {
+    Log("--- Test 2: Count-Min ---");
+    auto keys = SkewedKeys(100000, 5000, 3);
+    std::map<int64_t, uint64_t> exact;
+    CountMinSketch first, second, whole;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        (i % 2 == 0 ? first : second).add(keys[i]);
+        whole.add(keys[i]);
+        exact[keys[i]]++;
+    }
+    Assert(first.merge(second) && first.total() == whole.total(), "merge adds totals");
+
+    size_t within = 0;
+    for (const auto& [key, count] : exact) {
+        uint64_t estimate = first.estimate(key);
+        Assert(estimate == whole.estimate(key), "merged counters equal the single sketch");
+        Assert(estimate >= count, "count-min undercounted");
+        within += estimate - count <= first.errorBound() ? 1 : 0;
+    }
+    // Each key is within the bound with probability 1 - e^-depth (98%).
+    Assert(within >= exact.size() * 95 / 100, "too many estimates beyond the error bound");
+    Assert(!first.merge(CountMinSketch(128, 4)), "shape mismatch is rejected");
+    Log(">>> PASSED: Count-Min.");
+}
+
+// 3. Heavy hitters.
+void TestSpaceSaving() {
+    Log("--- Test 3: SpaceSaving ---");
+    auto keys = SkewedKeys(100000, 5000, 5);
+    std::map<int64_t, uint64_t> exact;
+    std::vector<SpaceSaving> parts(4, SpaceSaving(64));
+    SpaceSaving single(64);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        parts[i % parts.size()].add(keys[i]);
+        single.add(keys[i]);
+        exact[keys[i]]++;
+    }
+    SpaceSaving merged(64);
+    for (const auto& part : parts) {
+        merged.merge(part);
+    }
+    Assert(merged.total() == keys.size() && merged.size() <= 64, "merged size and total");
+
+    std::vector<std::pair<uint64_t, int64_t>> ranked;
+    for (const auto& [key, count] : exact) {
+        ranked.emplace_back(count, key);
+    }
+    std::sort(ranked.rbegin(), ranked.rend());
+
+    for (const SpaceSaving* summary : { &single, &merged }) {
+        auto top = summary->top(10);
+        Assert(top.size() == 10, "top-10 size");
+        std::set<int64_t> reported;
+        for (const HeavyHitter& hitter : top) {
+            uint64_t truth = exact[hitter.key];
+            Assert(hitter.count >= truth && hitter.count - hitter.error <= truth, "count bounds for key " + std::to_string(hitter.key));
+            reported.insert(hitter.key);
+        }
+        // Keys 0..4 hold well over total / capacity events each: always reported.
+        for (int i = 0; i < 5; ++i) {
+            Assert(reported.count(ranked[i].second) == 1, "missed heavy hitter " + std::to_string(ranked[i].second));
+        }
+    }
+    Log(">>> PASSED: SpaceSaving.");
+}
+
+// 4. Window queries through ingest.
+void TestSketchStore() {
+    Log("--- Test 4: SketchStore ---");
+    Cleanup();
+    {
+        disk::DiskManager disk(DB_FILE);
+        bufferpool::BufferPoolManager bpm(64, &disk);
+        bufferpool::BufferPoolManagerAdapter bpm_adapter(&bpm);
+        storage::LogStore store(&bpm_adapter);
+        SketchStore sketches;
+        store.addListener(&sketches);
+
+        // 50k records one second apart (~14 hours), skewed over 3000 resources; 10% ERROR.
+        auto logs = utils::LogManager::generateSyntheticLogs(50000, 1000, 1000);
+        auto resources = SkewedKeys(logs.size(), 3000, 9);
+        std::mt19937 rng(13);
+        for (size_t i = 0; i < logs.size(); ++i) {
+            logs[i].resource_id = 1000 + resources[i];
+            std::memset(logs[i].event_type, 0, sizeof(logs[i].event_type));
+            std::strcpy(logs[i].event_type, rng() % 10 == 0 ? "ERROR" : "INFO");
+            store.append(logs[i]);
+        }
+        Assert(sketches.bucketCount() >= 14, "hourly buckets");
+
+        int64_t first_ms = storage::LogStore::timestampMillis(logs.front());
+        constexpr int64_t HOUR = rollup::RollupStore::HOUR_MS;
+        int64_t begin = rollup::RollupStore::bucketStart(first_ms, HOUR) + 2 * HOUR;
+        rollup::WindowSketch window;
+        Assert(sketches.summarize(begin + 1, begin + 6 * HOUR - 1, std::string("ERROR"), &window), "summarize");
+        Assert(window.begin_ms == begin && window.end_ms == begin + 6 * HOUR, "window rounded to whole buckets");
+        Assert(window.sketches_merged == 6, "one ERROR sketch per bucket");
+
+        std::set<int64_t> distinct;
+        std::map<int64_t, uint64_t> per_resource;
+        uint64_t events = 0;
+        for (const auto& record : logs) {
+            int64_t ts = storage::LogStore::timestampMillis(record);
+            if (ts >= window.begin_ms && ts < window.end_ms && std::strcmp(record.event_type, "ERROR") == 0) {
+                distinct.insert(record.resource_id);
+                per_resource[record.resource_id]++;
+                events++;
+            }
+        }
+        Assert(window.events == events, "event totals are exact");
+        double estimate = window.distinct.estimate();
+        Log("Distinct ERROR resources: exact " + std::to_string(distinct.size()) + ", estimate " + std::to_string(estimate));
+        Assert(std::abs(estimate - distinct.size()) <= 3 * window.distinct.relativeError() * distinct.size(), "distinct estimate");
+
+        auto top = window.top.top(3);
+        Assert(!top.empty() && top[0].key == 1000, "noisiest resource");
+        for (const HeavyHitter& hitter : top) {
+            Assert(hitter.count >= per_resource[hitter.key] && hitter.count - hitter.error <= per_resource[hitter.key], "top bounds");
+        }
+        uint64_t noisy = window.counts.estimate(1000);
+        Assert(noisy >= per_resource[1000] && noisy - per_resource[1000] <= window.counts.errorBound(), "count-min estimate");
+
+        // Shorthands and the every-type window.
+        Assert(sketches.resourceEvents(begin, begin + 1, 1000, std::string("ERROR")) > 0, "resourceEvents");
+        Assert(sketches.distinctResources(first_ms, first_ms + 24 * HOUR) > sketches.distinctResources(begin, begin + 1), "larger window, more resources");
+        Assert(sketches.topResources(first_ms, first_ms + 24 * HOUR, 1).front().key == 1000, "topResources over every type");
+        Assert(sketches.distinctResources(begin, begin) == 0.0, "empty window");
+    }
+    Cleanup();
+    Log(">>> PASSED: SketchStore.");
+}
+
+int main() {
+    TestHyperLogLog();
+    TestCountMin();
+    TestSpaceSaving();
+    TestSketchStore();
+
+    Log("ALL SKETCH TESTS PASSED");
+    return 0;
+}
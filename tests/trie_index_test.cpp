@@ -0,0 +1,277 @@
+/**
+ * trie_index_test.cpp
+ *
+ * Verifies the page-backed trie (TrieAdapter + TrieIndex):
+ * 1. Node edges stay sorted by unsigned byte and survive insert/update/remove.
+ * 2. Random keys match a std::map reference for lookup, prefixCount (subtree_terminals)
+ *    and prefixScan (order and content).
+ * 3. Maintenance through LogStore ingest, and flush/load across a restart.
+ * 4. A name shared by several resource ids keeps all of them (posting pages), through
+ *    lookupAll, prefixScan and a reload.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <random>
+#include <cstring>
+#include <filesystem>
+
+#include "../src/adapter/trie_adapter.h"
+#include "../src/bufferpool/buffer_pool_adapter.h"
+#include "../src/index/trie_index.h"
+#include "../src/storage/log_store.h"
+#include "../src/utils/log_manager.h"
+
+using namespace cmse;
+using index::TrieIndex;
+
+const std::string DB_FILE = "test_trie_index.db";
+
+void Cleanup() {
+    std::filesystem::remove(DB_FILE);
+}
+
+void Log(const std::string& msg) {
+    std::cout << "[TRIE_TEST] " << msg << std::endl;
+}
+
+void Assert(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "!!! FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+// Entries of 'expected' whose key starts with 'prefix': keys in byte order, values in insertion order.
+std::vector<std::pair<std::string, ValueType>> WithPrefix(const std::map<std::string, std::vector<ValueType>>& expected, const std::string& prefix) {
+    std::vector<std::pair<std::string, ValueType>> result;
+    for (auto it = expected.lower_bound(prefix); it != expected.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+        for (ValueType value : it->second) {
+            result.emplace_back(it->first, value);
+        }
+    }
+    return result;
+}
+
+// Records 'value' for 'key' the way TrieIndex::insert does (no duplicates, insertion order).
+void AddExpected(std::map<std::string, std::vector<ValueType>>* expected, const std::string& key, ValueType value) {
+    auto& values = (*expected)[key];
+    if (std::find(values.begin(), values.end(), value) == values.end()) {
+        values.push_back(value);
+    }
+}
+
+// 1. Adapter edge handling on a single page.
+void TestAdapter() {
+    Log("--- Test 1: Trie Node Layout ---");
+    std::vector<char> bytes(PAGE_SIZE);
+    Page page(bytes.data());
+    adapter::TrieAdapter trie;
+    trie.initNode(&page);
+    Assert(!trie.isTerminal(&page) && trie.getChildCount(&page) == 0 && trie.getSubtreeCount(&page) == 0, "fresh node");
+
+    // Bytes above 0x7f must sort after ASCII regardless of char signedness.
+    const char chars[] = { 'm', 'a', static_cast<char>(0xE9), 'z', '0' };
+    for (int i = 0; i < 5; ++i) {
+        Assert(trie.insertChild(&page, chars[i], 100 + i), "insertChild");
+    }
+    Assert(trie.getChildCount(&page) == 5, "child count");
+    Assert(trie.getChildAt(&page, 0).key_char == '0' && trie.getChildAt(&page, 4).key_char == static_cast<char>(0xE9), "unsigned byte order");
+    Assert(trie.findChild(&page, 'z') == 103 && trie.findChild(&page, 'b') == INVALID_PAGE_ID, "findChild");
+
+    trie.updateChildPointer(&page, 'z', 7);
+    Assert(trie.findChild(&page, 'z') == 7, "updateChildPointer");
+    trie.removeChild(&page, 'm');
+    Assert(trie.getChildCount(&page) == 4 && trie.findChild(&page, 'm') == INVALID_PAGE_ID && trie.findChild(&page, 'a') == 101, "removeChild");
+
+    trie.setTerminal(&page, true, 42);
+    trie.adjustSubtreeCount(&page, 3);
+    Assert(trie.isTerminal(&page) && trie.getValue(&page) == 42 && trie.getSubtreeCount(&page) == 3, "terminal + count");
+
+    // Every possible byte fits in one node.
+    trie.initNode(&page);
+    for (int c = 0; c < adapter::MAX_TRIE_CHILDREN; ++c) {
+        Assert(trie.insertChild(&page, static_cast<char>(c), c), "full fan-out");
+    }
+    Assert(trie.getChildCount(&page) == adapter::MAX_TRIE_CHILDREN, "256 children");
+    Log(">>> PASSED: Trie Node Layout.");
+}
+
+// 2. Random keys against a reference map.
+void TestRandomKeys() {
+    Log("--- Test 2: Lookup / Prefix Count / Prefix Scan ---");
+    Cleanup();
+    disk::DiskManager disk(DB_FILE);
+    bufferpool::BufferPoolManager bpm(64, &disk); // Far fewer frames than nodes: exercises eviction
+    bufferpool::BufferPoolManagerAdapter bpm_adapter(&bpm);
+    TrieIndex trie(&bpm_adapter);
+
+    std::map<std::string, std::vector<ValueType>> expected;
+    std::mt19937 rng(11);
+    const std::vector<std::string> stems = { "vm-prod-", "vm-dev-", "db-", "lb-", "vm-prod-eu-" };
+    Assert(trie.size() == 0 && trie.prefixCount("") == 0, "empty trie");
+
+    for (int i = 0; i < 600; ++i) {
+        std::string key = stems[rng() % stems.size()] + std::to_string(rng() % 300);
+        ValueType value = static_cast<ValueType>(rng() % 100000);
+        Assert(trie.insert(key, value), "insert " + key);
+        AddExpected(&expected, key, value); // Re-inserting a key adds a value
+    }
+    Assert(trie.insert("", -1), "empty key");
+    AddExpected(&expected, "", -1);
+
+    Assert(trie.size() == static_cast<int64_t>(expected.size()), "size counts distinct keys");
+    for (const auto& [key, values] : expected) {
+        ValueType found = 0;
+        Assert(trie.lookup(key, &found) && found == values.front(), "lookup " + key);
+        std::vector<ValueType> all;
+        Assert(trie.lookupAll(key, &all) && all == values, "lookupAll " + key);
+    }
+    Assert(!trie.lookup("vm-prod", nullptr), "inner node is not a key");
+    Assert(!trie.lookup("vm-prod-99999", nullptr), "missing key");
+
+    for (const std::string prefix : { "", "v", "vm-", "vm-prod-", "vm-prod-eu-", "db-1", "lb-299", "x", "vm-prod-eu-1000" }) {
+        auto reference = WithPrefix(expected, prefix);
+        std::map<std::string, int> keys;
+        for (const auto& entry : reference) {
+            keys[entry.first]++;
+        }
+        Assert(trie.prefixCount(prefix) == static_cast<int64_t>(keys.size()), "prefixCount '" + prefix + "'");
+
+        std::vector<TrieIndex::Entry> scanned;
+        Assert(trie.prefixScan(prefix, reference.size() + 5, &scanned), "prefixScan failed");
+        Assert(scanned == reference, "prefixScan content '" + prefix + "'");
+
+        std::vector<TrieIndex::Entry> limited;
+        Assert(trie.prefixScan(prefix, 3, &limited), "limited prefixScan failed");
+        Assert(limited.size() == std::min<size_t>(3, reference.size()), "prefixScan limit");
+    }
+    Log(">>> PASSED: Lookup / Prefix Count / Prefix Scan.");
+}
+
+// 3. Ingest maintenance and reopening.
+void TestIngestAndReload() {
+    Log("--- Test 3: Ingest + Flush / Load ---");
+    Cleanup();
+    page_id_t root = INVALID_PAGE_ID;
+    size_t nodes = 0;
+    {
+        disk::DiskManager disk(DB_FILE);
+        bufferpool::BufferPoolManager bpm(64, &disk);
+        bufferpool::BufferPoolManagerAdapter bpm_adapter(&bpm);
+        storage::LogStore store(&bpm_adapter);
+        TrieIndex trie(&bpm_adapter);
+        store.addListener(&trie);
+
+        for (const auto& record : utils::LogManager::generateSyntheticLogs(2000)) {
+            store.append(record);
+        }
+        // The generator cycles through 50 names "vm-node-N" with resource ids 1000 + N.
+        Assert(trie.size() == 50, "50 distinct names");
+        Assert(trie.prefixCount("vm-node-1") == 11, "vm-node-1 and vm-node-10..19");
+        ValueType id = 0;
+        Assert(trie.lookup("vm-node-42", &id) && id == 1042, "name maps to resource id");
+
+        nodes = trie.nodeCount();
+        root = trie.flush();
+        Assert(root != INVALID_PAGE_ID, "flush returns the root");
+        bpm.FlushAllPages();
+    }
+    {
+        disk::DiskManager disk(DB_FILE);
+        bufferpool::BufferPoolManager bpm(64, &disk);
+        bufferpool::BufferPoolManagerAdapter bpm_adapter(&bpm);
+        TrieIndex trie(&bpm_adapter);
+        Assert(trie.load(root), "load");
+        Assert(trie.nodeCount() == nodes && trie.size() == 50, "reloaded shape");
+        ValueType id = 0;
+        Assert(trie.lookup("vm-node-7", &id) && id == 1007, "reloaded lookup");
+        Assert(trie.insert("vm-node-50", 1050) && trie.prefixCount("vm-node-5") == 2, "insert after reload");
+    }
+    Cleanup();
+    Log(">>> PASSED: Ingest + Flush / Load.");
+}
+
+LogRecord MakeRecord(const std::string& name, int64_t resource_id) {
+    LogRecord record{};
+    record.timestamp = std::chrono::system_clock::now();
+    record.resource_id = resource_id;
+    std::memcpy(record.resource_name, name.data(), name.size());
+    std::memcpy(record.event_type, "START", 5);
+    return record;
+}
+
+// 4. Names shared by several resource ids.
+void TestSharedNames() {
+    Log("--- Test 4: Shared Names ---");
+    Cleanup();
+    page_id_t root = INVALID_PAGE_ID;
+    // More ids than one posting page holds, so the chain has to grow.
+    const ValueType many = adapter::MAX_TRIE_POSTINGS + 300;
+    {
+        disk::DiskManager disk(DB_FILE);
+        bufferpool::BufferPoolManager bpm(16, &disk);
+        bufferpool::BufferPoolManagerAdapter bpm_adapter(&bpm);
+        storage::LogStore store(&bpm_adapter);
+        TrieIndex trie(&bpm_adapter);
+        store.addListener(&trie);
+
+        // Two resources named "vm-shared", ingested interleaved and repeatedly.
+        for (int i = 0; i < 10; ++i) {
+            store.append(MakeRecord("vm-shared", i % 2 == 0 ? 7 : 9));
+        }
+        store.append(MakeRecord("vm-single", 5));
+
+        std::vector<ValueType> ids;
+        Assert(trie.lookupAll("vm-shared", &ids) && ids == std::vector<ValueType>({ 7, 9 }), "both ids of a shared name");
+        Assert(trie.size() == 2 && trie.prefixCount("vm-") == 2, "names are counted once");
+        Assert(trie.postingPageCount() == 1, "second id on a posting page");
+
+        std::vector<TrieIndex::Entry> scanned;
+        Assert(trie.prefixScan("vm-", 10, &scanned), "prefixScan");
+        std::vector<TrieIndex::Entry> expected = { { "vm-shared", 7 }, { "vm-shared", 9 }, { "vm-single", 5 } };
+        Assert(scanned == expected, "prefixScan lists every id of a shared name");
+        std::vector<TrieIndex::Entry> limited;
+        Assert(trie.prefixScan("vm-", 2, &limited) && limited.size() == 2, "limit counts entries");
+
+        for (ValueType id = 100; id < 100 + many; ++id) {
+            Assert(trie.insert("db-shared", id), "insert db-shared");
+        }
+        Assert(trie.insert("db-shared", 100 + many / 2), "duplicate id is a no-op");
+        ids.clear();
+        Assert(trie.lookupAll("db-shared", &ids) && static_cast<ValueType>(ids.size()) == many, "chained posting pages");
+        Assert(ids.front() == 100 && ids.back() == 100 + many - 1, "insertion order");
+        Assert(trie.postingPageCount() == 3, "chain grew by one page");
+
+        root = trie.flush();
+        bpm.FlushAllPages();
+    }
+    {
+        disk::DiskManager disk(DB_FILE);
+        bufferpool::BufferPoolManager bpm(16, &disk);
+        bufferpool::BufferPoolManagerAdapter bpm_adapter(&bpm);
+        TrieIndex trie(&bpm_adapter);
+        Assert(trie.load(root) && trie.postingPageCount() == 3, "posting pages reloaded");
+        std::vector<ValueType> ids;
+        Assert(trie.lookupAll("vm-shared", &ids) && ids == std::vector<ValueType>({ 7, 9 }), "reloaded shared name");
+        Assert(trie.insert("vm-shared", 11), "insert after reload");
+        ids.clear();
+        Assert(trie.lookupAll("vm-shared", &ids) && ids == std::vector<ValueType>({ 7, 9, 11 }), "appended after reload");
+    }
+    Cleanup();
+    Log(">>> PASSED: Shared Names.");
+}
+
+int main() {
+    TestAdapter();
+    TestRandomKeys();
+    TestIngestAndReload();
+    TestSharedNames();
+    Cleanup();
+
+    Log("ALL TRIE INDEX TESTS PASSED");
+    return 0;
+}
@@ -0,0 +1,216 @@
+/**
+ * version_manager_test.cpp
+ *
+ * Verifies the versioned (Copy-on-Write) B+Tree:
+ * 1. Random inserts/updates across many versions match a std::map reference (lookup + scan).
+ * 2. Committed versions are immutable snapshots; aborted versions leave no trace.
+ * 3. Readers of committed versions run concurrently with a writer.
+ * 4. Data survives eviction with a small buffer pool.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <limits>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <filesystem>
+
+#include "../src/adapter/btree_adapter.h"
+#include "../src/bufferpool/buffer_pool_adapter.h"
+#include "../src/versioning/version_manager.h"
+#include "versioned_tree_fixture.h"
+
+using namespace cmse;
+
+const std::string DB_FILE = "test_versioning.db";
+
+void Cleanup() {
+    std::filesystem::remove(DB_FILE);
+}
+
+void Log(const std::string& msg) {
+    std::cout << "[VERSION_TEST] " << msg << std::endl;
+}
+
+void Assert(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "!!! FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+struct VersionedTree : VersionedTreeFixture<KeyType> {
+    explicit VersionedTree(size_t pool_size) : VersionedTreeFixture(DB_FILE, pool_size) {}
+};
+
+void VerifyAgainst(versioning::VersionManager& vm, version_t version, const std::map<KeyType, ValueType>& expected) {
+    std::vector<std::pair<KeyType, ValueType>> all;
+    Assert(vm.scan(version, std::numeric_limits<KeyType>::min(), expected.size() + 10, &all), "full scan failed");
+    Assert(all.size() == expected.size(), "scan size " + std::to_string(all.size()) + " != " + std::to_string(expected.size()));
+
+    size_t i = 0;
+    for (const auto& [key, val] : expected) {
+        Assert(all[i].first == key && all[i].second == val, "scan mismatch at " + std::to_string(i));
+        ValueType found = 0;
+        Assert(vm.lookup(version, key, &found) && found == val, "lookup mismatch for key " + std::to_string(key));
+        ++i;
+    }
+}
+
+void TestRandomAgainstReference() {
+    Log("--- Test 1: Random Workload vs std::map ---");
+    Cleanup();
+    VersionedTree tree(64);
+
+    std::mt19937_64 rng(5);
+    std::map<KeyType, ValueType> reference;
+    version_t base = INVALID_VERSION;
+    for (int batch = 0; batch < 50; ++batch) {
+        version_t v = tree.vm.createVersion();
+        for (int i = 0; i < 200; ++i) {
+            KeyType key = static_cast<KeyType>(rng() % 5000);
+            ValueType val = static_cast<ValueType>(rng());
+            Assert(tree.vm.applyUpdate(v, base, key, val), "applyUpdate failed");
+            reference[key] = val;
+        }
+        Assert(tree.vm.commitVersion(v), "commit failed");
+        base = v;
+    }
+    Assert(tree.vm.latestVersion() == base, "latestVersion");
+    VerifyAgainst(tree.vm, base, reference);
+
+    // Bounded scan from the middle.
+    std::vector<std::pair<KeyType, ValueType>> part;
+    Assert(tree.vm.scan(base, 2500, 20, &part), "bounded scan");
+    auto it = reference.lower_bound(2500);
+    Assert(part.size() == 20, "bounded scan size");
+    for (const auto& entry : part) {
+        Assert(entry.first == it->first, "bounded scan order");
+        ++it;
+    }
+    Assert(!tree.vm.lookup(base, 999999, nullptr), "absent key must not be found");
+
+    Log(">>> PASSED: Random Workload vs std::map.");
+}
+
+void TestSnapshotsAndAbort() {
+    Log("--- Test 2: Snapshots & Abort ---");
+    Cleanup();
+    VersionedTree tree(64);
+
+    version_t v1 = tree.vm.createVersion();
+    for (KeyType k = 0; k < 1000; ++k) {
+        tree.vm.applyUpdate(v1, INVALID_VERSION, k, k);
+    }
+    tree.vm.commitVersion(v1);
+
+    version_t v2 = tree.vm.createVersion();
+    for (KeyType k = 0; k < 1000; k += 2) {
+        tree.vm.applyUpdate(v2, v1, k, -k);
+    }
+    tree.vm.commitVersion(v2);
+
+    version_t v3 = tree.vm.createVersion();
+    tree.vm.applyUpdate(v3, v2, 5, 12345);
+    tree.vm.abortVersion(v3);
+    Assert(!tree.vm.commitVersion(v3), "aborted version must not commit");
+    Assert(!tree.vm.applyUpdate(v3, v2, 6, 1), "aborted version must reject updates");
+
+    ValueType val;
+    Assert(tree.vm.lookup(v1, 4, &val) && val == 4, "v1 must keep its value");
+    Assert(tree.vm.lookup(v2, 4, &val) && val == -4, "v2 sees its update");
+    Assert(tree.vm.lookup(v2, 5, &val) && val == 5, "v2 sees unchanged keys of v1");
+    Assert(tree.vm.latestVersion() == v2, "abort must not change the latest version");
+    Assert(tree.vm.getRoot(v1) != tree.vm.getRoot(v2), "CoW must give v2 its own root");
+
+    Log(">>> PASSED: Snapshots & Abort.");
+}
+
+void TestConcurrentReaders() {
+    Log("--- Test 3: Concurrent Readers ---");
+    Cleanup();
+    VersionedTree tree(128);
+
+    // Invariant checked by readers: every committed version holds keys 0..999, all mapped to
+    // the same round number. A torn snapshot would mix rounds or miss keys.
+    version_t base = tree.vm.createVersion();
+    for (KeyType k = 0; k < 1000; ++k) {
+        tree.vm.applyUpdate(base, INVALID_VERSION, k, 0);
+    }
+    tree.vm.commitVersion(base);
+
+    std::atomic<bool> done{ false };
+    std::atomic<int> errors{ 0 };
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&]() {
+            while (!done) {
+                version_t v = tree.vm.latestVersion();
+                std::vector<std::pair<KeyType, ValueType>> out;
+                if (!tree.vm.scan(v, 0, 2000, &out)) {
+                    continue; // pool momentarily exhausted
+                }
+                // Every snapshot is complete and internally consistent (all values equal).
+                if (out.size() != 1000) {
+                    errors++;
+                    continue;
+                }
+                for (const auto& entry : out) {
+                    if (entry.second != out[0].second) {
+                        errors++;
+                        break;
+                    }
+                }
+            }
+        });
+    }
+
+    for (int round = 1; round <= 30; ++round) {
+        version_t v = tree.vm.createVersion();
+        for (KeyType k = 0; k < 1000; ++k) {
+            Assert(tree.vm.applyUpdate(v, base, k, round), "writer applyUpdate failed");
+        }
+        tree.vm.commitVersion(v);
+        base = v;
+    }
+    done = true;
+    for (auto& r : readers) {
+        r.join();
+    }
+    Assert(errors == 0, "readers observed " + std::to_string(errors.load()) + " inconsistent snapshots");
+
+    Log(">>> PASSED: Concurrent Readers.");
+}
+
+void TestSmallPool() {
+    Log("--- Test 4: Small Pool (eviction) ---");
+    Cleanup();
+    VersionedTree tree(8);
+
+    std::map<KeyType, ValueType> reference;
+    version_t base = INVALID_VERSION;
+    for (int batch = 0; batch < 20; ++batch) {
+        version_t v = tree.vm.createVersion();
+        for (KeyType k = batch * 300; k < (batch + 1) * 300; ++k) {
+            Assert(tree.vm.applyUpdate(v, base, k, k * 7), "applyUpdate failed with a small pool");
+            reference[k] = k * 7;
+        }
+        tree.vm.commitVersion(v);
+        base = v;
+    }
+    VerifyAgainst(tree.vm, base, reference);
+
+    Log(">>> PASSED: Small Pool.");
+}
+
+int main() {
+    TestRandomAgainstReference();
+    TestSnapshotsAndAbort();
+    TestConcurrentReaders();
+    TestSmallPool();
+    Cleanup();
+    return 0;
+}
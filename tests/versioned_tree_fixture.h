@@ -0,0 +1,28 @@
+/**
+ * versioned_tree_fixture.h
+ *
+ * Shared fixture of the B+Tree tests: the full stack disk -> buffer pool -> adapter ->
+ * version manager for one key type, on pages of PageSize (PAGE_SIZE unless a test picks
+ * another, see page_size_test.cpp). Tests extend it with what they attach to the tree
+ * (see leaf_bloom_filter_test.cpp).
+ */
+
+#pragma once
+
+#include <string>
+
+#include "../src/adapter/btree_adapter.h"
+#include "../src/bufferpool/buffer_pool_adapter.h"
+#include "../src/versioning/version_manager.h"
+
+template <typename KeyT, size_t PageSize = cmse::PAGE_SIZE>
+struct VersionedTreeFixture {
+    cmse::disk::BasicDiskManager<PageSize> disk;
+    cmse::bufferpool::BasicBufferPoolManager<PageSize> bpm;
+    cmse::bufferpool::BasicBufferPoolManagerAdapter<PageSize> bpm_adapter;
+    cmse::adapter::BasicBTreeAdapter<KeyT, PageSize> tree_adapter;
+    cmse::versioning::BasicVersionManager<KeyT, PageSize> vm;
+
+    VersionedTreeFixture(const std::string& db_file, size_t pool_size)
+        : disk(db_file), bpm(pool_size, &disk), bpm_adapter(&bpm), vm(&bpm_adapter, &tree_adapter) {}
+};